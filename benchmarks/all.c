@@ -19,9 +19,13 @@
 #include <graph/plane/p3color.h>
 #include <graph/plane/p3choose.h>
 #include <graph/gen.h>
+#include <graph/io/cache.h>
 
 #ifdef BENCHMARK_THREADED
     #include <aven/thread/pool.h>
+    #include <graph/thread.h>
+    #include <graph/bfs/thread.h>
+    #include <graph/gen/thread.h>
     #include <graph/plane/p3color/thread.h>
     #include <graph/plane/p3choose/thread.h>
 #endif
@@ -39,9 +43,9 @@
 #define NTHREADS 4
 
 #ifdef BENCHMARK_THREADED
-    #define NBENCHES 11
+    #define NBENCHES 26
 #else
-    #define NBENCHES 5
+    #define NBENCHES 7
 #endif
 
 #ifdef __GNUC__
@@ -60,19 +64,38 @@ int main(void) {
 
     const char *bench_names[NBENCHES] = {
         "BFS",
+        "BFS (direction-optimizing)",
+#ifdef BENCHMARK_THREADED
+        "BFS (2 threads)",
+        "BFS (3 threads)",
+        "BFS (4 threads)",
+#endif
         "Augment Adjacency Lists",
+#ifdef BENCHMARK_THREADED
+        "Augment Adjacency Lists (2 threads)",
+        "Augment Adjacency Lists (3 threads)",
+        "Augment Adjacency Lists (4 threads)",
+#endif
         "Path 3-Color w/ BFS",
         "Path 3-Color w/ N(P)",
+        "Path 3-Color w/ N(P) (aug)",
 #ifdef BENCHMARK_THREADED
         "Path 3-Color w/ N(P) (2 threads)",
         "Path 3-Color w/ N(P) (3 threads)",
         "Path 3-Color w/ N(P) (4 threads)",
+        "Path 3-Color w/ N(P) (aug, 2 threads)",
+        "Path 3-Color w/ N(P) (aug, 3 threads)",
+        "Path 3-Color w/ N(P) (aug, 4 threads)",
 #endif
         "Path 3-Choose",
 #ifdef BENCHMARK_THREADED
         "Path 3-Choose (2 threads)",
         "Path 3-Choose (3 threads)",
         "Path 3-Choose (4 threads)",
+        "Generate Triangulation (1 thread)",
+        "Generate Triangulation (2 threads)",
+        "Generate Triangulation (3 threads)",
+        "Generate Triangulation (4 threads)",
 #endif
     };
 
@@ -103,9 +126,6 @@ int main(void) {
         }
     }
 
-    AvenRngPcg pcg_ctx = aven_rng_pcg_seed(0x3241ef25, 0xe837910f);
-    AvenRng rng = aven_rng_pcg(&pcg_ctx);
-
 #ifdef BENCHMARK_THREADED
     AvenThreadPool thread_pool = aven_thread_pool_init(
         NTHREADS - 1,
@@ -115,12 +135,12 @@ int main(void) {
     aven_thread_pool_run(&thread_pool);
 #endif
 
-    uint32_t p_data[] = { 1, 2 };
-    uint32_t q_data[] = { 0 };
+    GraphIndex p_data[] = { 1, 2 };
+    GraphIndex q_data[] = { 0 };
     GraphSubset p = slice_array(p_data);
     GraphSubset q = slice_array(q_data);
 
-    uint32_t face_data[3] = { 0, 1, 2 };
+    GraphIndex face_data[3] = { 0, 1, 2 };
     GraphSubset face = slice_array(face_data);
 
     Aff2 ident;
@@ -139,6 +159,7 @@ int main(void) {
                 GraphPlaneP3ChooseListProp color_lists;
                 GraphPropUint8 coloring;
                 GraphBfsTree tree;
+                GraphBfsTree dir_tree;
                 uint32_t root;
             } CaseData;
 
@@ -151,11 +172,82 @@ int main(void) {
                 cases.len
             );
 
+            // each case is seeded from its cache key, so the inputs are
+            // the same whether or not they are loaded from the cache, the
+            // aug graphs are never cached as building them is benchmarked
+#ifdef BENCHMARK_CACHE_DIR
+            AvenStr cache_dir = aven_str(BENCHMARK_CACHE_DIR);
+            List(GraphIoCacheEntry) cache_entries = aven_arena_create_list(
+                GraphIoCacheEntry,
+                &loop_arena,
+                cases.len
+            );
+#endif
+
             for (uint32_t i = 0; i < cases.len; i += 1) {
+                Vec2 area_bounds = { 0.0833f, 0.1666f };
+
+                uint64_t key = graph_io_cache_key(aven_str("triangulation"));
+                key = graph_io_cache_key_push(key, 0x3241ef25e837910fUL);
+                key = graph_io_cache_key_push(key, n);
+                key = graph_io_cache_key_push_float(key, area_bounds[0]);
+                key = graph_io_cache_key_push_float(key, area_bounds[1]);
+                key = graph_io_cache_key_push(key, MAX_COLOR);
+                key = graph_io_cache_key_push(key, r);
+                key = graph_io_cache_key_push(key, i);
+
+                AvenRngPcg pcg_ctx = aven_rng_pcg_seed(
+                    (uint32_t)key,
+                    (uint32_t)(key >> 32)
+                );
+                AvenRng rng = aven_rng_pcg(&pcg_ctx);
+
+                get(cases, i).root = aven_rng_rand_bounded(rng, n);
+
+                GraphPlaneP3ChooseListProp *color_lists = &get(cases, i)
+                    .color_lists;
+
+#ifdef BENCHMARK_CACHE_DIR
+                GraphIoCacheResult cache_res = graph_io_cache_load(
+                    cache_dir,
+                    key,
+                    loop_arena
+                );
+                if (cache_res.error == 0) {
+                    GraphIoCacheEntry entry = cache_res.payload;
+                    GraphIoResult graph_res = graph_io_container_graph(
+                        entry.container
+                    );
+                    GraphIoSectionResult lists_res =
+                        graph_io_container_section(
+                            GraphPlaneP3ChooseList,
+                            entry.container,
+                            GRAPH_IO_SECTION_COLOR_LISTS
+                        );
+                    if (
+                        graph_res.error == 0 and
+                        lists_res.error == 0 and
+                        graph_res.payload.adj.len == n and
+                        graph_io_cache_check(&entry, graph_res.payload)
+                    ) {
+                        GraphPlaneP3ChooseListProp cached_lists =
+                            aven_io_slice(
+                                GraphPlaneP3ChooseList,
+                                lists_res.payload
+                            );
+                        get(cases, i).graph = graph_res.payload;
+                        *color_lists = cached_lists;
+                        list_push(cache_entries) = entry;
+                        continue;
+                    }
+                    graph_io_cache_close(&entry);
+                }
+#endif
+
                 Graph graph = graph_gen_triangulation(
                     n,
                     rng,
-                    (Vec2){ 0.0833f, 0.1666f },
+                    area_bounds,
                     &loop_arena
                 );
                 get(cases, i).graph = graph;
@@ -163,11 +255,6 @@ int main(void) {
                     aven_panic("graph generation failed");
                 }
 
-                get(cases, i).root = aven_rng_rand_bounded(rng, n);
-
-                GraphPlaneP3ChooseListProp *color_lists = &get(cases, i)
-                    .color_lists;
-
                 color_lists->len = n;
                 color_lists->ptr = aven_arena_create_array(
                     GraphPlaneP3ChooseList,
@@ -203,6 +290,34 @@ int main(void) {
 
                     get(*color_lists, j) = list;
                 }
+
+#ifdef BENCHMARK_CACHE_DIR
+                GraphIoContainerWriter writer = graph_io_container_writer_init(
+                    4,
+                    false,
+                    &loop_arena
+                );
+                graph_io_container_writer_add_graph(&writer, graph);
+                graph_io_container_writer_add(
+                    &writer,
+                    GRAPH_IO_SECTION_COLOR_LISTS,
+                    *color_lists
+                );
+                int store_error = graph_io_cache_store(
+                    cache_dir,
+                    key,
+                    graph_io_cache_hash(graph),
+                    &writer,
+                    loop_arena
+                );
+                if (store_error != 0) {
+                    fprintf(
+                        stderr,
+                        "WARNING: failed to cache input (error %d)\n",
+                        store_error
+                    );
+                }
+#endif
             }
             {
                 AvenArena temp_arena = loop_arena;
@@ -232,6 +347,9 @@ int main(void) {
                 double ns_per_graph = (double)elapsed_ns /
                     (double)(cases.len * nruns);
 
+                // the trees are checked against by the other BFS variants
+                loop_arena = temp_arena;
+
                 uint32_t nvalid = 0;
                 for (uint32_t i = 0; i < cases.len; i += 1) {
                     GraphBfsTree tree = get(cases, i).tree;
@@ -251,7 +369,7 @@ int main(void) {
                                 break;
                             }
                         } else {
-                            uint32_t u = graph_bfs_tree_parent(tree, v);
+                            GraphIndex u = graph_bfs_tree_parent(tree, v);
                             if (get(tree, v).dist - get(tree, u).dist != 1) {
                                 valid = false;
                                 break;
@@ -280,6 +398,168 @@ int main(void) {
                 get(get(bench_times, bench_index), n_count) += ns_per_graph;
                 bench_index += 1;
             }
+            {
+                AvenArena temp_arena = loop_arena;
+
+                BENCHMARK_COMPILER_BARRIER;
+                AvenTimeInst start_inst = aven_time_now();
+                BENCHMARK_COMPILER_BARRIER;
+
+                for (size_t k = 0; k < nruns; k += 1) {
+                    BENCHMARK_COMPILER_BARRIER;
+                    temp_arena = loop_arena;
+                    for (uint32_t i = 0; i < cases.len; i += 1) {
+                        get(cases, i).dir_tree = graph_bfs_dir(
+                            get(cases, i).graph,
+                            get(cases, i).root,
+                            &temp_arena
+                        );
+                    }
+                    BENCHMARK_COMPILER_BARRIER;
+                }
+
+                BENCHMARK_COMPILER_BARRIER;
+                AvenTimeInst end_inst = aven_time_now();
+                BENCHMARK_COMPILER_BARRIER;
+
+                int64_t elapsed_ns = aven_time_since(end_inst, start_inst);
+                double ns_per_graph = (double)elapsed_ns /
+                    (double)(cases.len * nruns);
+
+                uint32_t nvalid = 0;
+                for (uint32_t i = 0; i < cases.len; i += 1) {
+                    GraphBfsTree tree = get(cases, i).tree;
+                    GraphBfsTree dir_tree = get(cases, i).dir_tree;
+                    bool valid = true;
+                    for (uint32_t v = 0; v < dir_tree.len; v += 1) {
+                        if (!graph_bfs_tree_contains(dir_tree, v)) {
+                            valid = false;
+                            break;
+                        }
+                        if (get(dir_tree, v).dist != get(tree, v).dist) {
+                            valid = false;
+                            break;
+                        }
+                        if (v != get(cases, i).root) {
+                            GraphIndex u = graph_bfs_tree_parent(dir_tree, v);
+                            if (get(tree, v).dist - get(tree, u).dist != 1) {
+                                valid = false;
+                                break;
+                            }
+                        }
+                    }
+                    if (valid) {
+                        nvalid += 1;
+                    }
+                }
+
+                if (nvalid < cases.len) {
+                    aven_panic("invalid bfs tree (direction-optimizing)");
+                }
+
+                printf(
+                    "direction-optimizing bfs on %lu graph(s) "
+                    "with %lu vertices:\n"
+                    "\ttime per graph: %fns\n"
+                    "\ttime per half-edge: %fns\n",
+                    (unsigned long)cases.len,
+                    (unsigned long)n,
+                    ns_per_graph,
+                    ns_per_graph / (double)(6 * n - 12)
+                );
+
+                get(get(bench_times, bench_index), n_count) += ns_per_graph;
+                bench_index += 1;
+            }
+#ifdef BENCHMARK_THREADED
+            for (size_t nthreads = 2; nthreads <= NTHREADS; nthreads += 1) {
+                AvenArena temp_arena = loop_arena;
+
+                Slice(GraphBfsTree) thread_trees = aven_arena_create_slice(
+                    GraphBfsTree,
+                    &temp_arena,
+                    cases.len
+                );
+                AvenArena run_arena = temp_arena;
+
+                BENCHMARK_COMPILER_BARRIER;
+                AvenTimeInst start_inst = aven_time_now();
+                BENCHMARK_COMPILER_BARRIER;
+
+                for (size_t k = 0; k < nruns; k += 1) {
+                    BENCHMARK_COMPILER_BARRIER;
+                    temp_arena = run_arena;
+                    for (uint32_t i = 0; i < cases.len; i += 1) {
+                        get(thread_trees, i) = graph_bfs_thread(
+                            get(cases, i).graph,
+                            get(cases, i).root,
+                            &thread_pool,
+                            nthreads,
+                            &temp_arena
+                        );
+                    }
+                    BENCHMARK_COMPILER_BARRIER;
+                }
+
+                BENCHMARK_COMPILER_BARRIER;
+                AvenTimeInst end_inst = aven_time_now();
+                BENCHMARK_COMPILER_BARRIER;
+
+                int64_t elapsed_ns = aven_time_since(end_inst, start_inst);
+                double ns_per_graph = (double)elapsed_ns /
+                    (double)(cases.len * nruns);
+
+                uint32_t nvalid = 0;
+                for (uint32_t i = 0; i < cases.len; i += 1) {
+                    GraphBfsTree tree = get(cases, i).tree;
+                    GraphBfsTree thread_tree = get(thread_trees, i);
+                    bool valid = true;
+                    for (uint32_t v = 0; v < thread_tree.len; v += 1) {
+                        if (!graph_bfs_tree_contains(thread_tree, v)) {
+                            valid = false;
+                            break;
+                        }
+                        if (get(thread_tree, v).dist != get(tree, v).dist) {
+                            valid = false;
+                            break;
+                        }
+                        GraphIndex u = graph_bfs_tree_parent(thread_tree, v);
+                        if (v == get(cases, i).root) {
+                            if (u != v) {
+                                valid = false;
+                                break;
+                            }
+                        } else if (
+                            get(tree, v).dist - get(tree, u).dist != 1
+                        ) {
+                            valid = false;
+                            break;
+                        }
+                    }
+                    if (valid) {
+                        nvalid += 1;
+                    }
+                }
+
+                if (nvalid < cases.len) {
+                    aven_panic("invalid bfs tree (threaded)");
+                }
+
+                printf(
+                    "bfs (%lu threads) on %lu graph(s) with %lu vertices:\n"
+                    "\ttime per graph: %fns\n"
+                    "\ttime per half-edge: %fns\n",
+                    (unsigned long)nthreads,
+                    (unsigned long)cases.len,
+                    (unsigned long)n,
+                    ns_per_graph,
+                    ns_per_graph / (double)(6 * n - 12)
+                );
+
+                get(get(bench_times, bench_index), n_count) += ns_per_graph;
+                bench_index += 1;
+            }
+#endif
             {
                 AvenArena temp_arena = loop_arena;
                 BENCHMARK_COMPILER_BARRIER;
@@ -327,7 +607,7 @@ int main(void) {
                         }
 
                         for (uint32_t j = 0; j < v_adj.len; j += 1) {
-                            uint32_t u = graph_nb(graph.nb, v_adj, j);
+                            GraphIndex u = graph_nb(graph.nb, v_adj, j);
                             GraphAugNb u_node = graph_aug_nb(
                                 aug_graph.nb,
                                 v_aug_adj,
@@ -340,7 +620,7 @@ int main(void) {
                             }
 
                             GraphAdj u_aug_adj = get(aug_graph.adj, u);
-                            uint32_t w = graph_aug_nb(
+                            GraphIndex w = graph_aug_nb(
                                 aug_graph.nb,
                                 u_aug_adj,
                                 u_node.back_index
@@ -378,6 +658,105 @@ int main(void) {
                 get(get(bench_times, bench_index), n_count) += ns_per_graph;
                 bench_index += 1;
             }
+#ifdef BENCHMARK_THREADED
+            for (size_t nthreads = 2; nthreads <= NTHREADS; nthreads += 1) {
+                AvenArena temp_arena = loop_arena;
+
+                Slice(GraphAug) thread_aug_graphs = aven_arena_create_slice(
+                    GraphAug,
+                    &temp_arena,
+                    cases.len
+                );
+                AvenArena run_arena = temp_arena;
+
+                BENCHMARK_COMPILER_BARRIER;
+                AvenTimeInst start_inst = aven_time_now();
+                BENCHMARK_COMPILER_BARRIER;
+
+                for (size_t k = 0; k < nruns; k += 1) {
+                    BENCHMARK_COMPILER_BARRIER;
+                    temp_arena = run_arena;
+                    for (uint32_t i = 0; i < cases.len; i += 1) {
+                        get(thread_aug_graphs, i) = graph_aug_thread(
+                            get(cases, i).graph,
+                            &thread_pool,
+                            nthreads,
+                            &temp_arena
+                        );
+                    }
+                    BENCHMARK_COMPILER_BARRIER;
+                }
+
+                BENCHMARK_COMPILER_BARRIER;
+                AvenTimeInst end_inst = aven_time_now();
+                BENCHMARK_COMPILER_BARRIER;
+
+                int64_t elapsed_ns = aven_time_since(end_inst, start_inst);
+                double ns_per_graph = (double)elapsed_ns /
+                    (double)(cases.len * nruns);
+
+                // must match the sequential augmentation exactly
+                uint32_t nvalid = 0;
+                for (uint32_t i = 0; i < cases.len; i += 1) {
+                    GraphAug aug_graph = get(cases, i).aug_graph;
+                    GraphAug thread_aug_graph = get(thread_aug_graphs, i);
+
+                    if (
+                        aug_graph.adj.len != thread_aug_graph.adj.len or
+                        aug_graph.nb.len != thread_aug_graph.nb.len
+                    ) {
+                        continue;
+                    }
+
+                    bool valid = true;
+                    for (uint32_t v = 0; v < aug_graph.adj.len; v += 1) {
+                        GraphAdj v_adj = get(aug_graph.adj, v);
+                        GraphAdj v_thread_adj = get(thread_aug_graph.adj, v);
+                        if (
+                            v_adj.index != v_thread_adj.index or
+                            v_adj.len != v_thread_adj.len
+                        ) {
+                            valid = false;
+                            break;
+                        }
+                    }
+                    for (uint32_t j = 0; j < aug_graph.nb.len; j += 1) {
+                        GraphAugNb nb = get(aug_graph.nb, j);
+                        GraphAugNb thread_nb = get(thread_aug_graph.nb, j);
+                        if (
+                            nb.vertex != thread_nb.vertex or
+                            nb.back_index != thread_nb.back_index
+                        ) {
+                            valid = false;
+                            break;
+                        }
+                    }
+
+                    if (valid) {
+                        nvalid += 1;
+                    }
+                }
+
+                if (nvalid < cases.len) {
+                    aven_panic("invalid augmentation (threaded)");
+                }
+
+                printf(
+                    "augmenting (%lu threads) %lu graph(s) "
+                    "with %lu vertices:\n"
+                    "\ttime per graph: %fns\n"
+                    "\ttime per half-edge: %fns\n",
+                    (unsigned long)nthreads,
+                    (unsigned long)cases.len,
+                    (unsigned long)n,
+                    ns_per_graph,
+                    ns_per_graph / (double)(6 * n - 12)
+                );
+
+                get(get(bench_times, bench_index), n_count) += ns_per_graph;
+                bench_index += 1;
+            }
+#endif
             {
                 AvenArena temp_arena = loop_arena;
 
@@ -493,6 +872,64 @@ int main(void) {
                     ns_per_graph / (double)(6 * n - 12)
                 );
 
+                get(get(bench_times, bench_index), n_count) += ns_per_graph;
+                bench_index += 1;
+            }
+            {
+                AvenArena temp_arena = loop_arena;
+
+                BENCHMARK_COMPILER_BARRIER;
+                AvenTimeInst start_inst = aven_time_now();
+                BENCHMARK_COMPILER_BARRIER;
+
+                for (size_t k = 0; k < nruns; k += 1) {
+                    BENCHMARK_COMPILER_BARRIER;
+                    temp_arena = loop_arena;
+                    for (uint32_t i = 0; i < cases.len; i += 1) {
+                        get(cases, i).coloring = graph_plane_p3color_aug(
+                            get(cases, i).aug_graph,
+                            p,
+                            q,
+                            &temp_arena
+                        );
+                    }
+                    BENCHMARK_COMPILER_BARRIER;
+                }
+
+                BENCHMARK_COMPILER_BARRIER;
+                AvenTimeInst end_inst = aven_time_now();
+                BENCHMARK_COMPILER_BARRIER;
+
+                int64_t elapsed_ns = aven_time_since(end_inst, start_inst);
+                double ns_per_graph = (double)elapsed_ns /
+                    (double)(cases.len * nruns);
+
+                uint32_t nvalid = 0;
+                for (uint32_t i = 0; i < cases.len; i += 1) {
+                    bool valid = graph_path_color_verify(
+                        get(cases, i).graph,
+                        get(cases, i).coloring,
+                        temp_arena
+                    );
+                    if (valid) {
+                        nvalid += 1;
+                    }
+                }
+
+                if (nvalid < cases.len) {
+                    aven_panic("invalid 3-coloring (aug)");
+                }
+
+                printf(
+                    "path 3-coloring (aug) %lu graph(s) with %lu vertices:\n"
+                    "\ttime per graph: %fns\n"
+                    "\ttime per half-edge: %fns\n",
+                    (unsigned long)cases.len,
+                    (unsigned long)n,
+                    ns_per_graph,
+                    ns_per_graph / (double)(6 * n - 12)
+                );
+
                 get(get(bench_times, bench_index), n_count) += ns_per_graph;
                 bench_index += 1;
             }
@@ -556,6 +993,69 @@ int main(void) {
                     ns_per_graph / (double)(6 * n - 12)
                 );
 
+                get(get(bench_times, bench_index), n_count) += ns_per_graph;
+                bench_index += 1;
+            }
+            for (size_t nthreads = 2; nthreads <= NTHREADS; nthreads += 1) {
+                AvenArena temp_arena = loop_arena;
+
+                BENCHMARK_COMPILER_BARRIER;
+                AvenTimeInst start_inst = aven_time_now();
+                BENCHMARK_COMPILER_BARRIER;
+
+                for (size_t k = 0; k < nruns; k += 1) {
+                    BENCHMARK_COMPILER_BARRIER;
+                    temp_arena = loop_arena;
+                    for (uint32_t i = 0; i < cases.len; i += 1) {
+                        get(cases, i).coloring =
+                            graph_plane_p3color_thread_aug(
+                                get(cases, i).aug_graph,
+                                p,
+                                q,
+                                &thread_pool,
+                                nthreads,
+                                &temp_arena
+                            );
+                    }
+                    BENCHMARK_COMPILER_BARRIER;
+                }
+
+                BENCHMARK_COMPILER_BARRIER;
+                AvenTimeInst end_inst = aven_time_now();
+                BENCHMARK_COMPILER_BARRIER;
+
+                int64_t elapsed_ns = aven_time_since(end_inst, start_inst);
+                double ns_per_graph = (double)elapsed_ns /
+                    (double)(cases.len * nruns);
+
+                uint32_t nvalid = 0;
+                for (uint32_t i = 0; i < cases.len; i += 1) {
+                    bool valid = graph_path_color_verify(
+                        get(cases, i).graph,
+                        get(cases, i).coloring,
+                        temp_arena
+                    );
+                    if (valid) {
+                        nvalid += 1;
+                    }
+                }
+
+                if (nvalid < cases.len) {
+                    aven_panic("invalid 3-coloring (aug, threaded)");
+                }
+
+                printf(
+                    "path 3-coloring (aug, %lu threads) %lu graph(s) "
+                    "with %lu vertices:\n"
+                    "\ttime per graph: %fns\n"
+                    "\ttime per half-edge: %fns\n",
+                    (unsigned long)nthreads,
+                    (unsigned long)cases.len,
+                    (unsigned long)n,
+                    ns_per_graph,
+                    ns_per_graph / (double)(6 * n - 12)
+                );
+
                 get(get(bench_times, bench_index), n_count) += ns_per_graph;
                 bench_index += 1;
             }
@@ -744,6 +1244,130 @@ int main(void) {
                 bench_index += 1;
             }
 #endif
+#ifdef BENCHMARK_THREADED
+            {
+                // the one thread graphs are the reference for the others
+                Slice(Graph) gen_graphs = aven_arena_create_slice(
+                    Graph,
+                    &loop_arena,
+                    cases.len
+                );
+                Vec2 flip_prob = { 0.33f, 0.33f };
+
+                for (size_t nthreads = 1; nthreads <= NTHREADS; nthreads += 1) {
+                    AvenArena temp_arena = loop_arena;
+
+                    Slice(Graph) thread_graphs = aven_arena_create_slice(
+                        Graph,
+                        &temp_arena,
+                        cases.len
+                    );
+                    AvenArena run_arena = temp_arena;
+
+                    BENCHMARK_COMPILER_BARRIER;
+                    AvenTimeInst start_inst = aven_time_now();
+                    BENCHMARK_COMPILER_BARRIER;
+
+                    for (size_t k = 0; k < nruns; k += 1) {
+                        BENCHMARK_COMPILER_BARRIER;
+                        temp_arena = run_arena;
+                        for (uint32_t i = 0; i < cases.len; i += 1) {
+                            get(thread_graphs, i) =
+                                graph_gen_triangulation_thread(
+                                    n,
+                                    get(cases, i).root,
+                                    flip_prob,
+                                    &thread_pool,
+                                    nthreads,
+                                    &temp_arena
+                                );
+                        }
+                        BENCHMARK_COMPILER_BARRIER;
+                    }
+
+                    BENCHMARK_COMPILER_BARRIER;
+                    AvenTimeInst end_inst = aven_time_now();
+                    BENCHMARK_COMPILER_BARRIER;
+
+                    int64_t elapsed_ns = aven_time_since(end_inst, start_inst);
+                    double ns_per_graph = (double)elapsed_ns /
+                        (double)(cases.len * nruns);
+
+                    if (nthreads == 1) {
+                        for (uint32_t i = 0; i < cases.len; i += 1) {
+                            get(gen_graphs, i) = get(thread_graphs, i);
+                        }
+                        // keep the reference graphs for the later runs
+                        loop_arena = temp_arena;
+                    }
+
+                    uint32_t nvalid = 0;
+                    for (uint32_t i = 0; i < cases.len; i += 1) {
+                        Graph graph = get(gen_graphs, i);
+                        Graph thread_graph = get(thread_graphs, i);
+
+                        if (
+                            thread_graph.adj.len != n or
+                            thread_graph.nb.len != 6 * n - 12 or
+                            graph.nb.len != thread_graph.nb.len
+                        ) {
+                            continue;
+                        }
+
+                        bool valid = true;
+                        for (uint32_t v = 0; v < graph.adj.len; v += 1) {
+                            GraphAdj v_adj = get(graph.adj, v);
+                            GraphAdj v_thread_adj = get(thread_graph.adj, v);
+                            if (
+                                v_adj.index != v_thread_adj.index or
+                                v_adj.len != v_thread_adj.len
+                            ) {
+                                valid = false;
+                                break;
+                            }
+                        }
+                        for (uint32_t j = 0; j < graph.nb.len; j += 1) {
+                            if (
+                                get(graph.nb, j) != get(thread_graph.nb, j)
+                            ) {
+                                valid = false;
+                                break;
+                            }
+                        }
+
+                        if (valid) {
+                            nvalid += 1;
+                        }
+                    }
+
+                    if (nvalid < cases.len) {
+                        aven_panic("invalid triangulation (threaded)");
+                    }
+
+                    printf(
+                        "generating (%lu threads) %lu triangulation(s) "
+                        "with %lu vertices:\n"
+                        "\ttime per graph: %fns\n"
+                        "\ttime per half-edge: %fns\n",
+                        (unsigned long)nthreads,
+                        (unsigned long)cases.len,
+                        (unsigned long)n,
+                        ns_per_graph,
+                        ns_per_graph / (double)(6 * n - 12)
+                    );
+
+                    get(get(bench_times, bench_index), n_count) +=
+                        ns_per_graph;
+                    bench_index += 1;
+                }
+            }
+#endif
+#ifdef BENCHMARK_CACHE_DIR
+            for (size_t i = 0; i < cache_entries.len; i += 1) {
+                graph_io_cache_close(&get(cache_entries, i));
+            }
+#endif
+
             n_count += 1;
         }
     }
@@ -88,13 +88,13 @@ int main(void) {
     AvenRngPcg pcg_ctx = aven_rng_pcg_seed(0x3241ef25, 0xe837910f);
     AvenRng rng = aven_rng_pcg(&pcg_ctx);
 
-    uint32_t p_data[] = { 0 };
-    uint32_t q_data[] = { 2, 1 };
+    GraphIndex p_data[] = { 0 };
+    GraphIndex q_data[] = { 2, 1 };
     GraphSubset p = slice_array(p_data);
     GraphSubset q = slice_array(q_data);
 
-    uint32_t p_data_flipped[] = { 1, 2 };
-    uint32_t q_data_flipped[] = { 0 };
+    GraphIndex p_data_flipped[] = { 1, 2 };
+    GraphIndex q_data_flipped[] = { 0 };
     GraphSubset p_flipped = slice_array(p_data_flipped);
     GraphSubset q_flipped = slice_array(q_data_flipped);
 
@@ -187,7 +187,7 @@ int main(void) {
                                 break;
                             }
                         } else {
-                            uint32_t u = graph_bfs_tree_parent(tree, v);
+                            GraphIndex u = graph_bfs_tree_parent(tree, v);
                             if (get(tree, v).dist - get(tree, u).dist != 1) {
                                 valid = false;
                                 break;
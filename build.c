@@ -488,11 +488,14 @@ int main(int argc, char **argv) {
     AvenStr test_dir = aven_str("build_test");
     AvenBuildStep test_dir_step = aven_build_step_mkdir(test_dir);
 
-    AvenBuildStep *test_obj_data[1];
+    AvenBuildStep *test_obj_data[2];
     List(AvenBuildStep *) test_obj_list = list_array(test_obj_data);
     if (winutf8_obj_step.valid) {
         list_push(test_obj_list) = &winutf8_obj_step.value;
     }
+    if (winpthreads_obj_step.valid) {
+        list_push(test_obj_list) = &winpthreads_obj_step.value;
+    }
     AvenBuildStepPtrSlice test_objs = slice_list(test_obj_list);
 
     AvenStrSlice test_args = { 0 };
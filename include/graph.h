@@ -4,27 +4,42 @@
     #include <aven.h>
     #include <aven/arena.h>
 
+    // Vertex and half-edge index type, define GRAPH_WIDE_INDEX for graphs
+    // with more than 2^32 - 1 half-edges
+
+    #ifdef GRAPH_WIDE_INDEX
+        typedef uint64_t GraphIndex;
+        #define GRAPH_INDEX_MAX UINT64_MAX
+    #else
+        typedef uint32_t GraphIndex;
+        #define GRAPH_INDEX_MAX UINT32_MAX
+    #endif
+
     typedef struct {
-        uint32_t index;
-        uint32_t len;
+        GraphIndex index;
+        GraphIndex len;
     } GraphAdj;
 
     typedef Slice(GraphAdj) GraphAdjSlice;
-    typedef Slice(uint32_t) GraphNbSlice;
+    typedef Slice(GraphIndex) GraphNbSlice;
 
     typedef struct {
         GraphNbSlice nb;
         GraphAdjSlice adj;
     } Graph;
 
-    typedef Slice(uint32_t) GraphSubset;
+    typedef Slice(GraphIndex) GraphSubset;
 
-    static inline uint32_t graph_nb(GraphNbSlice nb, GraphAdj v_adj, uint32_t i) {
+    static inline GraphIndex graph_nb(
+        GraphNbSlice nb,
+        GraphAdj v_adj,
+        GraphIndex i
+    ) {
         assert(i < v_adj.len);
         return get(nb, v_adj.index + i);
     }
 
-    static inline uint32_t graph_adj_next(GraphAdj v_adj, uint32_t i) {
+    static inline GraphIndex graph_adj_next(GraphAdj v_adj, GraphIndex i) {
         assert(i < v_adj.len);
         if (i == v_adj.len - 1) {
             return 0;
@@ -32,7 +47,7 @@
         return i + 1;
     }
 
-    static inline uint32_t graph_adj_prev(GraphAdj v_adj, uint32_t i) {
+    static inline GraphIndex graph_adj_prev(GraphAdj v_adj, GraphIndex i) {
         assert(i < v_adj.len);
         if (i == 0) {
             return v_adj.len - 1;
@@ -40,29 +55,30 @@
         return i - 1;
     }
 
-    static inline uint32_t graph_nb_index(
+    static inline GraphIndex graph_nb_index(
         GraphNbSlice nb,
         GraphAdj v_adj,
-        uint32_t u
+        GraphIndex u
     ) {
-        for (uint32_t i = 0; i < v_adj.len; i += 1) {
+        for (GraphIndex i = 0; i < v_adj.len; i += 1) {
             if (graph_nb(nb, v_adj, i) == u) {
                 return i;
             }
         }
 
         assert(false);
-        return 0xffffffff;
+        return GRAPH_INDEX_MAX;
     }
 
     typedef Slice(uint64_t) GraphPropUint64;
     typedef Slice(uint32_t) GraphPropUint32;
     typedef Slice(uint16_t) GraphPropUint16;
     typedef Slice(uint8_t) GraphPropUint8;
+    typedef Slice(GraphIndex) GraphPropIndex;
 
     typedef struct {
-        uint32_t vertex;
-        uint32_t back_index;
+        GraphIndex vertex;
+        GraphIndex back_index;
     } GraphAugNb;
     typedef Slice(GraphAugNb) GraphAugNbSlice;
 
@@ -74,28 +90,28 @@
     static inline GraphAugNb graph_aug_nb(
         GraphAugNbSlice nb,
         GraphAdj v_adj,
-        uint32_t i
+        GraphIndex i
     ) {
         assert(i < v_adj.len);
         return get(nb, v_adj.index + i);
     }
 
-    static inline uint32_t graph_aug_nb_index(
+    static inline GraphIndex graph_aug_nb_index(
         GraphAugNbSlice nb,
         GraphAdj v_adj,
-        uint32_t u
+        GraphIndex u
     ) {
-        for (uint32_t i = 0; i < v_adj.len; i += 1) {
+        for (GraphIndex i = 0; i < v_adj.len; i += 1) {
             if (graph_aug_nb(nb, v_adj, i).vertex == u) {
                 return i;
             }
         }
 
         assert(false);
-        return 0xffffffff;
+        return GRAPH_INDEX_MAX;
     }
 
-    static inline uint32_t graph_aug_deg(GraphAug graph, uint32_t v) {
+    static inline GraphIndex graph_aug_deg(GraphAug graph, GraphIndex v) {
         return get(graph.adj, v).len;
     }
 
@@ -115,11 +131,11 @@
             aug_graph.adj.len
         );
 
-        for (uint32_t v = 0; v < graph.adj.len; v += 1) {
+        for (GraphIndex v = 0; v < graph.adj.len; v += 1) {
             get(aug_graph.adj, v) = get(graph.adj, v);
         }
 
-        for (uint32_t i = 0; i < graph.nb.len; i += 1) {
+        for (GraphIndex i = 0; i < graph.nb.len; i += 1) {
             get(aug_graph.nb, i) = (GraphAugNb){ .vertex = get(graph.nb, i) };
         }
 
@@ -134,8 +150,8 @@
             work_lists.len
         );
 
-        for (uint32_t v = 0; v < graph.adj.len; v += 1) {
-            uint32_t v_deg = get(graph.adj, v).len;
+        for (GraphIndex v = 0; v < graph.adj.len; v += 1) {
+            GraphIndex v_deg = get(graph.adj, v).len;
 
             GraphAugNb *v_work_nodes = aven_arena_create_array(
                 GraphAugNb,
@@ -149,10 +165,10 @@
             };
         }
 
-        for (uint32_t v = 0; v < graph.adj.len; v += 1) {
+        for (GraphIndex v = 0; v < graph.adj.len; v += 1) {
             GraphAdj v_adj = get(graph.adj, v);
-            for (uint32_t i = 0; i < v_adj.len; i += 1) {
-                uint32_t u = graph_nb(graph.nb, v_adj, i);
+            for (GraphIndex i = 0; i < v_adj.len; i += 1) {
+                GraphIndex u = graph_nb(graph.nb, v_adj, i);
 
                 list_push(get(work_lists, u)) = (GraphAugNb){
                     .vertex = v,
@@ -161,13 +177,13 @@
             }
         }
 
-        for (uint32_t k = (uint32_t)graph.adj.len; k > 0; k -= 1) {
-            uint32_t v = k - 1;
+        for (GraphIndex k = (GraphIndex)graph.adj.len; k > 0; k -= 1) {
+            GraphIndex v = k - 1;
 
             GraphAugWorkList *v_work_list = &get(work_lists, v);
-            for (uint32_t i = 0; i < v_work_list->len; i += 1) {
+            for (GraphIndex i = 0; i < v_work_list->len; i += 1) {
                 GraphAugNb v_work_node = get(*v_work_list, i);
-                uint32_t u = v_work_node.vertex;
+                GraphIndex u = v_work_node.vertex;
 
                 GraphAugWorkList *u_work_list = &get(work_lists, u);
                 GraphAugNb u_work_node = get(*u_work_list, u_work_list->len - 1);
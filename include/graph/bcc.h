@@ -0,0 +1,323 @@
+#ifndef GRAPH_BCC_H
+    #define GRAPH_BCC_H
+
+    #include <aven.h>
+    #include <aven/arena.h>
+
+    #include "../graph.h"
+    #include "dfs.h"
+
+    // Biconnected components, articulation points and bridges of a simple
+    // graph from a DFS forest. The lowpoint kept by graph_dfs_step folds in
+    // the lowpoints of visited neighbors, which may reach above an
+    // articulation point, so the classical lowpoint is rebuilt here from
+    // least_ancestor in reverse DFS order.
+
+    typedef struct {
+        // block containing each edge, indexed by half-edge like graph.nb
+        GraphPropIndex edge_block;
+        // get(blocks, b) is the range of block_vertices holding block b
+        GraphAdjSlice blocks;
+        GraphNbSlice block_vertices;
+        // non-zero exactly for the articulation points
+        GraphPropUint8 cut;
+        // the articulation points in increasing order
+        GraphSubset cut_vertices;
+        // one half-edge index p -> v per bridge, p the DFS parent of v
+        GraphSubset bridges;
+    } GraphBcc;
+
+    static inline GraphBcc graph_bcc(Graph graph, AvenArena *arena) {
+        GraphIndex n = (GraphIndex)graph.adj.len;
+
+        GraphBcc bcc = {
+            .edge_block = { .len = graph.nb.len },
+            .cut = { .len = n },
+        };
+        bcc.edge_block.ptr = aven_arena_create_array(
+            GraphIndex,
+            arena,
+            bcc.edge_block.len
+        );
+        bcc.cut.ptr = aven_arena_create_array(uint8_t, arena, bcc.cut.len);
+
+        List(GraphAdj) block_list = aven_arena_create_list(GraphAdj, arena, n);
+        List(GraphIndex) block_vertex_list = aven_arena_create_list(
+            GraphIndex,
+            arena,
+            2 * n
+        );
+        List(GraphIndex) cut_list = aven_arena_create_list(
+            GraphIndex,
+            arena,
+            n
+        );
+        List(GraphIndex) bridge_list = aven_arena_create_list(
+            GraphIndex,
+            arena,
+            n
+        );
+
+        if (n > 0) {
+            AvenArena temp_arena = *arena;
+
+            GraphPropIndex low = aven_arena_create_slice(
+                GraphIndex,
+                &temp_arena,
+                n
+            );
+            GraphPropIndex vertex_block = aven_arena_create_slice(
+                GraphIndex,
+                &temp_arena,
+                n
+            );
+            GraphPropIndex head_children = aven_arena_create_slice(
+                GraphIndex,
+                &temp_arena,
+                n
+            );
+            GraphPropIndex block_parent = aven_arena_create_slice(
+                GraphIndex,
+                &temp_arena,
+                n
+            );
+
+            GraphDfsCtx ctx = graph_dfs_init(graph, 0, &temp_arena);
+            for (GraphIndex r = 0; r < n; r += 1) {
+                if (!graph_dfs_tree_contains(ctx.tree, r)) {
+                    graph_dfs_push_root(&ctx, r);
+                }
+                while (!graph_dfs_step(&ctx)) {}
+            }
+
+            for (GraphIndex v = 0; v < n; v += 1) {
+                get(low, v) = get(ctx.tree, v).least_ancestor;
+                get(head_children, v) = 0;
+            }
+
+            for (GraphIndex k = n; k > 0; k -= 1) {
+                GraphIndex v = get(ctx.dfs_numbering, k - 1);
+                GraphIndex p = graph_dfs_tree_parent(ctx.tree, v);
+                if (p != v) {
+                    get(low, p) = min(get(low, p), get(low, v));
+                }
+            }
+
+            // A child whose subtree cannot reach above its parent starts a
+            // new block with the parent, any other vertex joins the block
+            // of its parent. Roots belong only to the blocks of their
+            // children unless they are isolated.
+
+            GraphIndex nblocks = 0;
+            for (GraphIndex k = 0; k < n; k += 1) {
+                GraphIndex v = get(ctx.dfs_numbering, k);
+                GraphIndex p = graph_dfs_tree_parent(ctx.tree, v);
+                if (p == v) {
+                    if (get(graph.adj, v).len == 0) {
+                        get(block_parent, nblocks) = GRAPH_INDEX_MAX;
+                        get(vertex_block, v) = nblocks;
+                        nblocks += 1;
+                    } else {
+                        get(vertex_block, v) = GRAPH_INDEX_MAX;
+                    }
+                } else if (get(low, v) >= get(ctx.tree, p).number) {
+                    get(block_parent, nblocks) = p;
+                    get(vertex_block, v) = nblocks;
+                    get(head_children, p) += 1;
+                    nblocks += 1;
+                } else {
+                    get(vertex_block, v) = get(vertex_block, p);
+                }
+            }
+
+            for (GraphIndex v = 0; v < n; v += 1) {
+                GraphIndex min_children = 1;
+                if (graph_dfs_tree_parent(ctx.tree, v) == v) {
+                    min_children = 2;
+                }
+
+                get(bcc.cut, v) = get(head_children, v) >= min_children;
+                if (get(bcc.cut, v) != 0) {
+                    list_push(cut_list) = v;
+                }
+            }
+
+            for (GraphIndex b = 0; b < nblocks; b += 1) {
+                list_push(block_list) = (GraphAdj){ 0 };
+            }
+            for (GraphIndex b = 0; b < nblocks; b += 1) {
+                if (get(block_parent, b) != GRAPH_INDEX_MAX) {
+                    get(block_list, b).len += 1;
+                }
+            }
+            for (GraphIndex v = 0; v < n; v += 1) {
+                if (get(vertex_block, v) != GRAPH_INDEX_MAX) {
+                    get(block_list, get(vertex_block, v)).len += 1;
+                }
+            }
+
+            GraphIndex index = 0;
+            for (GraphIndex b = 0; b < nblocks; b += 1) {
+                get(block_list, b).index = index;
+                index += get(block_list, b).len;
+                get(block_list, b).len = 0;
+            }
+            block_vertex_list.len = index;
+
+            for (GraphIndex b = 0; b < nblocks; b += 1) {
+                GraphIndex p = get(block_parent, b);
+                if (p != GRAPH_INDEX_MAX) {
+                    GraphAdj *b_adj = &get(block_list, b);
+                    get(block_vertex_list, b_adj->index + b_adj->len) = p;
+                    b_adj->len += 1;
+                }
+            }
+            for (GraphIndex k = 0; k < n; k += 1) {
+                GraphIndex v = get(ctx.dfs_numbering, k);
+                GraphIndex b = get(vertex_block, v);
+                if (b != GRAPH_INDEX_MAX) {
+                    GraphAdj *b_adj = &get(block_list, b);
+                    get(block_vertex_list, b_adj->index + b_adj->len) = v;
+                    b_adj->len += 1;
+                }
+            }
+
+            // Each edge lies in the block of its endpoint farther from the
+            // root, a tree edge is a bridge if the child subtree cannot
+            // reach the parent or above
+
+            for (GraphIndex v = 0; v < n; v += 1) {
+                GraphAdj v_adj = get(graph.adj, v);
+                GraphDfsTreeNode v_node = get(ctx.tree, v);
+                for (GraphIndex i = 0; i < v_adj.len; i += 1) {
+                    GraphIndex u = graph_nb(graph.nb, v_adj, i);
+                    GraphDfsTreeNode u_node = get(ctx.tree, u);
+
+                    GraphIndex child = u;
+                    if (v_node.number > u_node.number) {
+                        child = v;
+                    }
+                    get(bcc.edge_block, v_adj.index + i) = get(
+                        vertex_block,
+                        child
+                    );
+
+                    if (
+                        graph_dfs_tree_parent(ctx.tree, u) == v and
+                        get(low, u) > v_node.number
+                    ) {
+                        list_push(bridge_list) = v_adj.index + i;
+                    }
+                }
+            }
+        }
+
+        bcc.blocks = aven_arena_commit_list_to_slice(
+            GraphAdjSlice,
+            arena,
+            block_list
+        );
+        bcc.block_vertices = aven_arena_commit_list_to_slice(
+            GraphNbSlice,
+            arena,
+            block_vertex_list
+        );
+        bcc.cut_vertices = aven_arena_commit_list_to_slice(
+            GraphSubset,
+            arena,
+            cut_list
+        );
+        bcc.bridges = aven_arena_commit_list_to_slice(
+            GraphSubset,
+            arena,
+            bridge_list
+        );
+
+        return bcc;
+    }
+
+    static inline GraphSubset graph_bcc_block(GraphBcc bcc, GraphIndex b) {
+        GraphAdj b_adj = get(bcc.blocks, b);
+        return (GraphSubset){
+            .ptr = &get(bcc.block_vertices, b_adj.index),
+            .len = b_adj.len,
+        };
+    }
+
+    // Block-cut tree: vertex b < bcc.blocks.len is block b and vertex
+    // bcc.blocks.len + i is get(bcc.cut_vertices, i), each cut vertex is
+    // adjacent to the blocks containing it
+    static inline Graph graph_bcc_tree(GraphBcc bcc, AvenArena *arena) {
+        GraphIndex nblocks = (GraphIndex)bcc.blocks.len;
+        GraphIndex ncuts = (GraphIndex)bcc.cut_vertices.len;
+
+        GraphIndex nb_len = 0;
+        for (GraphIndex b = 0; b < nblocks; b += 1) {
+            GraphSubset block = graph_bcc_block(bcc, b);
+            for (GraphIndex j = 0; j < block.len; j += 1) {
+                if (get(bcc.cut, get(block, j)) != 0) {
+                    nb_len += 2;
+                }
+            }
+        }
+
+        Graph tree = {
+            .nb = { .len = nb_len },
+            .adj = { .len = nblocks + ncuts },
+        };
+        tree.nb.ptr = aven_arena_create_array(GraphIndex, arena, tree.nb.len);
+        tree.adj.ptr = aven_arena_create_array(GraphAdj, arena, tree.adj.len);
+
+        AvenArena temp_arena = *arena;
+        GraphPropIndex cut_index = aven_arena_create_slice(
+            GraphIndex,
+            &temp_arena,
+            bcc.cut.len
+        );
+        for (GraphIndex i = 0; i < ncuts; i += 1) {
+            get(cut_index, get(bcc.cut_vertices, i)) = nblocks + i;
+        }
+
+        for (GraphIndex x = 0; x < tree.adj.len; x += 1) {
+            get(tree.adj, x) = (GraphAdj){ 0 };
+        }
+        for (GraphIndex b = 0; b < nblocks; b += 1) {
+            GraphSubset block = graph_bcc_block(bcc, b);
+            for (GraphIndex j = 0; j < block.len; j += 1) {
+                GraphIndex w = get(block, j);
+                if (get(bcc.cut, w) != 0) {
+                    get(tree.adj, b).len += 1;
+                    get(tree.adj, get(cut_index, w)).len += 1;
+                }
+            }
+        }
+
+        GraphIndex index = 0;
+        for (GraphIndex x = 0; x < tree.adj.len; x += 1) {
+            get(tree.adj, x).index = index;
+            index += get(tree.adj, x).len;
+            get(tree.adj, x).len = 0;
+        }
+
+        for (GraphIndex b = 0; b < nblocks; b += 1) {
+            GraphSubset block = graph_bcc_block(bcc, b);
+            for (GraphIndex j = 0; j < block.len; j += 1) {
+                GraphIndex w = get(block, j);
+                if (get(bcc.cut, w) == 0) {
+                    continue;
+                }
+
+                GraphIndex c = get(cut_index, w);
+                GraphAdj *b_adj = &get(tree.adj, b);
+                GraphAdj *c_adj = &get(tree.adj, c);
+                get(tree.nb, b_adj->index + b_adj->len) = c;
+                get(tree.nb, c_adj->index + c_adj->len) = b;
+                b_adj->len += 1;
+                c_adj->len += 1;
+            }
+        }
+
+        return tree;
+    }
+
+#endif // GRAPH_BCC_H
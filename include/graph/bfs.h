@@ -5,65 +5,61 @@
     #include <aven/arena.h>
 
     #include "../graph.h"
+    #include "compressed.h"
 
     typedef struct {
-        uint32_t parent;
-        uint32_t dist;
+        GraphIndex parent;
+        GraphIndex dist;
     } GraphBfsTreeNode;
     typedef Slice(GraphBfsTreeNode) GraphBfsTree;
 
-    typedef struct {
-        GraphAdj adj;
-        GraphBfsTreeNode node;
-    } GraphBfsVertex;
-
     typedef struct {
         GraphNbSlice nb;
-        Slice(GraphBfsVertex) vertex_info;
-        Queue(uint32_t) bfs_queue;
-        uint32_t edge_index;
-        uint32_t vertex;
+        GraphAdjSlice adj;
+        GraphBfsTree tree;
+        Queue(GraphIndex) bfs_queue;
+        GraphIndex edge_index;
+        GraphIndex vertex;
     } GraphBfsCtx;
 
     static inline GraphBfsCtx graph_bfs_init(
         Graph graph,
-        uint32_t root_vertex,
+        GraphIndex root_vertex,
         AvenArena *arena
     ) {
         assert(root_vertex < graph.adj.len);
 
         GraphBfsCtx ctx = {
             .nb = graph.nb,
+            .adj = graph.adj,
             .vertex = root_vertex,
             .bfs_queue = { .cap = graph.adj.len },
-            .vertex_info = { .len = graph.adj.len },
+            .tree = { .len = graph.adj.len },
         };
 
         ctx.bfs_queue.ptr = aven_arena_create_array(
-            uint32_t,
+            GraphIndex,
             arena,
             ctx.bfs_queue.cap
         );
-        ctx.vertex_info.ptr = aven_arena_create_array(
-            GraphBfsVertex,
+        ctx.tree.ptr = aven_arena_create_array(
+            GraphBfsTreeNode,
             arena,
-            ctx.vertex_info.len
+            ctx.tree.len
         );
 
-        for (uint32_t v = 0; v < ctx.vertex_info.len; v += 1) {
-            get(ctx.vertex_info, v) = (GraphBfsVertex){
-                .adj = get(graph.adj, v),
-            };
+        for (GraphIndex v = 0; v < ctx.tree.len; v += 1) {
+            get(ctx.tree, v) = (GraphBfsTreeNode){ 0 };
         }
 
-        get(ctx.vertex_info, ctx.vertex).node.parent = ctx.vertex + 1;
+        get(ctx.tree, ctx.vertex).parent = ctx.vertex + 1;
 
         return ctx;
     }
 
     static inline bool graph_bfs_step(GraphBfsCtx *ctx) {
-        GraphBfsVertex *v_info = &get(ctx->vertex_info, ctx->vertex);
-        if (ctx->edge_index == v_info->adj.len) {
+        GraphAdj v_adj = get(ctx->adj, ctx->vertex);
+        if (ctx->edge_index == v_adj.len) {
             if (ctx->bfs_queue.used == 0) {
                 return true;
             }
@@ -73,21 +69,33 @@
             return false;
         }
 
-        uint32_t u = graph_nb(ctx->nb, v_info->adj, ctx->edge_index);
-        GraphBfsVertex *u_info = &get(ctx->vertex_info, u);
-        if (u_info->node.parent == 0) {
+        GraphIndex u = graph_nb(ctx->nb, v_adj, ctx->edge_index);
+        GraphBfsTreeNode *u_node = &get(ctx->tree, u);
+        if (u_node->parent == 0) {
             queue_push(ctx->bfs_queue) = u;
-            u_info->node.parent = ctx->vertex + 1;
-            u_info->node.dist = v_info->node.dist + 1;
+            u_node->parent = ctx->vertex + 1;
+            u_node->dist = get(ctx->tree, ctx->vertex).dist + 1;
         }
         ctx->edge_index += 1;
 
         return false;
     }
 
+    // Run at most budget steps, returns true once the search is done and
+    // can be called again to resume where it stopped
+    static inline bool graph_bfs_run(GraphBfsCtx *ctx, size_t budget) {
+        for (; budget > 0; budget -= 1) {
+            if (graph_bfs_step(ctx)) {
+                return true;
+            }
+        }
+
+        return false;
+    }
+
     static inline GraphBfsTree graph_bfs(
         Graph graph,
-        uint32_t root_vertex,
+        GraphIndex root_vertex,
         AvenArena *arena
     ) {
         GraphBfsTree tree = aven_arena_create_slice(
@@ -102,35 +110,513 @@
         while (!graph_bfs_step(&ctx)) {}
         ;
 
-        for (uint32_t v = 0; v < tree.len; v += 1) {
-            get(tree, v) = get(ctx.vertex_info, v).node;
+        for (GraphIndex v = 0; v < tree.len; v += 1) {
+            get(tree, v) = get(ctx.tree, v);
+        }
+
+        return tree;
+    }
+
+    // BFS reusable across roots, a node is visited iff stamped this epoch
+
+    typedef struct {
+        GraphNbSlice nb;
+        GraphAdjSlice adj;
+        GraphBfsTree tree;
+        GraphPropIndex stamps;
+        Queue(GraphIndex) bfs_queue;
+        GraphIndex edge_index;
+        GraphIndex vertex;
+        GraphIndex epoch;
+    } GraphBfsEpochCtx;
+
+    static inline GraphBfsEpochCtx graph_bfs_epoch_init(
+        Graph graph,
+        AvenArena *arena
+    ) {
+        GraphBfsEpochCtx ctx = {
+            .nb = graph.nb,
+            .adj = graph.adj,
+            .bfs_queue = { .cap = graph.adj.len },
+            .tree = { .len = graph.adj.len },
+            .stamps = { .len = graph.adj.len },
+            // past the cleared stamps, so no vertex is contained until the
+            // first search starts
+            .epoch = 1,
+        };
+
+        ctx.bfs_queue.ptr = aven_arena_create_array(
+            GraphIndex,
+            arena,
+            ctx.bfs_queue.cap
+        );
+        ctx.tree.ptr = aven_arena_create_array(
+            GraphBfsTreeNode,
+            arena,
+            ctx.tree.len
+        );
+        ctx.stamps.ptr = aven_arena_create_array(
+            GraphIndex,
+            arena,
+            ctx.stamps.len
+        );
+
+        for (GraphIndex v = 0; v < ctx.stamps.len; v += 1) {
+            get(ctx.stamps, v) = 0;
+        }
+
+        return ctx;
+    }
+
+    // Begin a new search from root_vertex, any previous search on the
+    // context is discarded even if it did not finish
+    static inline void graph_bfs_epoch_start(
+        GraphBfsEpochCtx *ctx,
+        GraphIndex root_vertex
+    ) {
+        assert(root_vertex < ctx->adj.len);
+
+        if (ctx->epoch == GRAPH_INDEX_MAX) {
+            for (GraphIndex v = 0; v < ctx->stamps.len; v += 1) {
+                get(ctx->stamps, v) = 0;
+            }
+            ctx->epoch = 0;
+        }
+        ctx->epoch += 1;
+
+        queue_clear(ctx->bfs_queue);
+        ctx->vertex = root_vertex;
+        ctx->edge_index = 0;
+
+        get(ctx->stamps, root_vertex) = ctx->epoch;
+        get(ctx->tree, root_vertex) = (GraphBfsTreeNode){
+            .parent = root_vertex + 1,
+        };
+    }
+
+    static inline bool graph_bfs_epoch_step(GraphBfsEpochCtx *ctx) {
+        GraphAdj v_adj = get(ctx->adj, ctx->vertex);
+        if (ctx->edge_index == v_adj.len) {
+            if (ctx->bfs_queue.used == 0) {
+                return true;
+            }
+
+            ctx->vertex = queue_pop(ctx->bfs_queue);
+            ctx->edge_index = 0;
+            return false;
+        }
+
+        GraphIndex u = graph_nb(ctx->nb, v_adj, ctx->edge_index);
+        if (get(ctx->stamps, u) != ctx->epoch) {
+            get(ctx->stamps, u) = ctx->epoch;
+            queue_push(ctx->bfs_queue) = u;
+            get(ctx->tree, u) = (GraphBfsTreeNode){
+                .parent = ctx->vertex + 1,
+                .dist = get(ctx->tree, ctx->vertex).dist + 1,
+            };
+        }
+        ctx->edge_index += 1;
+
+        return false;
+    }
+
+    static inline bool graph_bfs_epoch_run(
+        GraphBfsEpochCtx *ctx,
+        size_t budget
+    ) {
+        for (; budget > 0; budget -= 1) {
+            if (graph_bfs_epoch_step(ctx)) {
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+    static inline bool graph_bfs_epoch_contains(
+        GraphBfsEpochCtx *ctx,
+        GraphIndex v
+    ) {
+        return get(ctx->stamps, v) == ctx->epoch;
+    }
+
+    static inline GraphIndex graph_bfs_epoch_parent(
+        GraphBfsEpochCtx *ctx,
+        GraphIndex v
+    ) {
+        assert(graph_bfs_epoch_contains(ctx, v));
+        return get(ctx->tree, v).parent - 1;
+    }
+
+    static inline GraphIndex graph_bfs_epoch_dist(
+        GraphBfsEpochCtx *ctx,
+        GraphIndex v
+    ) {
+        assert(graph_bfs_epoch_contains(ctx, v));
+        return get(ctx->tree, v).dist;
+    }
+
+    // Direction-optimizing BFS, each step expands a whole level either
+    // top-down from the frontier or bottom-up by scanning the rotations of
+    // the unvisited vertices for a neighbor in the frontier bitmap. The
+    // distances match graph_bfs, the parents may be any neighbor one level
+    // closer to the root.
+
+    #define GRAPH_BFS_DIR_ALPHA 14
+    #define GRAPH_BFS_DIR_BETA 24
+
+    typedef struct {
+        GraphNbSlice nb;
+        GraphAdjSlice adj;
+        GraphBfsTree tree;
+        List(GraphIndex) queue;
+        GraphPropUint64 visited;
+        GraphPropUint64 frontier;
+        size_t level_start;
+        size_t frontier_edges;
+        size_t unvisited_edges;
+        size_t alpha;
+        GraphIndex dist;
+        bool bottom_up;
+    } GraphBfsDirCtx;
+
+    static inline bool graph_bfs_dir_bitmap_test(
+        GraphPropUint64 bitmap,
+        GraphIndex v
+    ) {
+        return (get(bitmap, v / 64) & ((uint64_t)1 << (v % 64))) != 0;
+    }
+
+    static inline void graph_bfs_dir_bitmap_set(
+        GraphPropUint64 bitmap,
+        GraphIndex v
+    ) {
+        get(bitmap, v / 64) |= (uint64_t)1 << (v % 64);
+    }
+
+    static inline GraphBfsDirCtx graph_bfs_dir_init(
+        Graph graph,
+        GraphIndex root_vertex,
+        AvenArena *arena
+    ) {
+        assert(root_vertex < graph.adj.len);
+
+        GraphBfsDirCtx ctx = {
+            .nb = graph.nb,
+            .adj = graph.adj,
+            .tree = { .len = graph.adj.len },
+            .queue = { .cap = graph.adj.len },
+            .visited = { .len = (graph.adj.len + 63) / 64 },
+            .frontier = { .len = (graph.adj.len + 63) / 64 },
+            .alpha = GRAPH_BFS_DIR_ALPHA,
+        };
+
+        ctx.tree.ptr = aven_arena_create_array(
+            GraphBfsTreeNode,
+            arena,
+            ctx.tree.len
+        );
+        ctx.queue.ptr = aven_arena_create_array(
+            GraphIndex,
+            arena,
+            ctx.queue.cap
+        );
+        ctx.visited.ptr = aven_arena_create_array(
+            uint64_t,
+            arena,
+            ctx.visited.len
+        );
+        ctx.frontier.ptr = aven_arena_create_array(
+            uint64_t,
+            arena,
+            ctx.frontier.len
+        );
+
+        for (GraphIndex v = 0; v < ctx.tree.len; v += 1) {
+            get(ctx.tree, v) = (GraphBfsTreeNode){ 0 };
+        }
+        for (size_t i = 0; i < ctx.visited.len; i += 1) {
+            get(ctx.visited, i) = 0;
+        }
+
+        GraphIndex root_len = get(ctx.adj, root_vertex).len;
+        get(ctx.tree, root_vertex).parent = root_vertex + 1;
+        graph_bfs_dir_bitmap_set(ctx.visited, root_vertex);
+        list_push(ctx.queue) = root_vertex;
+        ctx.frontier_edges = root_len;
+        ctx.unvisited_edges = graph.nb.len - root_len;
+
+        return ctx;
+    }
+
+    static inline void graph_bfs_dir_visit(
+        GraphBfsDirCtx *ctx,
+        GraphIndex u,
+        GraphIndex v
+    ) {
+        GraphIndex u_len = get(ctx->adj, u).len;
+
+        graph_bfs_dir_bitmap_set(ctx->visited, u);
+        get(ctx->tree, u) = (GraphBfsTreeNode){
+            .parent = v + 1,
+            .dist = ctx->dist + 1,
+        };
+        list_push(ctx->queue) = u;
+        ctx->frontier_edges += u_len;
+        ctx->unvisited_edges -= u_len;
+    }
+
+    static inline bool graph_bfs_dir_step(GraphBfsDirCtx *ctx) {
+        size_t level_start = ctx->level_start;
+        size_t level_end = ctx->queue.len;
+        if (level_start == level_end) {
+            return true;
+        }
+
+        // go bottom-up while the frontier has more edges than the fraction
+        // 1 / alpha of the unvisited edges a bottom-up sweep is expected to
+        // check, and back to top-down once the frontier is small; alpha is
+        // re-estimated after every sweep so that graphs where most unvisited
+        // vertices are far from the frontier (e.g. planar) stay top-down
+        size_t frontier_len = level_end - level_start;
+        bool bottom_up_cheaper = ctx->frontier_edges * ctx->alpha >
+            ctx->unvisited_edges;
+        if (!ctx->bottom_up) {
+            ctx->bottom_up = bottom_up_cheaper;
+        } else {
+            ctx->bottom_up = bottom_up_cheaper and
+                frontier_len * GRAPH_BFS_DIR_BETA >= ctx->tree.len;
+        }
+
+        ctx->frontier_edges = 0;
+
+        if (!ctx->bottom_up) {
+            for (size_t i = level_start; i < level_end; i += 1) {
+                GraphIndex v = list_get(ctx->queue, i);
+                GraphAdj v_adj = get(ctx->adj, v);
+                for (GraphIndex j = 0; j < v_adj.len; j += 1) {
+                    GraphIndex u = graph_nb(ctx->nb, v_adj, j);
+                    if (!graph_bfs_dir_bitmap_test(ctx->visited, u)) {
+                        graph_bfs_dir_visit(ctx, u, v);
+                    }
+                }
+            }
+        } else {
+            for (size_t i = 0; i < ctx->frontier.len; i += 1) {
+                get(ctx->frontier, i) = 0;
+            }
+            for (size_t i = level_start; i < level_end; i += 1) {
+                graph_bfs_dir_bitmap_set(
+                    ctx->frontier,
+                    list_get(ctx->queue, i)
+                );
+            }
+
+            size_t unvisited_edges = ctx->unvisited_edges;
+            size_t checked_edges = 0;
+            for (size_t i = 0; i < ctx->visited.len; i += 1) {
+                if (get(ctx->visited, i) == UINT64_MAX) {
+                    continue;
+                }
+
+                GraphIndex start_vertex = (GraphIndex)(i * 64);
+                GraphIndex end_vertex = (GraphIndex)min(
+                    start_vertex + 64,
+                    ctx->tree.len
+                );
+                for (GraphIndex u = start_vertex; u < end_vertex; u += 1) {
+                    if (graph_bfs_dir_bitmap_test(ctx->visited, u)) {
+                        continue;
+                    }
+
+                    GraphAdj u_adj = get(ctx->adj, u);
+                    GraphIndex j = 0;
+                    for (; j < u_adj.len; j += 1) {
+                        GraphIndex v = graph_nb(ctx->nb, u_adj, j);
+                        if (graph_bfs_dir_bitmap_test(ctx->frontier, v)) {
+                            graph_bfs_dir_visit(ctx, u, v);
+                            j += 1;
+                            break;
+                        }
+                    }
+                    checked_edges += j;
+                }
+            }
+
+            // never below 1, or the bottom-up test could not pass again
+            ctx->alpha = max(unvisited_edges / max(checked_edges, 1), 1);
+        }
+
+        ctx->level_start = level_end;
+        ctx->dist += 1;
+
+        return false;
+    }
+
+    static inline GraphBfsTree graph_bfs_dir(
+        Graph graph,
+        GraphIndex root_vertex,
+        AvenArena *arena
+    ) {
+        GraphBfsTree tree = aven_arena_create_slice(
+            GraphBfsTreeNode,
+            arena,
+            graph.adj.len
+        );
+
+        AvenArena temp_arena = *arena;
+        GraphBfsDirCtx ctx = graph_bfs_dir_init(
+            graph,
+            root_vertex,
+            &temp_arena
+        );
+
+        while (!graph_bfs_dir_step(&ctx)) {}
+
+        for (GraphIndex v = 0; v < tree.len; v += 1) {
+            get(tree, v) = get(ctx.tree, v);
+        }
+
+        return tree;
+    }
+
+    // BFS directly on a compressed graph, each rotation is decoded once as
+    // its vertex is scanned
+
+    typedef struct {
+        GraphCompressed graph;
+        GraphBfsTree tree;
+        Queue(GraphIndex) bfs_queue;
+        GraphCompressedIter iter;
+        GraphIndex vertex;
+    } GraphBfsCompressedCtx;
+
+    static inline GraphBfsCompressedCtx graph_bfs_compressed_init(
+        GraphCompressed graph,
+        GraphIndex root_vertex,
+        AvenArena *arena
+    ) {
+        assert(root_vertex < graph_compressed_vertices(graph));
+
+        GraphBfsCompressedCtx ctx = {
+            .graph = graph,
+            .vertex = root_vertex,
+            .bfs_queue = { .cap = graph_compressed_vertices(graph) },
+            .tree = { .len = graph_compressed_vertices(graph) },
+        };
+
+        ctx.bfs_queue.ptr = aven_arena_create_array(
+            GraphIndex,
+            arena,
+            ctx.bfs_queue.cap
+        );
+        ctx.tree.ptr = aven_arena_create_array(
+            GraphBfsTreeNode,
+            arena,
+            ctx.tree.len
+        );
+
+        for (GraphIndex v = 0; v < ctx.tree.len; v += 1) {
+            get(ctx.tree, v) = (GraphBfsTreeNode){ 0 };
+        }
+
+        get(ctx.tree, ctx.vertex).parent = ctx.vertex + 1;
+        ctx.iter = graph_compressed_iter(graph, ctx.vertex);
+
+        return ctx;
+    }
+
+    static inline bool graph_bfs_compressed_step(GraphBfsCompressedCtx *ctx) {
+        if (ctx->iter.len == 0) {
+            if (ctx->bfs_queue.used == 0) {
+                return true;
+            }
+
+            ctx->vertex = queue_pop(ctx->bfs_queue);
+            ctx->iter = graph_compressed_iter(ctx->graph, ctx->vertex);
+            return false;
+        }
+
+        GraphIndex u = graph_compressed_iter_next(&ctx->iter);
+
+        GraphBfsTreeNode *u_node = &get(ctx->tree, u);
+        if (u_node->parent == 0) {
+            queue_push(ctx->bfs_queue) = u;
+            u_node->parent = ctx->vertex + 1;
+            u_node->dist = get(ctx->tree, ctx->vertex).dist + 1;
+        }
+
+        return false;
+    }
+
+    static inline bool graph_bfs_compressed_run(
+        GraphBfsCompressedCtx *ctx,
+        size_t budget
+    ) {
+        for (; budget > 0; budget -= 1) {
+            if (graph_bfs_compressed_step(ctx)) {
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+    static inline GraphBfsTree graph_bfs_compressed(
+        GraphCompressed graph,
+        GraphIndex root_vertex,
+        AvenArena *arena
+    ) {
+        GraphBfsTree tree = aven_arena_create_slice(
+            GraphBfsTreeNode,
+            arena,
+            graph_compressed_vertices(graph)
+        );
+
+        AvenArena temp_arena = *arena;
+        GraphBfsCompressedCtx ctx = graph_bfs_compressed_init(
+            graph,
+            root_vertex,
+            &temp_arena
+        );
+
+        while (!graph_bfs_compressed_step(&ctx)) {}
+
+        for (GraphIndex v = 0; v < tree.len; v += 1) {
+            get(tree, v) = get(ctx.tree, v);
         }
 
         return tree;
     }
 
-    static inline bool graph_bfs_tree_contains(GraphBfsTree tree, uint32_t v) {
+    static inline bool graph_bfs_tree_contains(
+        GraphBfsTree tree,
+        GraphIndex v
+    ) {
         return get(tree, v).parent != 0;
     }
 
-    static inline uint32_t graph_bfs_tree_parent(GraphBfsTree tree, uint32_t v) {
+    static inline GraphIndex graph_bfs_tree_parent(
+        GraphBfsTree tree,
+        GraphIndex v
+    ) {
         assert(graph_bfs_tree_contains(tree, v));
         return get(tree, v).parent - 1;
     }
 
     static inline GraphSubset graph_bfs_tree_path_to_root(
         GraphBfsTree tree,
-        uint32_t v,
+        GraphIndex v,
         AvenArena *arena
     ) {
-        List(uint32_t) path_list = aven_arena_create_list(
-            uint32_t,
+        List(GraphIndex) path_list = aven_arena_create_list(
+            GraphIndex,
             arena,
             tree.len
         );
 
         if (get(tree, v).parent != 0) {
-            uint32_t last_v;
+            GraphIndex last_v;
             do {
                 list_push(path_list) = v;
                 last_v = v;
@@ -0,0 +1,228 @@
+#ifndef GRAPH_BFS_MULTI_H
+    #define GRAPH_BFS_MULTI_H
+
+    #include <aven.h>
+    #include <aven/arena.h>
+
+    #include "../../graph.h"
+
+    // Multi-source BFS from up to 64 roots at once. Every vertex keeps a
+    // bitmask of the roots that have reached it and of the roots whose
+    // frontier it is on, so each level is a single sweep over the graph no
+    // matter how many searches share it.
+
+    #define GRAPH_BFS_MULTI_BATCH ((size_t)64)
+
+    typedef struct {
+        GraphNbSlice nb;
+        GraphAdjSlice adj;
+        GraphPropUint64 seen;
+        GraphPropUint64 visit;
+        GraphPropUint64 visit_next;
+        GraphSubset roots;
+        // get(dists, i * adj.len + v) is the distance from roots[i] to v,
+        // or GRAPH_INDEX_MAX if v is unreachable; may be empty
+        GraphPropIndex dists;
+        // the distance to the farthest vertex reached from each root
+        GraphPropIndex ecc;
+        GraphIndex dist;
+    } GraphBfsMultiCtx;
+
+    static inline size_t graph_bfs_multi_ctz(uint64_t bits) {
+        assert(bits != 0);
+    #if __has_builtin(__builtin_ctzll)
+        return (size_t)__builtin_ctzll(bits);
+    #else
+        size_t i = 0;
+        while ((bits & 1) == 0) {
+            bits >>= 1;
+            i += 1;
+        }
+        return i;
+    #endif
+    }
+
+    static inline GraphBfsMultiCtx graph_bfs_multi_init(
+        Graph graph,
+        AvenArena *arena
+    ) {
+        GraphBfsMultiCtx ctx = {
+            .nb = graph.nb,
+            .adj = graph.adj,
+            .seen = { .len = graph.adj.len },
+            .visit = { .len = graph.adj.len },
+            .visit_next = { .len = graph.adj.len },
+            .ecc = { .len = GRAPH_BFS_MULTI_BATCH },
+        };
+
+        ctx.seen.ptr = aven_arena_create_array(uint64_t, arena, ctx.seen.len);
+        ctx.visit.ptr = aven_arena_create_array(
+            uint64_t,
+            arena,
+            ctx.visit.len
+        );
+        ctx.visit_next.ptr = aven_arena_create_array(
+            uint64_t,
+            arena,
+            ctx.visit_next.len
+        );
+        ctx.ecc.ptr = aven_arena_create_array(GraphIndex, arena, ctx.ecc.len);
+
+        return ctx;
+    }
+
+    // Start a batch of at most GRAPH_BFS_MULTI_BATCH roots, dists is either
+    // empty or has roots.len * graph.adj.len entries
+    static inline void graph_bfs_multi_start(
+        GraphBfsMultiCtx *ctx,
+        GraphSubset roots,
+        GraphPropIndex dists
+    ) {
+        assert(roots.len <= GRAPH_BFS_MULTI_BATCH);
+        assert(dists.len == 0 or dists.len == roots.len * ctx->adj.len);
+
+        ctx->roots = roots;
+        ctx->dists = dists;
+        ctx->dist = 0;
+
+        for (GraphIndex v = 0; v < ctx->adj.len; v += 1) {
+            get(ctx->seen, v) = 0;
+            get(ctx->visit, v) = 0;
+            get(ctx->visit_next, v) = 0;
+        }
+        for (size_t i = 0; i < ctx->dists.len; i += 1) {
+            get(ctx->dists, i) = GRAPH_INDEX_MAX;
+        }
+
+        for (size_t i = 0; i < roots.len; i += 1) {
+            GraphIndex root = get(roots, i);
+            assert(root < ctx->adj.len);
+
+            uint64_t root_bit = (uint64_t)1 << i;
+            get(ctx->seen, root) |= root_bit;
+            get(ctx->visit, root) |= root_bit;
+            get(ctx->ecc, i) = 0;
+            if (ctx->dists.len > 0) {
+                get(ctx->dists, i * ctx->adj.len + root) = 0;
+            }
+        }
+    }
+
+    // Expand every search by one level, returns true once all are done
+    static inline bool graph_bfs_multi_step(GraphBfsMultiCtx *ctx) {
+        for (GraphIndex v = 0; v < ctx->adj.len; v += 1) {
+            uint64_t v_visit = get(ctx->visit, v);
+            if (v_visit == 0) {
+                continue;
+            }
+
+            GraphAdj v_adj = get(ctx->adj, v);
+            for (GraphIndex i = 0; i < v_adj.len; i += 1) {
+                GraphIndex u = graph_nb(ctx->nb, v_adj, i);
+                get(ctx->visit_next, u) |= v_visit;
+            }
+        }
+
+        ctx->dist += 1;
+
+        uint64_t level_roots = 0;
+        for (GraphIndex u = 0; u < ctx->adj.len; u += 1) {
+            uint64_t u_new = get(ctx->visit_next, u) & ~get(ctx->seen, u);
+            get(ctx->visit_next, u) = 0;
+            get(ctx->visit, u) = u_new;
+            if (u_new == 0) {
+                continue;
+            }
+
+            get(ctx->seen, u) |= u_new;
+            level_roots |= u_new;
+
+            if (ctx->dists.len > 0) {
+                do {
+                    size_t i = graph_bfs_multi_ctz(u_new);
+                    get(ctx->dists, i * ctx->adj.len + u) = ctx->dist;
+                    u_new &= u_new - 1;
+                } while (u_new != 0);
+            }
+        }
+
+        if (level_roots == 0) {
+            return true;
+        }
+
+        do {
+            get(ctx->ecc, graph_bfs_multi_ctz(level_roots)) = ctx->dist;
+            level_roots &= level_roots - 1;
+        } while (level_roots != 0);
+
+        return false;
+    }
+
+    // Distances from every root, get(dists, i * graph.adj.len + v) is the
+    // distance from roots[i] to v
+    static inline GraphPropIndex graph_bfs_multi_dists(
+        Graph graph,
+        GraphSubset roots,
+        AvenArena *arena
+    ) {
+        GraphPropIndex dists = aven_arena_create_slice(
+            GraphIndex,
+            arena,
+            roots.len * graph.adj.len
+        );
+
+        AvenArena temp_arena = *arena;
+        GraphBfsMultiCtx ctx = graph_bfs_multi_init(graph, &temp_arena);
+
+        for (size_t i = 0; i < roots.len; i += GRAPH_BFS_MULTI_BATCH) {
+            size_t batch_len = min(GRAPH_BFS_MULTI_BATCH, roots.len - i);
+            GraphSubset batch_roots = {
+                .ptr = &get(roots, i),
+                .len = batch_len,
+            };
+            GraphPropIndex batch_dists = {
+                .ptr = &get(dists, i * graph.adj.len),
+                .len = batch_len * graph.adj.len,
+            };
+
+            graph_bfs_multi_start(&ctx, batch_roots, batch_dists);
+            while (!graph_bfs_multi_step(&ctx)) {}
+        }
+
+        return dists;
+    }
+
+    // Eccentricity of every root within its connected component
+    static inline GraphPropIndex graph_bfs_multi_ecc(
+        Graph graph,
+        GraphSubset roots,
+        AvenArena *arena
+    ) {
+        GraphPropIndex ecc = aven_arena_create_slice(
+            GraphIndex,
+            arena,
+            roots.len
+        );
+
+        AvenArena temp_arena = *arena;
+        GraphBfsMultiCtx ctx = graph_bfs_multi_init(graph, &temp_arena);
+
+        for (size_t i = 0; i < roots.len; i += GRAPH_BFS_MULTI_BATCH) {
+            size_t batch_len = min(GRAPH_BFS_MULTI_BATCH, roots.len - i);
+            GraphSubset batch_roots = {
+                .ptr = &get(roots, i),
+                .len = batch_len,
+            };
+
+            graph_bfs_multi_start(&ctx, batch_roots, (GraphPropIndex){ 0 });
+            while (!graph_bfs_multi_step(&ctx)) {}
+
+            for (size_t j = 0; j < batch_len; j += 1) {
+                get(ecc, i + j) = get(ctx.ecc, j);
+            }
+        }
+
+        return ecc;
+    }
+
+#endif // GRAPH_BFS_MULTI_H
@@ -0,0 +1,295 @@
+#ifndef GRAPH_BFS_THREAD_H
+    #define GRAPH_BFS_THREAD_H
+
+    #include <aven.h>
+    #include <aven/arena.h>
+    #include <aven/thread/pool.h>
+
+    #if !defined(__STDC_VERSION__) or __STDC_VERSION__ < 201112L
+        #error "C11 or later is required"
+    #endif
+
+    #include <stdatomic.h>
+
+    #include "../../graph.h"
+    #include "../bfs.h"
+    #include "../thread.h"
+
+    // Level-synchronous multi-threaded BFS. The threads grab chunks of the
+    // frontier, claim unvisited neighbors by a compare-exchange on their
+    // parent and collect them in a local buffer that is flushed to the end
+    // of the shared queue. Levels are separated by waiting on the pool,
+    // which also orders the plain writes to the queue and the distances.
+    // Which of several equally close parents claims a vertex depends on
+    // the schedule.
+
+    #ifdef GRAPH_WIDE_INDEX
+        typedef atomic_uint_least64_t GraphBfsThreadAtomicIndex;
+    #else
+        typedef atomic_uint_least32_t GraphBfsThreadAtomicIndex;
+    #endif
+
+    #ifndef GRAPH_BFS_THREAD_CHUNK_SIZE
+        #define GRAPH_BFS_THREAD_CHUNK_SIZE 256
+    #endif
+
+    // frontiers smaller than this are expanded by the calling thread alone
+    #ifndef GRAPH_BFS_THREAD_MIN_FRONTIER
+        #define GRAPH_BFS_THREAD_MIN_FRONTIER 1024
+    #endif
+
+    typedef struct {
+        GraphNbSlice nb;
+        GraphAdjSlice adj;
+        GraphBfsTree tree;
+        Slice(GraphBfsThreadAtomicIndex) parents;
+        GraphSubset queue;
+        atomic_size_t queue_len;
+        atomic_size_t frontier_index;
+        size_t level_start;
+        size_t level_end;
+        GraphIndex dist;
+    } GraphBfsThreadCtx;
+
+    typedef struct {
+        GraphBfsThreadCtx *ctx;
+        GraphSubset buffer;
+        size_t buffer_len;
+        GraphIndex start_vertex;
+        GraphIndex end_vertex;
+    } GraphBfsThreadWorker;
+    typedef Slice(GraphBfsThreadWorker) GraphBfsThreadWorkerSlice;
+
+    static inline void graph_bfs_thread_flush(GraphBfsThreadWorker *worker) {
+        GraphBfsThreadCtx *ctx = worker->ctx;
+
+        size_t queue_index = atomic_fetch_add_explicit(
+            &ctx->queue_len,
+            worker->buffer_len,
+            memory_order_relaxed
+        );
+        for (size_t i = 0; i < worker->buffer_len; i += 1) {
+            get(ctx->queue, queue_index + i) = get(worker->buffer, i);
+        }
+
+        worker->buffer_len = 0;
+    }
+
+    static void graph_bfs_thread_init_worker(void *args) {
+        GraphBfsThreadWorker *worker = args;
+        GraphBfsThreadCtx *ctx = worker->ctx;
+
+        for (
+            GraphIndex v = worker->start_vertex;
+            v != worker->end_vertex;
+            v += 1
+        ) {
+            atomic_init(&get(ctx->parents, v), 0);
+            get(ctx->tree, v) = (GraphBfsTreeNode){ 0 };
+        }
+    }
+
+    static void graph_bfs_thread_level_worker(void *args) {
+        GraphBfsThreadWorker *worker = args;
+        GraphBfsThreadCtx *ctx = worker->ctx;
+
+        size_t frontier_len = ctx->level_end - ctx->level_start;
+        for (;;) {
+            size_t chunk_start = atomic_fetch_add_explicit(
+                &ctx->frontier_index,
+                GRAPH_BFS_THREAD_CHUNK_SIZE,
+                memory_order_relaxed
+            );
+            if (chunk_start >= frontier_len) {
+                break;
+            }
+            size_t chunk_end = min(
+                chunk_start + GRAPH_BFS_THREAD_CHUNK_SIZE,
+                frontier_len
+            );
+
+            for (size_t i = chunk_start; i < chunk_end; i += 1) {
+                GraphIndex v = get(ctx->queue, ctx->level_start + i);
+                GraphAdj v_adj = get(ctx->adj, v);
+                for (GraphIndex j = 0; j < v_adj.len; j += 1) {
+                    GraphIndex u = graph_nb(ctx->nb, v_adj, j);
+                    GraphBfsThreadAtomicIndex *u_parent = &get(
+                        ctx->parents,
+                        u
+                    );
+
+                    GraphIndex expected = (GraphIndex)atomic_load_explicit(
+                        u_parent,
+                        memory_order_relaxed
+                    );
+                    if (expected != 0) {
+                        continue;
+                    }
+                    bool claimed = atomic_compare_exchange_strong_explicit(
+                        u_parent,
+                        &expected,
+                        v + 1,
+                        memory_order_relaxed,
+                        memory_order_relaxed
+                    );
+                    if (!claimed) {
+                        continue;
+                    }
+
+                    get(ctx->tree, u).dist = ctx->dist + 1;
+                    get(worker->buffer, worker->buffer_len) = u;
+                    worker->buffer_len += 1;
+                    if (worker->buffer_len == worker->buffer.len) {
+                        graph_bfs_thread_flush(worker);
+                    }
+                }
+            }
+        }
+
+        graph_bfs_thread_flush(worker);
+    }
+
+    static void graph_bfs_thread_parent_worker(void *args) {
+        GraphBfsThreadWorker *worker = args;
+        GraphBfsThreadCtx *ctx = worker->ctx;
+
+        for (
+            GraphIndex v = worker->start_vertex;
+            v != worker->end_vertex;
+            v += 1
+        ) {
+            get(ctx->tree, v).parent = (GraphIndex)atomic_load_explicit(
+                &get(ctx->parents, v),
+                memory_order_relaxed
+            );
+        }
+    }
+
+    static inline GraphBfsTree graph_bfs_thread(
+        Graph graph,
+        GraphIndex root_vertex,
+        AvenThreadPool *thread_pool,
+        size_t nthreads,
+        AvenArena *arena
+    ) {
+        assert(root_vertex < graph.adj.len);
+        assert(nthreads > 0);
+
+        GraphBfsTree tree = aven_arena_create_slice(
+            GraphBfsTreeNode,
+            arena,
+            graph.adj.len
+        );
+
+        GraphBfsThreadCtx ctx = {
+            .nb = graph.nb,
+            .adj = graph.adj,
+            .tree = tree,
+            .parents = { .len = graph.adj.len },
+            .queue = { .len = graph.adj.len },
+        };
+
+        AvenArena temp_arena = *arena;
+
+        ctx.parents.ptr = aven_arena_create_array(
+            GraphBfsThreadAtomicIndex,
+            &temp_arena,
+            ctx.parents.len
+        );
+        ctx.queue.ptr = aven_arena_create_array(
+            GraphIndex,
+            &temp_arena,
+            ctx.queue.len
+        );
+
+        GraphBfsThreadWorkerSlice workers = aven_arena_create_slice(
+            GraphBfsThreadWorker,
+            &temp_arena,
+            nthreads
+        );
+        AvenThreadPoolJobSlice jobs = aven_arena_create_slice(
+            AvenThreadPoolJob,
+            &temp_arena,
+            nthreads - 1
+        );
+
+        GraphIndex chunk_size = (GraphIndex)(graph.adj.len / workers.len);
+        for (uint32_t i = 0; i < workers.len; i += 1) {
+            GraphIndex start_vertex = i * chunk_size;
+            GraphIndex end_vertex = (i + 1) * chunk_size;
+            if (i + 1 == workers.len) {
+                end_vertex = (GraphIndex)graph.adj.len;
+            }
+
+            GraphSubset buffer = aven_arena_create_slice(
+                GraphIndex,
+                &temp_arena,
+                GRAPH_BFS_THREAD_CHUNK_SIZE
+            );
+
+            get(workers, i) = (GraphBfsThreadWorker){
+                .ctx = &ctx,
+                .buffer = buffer,
+                .start_vertex = start_vertex,
+                .end_vertex = end_vertex,
+            };
+        }
+
+        graph_thread_run_phase(
+            thread_pool,
+            jobs,
+            workers,
+            graph_bfs_thread_init_worker
+        );
+
+        atomic_store_explicit(
+            &get(ctx.parents, root_vertex),
+            root_vertex + 1,
+            memory_order_relaxed
+        );
+        get(ctx.queue, 0) = root_vertex;
+        atomic_init(&ctx.queue_len, 1);
+
+        for (;;) {
+            ctx.level_start = ctx.level_end;
+            ctx.level_end = atomic_load_explicit(
+                &ctx.queue_len,
+                memory_order_relaxed
+            );
+            if (ctx.level_start == ctx.level_end) {
+                break;
+            }
+
+            atomic_store_explicit(
+                &ctx.frontier_index,
+                0,
+                memory_order_relaxed
+            );
+            if (
+                ctx.level_end - ctx.level_start <
+                GRAPH_BFS_THREAD_MIN_FRONTIER
+            ) {
+                graph_bfs_thread_level_worker(&get(workers, 0));
+            } else {
+                graph_thread_run_phase(
+                    thread_pool,
+                    jobs,
+                    workers,
+                    graph_bfs_thread_level_worker
+                );
+            }
+
+            ctx.dist += 1;
+        }
+
+        graph_thread_run_phase(
+            thread_pool,
+            jobs,
+            workers,
+            graph_bfs_thread_parent_worker
+        );
+
+        return tree;
+    }
+
+#endif // GRAPH_BFS_THREAD_H
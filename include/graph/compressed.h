@@ -0,0 +1,219 @@
+#ifndef GRAPH_COMPRESSED_H
+    #define GRAPH_COMPRESSED_H
+
+    #include <aven.h>
+    #include <aven/arena.h>
+
+    #include "../graph.h"
+
+    // Read-only graph with each rotation stored as a byte stream: the degree,
+    // then every neighbor as a zigzag varint delta from the previous one
+    // (the first neighbor is relative to the vertex itself). Works best after
+    // a locality improving relabel from graph/order.h.
+
+    typedef struct {
+        ByteSlice bytes;
+        Slice(uint64_t) offsets;
+        size_t nb_len;
+    } GraphCompressed;
+
+    typedef struct {
+        const unsigned char *ptr;
+        GraphIndex prev;
+        GraphIndex len;
+    } GraphCompressedIter;
+
+    static inline size_t graph_compressed_varint_size(GraphIndex x) {
+        size_t size = 1;
+        while (x >= 0x80) {
+            x >>= 7;
+            size += 1;
+        }
+        return size;
+    }
+
+    static inline unsigned char *graph_compressed_varint_write(
+        unsigned char *ptr,
+        GraphIndex x
+    ) {
+        while (x >= 0x80) {
+            *ptr = (unsigned char)(x | 0x80);
+            ptr += 1;
+            x >>= 7;
+        }
+        *ptr = (unsigned char)x;
+        return ptr + 1;
+    }
+
+    static inline const unsigned char *graph_compressed_varint_read(
+        const unsigned char *ptr,
+        GraphIndex *x
+    ) {
+        GraphIndex value = *ptr & 0x7f;
+        GraphIndex shift = 7;
+        while ((*ptr & 0x80) != 0) {
+            ptr += 1;
+            value |= (GraphIndex)(*ptr & 0x7f) << shift;
+            shift += 7;
+        }
+        *x = value;
+        return ptr + 1;
+    }
+
+    // Deltas wrap modulo the index width, zigzag keeps small negative steps
+    // small
+
+    #define GRAPH_COMPRESSED_SIGN_SHIFT (sizeof(GraphIndex) * 8 - 1)
+
+    static inline GraphIndex graph_compressed_delta(
+        GraphIndex prev,
+        GraphIndex u
+    ) {
+        GraphIndex delta = u - prev;
+        return (delta << 1) ^
+            ((GraphIndex)0 - (delta >> GRAPH_COMPRESSED_SIGN_SHIFT));
+    }
+
+    static inline GraphIndex graph_compressed_undelta(
+        GraphIndex prev,
+        GraphIndex zigzag
+    ) {
+        return prev + ((zigzag >> 1) ^ ((GraphIndex)0 - (zigzag & 1)));
+    }
+
+    static inline GraphCompressed graph_compressed(
+        Graph graph,
+        AvenArena *arena
+    ) {
+        GraphCompressed cgraph = {
+            .offsets = { .len = graph.adj.len + 1 },
+            .nb_len = graph.nb.len,
+        };
+        cgraph.offsets.ptr = aven_arena_create_array(
+            uint64_t,
+            arena,
+            cgraph.offsets.len
+        );
+
+        size_t size = 0;
+        for (GraphIndex v = 0; v < graph.adj.len; v += 1) {
+            get(cgraph.offsets, v) = size;
+
+            GraphAdj v_adj = get(graph.adj, v);
+            size += graph_compressed_varint_size(v_adj.len);
+
+            GraphIndex prev = v;
+            for (GraphIndex i = 0; i < v_adj.len; i += 1) {
+                GraphIndex u = graph_nb(graph.nb, v_adj, i);
+                size += graph_compressed_varint_size(
+                    graph_compressed_delta(prev, u)
+                );
+                prev = u;
+            }
+        }
+        get(cgraph.offsets, graph.adj.len) = size;
+
+        cgraph.bytes.len = size;
+        cgraph.bytes.ptr = aven_arena_create_array(
+            unsigned char,
+            arena,
+            cgraph.bytes.len
+        );
+
+        unsigned char *ptr = cgraph.bytes.ptr;
+        for (GraphIndex v = 0; v < graph.adj.len; v += 1) {
+            GraphAdj v_adj = get(graph.adj, v);
+            ptr = graph_compressed_varint_write(ptr, v_adj.len);
+
+            GraphIndex prev = v;
+            for (GraphIndex i = 0; i < v_adj.len; i += 1) {
+                GraphIndex u = graph_nb(graph.nb, v_adj, i);
+                ptr = graph_compressed_varint_write(
+                    ptr,
+                    graph_compressed_delta(prev, u)
+                );
+                prev = u;
+            }
+        }
+        assert(ptr == cgraph.bytes.ptr + cgraph.bytes.len);
+
+        return cgraph;
+    }
+
+    static inline GraphIndex graph_compressed_vertices(GraphCompressed graph) {
+        return (GraphIndex)(graph.offsets.len - 1);
+    }
+
+    // Iterate the rotation of v in order, iter.len counts the neighbors not
+    // yet returned by graph_compressed_iter_next
+
+    static inline GraphCompressedIter graph_compressed_iter(
+        GraphCompressed graph,
+        GraphIndex v
+    ) {
+        GraphCompressedIter iter = {
+            .ptr = &get(graph.bytes, get(graph.offsets, v)),
+            .prev = v,
+        };
+        iter.ptr = graph_compressed_varint_read(iter.ptr, &iter.len);
+        return iter;
+    }
+
+    static inline GraphIndex graph_compressed_iter_next(
+        GraphCompressedIter *iter
+    ) {
+        assert(iter->len > 0);
+
+        GraphIndex zigzag;
+        iter->ptr = graph_compressed_varint_read(iter->ptr, &zigzag);
+        iter->prev = graph_compressed_undelta(iter->prev, zigzag);
+        iter->len -= 1;
+        return iter->prev;
+    }
+
+    static inline GraphIndex graph_compressed_deg(
+        GraphCompressed graph,
+        GraphIndex v
+    ) {
+        GraphIndex deg;
+        graph_compressed_varint_read(
+            &get(graph.bytes, get(graph.offsets, v)),
+            &deg
+        );
+        return deg;
+    }
+
+    static inline Graph graph_compressed_decode(
+        GraphCompressed graph,
+        AvenArena *arena
+    ) {
+        Graph dgraph = {
+            .nb = { .len = graph.nb_len },
+            .adj = { .len = graph_compressed_vertices(graph) },
+        };
+        dgraph.nb.ptr = aven_arena_create_array(
+            GraphIndex,
+            arena,
+            dgraph.nb.len
+        );
+        dgraph.adj.ptr = aven_arena_create_array(
+            GraphAdj,
+            arena,
+            dgraph.adj.len
+        );
+
+        GraphIndex index = 0;
+        for (GraphIndex v = 0; v < dgraph.adj.len; v += 1) {
+            GraphCompressedIter iter = graph_compressed_iter(graph, v);
+            GraphAdj v_adj = { .index = index, .len = iter.len };
+            for (GraphIndex i = 0; i < v_adj.len; i += 1) {
+                get(dgraph.nb, index + i) = graph_compressed_iter_next(&iter);
+            }
+            get(dgraph.adj, v) = v_adj;
+            index += v_adj.len;
+        }
+
+        return dgraph;
+    }
+
+#endif // GRAPH_COMPRESSED_H
@@ -7,58 +7,55 @@
     #include "../graph.h"
 
     typedef struct {
-        uint32_t vertex;
-        uint32_t edge_index;
+        GraphIndex vertex;
+        GraphIndex edge_index;
     } GraphDfsFrame;
 
     typedef struct {
-        uint32_t parent;
-        uint32_t number;
-        uint32_t least_ancestor;
-        uint32_t lowpoint;
+        GraphIndex parent;
+        GraphIndex number;
+        GraphIndex least_ancestor;
+        GraphIndex lowpoint;
     } GraphDfsTreeNode;
 
     typedef Slice(GraphDfsTreeNode) GraphDfsTree;
-    typedef Slice(uint32_t) GraphDfsNumbering;
+    typedef Slice(GraphIndex) GraphDfsNumbering;
 
     typedef struct {
         GraphDfsNumbering numbering;
         GraphDfsTree tree;
     } GraphDfsData;
 
-    typedef struct {
-        GraphAdj adj;
-        GraphDfsTreeNode node;
-    } GraphDfsVertex;
-
     typedef struct {
         GraphNbSlice nb;
-        Slice(GraphDfsVertex) vertex_info;
-        List(uint32_t) dfs_numbering;
+        GraphAdjSlice adj;
+        GraphDfsTree tree;
+        List(GraphIndex) dfs_numbering;
         List(GraphDfsFrame) dfs_list;
     } GraphDfsCtx;
 
     static inline GraphDfsCtx graph_dfs_init(
         Graph graph,
-        uint32_t root_vertex,
+        GraphIndex root_vertex,
         AvenArena *arena
     ) {
         assert(root_vertex < graph.adj.len);
 
         GraphDfsCtx ctx = {
             .nb = graph.nb,
+            .adj = graph.adj,
             .dfs_list = { .cap = graph.adj.len },
             .dfs_numbering = { .cap = graph.adj.len },
-            .vertex_info = { .len = graph.adj.len },
+            .tree = { .len = graph.adj.len },
         };
 
-        ctx.vertex_info.ptr = aven_arena_create_array(
-            GraphDfsVertex,
+        ctx.tree.ptr = aven_arena_create_array(
+            GraphDfsTreeNode,
             arena,
-            ctx.vertex_info.len
+            ctx.tree.len
         );
         ctx.dfs_numbering.ptr = aven_arena_create_array(
-            uint32_t,
+            GraphIndex,
             arena,
             ctx.dfs_numbering.cap
         );
@@ -68,13 +65,11 @@
             ctx.dfs_list.cap
         );
 
-        for (uint32_t v = 0; v < ctx.vertex_info.len; v += 1) {
-            get(ctx.vertex_info, v) = (GraphDfsVertex){
-                .adj = get(graph.adj, v),
-            };
+        for (GraphIndex v = 0; v < ctx.tree.len; v += 1) {
+            get(ctx.tree, v) = (GraphDfsTreeNode){ 0 };
         }
 
-        get(ctx.vertex_info, root_vertex).node.parent = root_vertex + 1;
+        get(ctx.tree, root_vertex).parent = root_vertex + 1;
         list_push(ctx.dfs_numbering) = root_vertex;
         list_push(ctx.dfs_list) = (GraphDfsFrame){ .vertex = root_vertex };
 
@@ -87,51 +82,80 @@
         }
 
         GraphDfsFrame *frame = &list_back(ctx->dfs_list);
-        GraphDfsVertex *v_info = &get(ctx->vertex_info, frame->vertex);
-        if (frame->edge_index == v_info->adj.len) {
-            uint32_t p = v_info->node.parent - 1;
+        GraphAdj v_adj = get(ctx->adj, frame->vertex);
+        GraphDfsTreeNode *v_node = &get(ctx->tree, frame->vertex);
+        if (frame->edge_index == v_adj.len) {
+            GraphIndex p = v_node->parent - 1;
             if (p != frame->vertex) {
-                GraphDfsVertex *p_info = &get(ctx->vertex_info, p);
-                p_info->node.lowpoint = min(
-                    p_info->node.lowpoint,
-                    v_info->node.lowpoint
-                );
+                GraphDfsTreeNode *p_node = &get(ctx->tree, p);
+                p_node->lowpoint = min(p_node->lowpoint, v_node->lowpoint);
             }
             (void)list_pop(ctx->dfs_list);
             return false;
         }
 
-        uint32_t u = graph_nb(ctx->nb, v_info->adj, frame->edge_index);
-        GraphDfsVertex *u_info = &get(ctx->vertex_info, u);
-        if (u_info->node.parent == 0) {
-            u_info->node.number = (uint32_t)ctx->dfs_numbering.len;
-            u_info->node.least_ancestor = u_info->node.number;
-            u_info->node.lowpoint = u_info->node.number;
-            u_info->node.parent = frame->vertex + 1;
+        GraphIndex u = graph_nb(ctx->nb, v_adj, frame->edge_index);
+        GraphDfsTreeNode *u_node = &get(ctx->tree, u);
+        if (u_node->parent == 0) {
+            u_node->number = (GraphIndex)ctx->dfs_numbering.len;
+            u_node->least_ancestor = u_node->number;
+            u_node->lowpoint = u_node->number;
+            u_node->parent = frame->vertex + 1;
 
             list_push(ctx->dfs_list) = (GraphDfsFrame){
                 .vertex = u,
                 .edge_index = 0,
             };
             list_push(ctx->dfs_numbering) = u;
-        } else if (u != v_info->node.parent - 1) {
-            v_info->node.least_ancestor = min(
-                v_info->node.least_ancestor,
-                u_info->node.number
-            );
-            v_info->node.lowpoint = min(
-                v_info->node.lowpoint,
-                u_info->node.lowpoint
+        } else if (u != v_node->parent - 1) {
+            v_node->least_ancestor = min(
+                v_node->least_ancestor,
+                u_node->number
             );
+            v_node->lowpoint = min(v_node->lowpoint, u_node->lowpoint);
         }
         frame->edge_index += 1;
 
         return false;
     }
 
+    // Take at most budget steps, returns true once the search is finished,
+    // a later call picks up where this one stopped
+    static inline bool graph_dfs_run(GraphDfsCtx *ctx, size_t budget) {
+        for (; budget > 0; budget -= 1) {
+            if (graph_dfs_step(ctx)) {
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+    // Continue the search from another unvisited vertex once the current
+    // tree is finished, numbers keep increasing so the context ends up
+    // holding a DFS forest
+    static inline void graph_dfs_push_root(
+        GraphDfsCtx *ctx,
+        GraphIndex root_vertex
+    ) {
+        assert(root_vertex < ctx->adj.len);
+        assert(ctx->dfs_list.len == 0);
+        assert(get(ctx->tree, root_vertex).parent == 0);
+
+        GraphIndex root_number = (GraphIndex)ctx->dfs_numbering.len;
+        get(ctx->tree, root_vertex) = (GraphDfsTreeNode){
+            .parent = root_vertex + 1,
+            .number = root_number,
+            .least_ancestor = root_number,
+            .lowpoint = root_number,
+        };
+        list_push(ctx->dfs_numbering) = root_vertex;
+        list_push(ctx->dfs_list) = (GraphDfsFrame){ .vertex = root_vertex };
+    }
+
     static inline GraphDfsData graph_dfs(
         Graph graph,
-        uint32_t root_vertex,
+        GraphIndex root_vertex,
         AvenArena *arena
     ) {
         GraphDfsTree tree = aven_arena_create_slice(
@@ -139,8 +163,8 @@
             arena,
             graph.adj.len
         );
-        List(uint32_t) numbering = aven_arena_create_list(
-            uint32_t,
+        List(GraphIndex) numbering = aven_arena_create_list(
+            GraphIndex,
             arena,
             graph.adj.len
         );
@@ -151,11 +175,11 @@
         while (!graph_dfs_step(&ctx)) {}
         ;
 
-        for (uint32_t v = 0; v < tree.len; v += 1) {
-            get(tree, v) = get(ctx.vertex_info, v).node;
+        for (GraphIndex v = 0; v < tree.len; v += 1) {
+            get(tree, v) = get(ctx.tree, v);
         }
 
-        for (uint32_t n = 0; n < ctx.dfs_numbering.len; n += 1) {
+        for (GraphIndex n = 0; n < ctx.dfs_numbering.len; n += 1) {
             list_push(numbering) = get(ctx.dfs_numbering, n);
         }
 
@@ -169,28 +193,203 @@
         };
     }
 
-    static inline bool graph_dfs_tree_contains(GraphDfsTree tree, uint32_t v) {
+    // DFS counterpart of GraphBfsEpochCtx
+
+    typedef struct {
+        GraphNbSlice nb;
+        GraphAdjSlice adj;
+        GraphDfsTree tree;
+        GraphPropIndex stamps;
+        List(GraphIndex) dfs_numbering;
+        List(GraphDfsFrame) dfs_list;
+        GraphIndex epoch;
+    } GraphDfsEpochCtx;
+
+    static inline GraphDfsEpochCtx graph_dfs_epoch_init(
+        Graph graph,
+        AvenArena *arena
+    ) {
+        GraphDfsEpochCtx ctx = {
+            .nb = graph.nb,
+            .adj = graph.adj,
+            .dfs_list = { .cap = graph.adj.len },
+            .dfs_numbering = { .cap = graph.adj.len },
+            .tree = { .len = graph.adj.len },
+            .stamps = { .len = graph.adj.len },
+            // past the cleared stamps, so no vertex is contained until the
+            // first search starts
+            .epoch = 1,
+        };
+
+        ctx.tree.ptr = aven_arena_create_array(
+            GraphDfsTreeNode,
+            arena,
+            ctx.tree.len
+        );
+        ctx.stamps.ptr = aven_arena_create_array(
+            GraphIndex,
+            arena,
+            ctx.stamps.len
+        );
+        ctx.dfs_numbering.ptr = aven_arena_create_array(
+            GraphIndex,
+            arena,
+            ctx.dfs_numbering.cap
+        );
+        ctx.dfs_list.ptr = aven_arena_create_array(
+            GraphDfsFrame,
+            arena,
+            ctx.dfs_list.cap
+        );
+
+        for (GraphIndex v = 0; v < ctx.stamps.len; v += 1) {
+            get(ctx.stamps, v) = 0;
+        }
+
+        return ctx;
+    }
+
+    // Begin a new search from root_vertex, any previous search on the
+    // context is discarded even if it did not finish
+    static inline void graph_dfs_epoch_start(
+        GraphDfsEpochCtx *ctx,
+        GraphIndex root_vertex
+    ) {
+        assert(root_vertex < ctx->adj.len);
+
+        if (ctx->epoch == GRAPH_INDEX_MAX) {
+            for (GraphIndex v = 0; v < ctx->stamps.len; v += 1) {
+                get(ctx->stamps, v) = 0;
+            }
+            ctx->epoch = 0;
+        }
+        ctx->epoch += 1;
+
+        ctx->dfs_numbering.len = 0;
+        ctx->dfs_list.len = 0;
+
+        get(ctx->stamps, root_vertex) = ctx->epoch;
+        get(ctx->tree, root_vertex) = (GraphDfsTreeNode){
+            .parent = root_vertex + 1,
+        };
+        list_push(ctx->dfs_numbering) = root_vertex;
+        list_push(ctx->dfs_list) = (GraphDfsFrame){ .vertex = root_vertex };
+    }
+
+    static inline bool graph_dfs_epoch_step(GraphDfsEpochCtx *ctx) {
+        if (ctx->dfs_list.len == 0) {
+            return true;
+        }
+
+        GraphDfsFrame *frame = &list_back(ctx->dfs_list);
+        GraphAdj v_adj = get(ctx->adj, frame->vertex);
+        GraphDfsTreeNode *v_node = &get(ctx->tree, frame->vertex);
+        if (frame->edge_index == v_adj.len) {
+            GraphIndex p = v_node->parent - 1;
+            if (p != frame->vertex) {
+                GraphDfsTreeNode *p_node = &get(ctx->tree, p);
+                p_node->lowpoint = min(p_node->lowpoint, v_node->lowpoint);
+            }
+            (void)list_pop(ctx->dfs_list);
+            return false;
+        }
+
+        GraphIndex u = graph_nb(ctx->nb, v_adj, frame->edge_index);
+        GraphDfsTreeNode *u_node = &get(ctx->tree, u);
+        if (get(ctx->stamps, u) != ctx->epoch) {
+            get(ctx->stamps, u) = ctx->epoch;
+
+            GraphIndex u_number = (GraphIndex)ctx->dfs_numbering.len;
+            *u_node = (GraphDfsTreeNode){
+                .parent = frame->vertex + 1,
+                .number = u_number,
+                .least_ancestor = u_number,
+                .lowpoint = u_number,
+            };
+
+            list_push(ctx->dfs_list) = (GraphDfsFrame){
+                .vertex = u,
+                .edge_index = 0,
+            };
+            list_push(ctx->dfs_numbering) = u;
+        } else if (u != v_node->parent - 1) {
+            v_node->least_ancestor = min(
+                v_node->least_ancestor,
+                u_node->number
+            );
+            v_node->lowpoint = min(v_node->lowpoint, u_node->lowpoint);
+        }
+        frame->edge_index += 1;
+
+        return false;
+    }
+
+    static inline bool graph_dfs_epoch_run(
+        GraphDfsEpochCtx *ctx,
+        size_t budget
+    ) {
+        for (; budget > 0; budget -= 1) {
+            if (graph_dfs_epoch_step(ctx)) {
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+    static inline bool graph_dfs_epoch_contains(
+        GraphDfsEpochCtx *ctx,
+        GraphIndex v
+    ) {
+        return get(ctx->stamps, v) == ctx->epoch;
+    }
+
+    static inline GraphDfsTreeNode graph_dfs_epoch_node(
+        GraphDfsEpochCtx *ctx,
+        GraphIndex v
+    ) {
+        assert(graph_dfs_epoch_contains(ctx, v));
+        return get(ctx->tree, v);
+    }
+
+    // The vertices reached so far in DFS order, valid until the next start
+    static inline GraphDfsNumbering graph_dfs_epoch_numbering(
+        GraphDfsEpochCtx *ctx
+    ) {
+        return (GraphDfsNumbering){
+            .ptr = ctx->dfs_numbering.ptr,
+            .len = ctx->dfs_numbering.len,
+        };
+    }
+
+    static inline bool graph_dfs_tree_contains(
+        GraphDfsTree tree,
+        GraphIndex v
+    ) {
         return get(tree, v).parent != 0;
     }
 
-    static inline uint32_t graph_dfs_tree_parent(GraphDfsTree tree, uint32_t v) {
+    static inline GraphIndex graph_dfs_tree_parent(
+        GraphDfsTree tree,
+        GraphIndex v
+    ) {
         assert(graph_dfs_tree_contains(tree, v));
         return get(tree, v).parent - 1;
     }
 
     static inline GraphSubset graph_dfs_tree_path_to_root(
         GraphDfsTree tree,
-        uint32_t v,
+        GraphIndex v,
         AvenArena *arena
     ) {
-        List(uint32_t) path_list = aven_arena_create_list(
-            uint32_t,
+        List(GraphIndex) path_list = aven_arena_create_list(
+            GraphIndex,
             arena,
             tree.len
         );
 
         if (get(tree, v).parent != 0) {
-            uint32_t last_v;
+            GraphIndex last_v;
             do {
                 list_push(path_list) = v;
                 last_v = v;
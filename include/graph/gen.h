@@ -7,37 +7,41 @@
     #include <aven/rng.h>
     #include "../graph.h"
 
-    static inline Graph graph_gen_path(uint32_t size, AvenArena *arena) {
+    static inline Graph graph_gen_path(GraphIndex size, AvenArena *arena) {
         assert(size > 0);
         GraphAdjSlice adj = aven_arena_create_slice(GraphAdj, arena, size);
-        List(uint32_t) nb = aven_arena_create_list(
-            uint32_t,
+        List(GraphIndex) nb = aven_arena_create_list(
+            GraphIndex,
             arena,
             2 * (size - 1)
         );
 
-        for (uint32_t v = 0; v < size; v += 1) {
-            get(adj, v).index = (uint32_t)nb.len;
+        for (GraphIndex v = 0; v < size; v += 1) {
+            get(adj, v).index = (GraphIndex)nb.len;
             if (v > 0) {
                 list_push(nb) = v - 1;
             }
             if (v < size - 1) {
                 list_push(nb) = v + 1;
             }
-            get(adj, v).len = (uint32_t)(nb.len - get(adj, v).index);
+            get(adj, v).len = (GraphIndex)(nb.len - get(adj, v).index);
         }
         assert(nb.len == nb.cap);
 
         return (Graph){ .adj = adj, .nb = slice_list(nb) };
     }
 
-    static inline Graph graph_gen_cycle(uint32_t size, AvenArena *arena) {
+    static inline Graph graph_gen_cycle(GraphIndex size, AvenArena *arena) {
         assert(size > 0);
         GraphAdjSlice adj = aven_arena_create_slice(GraphAdj, arena, size);
-        List(uint32_t) nb = aven_arena_create_list(uint32_t, arena, 2 * size);
+        List(GraphIndex) nb = aven_arena_create_list(
+            GraphIndex,
+            arena,
+            2 * size
+        );
 
-        for (uint32_t v = 0; v < size; v += 1) {
-            get(adj, v).index = (uint32_t)nb.len;
+        for (GraphIndex v = 0; v < size; v += 1) {
+            get(adj, v).index = (GraphIndex)nb.len;
             get(adj, v).len = 2;
 
             if (v > 0) {
@@ -56,22 +60,22 @@
         return (Graph){ .adj = adj, .nb = slice_list(nb) };
     }
 
-    static inline Graph graph_gen_complete(uint32_t size, AvenArena *arena) {
+    static inline Graph graph_gen_complete(GraphIndex size, AvenArena *arena) {
         Graph graph = {
             .nb = { .len = size * (size - 1) },
             .adj = { .len = size },
         };
-        graph.nb.ptr = aven_arena_create_array(uint32_t, arena, graph.nb.len);
+        graph.nb.ptr = aven_arena_create_array(GraphIndex, arena, graph.nb.len);
         graph.adj.ptr = aven_arena_create_array(GraphAdj, arena, graph.adj.len);
 
-        uint32_t i = 0;
-        for (uint32_t v = 0; v < graph.adj.len; v += 1) {
+        GraphIndex i = 0;
+        for (GraphIndex v = 0; v < graph.adj.len; v += 1) {
             get(graph.adj, v).len = size - 1;
             get(graph.adj, v).index = i;
 
-            for (uint32_t j = 0; j < graph.adj.len; j += 1) {
-                uint32_t u = ((v & 1) == 0) ?
-                    ((uint32_t)graph.adj.len - (j + 1)) :
+            for (GraphIndex j = 0; j < graph.adj.len; j += 1) {
+                GraphIndex u = ((v & 1) == 0) ?
+                    ((GraphIndex)graph.adj.len - (j + 1)) :
                     j;
                 if (u == v) {
                     continue;
@@ -85,8 +89,8 @@
     }
 
     static inline Graph graph_gen_grid(
-        uint32_t width,
-        uint32_t height,
+        GraphIndex width,
+        GraphIndex height,
         AvenArena *arena
     ) {
         assert(width > 1 and height > 1);
@@ -99,16 +103,16 @@
             },
             .adj = { .len = width * height },
         };
-        graph.nb.ptr = aven_arena_create_array(uint32_t, arena, graph.nb.len);
+        graph.nb.ptr = aven_arena_create_array(GraphIndex, arena, graph.nb.len);
         graph.adj.ptr = aven_arena_create_array(GraphAdj, arena, graph.adj.len);
 
-        uint32_t i = 0;
-        for (uint32_t v = 0; v < graph.adj.len; v += 1) {
+        GraphIndex i = 0;
+        for (GraphIndex v = 0; v < graph.adj.len; v += 1) {
             GraphAdj *v_adj = &get(graph.adj, v);
             v_adj->index = i;
 
-            uint32_t x = v % width;
-            uint32_t y = v / width;
+            GraphIndex x = v % width;
+            GraphIndex y = v / width;
 
             if (x > 0) {
                 get(graph.nb, i) = (x - 1) + y * width;
@@ -133,36 +137,40 @@
         return graph;
     }
 
-    static uint32_t graph_gen_pyramid_coord(uint32_t k, uint32_t x, uint32_t y) {
+    static GraphIndex graph_gen_pyramid_coord(
+        GraphIndex k,
+        GraphIndex x,
+        GraphIndex y
+    ) {
         assert(x < k - y);
         assert(y < k);
         return k * y - ((y * (y - 1)) / 2) + x + 3;
     }
 
-    static inline Graph graph_gen_pyramid(uint32_t k, AvenArena *arena) {
+    static inline Graph graph_gen_pyramid(GraphIndex k, AvenArena *arena) {
         assert(k > 0);
 
         size_t size = ((k * (k + 1)) / 2) + 3;
         Graph graph = { .nb = { .len = 6 * size - 12 }, .adj = { .len = size } };
-        graph.nb.ptr = aven_arena_create_array(uint32_t, arena, graph.nb.len);
+        graph.nb.ptr = aven_arena_create_array(GraphIndex, arena, graph.nb.len);
         graph.adj.ptr = aven_arena_create_array(GraphAdj, arena, graph.adj.len);
 
-        uint32_t nb_index = 0;
+        GraphIndex nb_index = 0;
         {
             get(graph.adj, 0).index = nb_index;
 
             get(graph.nb, nb_index) = 2;
             nb_index += 1;
 
-            for (uint32_t y = 0; y < k; y += 1) {
-                uint32_t u = graph_gen_pyramid_coord(k, 0, y);
+            for (GraphIndex y = 0; y < k; y += 1) {
+                GraphIndex u = graph_gen_pyramid_coord(k, 0, y);
                 get(graph.nb, nb_index) = u;
                 nb_index += 1;
             }
 
-            for (uint32_t x = 1; x < k; x += 1) {
-                uint32_t y = (k - x) - 1;
-                uint32_t u = graph_gen_pyramid_coord(k, x, y);
+            for (GraphIndex x = 1; x < k; x += 1) {
+                GraphIndex y = (k - x) - 1;
+                GraphIndex u = graph_gen_pyramid_coord(k, x, y);
                 get(graph.nb, nb_index) = u;
                 nb_index += 1;
             }
@@ -181,7 +189,7 @@
             nb_index += 1;
 
             {
-                uint32_t u = graph_gen_pyramid_coord(k, k - 1, 0);
+                GraphIndex u = graph_gen_pyramid_coord(k, k - 1, 0);
                 get(graph.nb, nb_index) = u;
                 nb_index += 1;
             }
@@ -199,8 +207,8 @@
             get(graph.nb, nb_index) = 1;
             nb_index += 1;
 
-            for (uint32_t x = k; x > 0; x -= 1) {
-                uint32_t u = graph_gen_pyramid_coord(k, x - 1, 0);
+            for (GraphIndex x = k; x > 0; x -= 1) {
+                GraphIndex u = graph_gen_pyramid_coord(k, x - 1, 0);
                 get(graph.nb, nb_index) = u;
                 nb_index += 1;
             }
@@ -212,15 +220,15 @@
             assert(get(graph.adj, 2).len == 2 + k);
         }
 
-        for (uint32_t y = 0; y < k; y += 1) {
-            uint32_t width = k - y;
-            for (uint32_t x = 0; x < width; x += 1) {
-                uint32_t v = graph_gen_pyramid_coord(k, x, y);
+        for (GraphIndex y = 0; y < k; y += 1) {
+            GraphIndex width = k - y;
+            for (GraphIndex x = 0; x < width; x += 1) {
+                GraphIndex v = graph_gen_pyramid_coord(k, x, y);
 
                 get(graph.adj, v).index = nb_index;
 
                 if (x > 0) {
-                    uint32_t u = graph_gen_pyramid_coord(k, x - 1, y);
+                    GraphIndex u = graph_gen_pyramid_coord(k, x - 1, y);
                     get(graph.nb, nb_index) = u;
                     nb_index += 1;
                 }
@@ -246,7 +254,7 @@
                     }
                 }
                 if (x < (width - 1)) {
-                    uint32_t u = graph_gen_pyramid_coord(k, x + 1, y);
+                    GraphIndex u = graph_gen_pyramid_coord(k, x + 1, y);
                     get(graph.nb, nb_index) = u;
                     nb_index += 1;
                 } else if ((width - 1) != 0) {
@@ -254,7 +262,7 @@
                     nb_index += 1;
                 }
                 if (y < (k - 1) and x < width - 1) {
-                    uint32_t u = graph_gen_pyramid_coord(k, x, y + 1);
+                    GraphIndex u = graph_gen_pyramid_coord(k, x, y + 1);
                     get(graph.nb, nb_index) = u;
                     nb_index += 1;
                 }
@@ -262,7 +270,7 @@
                     get(graph.nb, nb_index) = 0;
                     nb_index += 1;
                 } else if (y < (k - 1)) {
-                    uint32_t u = graph_gen_pyramid_coord(k, x - 1, y + 1);
+                    GraphIndex u = graph_gen_pyramid_coord(k, x - 1, y + 1);
                     get(graph.nb, nb_index) = u;
                     nb_index += 1;
                 }
@@ -275,221 +283,371 @@
     }
 
     typedef struct {
-        uint32_t vertices[3];
-        uint32_t neighbors[3];
+        GraphIndex vertices[3];
+        GraphIndex neighbors[3];
     } GraphGenTriangle;
 
-    static inline Graph graph_gen_triangulation(
-        uint32_t size,
-        AvenRng rng,
-        Vec2 flip_prob,
-        AvenArena *arena
+    typedef Slice(GraphGenTriangle) GraphGenTriangleSlice;
+
+    typedef struct {
+        GraphGenTriangleSlice faces;
+        GraphPropIndex labels;
+    } GraphGenTriangulationFaces;
+
+    // Insert the vertex v into the face at face_index, which leaves two new
+    // faces at the end of faces, then flip up to edge_flips of the edges of
+    // the old face starting from flip_start. Edges of face 0 are never
+    // flipped. Returns whether flip_start was moved to avoid a double edge.
+    static inline bool graph_gen_triangulation_insert(
+        GraphGenTriangleSlice *faces,
+        GraphIndex v,
+        GraphIndex face_index,
+        GraphIndex edge_flips,
+        GraphIndex flip_start
     ) {
-        assert(size >= 3);
+        bool shifted = false;
 
-        Graph graph = { .nb = { .len = 6 * size - 12 }, .adj = { .len = size } };
+        GraphGenTriangle og_face = get(*faces, face_index);
 
-        graph.nb.ptr = aven_arena_create_array(uint32_t, arena, graph.nb.len);
-        graph.adj.ptr = aven_arena_create_array(GraphAdj, arena, graph.adj.len);
+        GraphIndex face_indices[3] = {
+            face_index,
+            (GraphIndex)faces->len,
+            (GraphIndex)(faces->len + 1),
+        };
+        faces->len += 2;
+
+        GraphGenTriangle *new_faces[3];
+        for (size_t i = 0; i < 3; i += 1) {
+            new_faces[i] = &get(*faces, face_indices[i]);
+            *(new_faces[i]) = (GraphGenTriangle){
+                .vertices = {
+                    v,
+                    og_face.vertices[i],
+                    og_face.vertices[(i + 1) % 3],
+                },
+                .neighbors = {
+                    face_indices[(i + 2) % 3],
+                    og_face.neighbors[i],
+                    face_indices[(i + 1) % 3],
+                },
+            };
+        }
 
-        for (uint32_t v = 0; v < graph.adj.len; v += 1) {
-            get(graph.adj, v) = (GraphAdj){ 0 };
+        GraphGenTriangle *neighbor_faces[3];
+        GraphIndex neighbor_edge_indices[3];
+        GraphIndex neighbor_opposite_vertices[3];
+        for (size_t i = 0; i < 3; i += 1) {
+            GraphIndex u = og_face.vertices[(i + 1) % 3];
+            neighbor_faces[i] = &get(*faces, og_face.neighbors[i]);
+            GraphIndex j = 0;
+            for (; j < 3; j += 1) {
+                if (neighbor_faces[i]->vertices[j] == u) {
+                    neighbor_edge_indices[i] = j;
+                    neighbor_opposite_vertices[i] = neighbor_faces[i]
+                        ->vertices[(j + 2) % 3];
+                    neighbor_faces[i]->neighbors[j] = face_indices[i];
+                    break;
+                }
+            }
+            assert(j < 3);
         }
 
-        AvenArena temp_arena = *arena;
+        // avoid creating double edges when flipping
+        if (
+            edge_flips == 2 and
+            neighbor_opposite_vertices[flip_start] ==
+                neighbor_opposite_vertices[(flip_start + 1) % 3]
+        ) {
+            if (
+                neighbor_opposite_vertices[flip_start] ==
+                    neighbor_opposite_vertices[(flip_start + 2) % 3]
+            ) {
+                edge_flips -= 1;
+            } else {
+                flip_start += 1;
+                shifted = true;
+            }
+        }
+
+        for (GraphIndex i = 0; i < edge_flips; i += 1) {
+            GraphIndex flip_index = (flip_start + i) % 3;
+            if (og_face.neighbors[flip_index] == 0) {
+                // never flip an edge of the outer triangle
+                continue;
+            }
 
-        List(GraphGenTriangle) faces = aven_arena_create_list(
+            GraphIndex nflip_index = neighbor_edge_indices[flip_index];
+
+            GraphGenTriangle *face = new_faces[flip_index];
+            GraphGenTriangle *neighbor = neighbor_faces[flip_index];
+
+            {
+                GraphGenTriangle *face_next_neighbor = new_faces[
+                    (flip_index + 1) % 3
+                ];
+                GraphIndex j = 0;
+                for (; j < 3; j += 1) {
+                    if (face_next_neighbor->vertices[j] == v) {
+                        break;
+                    }
+                }
+                assert(j < 3);
+                face_next_neighbor->neighbors[j] = og_face.neighbors[
+                    flip_index
+                ];
+            }
+            {
+                GraphGenTriangle *neighbor_prev_neighbor = &get(
+                    *faces,
+                    neighbor->neighbors[(nflip_index + 1) % 3]
+                );
+                GraphIndex j = 0;
+                for (; j < 3; j += 1) {
+                    if (
+                        neighbor_prev_neighbor->vertices[j] ==
+                            neighbor_opposite_vertices[flip_index]
+                    ) {
+                        break;
+                    }
+                }
+                assert(j < 3);
+                neighbor_prev_neighbor->neighbors[j] = face_indices[
+                    flip_index
+                ];
+            }
+
+            face->vertices[2] = neighbor->vertices[(nflip_index + 2) % 3];
+            neighbor->vertices[(nflip_index + 1) % 3] = v;
+
+            face->neighbors[1] = neighbor->neighbors[(nflip_index + 1) % 3];
+            face->neighbors[2] = og_face.neighbors[flip_index];
+
+            neighbor->neighbors[nflip_index] = face_indices[
+                (flip_index + 1) % 3
+            ];
+            neighbor->neighbors[(nflip_index + 1) % 3] = face_indices[
+                flip_index
+            ];
+        }
+
+        return shifted;
+    }
+
+    // Random triangulation as a list of faces, faces[i].neighbors[j] is the
+    // face across the edge from vertices[j] to vertices[(j + 1) % 3]; the
+    // vertices are relabeled by a random permutation of labels
+    static inline GraphGenTriangulationFaces graph_gen_triangulation_faces(
+        GraphIndex size,
+        AvenRng rng,
+        Vec2 flip_prob,
+        AvenArena *arena
+    ) {
+        assert(size >= 3);
+
+        GraphGenTriangleSlice faces = { .len = 2 };
+        faces.ptr = aven_arena_create_array(
             GraphGenTriangle,
-            &temp_arena,
+            arena,
             2 * size - 4
         );
 
-        list_push(faces) = (GraphGenTriangle){
+        get(faces, 0) = (GraphGenTriangle){
             .vertices = { 0, 2, 1 },
             .neighbors = { 1, 1, 1 },
         };
-        list_push(faces) = (GraphGenTriangle){
+        get(faces, 1) = (GraphGenTriangle){
             .vertices = { 0, 1, 2 },
             .neighbors = { 0, 0, 0 },
         };
 
-        for (uint32_t v = 3; v < size; v += 1) {
-            uint32_t face_index = 1 +
+        for (GraphIndex v = 3; v < size; v += 1) {
+            GraphIndex face_index = 1 +
                 aven_rng_rand_bounded(rng, (uint32_t)(faces.len - 1));
 
             float r = aven_rng_randf(rng);
-            uint32_t edge_flips = 0;
+            GraphIndex edge_flips = 0;
             if (r >= flip_prob[0]) {
                 edge_flips += 1;
             }
             if (r >= flip_prob[1]) {
                 edge_flips += 1;
             }
-            uint32_t flip_start = aven_rng_rand_bounded(rng, 3);
-
-            GraphGenTriangle og_face = get(faces, face_index);
+            GraphIndex flip_start = aven_rng_rand_bounded(rng, 3);
 
-            uint32_t face_indices[3] = {
+            bool shifted = graph_gen_triangulation_insert(
+                &faces,
+                v,
                 face_index,
-                (uint32_t)faces.len,
-                (uint32_t)(faces.len + 1),
-            };
-            faces.len += 2;
-
-            GraphGenTriangle *new_faces[3];
-            for (size_t i = 0; i < 3; i += 1) {
-                new_faces[i] = &get(faces, face_indices[i]);
-                *(new_faces[i]) = (GraphGenTriangle){
-                    .vertices = {
-                        v,
-                        og_face.vertices[i],
-                        og_face.vertices[(i + 1) % 3],
-                    },
-                    .neighbors = {
-                        face_indices[(i + 2) % 3],
-                        og_face.neighbors[i],
-                        face_indices[(i + 1) % 3],
-                    },
-                };
+                edge_flips,
+                flip_start
+            );
+            if (shifted) {
+                // the shift is by 1 + a draw bounded by 1, keep consuming
+                // it so the same rng state still gives the same graph
+                (void)aven_rng_rand_bounded(rng, 1);
             }
+        }
 
-            GraphGenTriangle *neighbor_faces[3];
-            uint32_t neighbor_edge_indices[3];
-            uint32_t neighbor_opposite_vertices[3];
-            for (size_t i = 0; i < 3; i += 1) {
-                uint32_t u = og_face.vertices[(i + 1) % 3];
-                neighbor_faces[i] = &get(faces, og_face.neighbors[i]);
-                uint32_t j = 0;
-                for (; j < 3; j += 1) {
-                    if (neighbor_faces[i]->vertices[j] == u) {
-                        neighbor_edge_indices[i] = j;
-                        neighbor_opposite_vertices[i] = neighbor_faces[i]
-                            ->vertices[(j + 2) % 3];
-                        neighbor_faces[i]->neighbors[j] = face_indices[i];
-                        break;
-                    }
-                }
-                assert(j < 3);
-            }
+        GraphPropIndex labels = aven_arena_create_slice(
+            GraphIndex,
+            arena,
+            size
+        );
 
-            // avoid creating double edges when flipping
-            if (
-                edge_flips == 2 and
-                neighbor_opposite_vertices[flip_start] ==
-                    neighbor_opposite_vertices[(flip_start + 1) % 3]
-            ) {
-                if (
-                    neighbor_opposite_vertices[flip_start] ==
-                        neighbor_opposite_vertices[(flip_start + 2) % 3]
-                ) {
-                    edge_flips -= 1;
-                } else {
-                    flip_start += 1 + aven_rng_rand_bounded(rng, 1);
-                }
-            }
+        for (GraphIndex v = 0; v < labels.len; v += 1) {
+            get(labels, v) = v;
+        }
+
+        for (GraphIndex i = (GraphIndex)labels.len; i > 4; i -= 1) {
+            GraphIndex j = 3 + aven_rng_rand_bounded(rng, (uint32_t)(i - 4));
+            GraphIndex tmp = get(labels, i - 1);
+            get(labels, i - 1) = get(labels, j);
+            get(labels, j) = tmp;
+        }
 
-            for (uint32_t i = 0; i < edge_flips; i += 1) {
-                uint32_t flip_index = (flip_start + i) % 3;
-                if (og_face.neighbors[flip_index] == 0) {
-                    // never flip an edge of the outer triangle
+        return (GraphGenTriangulationFaces){
+            .faces = faces,
+            .labels = labels,
+        };
+    }
+
+    static inline Graph graph_gen_triangulation(
+        GraphIndex size,
+        AvenRng rng,
+        Vec2 flip_prob,
+        AvenArena *arena
+    ) {
+        assert(size >= 3);
+
+        Graph graph = { .nb = { .len = 6 * size - 12 }, .adj = { .len = size } };
+
+        graph.nb.ptr = aven_arena_create_array(GraphIndex, arena, graph.nb.len);
+        graph.adj.ptr = aven_arena_create_array(GraphAdj, arena, graph.adj.len);
+
+        for (GraphIndex v = 0; v < graph.adj.len; v += 1) {
+            get(graph.adj, v) = (GraphAdj){ 0 };
+        }
+
+        AvenArena temp_arena = *arena;
+        GraphGenTriangulationFaces data = graph_gen_triangulation_faces(
+            size,
+            rng,
+            flip_prob,
+            &temp_arena
+        );
+        GraphGenTriangleSlice faces = data.faces;
+        GraphPropIndex labels = data.labels;
+
+        GraphIndex nb_index = 0;
+        for (GraphIndex i = 0; i < faces.len; i += 1) {
+            GraphGenTriangle *face = &get(faces, i);
+
+            for (GraphIndex j = 0; j < 3; j += 1) {
+                GraphIndex v = face->vertices[j];
+                GraphIndex vl = get(labels, v);
+                if (get(graph.adj, vl).len != 0) {
                     continue;
                 }
 
-                uint32_t nflip_index = neighbor_edge_indices[flip_index];
+                get(graph.adj, vl).index = nb_index;
+                get(graph.nb, nb_index) = get(
+                    labels,
+                    face->vertices[(j + 1) % 3]
+                );
+                nb_index += 1;
 
-                GraphGenTriangle *face = new_faces[flip_index];
-                GraphGenTriangle *neighbor = neighbor_faces[flip_index];
+                GraphIndex face_index = face->neighbors[j];
+                while (face_index != i) {
+                    GraphGenTriangle *cur_face = &get(faces, face_index);
 
-                {
-                    GraphGenTriangle *face_next_neighbor = new_faces[
-                        (flip_index + 1) % 3
-                    ];
-                    uint32_t j = 0;
-                    for (; j < 3; j += 1) {
-                        if (face_next_neighbor->vertices[j] == v) {
+                    GraphIndex k = 0;
+                    for (; k < 3; k += 1) {
+                        if (cur_face->vertices[k] == v) {
                             break;
                         }
                     }
-                    assert(j < 3);
-                    face_next_neighbor->neighbors[j] = og_face.neighbors[
-                        flip_index
-                    ];
-                }
-                {
-                    GraphGenTriangle *neighbor_prev_neighbor = &get(
-                        faces,
-                        neighbor->neighbors[(nflip_index + 1) % 3]
+                    assert(k < 3);
+
+                    get(graph.nb, nb_index) = get(
+                        labels,
+                        cur_face->vertices[(k + 1) % 3]
                     );
-                    uint32_t j = 0;
-                    for (; j < 3; j += 1) {
-                        if (
-                            neighbor_prev_neighbor->vertices[j] ==
-                                neighbor_opposite_vertices[flip_index]
-                        ) {
-                            break;
-                        }
-                    }
-                    assert(j < 3);
-                    neighbor_prev_neighbor->neighbors[j] = face_indices[
-                        flip_index
-                    ];
+                    nb_index += 1;
+                    face_index = cur_face->neighbors[k];
                 }
 
-                face->vertices[2] = neighbor->vertices[(nflip_index + 2) % 3];
-                neighbor->vertices[(nflip_index + 1) % 3] = v;
-
-                face->neighbors[1] = neighbor->neighbors[(nflip_index + 1) % 3];
-                face->neighbors[2] = og_face.neighbors[flip_index];
-
-                neighbor->neighbors[nflip_index] = face_indices[
-                    (flip_index + 1) % 3
-                ];
-                neighbor->neighbors[(nflip_index + 1) % 3] = face_indices[
-                    flip_index
-                ];
+                get(graph.adj, vl).len = nb_index - get(graph.adj, vl).index;
             }
         }
 
-        Slice(uint32_t) labels = aven_arena_create_slice(
-            uint32_t,
-            &temp_arena,
-            size
-        );
+        assert((size_t)nb_index == graph.nb.len);
 
-        for (uint32_t v = 0; v < labels.len; v += 1) {
-            get(labels, v) = v;
-        }
+        return graph;
+    }
 
-        for (uint32_t i = (uint32_t)labels.len; i > 4; i -= 1) {
-            uint32_t j = 3 + aven_rng_rand_bounded(rng, i - 4);
-            uint32_t tmp = get(labels, i - 1);
-            get(labels, i - 1) = get(labels, j);
-            get(labels, j) = tmp;
+    // Same graph as graph_gen_triangulation for the same rng state, the back
+    // indices are read off the face adjacency instead of a graph_aug pass
+    static inline GraphAug graph_gen_triangulation_aug(
+        GraphIndex size,
+        AvenRng rng,
+        Vec2 flip_prob,
+        AvenArena *arena
+    ) {
+        assert(size >= 3);
+
+        GraphAug graph = {
+            .nb = { .len = 6 * size - 12 },
+            .adj = { .len = size },
+        };
+
+        graph.nb.ptr = aven_arena_create_array(GraphAugNb, arena, graph.nb.len);
+        graph.adj.ptr = aven_arena_create_array(GraphAdj, arena, graph.adj.len);
+
+        for (GraphIndex v = 0; v < graph.adj.len; v += 1) {
+            get(graph.adj, v) = (GraphAdj){ 0 };
         }
 
-        uint32_t nb_index = 0;
-        for (uint32_t i = 0; i < faces.len; i += 1) {
+        AvenArena temp_arena = *arena;
+        GraphGenTriangulationFaces data = graph_gen_triangulation_faces(
+            size,
+            rng,
+            flip_prob,
+            &temp_arena
+        );
+        GraphGenTriangleSlice faces = data.faces;
+        GraphPropIndex labels = data.labels;
+
+        // the half-edge from vertices[k] to vertices[(k + 1) % 3] of face f
+        // is stored at nb index get(corners, 3 * f + k)
+        GraphPropIndex corners = aven_arena_create_slice(
+            GraphIndex,
+            &temp_arena,
+            3 * faces.len
+        );
+
+        GraphIndex nb_index = 0;
+        for (GraphIndex i = 0; i < faces.len; i += 1) {
             GraphGenTriangle *face = &get(faces, i);
 
-            for (uint32_t j = 0; j < 3; j += 1) {
-                uint32_t v = face->vertices[j];
-                uint32_t vl = get(labels, v);
+            for (GraphIndex j = 0; j < 3; j += 1) {
+                GraphIndex v = face->vertices[j];
+                GraphIndex vl = get(labels, v);
                 if (get(graph.adj, vl).len != 0) {
                     continue;
                 }
 
                 get(graph.adj, vl).index = nb_index;
-                get(graph.nb, nb_index) = get(
-                    labels,
-                    face->vertices[(j + 1) % 3]
-                );
+                get(graph.nb, nb_index) = (GraphAugNb){
+                    .vertex = get(labels, face->vertices[(j + 1) % 3]),
+                };
+                get(corners, 3 * i + j) = nb_index;
                 nb_index += 1;
 
-                uint32_t face_index = face->neighbors[j];
+                GraphIndex face_index = face->neighbors[j];
                 while (face_index != i) {
                     GraphGenTriangle *cur_face = &get(faces, face_index);
 
-                    uint32_t k = 0;
+                    GraphIndex k = 0;
                     for (; k < 3; k += 1) {
                         if (cur_face->vertices[k] == v) {
                             break;
@@ -497,10 +655,10 @@
                     }
                     assert(k < 3);
 
-                    get(graph.nb, nb_index) = get(
-                        labels,
-                        cur_face->vertices[(k + 1) % 3]
-                    );
+                    get(graph.nb, nb_index) = (GraphAugNb){
+                        .vertex = get(labels, cur_face->vertices[(k + 1) % 3]),
+                    };
+                    get(corners, 3 * face_index + k) = nb_index;
                     nb_index += 1;
                     face_index = cur_face->neighbors[k];
                 }
@@ -511,7 +669,33 @@
 
         assert((size_t)nb_index == graph.nb.len);
 
+        // the twin of the half-edge from v to u in a face runs from u to v in
+        // the neighboring face across that edge
+        for (GraphIndex i = 0; i < faces.len; i += 1) {
+            GraphGenTriangle *face = &get(faces, i);
+
+            for (GraphIndex j = 0; j < 3; j += 1) {
+                GraphIndex u = face->vertices[(j + 1) % 3];
+                GraphIndex twin_face_index = face->neighbors[j];
+                GraphGenTriangle *twin_face = &get(faces, twin_face_index);
+
+                GraphIndex k = 0;
+                for (; k < 3; k += 1) {
+                    if (twin_face->vertices[k] == u) {
+                        break;
+                    }
+                }
+                assert(k < 3);
+                assert(twin_face->vertices[(k + 1) % 3] == face->vertices[j]);
+
+                GraphAdj u_adj = get(graph.adj, get(labels, u));
+                get(graph.nb, get(corners, 3 * i + j)).back_index =
+                    get(corners, 3 * twin_face_index + k) - u_adj.index;
+            }
+        }
+
         return graph;
     }
 #endif // GRAPH_GEN_H
 
+
@@ -0,0 +1,728 @@
+#ifndef GRAPH_GEN_THREAD_H
+    #define GRAPH_GEN_THREAD_H
+
+    #include <aven.h>
+    #include <aven/arena.h>
+    #include <aven/math.h>
+    #include <aven/thread/pool.h>
+
+    #include <math.h>
+
+    #include "../../graph.h"
+    #include "../gen.h"
+    #include "../thread.h"
+
+    // Multi-threaded random triangulation. A seed triangulation is built
+    // sequentially, then the remaining vertices are split between its inner
+    // faces and each face is triangulated on its own by the insertion
+    // process of graph_gen_triangulation, with the face as outer triangle:
+    //   1. each thread draws the seed face of a range of vertices;
+    //   2. each thread triangulates a contiguous range of seed faces, which
+    //      hold a contiguous range of vertices;
+    //   3. each thread links its faces on the seed edges to the faces on
+    //      the other side and counts the degrees of its vertices;
+    //   4. each thread writes the rotations of a range of vertices.
+    // Inserting into a uniform inner face is a Polya urn over the seed
+    // faces, a seed face with k vertices inside holds 2 k + 1 faces, so the
+    // vertex counts are drawn from its limit, the symmetric Dirichlet
+    // distribution with parameter 1/2. The one difference to the sequential
+    // process is that seed edges are never flipped once the seed is done.
+    // Random numbers come from a counter-based generator keyed by the seed
+    // and the vertex, face or label they are drawn for, so the graph does
+    // not depend on the number of threads.
+
+    // Inner vertices of the seed. More seed faces balance the work between
+    // threads better, fewer keep the degrees of the seed vertices closer to
+    // the sequential process: each is a fixed corner of several seed faces.
+    #ifndef GRAPH_GEN_TRIANGULATION_THREAD_SEED
+        #define GRAPH_GEN_TRIANGULATION_THREAD_SEED 256
+    #endif
+
+    typedef enum {
+        GRAPH_GEN_THREAD_STREAM_FACE,
+        GRAPH_GEN_THREAD_STREAM_FLIP,
+        GRAPH_GEN_THREAD_STREAM_FLIP_START,
+        GRAPH_GEN_THREAD_STREAM_SEED_FACE,
+        GRAPH_GEN_THREAD_STREAM_WEIGHT_RADIUS,
+        GRAPH_GEN_THREAD_STREAM_WEIGHT_ANGLE,
+        GRAPH_GEN_THREAD_STREAM_LABEL,
+        GRAPH_GEN_THREAD_STREAM_LEN,
+    } GraphGenThreadStream;
+
+    // splitmix64 of the counter-th value of the stream
+    static inline uint64_t graph_gen_thread_rand(
+        uint64_t seed,
+        GraphGenThreadStream stream,
+        uint64_t counter
+    ) {
+        uint64_t x = seed + 0x9e3779b97f4a7c15UL * (
+            counter * GRAPH_GEN_THREAD_STREAM_LEN + (uint64_t)stream + 1
+        );
+        x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9UL;
+        x = (x ^ (x >> 27)) * 0x94d049bb133111ebUL;
+        return x ^ (x >> 31);
+    }
+
+    static inline uint32_t graph_gen_thread_rand_bounded(
+        uint64_t seed,
+        GraphGenThreadStream stream,
+        uint64_t counter,
+        uint32_t bound
+    ) {
+        uint64_t x = graph_gen_thread_rand(seed, stream, counter) >> 32;
+        return (uint32_t)((x * bound) >> 32);
+    }
+
+    // Uniform in [0, 1)
+    static inline float graph_gen_thread_randf(
+        uint64_t seed,
+        GraphGenThreadStream stream,
+        uint64_t counter
+    ) {
+        uint64_t x = graph_gen_thread_rand(seed, stream, counter) >> 40;
+        return (float)x / (float)((uint64_t)1 << 24);
+    }
+
+    static inline double graph_gen_thread_randd(
+        uint64_t seed,
+        GraphGenThreadStream stream,
+        uint64_t counter
+    ) {
+        uint64_t x = graph_gen_thread_rand(seed, stream, counter) >> 11;
+        return (double)x / (double)((uint64_t)1 << 53);
+    }
+
+    // One step of graph_gen_triangulation_faces with the draws for v
+    static inline void graph_gen_triangulation_thread_insert(
+        GraphGenTriangleSlice *faces,
+        GraphIndex v,
+        uint64_t seed,
+        Vec2 flip_prob
+    ) {
+        GraphIndex face_index = 1 + graph_gen_thread_rand_bounded(
+            seed,
+            GRAPH_GEN_THREAD_STREAM_FACE,
+            v,
+            (uint32_t)(faces->len - 1)
+        );
+
+        float r = graph_gen_thread_randf(
+            seed,
+            GRAPH_GEN_THREAD_STREAM_FLIP,
+            v
+        );
+        GraphIndex edge_flips = 0;
+        if (r >= flip_prob[0]) {
+            edge_flips += 1;
+        }
+        if (r >= flip_prob[1]) {
+            edge_flips += 1;
+        }
+        GraphIndex flip_start = graph_gen_thread_rand_bounded(
+            seed,
+            GRAPH_GEN_THREAD_STREAM_FLIP_START,
+            v,
+            3
+        );
+
+        graph_gen_triangulation_insert(
+            faces,
+            v,
+            face_index,
+            edge_flips,
+            flip_start
+        );
+    }
+
+    // An inner face of the seed and the vertices and faces inside it
+    typedef struct {
+        GraphIndex vertex_start;
+        GraphIndex len;
+        GraphIndex face_start;
+        // face inside on the edge from the seed face vertices[j]
+        GraphIndex edge_faces[3];
+    } GraphGenTriangulationThreadRegion;
+    typedef Slice(GraphGenTriangulationThreadRegion)
+        GraphGenTriangulationThreadRegionSlice;
+
+    typedef Slice(double) GraphGenTriangulationThreadWeightSlice;
+
+    typedef struct {
+        uint64_t seed;
+        Vec2 flip_prob;
+        GraphIndex seed_size;
+        GraphGenTriangleSlice seed_faces;
+        GraphGenTriangulationThreadWeightSlice weights;
+        GraphGenTriangulationThreadRegionSlice regions;
+        GraphGenTriangleSlice faces;
+        GraphGenTriangleSlice scratch;
+        GraphPropIndex counts;
+        GraphPropIndex degrees;
+        GraphPropIndex corners;
+        GraphPropIndex labels;
+        Graph graph;
+        GraphIndex start_index;
+        GraphIndex end_index;
+        GraphIndex start_region;
+        GraphIndex end_region;
+        GraphIndex start_vertex;
+        GraphIndex end_vertex;
+    } GraphGenTriangulationThreadWorker;
+    typedef Slice(GraphGenTriangulationThreadWorker)
+        GraphGenTriangulationThreadWorkerSlice;
+
+    static inline GraphIndex graph_gen_triangulation_thread_corner(
+        GraphGenTriangle face,
+        GraphIndex v
+    ) {
+        GraphIndex k = 0;
+        for (; k < 3; k += 1) {
+            if (face.vertices[k] == v) {
+                break;
+            }
+        }
+        assert(k < 3);
+        return k;
+    }
+
+    // The face on the edge from v inside seed face seed_index, where seed
+    // face 0 is the outer face of the whole triangulation
+    static inline GraphIndex graph_gen_triangulation_thread_across(
+        GraphGenTriangleSlice seed_faces,
+        GraphGenTriangulationThreadRegionSlice regions,
+        GraphIndex seed_index,
+        GraphIndex v
+    ) {
+        if (seed_index == 0) {
+            return 0;
+        }
+        GraphIndex k = graph_gen_triangulation_thread_corner(
+            get(seed_faces, seed_index),
+            v
+        );
+        return get(regions, seed_index - 1).edge_faces[k];
+    }
+
+    static void graph_gen_triangulation_thread_count_worker(void *args) {
+        GraphGenTriangulationThreadWorker *worker = args;
+
+        for (GraphIndex r = 0; r < worker->counts.len; r += 1) {
+            get(worker->counts, r) = 0;
+        }
+
+        double total = get(worker->weights, worker->weights.len - 1);
+        for (
+            GraphIndex i = worker->start_index;
+            i < worker->end_index;
+            i += 1
+        ) {
+            double x = total * graph_gen_thread_randd(
+                worker->seed,
+                GRAPH_GEN_THREAD_STREAM_SEED_FACE,
+                i
+            );
+
+            GraphIndex lo = 0;
+            GraphIndex hi = (GraphIndex)(worker->weights.len - 1);
+            while (lo < hi) {
+                GraphIndex mid = lo + (hi - lo) / 2;
+                if (get(worker->weights, mid) > x) {
+                    hi = mid;
+                } else {
+                    lo = mid + 1;
+                }
+            }
+
+            get(worker->counts, lo) += 1;
+        }
+    }
+
+    static void graph_gen_triangulation_thread_grow_worker(void *args) {
+        GraphGenTriangulationThreadWorker *worker = args;
+
+        for (
+            GraphIndex r = worker->start_region;
+            r < worker->end_region;
+            r += 1
+        ) {
+            GraphGenTriangulationThreadRegion *region = &get(
+                worker->regions,
+                r
+            );
+            GraphGenTriangle seed_face = get(worker->seed_faces, r + 1);
+            GraphIndex a = seed_face.vertices[0];
+            GraphIndex b = seed_face.vertices[1];
+            GraphIndex c = seed_face.vertices[2];
+
+            GraphGenTriangleSlice local = {
+                .ptr = worker->scratch.ptr,
+                .len = 2,
+            };
+            get(local, 0) = (GraphGenTriangle){
+                .vertices = { a, c, b },
+                .neighbors = { 1, 1, 1 },
+            };
+            get(local, 1) = (GraphGenTriangle){
+                .vertices = { a, b, c },
+                .neighbors = { 0, 0, 0 },
+            };
+
+            for (GraphIndex i = 0; i < region->len; i += 1) {
+                graph_gen_triangulation_thread_insert(
+                    &local,
+                    region->vertex_start + i,
+                    worker->seed,
+                    worker->flip_prob
+                );
+            }
+
+            // edges of local face 0 are the seed edges in reverse, marked
+            // with GRAPH_INDEX_MAX until the other side is known
+            for (GraphIndex l = 1; l < local.len; l += 1) {
+                GraphGenTriangle face = get(local, l);
+                for (GraphIndex j = 0; j < 3; j += 1) {
+                    if (face.neighbors[j] == 0) {
+                        face.neighbors[j] = GRAPH_INDEX_MAX;
+                    } else {
+                        face.neighbors[j] += region->face_start - 1;
+                    }
+                }
+                get(worker->faces, region->face_start + l - 1) = face;
+            }
+
+            GraphGenTriangle outside = get(local, 0);
+            for (GraphIndex k = 0; k < 3; k += 1) {
+                region->edge_faces[2 - k] = region->face_start +
+                    outside.neighbors[k] - 1;
+            }
+        }
+    }
+
+    static void graph_gen_triangulation_thread_stitch_worker(void *args) {
+        GraphGenTriangulationThreadWorker *worker = args;
+
+        for (
+            GraphIndex v = worker->start_vertex;
+            v < worker->end_vertex;
+            v += 1
+        ) {
+            get(worker->degrees, v) = 0;
+        }
+
+        for (
+            GraphIndex r = worker->start_region;
+            r < worker->end_region;
+            r += 1
+        ) {
+            GraphGenTriangulationThreadRegion region = get(worker->regions, r);
+            GraphGenTriangle seed_face = get(worker->seed_faces, r + 1);
+
+            GraphIndex face_end = region.face_start + 2 * region.len + 1;
+            for (GraphIndex f = region.face_start; f < face_end; f += 1) {
+                GraphGenTriangle *face = &get(worker->faces, f);
+                for (GraphIndex j = 0; j < 3; j += 1) {
+                    GraphIndex v = face->vertices[j];
+                    if (face->neighbors[j] == GRAPH_INDEX_MAX) {
+                        GraphIndex e = graph_gen_triangulation_thread_corner(
+                            seed_face,
+                            v
+                        );
+                        face->neighbors[j] =
+                            graph_gen_triangulation_thread_across(
+                                worker->seed_faces,
+                                worker->regions,
+                                seed_face.neighbors[e],
+                                face->vertices[(j + 1) % 3]
+                            );
+                    }
+                    if (v >= worker->seed_size) {
+                        get(worker->degrees, v) += 1;
+                        get(worker->corners, v) = 3 * f + j;
+                    }
+                }
+            }
+        }
+    }
+
+    static void graph_gen_triangulation_thread_rotation_worker(void *args) {
+        GraphGenTriangulationThreadWorker *worker = args;
+        Graph graph = worker->graph;
+
+        for (
+            GraphIndex v = worker->start_vertex;
+            v < worker->end_vertex;
+            v += 1
+        ) {
+            GraphIndex corner = get(worker->corners, v);
+            GraphIndex i = corner / 3;
+            GraphIndex j = corner % 3;
+            GraphGenTriangle *face = &get(worker->faces, i);
+
+            GraphIndex nb_index = get(graph.adj, get(worker->labels, v)).index;
+            get(graph.nb, nb_index) = get(
+                worker->labels,
+                face->vertices[(j + 1) % 3]
+            );
+            nb_index += 1;
+
+            GraphIndex face_index = face->neighbors[j];
+            while (face_index != i) {
+                GraphGenTriangle *cur_face = &get(worker->faces, face_index);
+                GraphIndex k = graph_gen_triangulation_thread_corner(
+                    *cur_face,
+                    v
+                );
+
+                get(graph.nb, nb_index) = get(
+                    worker->labels,
+                    cur_face->vertices[(k + 1) % 3]
+                );
+                nb_index += 1;
+                face_index = cur_face->neighbors[k];
+            }
+        }
+    }
+
+    static inline Graph graph_gen_triangulation_thread(
+        GraphIndex size,
+        uint64_t seed,
+        Vec2 flip_prob,
+        AvenThreadPool *thread_pool,
+        size_t nthreads,
+        AvenArena *arena
+    ) {
+        assert(size >= 3);
+        assert(nthreads > 0);
+
+        Graph graph = {
+            .nb = { .len = 6 * size - 12 },
+            .adj = { .len = size },
+        };
+        graph.nb.ptr = aven_arena_create_array(
+            GraphIndex,
+            arena,
+            graph.nb.len
+        );
+        graph.adj.ptr = aven_arena_create_array(
+            GraphAdj,
+            arena,
+            graph.adj.len
+        );
+
+        AvenArena temp_arena = *arena;
+
+        GraphIndex seed_size = (GraphIndex)min(
+            (size_t)size,
+            3 + (size_t)GRAPH_GEN_TRIANGULATION_THREAD_SEED
+        );
+        GraphGenTriangleSlice seed_faces = { .len = 2 };
+        seed_faces.ptr = aven_arena_create_array(
+            GraphGenTriangle,
+            &temp_arena,
+            2 * seed_size - 4
+        );
+        get(seed_faces, 0) = (GraphGenTriangle){
+            .vertices = { 0, 2, 1 },
+            .neighbors = { 1, 1, 1 },
+        };
+        get(seed_faces, 1) = (GraphGenTriangle){
+            .vertices = { 0, 1, 2 },
+            .neighbors = { 0, 0, 0 },
+        };
+        for (GraphIndex v = 3; v < seed_size; v += 1) {
+            graph_gen_triangulation_thread_insert(
+                &seed_faces,
+                v,
+                seed,
+                flip_prob
+            );
+        }
+
+        // cumulative Dirichlet weights of the inner seed faces, each the
+        // square of a normal by Box-Muller
+        GraphGenTriangulationThreadRegionSlice regions = {
+            .len = seed_faces.len - 1,
+        };
+        regions.ptr = aven_arena_create_array(
+            GraphGenTriangulationThreadRegion,
+            &temp_arena,
+            regions.len
+        );
+        GraphGenTriangulationThreadWeightSlice weights = {
+            .len = regions.len,
+        };
+        weights.ptr = aven_arena_create_array(
+            double,
+            &temp_arena,
+            weights.len
+        );
+        double total_weight = 0.0;
+        for (GraphIndex r = 0; r < weights.len; r += 1) {
+            double radius = 1.0 - graph_gen_thread_randd(
+                seed,
+                GRAPH_GEN_THREAD_STREAM_WEIGHT_RADIUS,
+                r
+            );
+            double angle = graph_gen_thread_randd(
+                seed,
+                GRAPH_GEN_THREAD_STREAM_WEIGHT_ANGLE,
+                r
+            );
+            double z = sqrt(-2.0 * log(radius)) *
+                cos(2.0 * (double)AVEN_MATH_PI_F * angle);
+            total_weight += z * z;
+            get(weights, r) = total_weight;
+        }
+
+        GraphGenTriangulationThreadWorkerSlice workers = { .len = nthreads };
+        workers.ptr = aven_arena_create_array(
+            GraphGenTriangulationThreadWorker,
+            &temp_arena,
+            workers.len
+        );
+        AvenThreadPoolJobSlice jobs = aven_arena_create_slice(
+            AvenThreadPoolJob,
+            &temp_arena,
+            nthreads - 1
+        );
+
+        GraphGenTriangleSlice faces = { .len = 2 * (size_t)size - 4 };
+        faces.ptr = aven_arena_create_array(
+            GraphGenTriangle,
+            &temp_arena,
+            faces.len
+        );
+        GraphPropIndex degrees = aven_arena_create_slice(
+            GraphIndex,
+            &temp_arena,
+            size
+        );
+        GraphPropIndex corners = aven_arena_create_slice(
+            GraphIndex,
+            &temp_arena,
+            size
+        );
+        GraphPropIndex labels = aven_arena_create_slice(
+            GraphIndex,
+            &temp_arena,
+            size
+        );
+
+        GraphIndex ndraws = size - seed_size;
+        GraphIndex draw_chunk = (GraphIndex)(ndraws / workers.len);
+        for (uint32_t i = 0; i < workers.len; i += 1) {
+            GraphIndex end_index = (i + 1) * draw_chunk;
+            if (i + 1 == workers.len) {
+                end_index = ndraws;
+            }
+
+            GraphPropIndex counts = { .len = regions.len };
+            counts.ptr = aven_arena_create_array(
+                GraphIndex,
+                &temp_arena,
+                counts.len
+            );
+
+            get(workers, i) = (GraphGenTriangulationThreadWorker){
+                .seed = seed,
+                .flip_prob = { flip_prob[0], flip_prob[1] },
+                .seed_size = seed_size,
+                .seed_faces = seed_faces,
+                .weights = weights,
+                .regions = regions,
+                .faces = faces,
+                .counts = counts,
+                .degrees = degrees,
+                .corners = corners,
+                .labels = labels,
+                .graph = graph,
+                .start_index = i * draw_chunk,
+                .end_index = end_index,
+            };
+        }
+
+        graph_thread_run_phase(
+            thread_pool,
+            jobs,
+            workers,
+            graph_gen_triangulation_thread_count_worker
+        );
+
+        // lay the seed faces out in order and give each thread a range of
+        // them holding about as many faces as the others
+        GraphIndex vertex_start = seed_size;
+        GraphIndex face_start = 1;
+        for (GraphIndex r = 0; r < regions.len; r += 1) {
+            GraphIndex len = 0;
+            for (uint32_t i = 0; i < workers.len; i += 1) {
+                len += get(get(workers, i).counts, r);
+            }
+            get(regions, r) = (GraphGenTriangulationThreadRegion){
+                .vertex_start = vertex_start,
+                .len = len,
+                .face_start = face_start,
+            };
+            vertex_start += len;
+            face_start += 2 * len + 1;
+        }
+        assert(vertex_start == size);
+        assert(face_start == faces.len);
+
+        {
+            size_t ninner = faces.len - 1;
+            GraphIndex r = 0;
+            for (uint32_t i = 0; i < workers.len; i += 1) {
+                GraphGenTriangulationThreadWorker *worker = &get(workers, i);
+                size_t face_end = ((size_t)(i + 1) * ninner) / workers.len;
+
+                worker->start_region = r;
+                GraphIndex scratch_len = 2;
+                while (
+                    r < regions.len and
+                    get(regions, r).face_start - 1 < face_end
+                ) {
+                    scratch_len = max(
+                        scratch_len,
+                        2 * get(regions, r).len + 2
+                    );
+                    r += 1;
+                }
+                worker->end_region = r;
+
+                worker->scratch.len = scratch_len;
+                worker->scratch.ptr = aven_arena_create_array(
+                    GraphGenTriangle,
+                    &temp_arena,
+                    worker->scratch.len
+                );
+            }
+            assert(r == regions.len);
+        }
+
+        graph_thread_run_phase(
+            thread_pool,
+            jobs,
+            workers,
+            graph_gen_triangulation_thread_grow_worker
+        );
+
+        {
+            GraphGenTriangle outer_face = get(seed_faces, 0);
+            for (GraphIndex k = 0; k < 3; k += 1) {
+                GraphIndex across = graph_gen_triangulation_thread_across(
+                    seed_faces,
+                    regions,
+                    outer_face.neighbors[k],
+                    outer_face.vertices[(k + 1) % 3]
+                );
+                outer_face.neighbors[k] = across;
+            }
+            get(faces, 0) = outer_face;
+        }
+
+        // the stitch phase counts the degrees of the vertices inside the
+        // seed faces, each thread owning the vertices of its seed faces
+        for (uint32_t i = 0; i < workers.len; i += 1) {
+            GraphGenTriangulationThreadWorker *worker = &get(workers, i);
+            if (worker->start_region == worker->end_region) {
+                worker->start_vertex = 0;
+                worker->end_vertex = 0;
+                continue;
+            }
+            GraphGenTriangulationThreadRegion last_region = get(
+                regions,
+                worker->end_region - 1
+            );
+            worker->start_vertex = get(
+                regions,
+                worker->start_region
+            ).vertex_start;
+            worker->end_vertex = last_region.vertex_start + last_region.len;
+        }
+
+        graph_thread_run_phase(
+            thread_pool,
+            jobs,
+            workers,
+            graph_gen_triangulation_thread_stitch_worker
+        );
+
+        for (GraphIndex v = 0; v < seed_size; v += 1) {
+            get(degrees, v) = 0;
+        }
+        for (GraphIndex r = 0; r < regions.len; r += 1) {
+            GraphGenTriangle seed_face = get(seed_faces, r + 1);
+            for (GraphIndex e = 0; e < 3; e += 1) {
+                GraphIndex v = seed_face.vertices[e];
+                if (get(degrees, v) != 0) {
+                    continue;
+                }
+
+                GraphIndex i = get(regions, r).edge_faces[e];
+                GraphIndex j = graph_gen_triangulation_thread_corner(
+                    get(faces, i),
+                    v
+                );
+                get(corners, v) = 3 * i + j;
+
+                GraphIndex degree = 1;
+                GraphIndex face_index = get(faces, i).neighbors[j];
+                while (face_index != i) {
+                    GraphGenTriangle cur_face = get(faces, face_index);
+                    GraphIndex k = graph_gen_triangulation_thread_corner(
+                        cur_face,
+                        v
+                    );
+                    degree += 1;
+                    face_index = cur_face.neighbors[k];
+                }
+                get(degrees, v) = degree;
+            }
+        }
+
+        for (GraphIndex v = 0; v < labels.len; v += 1) {
+            get(labels, v) = v;
+        }
+        for (GraphIndex i = (GraphIndex)labels.len; i > 4; i -= 1) {
+            GraphIndex j = 3 + graph_gen_thread_rand_bounded(
+                seed,
+                GRAPH_GEN_THREAD_STREAM_LABEL,
+                i,
+                (uint32_t)(i - 4)
+            );
+            GraphIndex tmp = get(labels, i - 1);
+            get(labels, i - 1) = get(labels, j);
+            get(labels, j) = tmp;
+        }
+
+        for (GraphIndex v = 0; v < size; v += 1) {
+            get(graph.adj, get(labels, v)).len = get(degrees, v);
+        }
+        GraphIndex nb_index = 0;
+        for (GraphIndex v = 0; v < size; v += 1) {
+            get(graph.adj, v).index = nb_index;
+            nb_index += get(graph.adj, v).len;
+        }
+        assert((size_t)nb_index == graph.nb.len);
+
+        GraphIndex vertex_chunk = (GraphIndex)(size / workers.len);
+        for (uint32_t i = 0; i < workers.len; i += 1) {
+            GraphIndex end_vertex = (i + 1) * vertex_chunk;
+            if (i + 1 == workers.len) {
+                end_vertex = size;
+            }
+            get(workers, i).start_vertex = i * vertex_chunk;
+            get(workers, i).end_vertex = end_vertex;
+        }
+
+        graph_thread_run_phase(
+            thread_pool,
+            jobs,
+            workers,
+            graph_gen_triangulation_thread_rotation_worker
+        );
+
+        return graph;
+    }
+
+#endif // GRAPH_GEN_THREAD_H
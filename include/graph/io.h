@@ -7,8 +7,15 @@
 
     #include "../graph.h"
 
-    #define GRAPH_IO_TYPE_ADJ ((uint64_t)0xad7062af0UL)
-    #define GRAPH_IO_TYPE_ADJ_AUG ((uint64_t)0xa860ad7062afUL)
+    // Wide index files get their own type tags so neither build misreads the
+    // other's files
+    #ifdef GRAPH_WIDE_INDEX
+        #define GRAPH_IO_TYPE_ADJ ((uint64_t)0xad7062af064UL)
+        #define GRAPH_IO_TYPE_ADJ_AUG ((uint64_t)0xa860ad7062af64UL)
+    #else
+        #define GRAPH_IO_TYPE_ADJ ((uint64_t)0xad7062af0UL)
+        #define GRAPH_IO_TYPE_ADJ_AUG ((uint64_t)0xa860ad7062afUL)
+    #endif
 
     typedef struct {
         uint64_t type;
@@ -66,14 +73,14 @@
         GraphAdjSlice adj = aven_io_slice(GraphAdj, adj_res.payload);
 
         AvenIoSliceResult nb_res = aven_io_reader_pop_slice(
-            uint32_t,
+            GraphIndex,
             reader,
             arena
         );
         if (nb_res.error != 0) {
             return (GraphIoResult){ .error = nb_res.error };
         }
-        GraphNbSlice nb = aven_io_slice(uint32_t, nb_res.payload);
+        GraphNbSlice nb = aven_io_slice(GraphIndex, nb_res.payload);
 
         return (GraphIoResult){ .payload = { .adj = adj, .nb = nb } };
     }
@@ -136,14 +143,220 @@
         return (GraphIoAugResult){ .payload = { .adj = adj, .nb = nb } };
     }
 
+    // Aligned variant of the format: a fixed header records where each
+    // section starts and every section begins on a GRAPH_IO_ALIGN boundary,
+    // so a mapped file can be used in place without copying. The views do
+    // not check the contents, run graph_io_validate on untrusted files.
+
+    #ifdef GRAPH_WIDE_INDEX
+        #define GRAPH_IO_TYPE_ADJ_ALIGNED ((uint64_t)0xa119ad7062af064UL)
+        #define GRAPH_IO_TYPE_ADJ_AUG_ALIGNED ((uint64_t)0xa11a860ad7062a64UL)
+    #else
+        #define GRAPH_IO_TYPE_ADJ_ALIGNED ((uint64_t)0xa119ad7062af0UL)
+        #define GRAPH_IO_TYPE_ADJ_AUG_ALIGNED ((uint64_t)0xa11a860ad7062afUL)
+    #endif
+
+    #define GRAPH_IO_ALIGN ((size_t)4096)
+
+    typedef struct {
+        uint64_t type;
+        // byte offsets from the start of the file and element counts
+        uint64_t adj_offset;
+        uint64_t adj_len;
+        uint64_t nb_offset;
+        uint64_t nb_len;
+    } GraphIoAlignedHeader;
+
+    static inline size_t graph_io_align(size_t size) {
+        return (size + GRAPH_IO_ALIGN - 1) & ~(GRAPH_IO_ALIGN - 1);
+    }
+
+    #define graph_io_aligned_size(g) ( \
+            graph_io_align(sizeof(GraphIoAlignedHeader)) + \
+            graph_io_align((g).adj.len * sizeof(*(g).adj.ptr)) + \
+            (g).nb.len * sizeof(*(g).nb.ptr) \
+        )
+
+    // Write the header and adjacency section, returns the header so the
+    // caller can fill in the neighbor section at nb_offset
+    static inline GraphIoAlignedHeader graph_io_aligned_write_adj(
+        ByteSlice bytes,
+        uint64_t type,
+        GraphAdjSlice adj,
+        size_t nb_len,
+        size_t nb_size
+    ) {
+        GraphIoAlignedHeader header = {
+            .type = type,
+            .adj_offset = graph_io_align(sizeof(GraphIoAlignedHeader)),
+            .adj_len = adj.len,
+            .nb_len = nb_len,
+        };
+        header.nb_offset = header.adj_offset +
+            graph_io_align(adj.len * sizeof(GraphAdj));
+
+        assert(((uintptr_t)bytes.ptr % sizeof(uint64_t)) == 0);
+        assert(bytes.len >= header.nb_offset + nb_len * nb_size);
+
+        for (size_t i = 0; i < header.nb_offset; i += 1) {
+            get(bytes, i) = 0;
+        }
+        *(GraphIoAlignedHeader *)bytes.ptr = header;
+
+        GraphAdj *adj_ptr = (GraphAdj *)&get(bytes, header.adj_offset);
+        for (GraphIndex v = 0; v < adj.len; v += 1) {
+            adj_ptr[v] = get(adj, v);
+        }
+
+        return header;
+    }
+
+    // bytes must hold at least graph_io_aligned_size(graph) bytes and be
+    // aligned like the header, e.g. a fresh file mapping
+    static inline void graph_io_aligned_write(ByteSlice bytes, Graph graph) {
+        GraphIoAlignedHeader header = graph_io_aligned_write_adj(
+            bytes,
+            GRAPH_IO_TYPE_ADJ_ALIGNED,
+            graph.adj,
+            graph.nb.len,
+            sizeof(GraphIndex)
+        );
+
+        GraphIndex *nb_ptr = (GraphIndex *)&get(bytes, header.nb_offset);
+        for (GraphIndex i = 0; i < graph.nb.len; i += 1) {
+            nb_ptr[i] = get(graph.nb, i);
+        }
+    }
+
+    static inline void graph_io_aug_aligned_write(
+        ByteSlice bytes,
+        GraphAug graph
+    ) {
+        GraphIoAlignedHeader header = graph_io_aligned_write_adj(
+            bytes,
+            GRAPH_IO_TYPE_ADJ_AUG_ALIGNED,
+            graph.adj,
+            graph.nb.len,
+            sizeof(GraphAugNb)
+        );
+
+        GraphAugNb *nb_ptr = (GraphAugNb *)&get(bytes, header.nb_offset);
+        for (GraphIndex i = 0; i < graph.nb.len; i += 1) {
+            nb_ptr[i] = get(graph.nb, i);
+        }
+    }
+
+    // Check the header and that both sections are aligned and lie inside
+    // the bytes, without overflowing on hostile offsets and lengths
+    static inline int graph_io_aligned_check(
+        ByteSlice bytes,
+        uint64_t type,
+        size_t nb_size,
+        GraphIoAlignedHeader *header
+    ) {
+        if (
+            ((uintptr_t)bytes.ptr % sizeof(uint64_t)) != 0 or
+            bytes.len < sizeof(GraphIoAlignedHeader)
+        ) {
+            return AVEN_IO_ERROR_MISMATCH;
+        }
+
+        *header = *(GraphIoAlignedHeader *)bytes.ptr;
+        if (header->type != type) {
+            return AVEN_IO_ERROR_MISMATCH;
+        }
+
+        if (
+            (header->adj_offset % GRAPH_IO_ALIGN) != 0 or
+            (header->nb_offset % GRAPH_IO_ALIGN) != 0 or
+            header->adj_offset < sizeof(GraphIoAlignedHeader) or
+            header->adj_offset > bytes.len or
+            header->nb_offset > bytes.len
+        ) {
+            return AVEN_IO_ERROR_MISMATCH;
+        }
+
+        if (
+            header->adj_len > GRAPH_INDEX_MAX or
+            header->nb_len > GRAPH_INDEX_MAX or
+            header->adj_len >
+                (bytes.len - header->adj_offset) / sizeof(GraphAdj) or
+            header->nb_len > (bytes.len - header->nb_offset) / nb_size
+        ) {
+            return AVEN_IO_ERROR_MISMATCH;
+        }
+
+        uint64_t adj_end = header->adj_offset +
+            header->adj_len * sizeof(GraphAdj);
+        uint64_t nb_end = header->nb_offset + header->nb_len * nb_size;
+        if (header->adj_offset < nb_end and header->nb_offset < adj_end) {
+            return AVEN_IO_ERROR_MISMATCH;
+        }
+
+        return AVEN_IO_ERROR_NONE;
+    }
+
+    // The returned graph points into bytes and lives as long as they do
+    static inline GraphIoResult graph_io_aligned_view(ByteSlice bytes) {
+        GraphIoAlignedHeader header;
+        int error = graph_io_aligned_check(
+            bytes,
+            GRAPH_IO_TYPE_ADJ_ALIGNED,
+            sizeof(GraphIndex),
+            &header
+        );
+        if (error != 0) {
+            return (GraphIoResult){ .error = error };
+        }
+
+        return (GraphIoResult){
+            .payload = {
+                .adj = {
+                    .ptr = (GraphAdj *)&get(bytes, header.adj_offset),
+                    .len = (size_t)header.adj_len,
+                },
+                .nb = {
+                    .ptr = (GraphIndex *)&get(bytes, header.nb_offset),
+                    .len = (size_t)header.nb_len,
+                },
+            },
+        };
+    }
+
+    static inline GraphIoAugResult graph_io_aug_aligned_view(ByteSlice bytes) {
+        GraphIoAlignedHeader header;
+        int error = graph_io_aligned_check(
+            bytes,
+            GRAPH_IO_TYPE_ADJ_AUG_ALIGNED,
+            sizeof(GraphAugNb),
+            &header
+        );
+        if (error != 0) {
+            return (GraphIoAugResult){ .error = error };
+        }
+
+        return (GraphIoAugResult){
+            .payload = {
+                .adj = {
+                    .ptr = (GraphAdj *)&get(bytes, header.adj_offset),
+                    .len = (size_t)header.adj_len,
+                },
+                .nb = {
+                    .ptr = (GraphAugNb *)&get(bytes, header.nb_offset),
+                    .len = (size_t)header.nb_len,
+                },
+            },
+        };
+    }
+
     static inline bool graph_io_validate(Graph graph) {
-        for (uint32_t v = 0; v < graph.adj.len; v += 1) {
+        for (GraphIndex v = 0; v < graph.adj.len; v += 1) {
             GraphAdj v_adj = get(graph.adj, v);
-            for (uint32_t i = 0; i < v_adj.len; i += 1) {
+            for (GraphIndex i = 0; i < v_adj.len; i += 1) {
                 if (v_adj.index + i >= graph.nb.len) {
                     return false;
                 }
-                uint32_t u = graph_nb(graph.nb, v_adj, i);
+                GraphIndex u = graph_nb(graph.nb, v_adj, i);
                 if (u >= graph.adj.len) {
                     return false;
                 }
@@ -154,9 +367,9 @@
     }
 
     static inline bool graph_io_aug_validate(GraphAug graph) {
-        for (uint32_t v = 0; v < graph.adj.len; v += 1) {
+        for (GraphIndex v = 0; v < graph.adj.len; v += 1) {
             GraphAdj v_adj = get(graph.adj, v);
-            for (uint32_t i = 0; i < v_adj.len; i += 1) {
+            for (GraphIndex i = 0; i < v_adj.len; i += 1) {
                 if (v_adj.index + i >= graph.nb.len) {
                     return false;
                 }
@@ -0,0 +1,247 @@
+#ifndef GRAPH_IO_CACHE_H
+    #define GRAPH_IO_CACHE_H
+
+    #include <aven.h>
+    #include <aven/arena.h>
+    #include <aven/path.h>
+    #include <aven/str.h>
+
+    #include <stdio.h>
+
+    #include "../../graph.h"
+    #include "../io.h"
+    #include "container.h"
+    #include "map.h"
+
+    // On-disk cache of generated inputs. Entries are container files named
+    // by a key hashed from the generator name, its parameters and its seed,
+    // so changing any of them addresses a different file and stale entries
+    // are never read. Entries are memory mapped on load and written to a
+    // temporary file that is renamed into place, so an interrupted run
+    // never leaves a partial entry behind.
+
+    typedef struct {
+        uint64_t key;
+        // graph_io_cache_hash of the graph the entry was generated for
+        uint64_t hash;
+    } GraphIoCacheMeta;
+
+    // The cache also passes on AVEN_IO_ERROR_* and GRAPH_IO_MAP_ERROR_*
+    // codes, its own codes start well past both
+    typedef enum {
+        GRAPH_IO_CACHE_ERROR_NONE = 0,
+        // the entry holds no metadata or was stored under another key
+        GRAPH_IO_CACHE_ERROR_KEY = 0x100,
+        GRAPH_IO_CACHE_ERROR_RENAME,
+    } GraphIoCacheError;
+
+    // splitmix64 finalizer
+    static inline uint64_t graph_io_cache_mix(uint64_t x) {
+        x ^= x >> 30;
+        x *= 0xbf58476d1ce4e5b9UL;
+        x ^= x >> 27;
+        x *= 0x94d049bb133111ebUL;
+        x ^= x >> 31;
+        return x;
+    }
+
+    static inline uint64_t graph_io_cache_key(AvenStr generator) {
+        ByteSlice bytes = {
+            .ptr = (unsigned char *)generator.ptr,
+            .len = generator.len,
+        };
+        return graph_io_cache_mix(graph_io_checksum(bytes));
+    }
+
+    static inline uint64_t graph_io_cache_key_push(
+        uint64_t key,
+        uint64_t value
+    ) {
+        return graph_io_cache_mix(key + 0x9e3779b97f4a7c15UL + value);
+    }
+
+    static inline uint64_t graph_io_cache_key_push_float(
+        uint64_t key,
+        float value
+    ) {
+        union {
+            float f;
+            uint32_t u;
+        } bits = { .f = value };
+        return graph_io_cache_key_push(key, bits.u);
+    }
+
+    // Hash of the vertex count and every rotation in order, independent of
+    // where the rotations lie in graph.nb. Each word is folded in with a
+    // multiply, so hashing is a single pass that runs near memory speed.
+    static inline uint64_t graph_io_cache_hash(Graph graph) {
+        uint64_t hash = graph_io_cache_mix(graph.adj.len);
+        for (GraphIndex v = 0; v < graph.adj.len; v += 1) {
+            GraphAdj v_adj = get(graph.adj, v);
+            hash = (hash ^ v_adj.len) * 0x100000001b3UL;
+            for (GraphIndex i = 0; i < v_adj.len; i += 1) {
+                hash = (hash ^ graph_nb(graph.nb, v_adj, i)) * 0x100000001b3UL;
+            }
+        }
+        return graph_io_cache_mix(hash);
+    }
+
+    static inline uint64_t graph_io_cache_aug_hash(GraphAug graph) {
+        uint64_t hash = graph_io_cache_mix(graph.adj.len);
+        for (GraphIndex v = 0; v < graph.adj.len; v += 1) {
+            GraphAdj v_adj = get(graph.adj, v);
+            hash = (hash ^ v_adj.len) * 0x100000001b3UL;
+            for (GraphIndex i = 0; i < v_adj.len; i += 1) {
+                GraphAugNb vu = graph_aug_nb(graph.nb, v_adj, i);
+                hash = (hash ^ vu.vertex) * 0x100000001b3UL;
+                hash = (hash ^ vu.back_index) * 0x100000001b3UL;
+            }
+        }
+        return graph_io_cache_mix(hash);
+    }
+
+    // Path of the entry for key in the directory dir, which must exist
+    static inline AvenStr graph_io_cache_path(
+        AvenStr dir,
+        uint64_t key,
+        AvenArena *arena
+    ) {
+        AvenStr ext = aven_str(".graph");
+        AvenStr name = { .len = 16 + ext.len };
+        name.ptr = aven_arena_create_array(char, arena, name.len);
+        for (size_t i = 0; i < 16; i += 1) {
+            get(name, i) = "0123456789abcdef"[(key >> (60 - 4 * i)) & 0xf];
+        }
+        for (size_t i = 0; i < ext.len; i += 1) {
+            get(name, 16 + i) = get(ext, i);
+        }
+
+        return aven_path(arena, dir, name);
+    }
+
+    typedef struct {
+        GraphIoMap map;
+        GraphIoContainer container;
+        GraphIoCacheMeta meta;
+    } GraphIoCacheEntry;
+
+    typedef Result(GraphIoCacheEntry, int) GraphIoCacheResult;
+
+    // Map the entry for key, any error is a cache miss. The sections are
+    // read in place with the container functions until the entry is closed.
+    static inline GraphIoCacheResult graph_io_cache_load(
+        AvenStr dir,
+        uint64_t key,
+        AvenArena temp_arena
+    ) {
+        AvenStr path = graph_io_cache_path(dir, key, &temp_arena);
+        GraphIoMapResult map_res = graph_io_map_open(path, temp_arena);
+        if (map_res.error != 0) {
+            return (GraphIoCacheResult){ .error = map_res.error };
+        }
+        GraphIoCacheEntry entry = { .map = map_res.payload };
+
+        GraphIoContainerResult container_res = graph_io_container_open(
+            entry.map.bytes
+        );
+        if (container_res.error != 0) {
+            graph_io_map_close(&entry.map);
+            return (GraphIoCacheResult){ .error = container_res.error };
+        }
+        entry.container = container_res.payload;
+
+        GraphIoSectionResult meta_res = graph_io_container_section(
+            GraphIoCacheMeta,
+            entry.container,
+            GRAPH_IO_SECTION_CACHE
+        );
+        if (
+            meta_res.error != 0 or
+            meta_res.payload.len != sizeof(entry.meta)
+        ) {
+            graph_io_map_close(&entry.map);
+            return (GraphIoCacheResult){ .error = GRAPH_IO_CACHE_ERROR_KEY };
+        }
+        entry.meta = *(GraphIoCacheMeta *)meta_res.payload.ptr;
+        if (entry.meta.key != key) {
+            graph_io_map_close(&entry.map);
+            return (GraphIoCacheResult){ .error = GRAPH_IO_CACHE_ERROR_KEY };
+        }
+
+        return (GraphIoCacheResult){ .payload = entry };
+    }
+
+    static inline void graph_io_cache_close(GraphIoCacheEntry *entry) {
+        graph_io_map_close(&entry->map);
+        *entry = (GraphIoCacheEntry){ 0 };
+    }
+
+    // Whether graph, e.g. viewed from the entry, is the one it was stored
+    // with, for runs that do not trust the cache directory
+    static inline bool graph_io_cache_check(
+        GraphIoCacheEntry *entry,
+        Graph graph
+    ) {
+        return graph_io_cache_hash(graph) == entry->meta.hash;
+    }
+
+    // Write the sections collected by writer as the entry for key, the
+    // writer needs room for one more section holding the metadata and is
+    // left as it was
+    static inline int graph_io_cache_store(
+        AvenStr dir,
+        uint64_t key,
+        uint64_t hash,
+        GraphIoContainerWriter *writer,
+        AvenArena temp_arena
+    ) {
+        GraphIoCacheMeta meta = { .key = key, .hash = hash };
+        graph_io_container_writer_add_bytes(
+            writer,
+            GRAPH_IO_SECTION_CACHE,
+            &meta,
+            1,
+            sizeof(meta)
+        );
+
+        AvenStr path = graph_io_cache_path(dir, key, &temp_arena);
+        AvenStr tmp_path = { .len = path.len + 4 };
+        tmp_path.ptr = aven_arena_create_array(
+            char,
+            &temp_arena,
+            tmp_path.len
+        );
+        for (size_t i = 0; i < path.len; i += 1) {
+            get(tmp_path, i) = get(path, i);
+        }
+        for (size_t i = 0; i < 4; i += 1) {
+            get(tmp_path, path.len + i) = ".tmp"[i];
+        }
+
+        GraphIoMapResult map_res = graph_io_map_create(
+            tmp_path,
+            graph_io_container_size(writer),
+            temp_arena
+        );
+        if (map_res.error == 0) {
+            graph_io_container_write(writer, map_res.payload.bytes);
+            graph_io_map_close(&map_res.payload);
+        }
+
+        // the metadata section refers to this stack frame
+        writer->entries.len -= 1;
+        if (map_res.error != 0) {
+            return map_res.error;
+        }
+
+        char *cpath = graph_io_map_cstr(path, &temp_arena);
+        char *tmp_cpath = graph_io_map_cstr(tmp_path, &temp_arena);
+        if (rename(tmp_cpath, cpath) != 0) {
+            remove(tmp_cpath);
+            return GRAPH_IO_CACHE_ERROR_RENAME;
+        }
+
+        return GRAPH_IO_CACHE_ERROR_NONE;
+    }
+
+#endif // GRAPH_IO_CACHE_H
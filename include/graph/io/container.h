@@ -0,0 +1,411 @@
+#ifndef GRAPH_IO_CONTAINER_H
+    #define GRAPH_IO_CONTAINER_H
+
+    #include <aven.h>
+    #include <aven/arena.h>
+    #include <aven/io.h>
+
+    #include "../../graph.h"
+    #include "../io.h"
+
+    // Container file holding a graph together with the data computed for
+    // it. A header and a directory of sections are followed by the section
+    // payloads, each aligned so a mapped or in-memory file is read in
+    // place. Readers look up only the sections they need and skip kinds
+    // they do not know, so sections can be added without a version bump.
+
+    #ifdef GRAPH_WIDE_INDEX
+        #define GRAPH_IO_TYPE_CONTAINER ((uint64_t)0xc0a7a1ad7062af64UL)
+    #else
+        #define GRAPH_IO_TYPE_CONTAINER ((uint64_t)0xc0a7a1ad7062af0UL)
+    #endif
+
+    #define GRAPH_IO_CONTAINER_VERSION 1
+    #define GRAPH_IO_CONTAINER_ALIGN ((size_t)64)
+
+    typedef enum {
+        // GraphAdj per vertex, shared by the plain and augmented graphs
+        GRAPH_IO_SECTION_ADJ = 1,
+        // GraphIndex per half-edge
+        GRAPH_IO_SECTION_NB,
+        // GraphAugNb per half-edge, neighbors with their back indices
+        GRAPH_IO_SECTION_AUG_NB,
+        // Vec2 per vertex
+        GRAPH_IO_SECTION_EMBEDDING,
+        // GraphIndex list of the outer face in clockwise order
+        GRAPH_IO_SECTION_OUTER_FACE,
+        // GraphIndex lists of the precolored paths p and q
+        GRAPH_IO_SECTION_PATH_P,
+        GRAPH_IO_SECTION_PATH_Q,
+        // GraphPlaneP3ChooseList per vertex
+        GRAPH_IO_SECTION_COLOR_LISTS,
+        // uint8_t color per vertex
+        GRAPH_IO_SECTION_COLORING,
+        // GraphIoCacheMeta of an input cache entry, see graph/io/cache.h
+        GRAPH_IO_SECTION_CACHE,
+    } GraphIoSectionKind;
+
+    #define GRAPH_IO_SECTION_FLAG_CHECKSUM ((uint32_t)1)
+
+    typedef struct {
+        uint64_t type;
+        uint32_t version;
+        uint32_t len;
+    } GraphIoContainerHeader;
+
+    typedef struct {
+        uint32_t kind;
+        uint32_t flags;
+        // byte offset from the start of the file
+        uint64_t offset;
+        // element count and size in bytes
+        uint64_t len;
+        uint64_t elem_size;
+        // FNV-1a of the payload when GRAPH_IO_SECTION_FLAG_CHECKSUM is set
+        uint64_t checksum;
+    } GraphIoSection;
+    typedef Slice(GraphIoSection) GraphIoSectionSlice;
+
+    static inline uint64_t graph_io_checksum(ByteSlice bytes) {
+        uint64_t hash = 0xcbf29ce484222325UL;
+        for (size_t i = 0; i < bytes.len; i += 1) {
+            hash ^= get(bytes, i);
+            hash *= 0x100000001b3UL;
+        }
+        return hash;
+    }
+
+    static inline size_t graph_io_container_align(size_t size) {
+        return (size + GRAPH_IO_CONTAINER_ALIGN - 1) &
+            ~(GRAPH_IO_CONTAINER_ALIGN - 1);
+    }
+
+    typedef struct {
+        GraphIoSection section;
+        const void *data;
+    } GraphIoContainerEntry;
+
+    typedef struct {
+        List(GraphIoContainerEntry) entries;
+        bool checksum;
+    } GraphIoContainerWriter;
+
+    // Collects sections by reference, the data must stay alive until
+    // graph_io_container_write
+    static inline GraphIoContainerWriter graph_io_container_writer_init(
+        size_t max_sections,
+        bool checksum,
+        AvenArena *arena
+    ) {
+        GraphIoContainerWriter writer = { .checksum = checksum };
+        writer.entries.ptr = aven_arena_create_array(
+            GraphIoContainerEntry,
+            arena,
+            max_sections
+        );
+        writer.entries.cap = max_sections;
+        return writer;
+    }
+
+    static inline bool graph_io_container_writer_has(
+        GraphIoContainerWriter *writer,
+        uint32_t kind
+    ) {
+        for (size_t i = 0; i < writer->entries.len; i += 1) {
+            if (get(writer->entries, i).section.kind == kind) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    static inline void graph_io_container_writer_add_bytes(
+        GraphIoContainerWriter *writer,
+        uint32_t kind,
+        const void *data,
+        size_t len,
+        size_t elem_size
+    ) {
+        assert(!graph_io_container_writer_has(writer, kind));
+        list_push(writer->entries) = (GraphIoContainerEntry){
+            .section = {
+                .kind = kind,
+                .len = len,
+                .elem_size = elem_size,
+            },
+            .data = data,
+        };
+    }
+
+    #define graph_io_container_writer_add(writer, kind, s) \
+        graph_io_container_writer_add_bytes( \
+            writer, \
+            kind, \
+            (s).ptr, \
+            (s).len, \
+            sizeof(*(s).ptr) \
+        )
+
+    static inline void graph_io_container_writer_add_graph(
+        GraphIoContainerWriter *writer,
+        Graph graph
+    ) {
+        graph_io_container_writer_add(writer, GRAPH_IO_SECTION_ADJ, graph.adj);
+        graph_io_container_writer_add(writer, GRAPH_IO_SECTION_NB, graph.nb);
+    }
+
+    // The adjacency section is shared, so a graph and its augmentation can
+    // be stored together
+    static inline void graph_io_container_writer_add_aug(
+        GraphIoContainerWriter *writer,
+        GraphAug graph
+    ) {
+        if (!graph_io_container_writer_has(writer, GRAPH_IO_SECTION_ADJ)) {
+            graph_io_container_writer_add(
+                writer,
+                GRAPH_IO_SECTION_ADJ,
+                graph.adj
+            );
+        }
+        graph_io_container_writer_add(
+            writer,
+            GRAPH_IO_SECTION_AUG_NB,
+            graph.nb
+        );
+    }
+
+    // Lay out the sections and return the size of the file
+    static inline size_t graph_io_container_size(
+        GraphIoContainerWriter *writer
+    ) {
+        size_t offset = graph_io_container_align(
+            sizeof(GraphIoContainerHeader) +
+                writer->entries.len * sizeof(GraphIoSection)
+        );
+        size_t size = offset;
+        for (size_t i = 0; i < writer->entries.len; i += 1) {
+            GraphIoSection *section = &get(writer->entries, i).section;
+            section->offset = offset;
+            size = offset + section->len * section->elem_size;
+            offset = graph_io_container_align(size);
+        }
+        return size;
+    }
+
+    // bytes must hold graph_io_container_size bytes and be aligned like
+    // the header, e.g. a fresh file mapping
+    static inline void graph_io_container_write(
+        GraphIoContainerWriter *writer,
+        ByteSlice bytes
+    ) {
+        size_t size = graph_io_container_size(writer);
+        assert(((uintptr_t)bytes.ptr % sizeof(uint64_t)) == 0);
+        assert(bytes.len >= size);
+
+        for (size_t i = 0; i < size; i += 1) {
+            get(bytes, i) = 0;
+        }
+
+        *(GraphIoContainerHeader *)bytes.ptr = (GraphIoContainerHeader){
+            .type = GRAPH_IO_TYPE_CONTAINER,
+            .version = GRAPH_IO_CONTAINER_VERSION,
+            .len = (uint32_t)writer->entries.len,
+        };
+        GraphIoSection *directory = (GraphIoSection *)&get(
+            bytes,
+            sizeof(GraphIoContainerHeader)
+        );
+
+        for (size_t i = 0; i < writer->entries.len; i += 1) {
+            GraphIoContainerEntry *entry = &get(writer->entries, i);
+            ByteSlice payload = {
+                .ptr = &get(bytes, entry->section.offset),
+                .len = entry->section.len * entry->section.elem_size,
+            };
+            const unsigned char *data = entry->data;
+            for (size_t j = 0; j < payload.len; j += 1) {
+                get(payload, j) = data[j];
+            }
+
+            if (writer->checksum) {
+                entry->section.flags |= GRAPH_IO_SECTION_FLAG_CHECKSUM;
+                entry->section.checksum = graph_io_checksum(payload);
+            }
+            directory[i] = entry->section;
+        }
+    }
+
+    typedef struct {
+        ByteSlice bytes;
+        GraphIoSectionSlice sections;
+    } GraphIoContainer;
+
+    typedef Result(GraphIoContainer, int) GraphIoContainerResult;
+    typedef Result(ByteSlice, int) GraphIoSectionResult;
+
+    // Check the header and that every section lies inside the bytes, the
+    // payloads are only read when a section is verified
+    static inline GraphIoContainerResult graph_io_container_open(
+        ByteSlice bytes
+    ) {
+        if (
+            ((uintptr_t)bytes.ptr % sizeof(uint64_t)) != 0 or
+            bytes.len < sizeof(GraphIoContainerHeader)
+        ) {
+            return (GraphIoContainerResult){ .error = AVEN_IO_ERROR_MISMATCH };
+        }
+
+        GraphIoContainerHeader header =
+            *(GraphIoContainerHeader *)bytes.ptr;
+        if (
+            header.type != GRAPH_IO_TYPE_CONTAINER or
+            header.version == 0 or
+            header.version > GRAPH_IO_CONTAINER_VERSION or
+            header.len >
+                (bytes.len - sizeof(GraphIoContainerHeader)) /
+                    sizeof(GraphIoSection)
+        ) {
+            return (GraphIoContainerResult){ .error = AVEN_IO_ERROR_MISMATCH };
+        }
+
+        GraphIoContainer container = {
+            .bytes = bytes,
+            .sections = {
+                .ptr = (GraphIoSection *)&get(
+                    bytes,
+                    sizeof(GraphIoContainerHeader)
+                ),
+                .len = header.len,
+            },
+        };
+
+        size_t payload_start = sizeof(GraphIoContainerHeader) +
+            container.sections.len * sizeof(GraphIoSection);
+        for (size_t i = 0; i < container.sections.len; i += 1) {
+            GraphIoSection section = get(container.sections, i);
+            if (
+                section.elem_size == 0 or
+                (section.offset % GRAPH_IO_CONTAINER_ALIGN) != 0 or
+                section.offset < payload_start or
+                section.offset > bytes.len or
+                section.len >
+                    (bytes.len - section.offset) / section.elem_size
+            ) {
+                return (GraphIoContainerResult){
+                    .error = AVEN_IO_ERROR_MISMATCH,
+                };
+            }
+        }
+
+        return (GraphIoContainerResult){ .payload = container };
+    }
+
+    // The first section of the given kind, NULL if there is none
+    static inline GraphIoSection *graph_io_container_find(
+        GraphIoContainer container,
+        uint32_t kind
+    ) {
+        for (size_t i = 0; i < container.sections.len; i += 1) {
+            if (get(container.sections, i).kind == kind) {
+                return &get(container.sections, i);
+            }
+        }
+        return NULL;
+    }
+
+    static inline GraphIoSectionResult graph_io_container_bytes(
+        GraphIoContainer container,
+        uint32_t kind,
+        size_t elem_size
+    ) {
+        GraphIoSection *section = graph_io_container_find(container, kind);
+        if (section == NULL or section->elem_size != elem_size) {
+            return (GraphIoSectionResult){ .error = AVEN_IO_ERROR_MISMATCH };
+        }
+
+        return (GraphIoSectionResult){
+            .payload = {
+                .ptr = &get(container.bytes, section->offset),
+                .len = (size_t)(section->len * section->elem_size),
+            },
+        };
+    }
+
+    // Use with aven_io_slice to view a section as a slice of type t
+    #define graph_io_container_section(t, container, kind) \
+        graph_io_container_bytes(container, kind, sizeof(t))
+
+    // False if the section is missing or fails its checksum, sections
+    // written without checksums always pass
+    static inline bool graph_io_container_verify(
+        GraphIoContainer container,
+        uint32_t kind
+    ) {
+        GraphIoSection *section = graph_io_container_find(container, kind);
+        if (section == NULL) {
+            return false;
+        }
+        if ((section->flags & GRAPH_IO_SECTION_FLAG_CHECKSUM) == 0) {
+            return true;
+        }
+
+        ByteSlice payload = {
+            .ptr = &get(container.bytes, section->offset),
+            .len = (size_t)(section->len * section->elem_size),
+        };
+        return graph_io_checksum(payload) == section->checksum;
+    }
+
+    static inline GraphIoResult graph_io_container_graph(
+        GraphIoContainer container
+    ) {
+        GraphIoSectionResult adj_res = graph_io_container_section(
+            GraphAdj,
+            container,
+            GRAPH_IO_SECTION_ADJ
+        );
+        if (adj_res.error != 0) {
+            return (GraphIoResult){ .error = adj_res.error };
+        }
+        GraphAdjSlice adj = aven_io_slice(GraphAdj, adj_res.payload);
+
+        GraphIoSectionResult nb_res = graph_io_container_section(
+            GraphIndex,
+            container,
+            GRAPH_IO_SECTION_NB
+        );
+        if (nb_res.error != 0) {
+            return (GraphIoResult){ .error = nb_res.error };
+        }
+        GraphNbSlice nb = aven_io_slice(GraphIndex, nb_res.payload);
+
+        return (GraphIoResult){ .payload = { .adj = adj, .nb = nb } };
+    }
+
+    static inline GraphIoAugResult graph_io_container_aug(
+        GraphIoContainer container
+    ) {
+        GraphIoSectionResult adj_res = graph_io_container_section(
+            GraphAdj,
+            container,
+            GRAPH_IO_SECTION_ADJ
+        );
+        if (adj_res.error != 0) {
+            return (GraphIoAugResult){ .error = adj_res.error };
+        }
+        GraphAdjSlice adj = aven_io_slice(GraphAdj, adj_res.payload);
+
+        GraphIoSectionResult nb_res = graph_io_container_section(
+            GraphAugNb,
+            container,
+            GRAPH_IO_SECTION_AUG_NB
+        );
+        if (nb_res.error != 0) {
+            return (GraphIoAugResult){ .error = nb_res.error };
+        }
+        GraphAugNbSlice nb = aven_io_slice(GraphAugNb, nb_res.payload);
+
+        return (GraphIoAugResult){ .payload = { .adj = adj, .nb = nb } };
+    }
+
+#endif // GRAPH_IO_CONTAINER_H
@@ -0,0 +1,565 @@
+#ifndef GRAPH_IO_IMPORT_H
+    #define GRAPH_IO_IMPORT_H
+
+    #include <aven.h>
+    #include <aven/arena.h>
+    #include <aven/io.h>
+    #include <aven/str.h>
+
+    #include "../../graph.h"
+    #include "../io.h"
+
+    // Importers for graphs stored by other tools:
+    //   - edge lists, one "u v" pair of 0-based vertices per line with any
+    //     further fields ignored and lines starting with '#' or '%' skipped;
+    //   - DIMACS, a "p edge n m" line followed by "e u v" lines of 1-based
+    //     vertices, with 'c' comment lines;
+    //   - plantri planar code, which keeps the clockwise rotations.
+    // Each line of an edge list or DIMACS file is one undirected edge,
+    // repeated edges and loops are kept as they are. Rotations list the
+    // edges in file order. Parse errors return AVEN_IO_ERROR_MISMATCH.
+
+    typedef struct {
+        GraphIndex u;
+        GraphIndex v;
+    } GraphIoEdge;
+    typedef Slice(GraphIoEdge) GraphIoEdgeSlice;
+
+    typedef enum {
+        GRAPH_IO_IMPORT_FORMAT_EDGE_LIST,
+        GRAPH_IO_IMPORT_FORMAT_DIMACS,
+    } GraphIoImportFormat;
+
+    typedef enum {
+        GRAPH_IO_IMPORT_LINE_NONE,
+        GRAPH_IO_IMPORT_LINE_EDGE,
+        GRAPH_IO_IMPORT_LINE_ERROR,
+    } GraphIoImportLine;
+
+    static inline bool graph_io_import_is_space(unsigned char c) {
+        return c == ' ' or c == '\t' or c == '\r';
+    }
+
+    static inline void graph_io_import_skip_space(
+        ByteSlice text,
+        size_t *pos
+    ) {
+        while (*pos < text.len and graph_io_import_is_space(get(text, *pos))) {
+            *pos += 1;
+        }
+    }
+
+    // Parse a decimal vertex index below GRAPH_INDEX_MAX
+    static inline bool graph_io_import_parse_index(
+        ByteSlice text,
+        size_t *pos,
+        GraphIndex *value
+    ) {
+        graph_io_import_skip_space(text, pos);
+
+        size_t start = *pos;
+        uint64_t x = 0;
+        while (
+            *pos < text.len and
+            get(text, *pos) >= '0' and
+            get(text, *pos) <= '9'
+        ) {
+            x = 10 * x + (uint64_t)(get(text, *pos) - '0');
+            if (x >= GRAPH_INDEX_MAX) {
+                return false;
+            }
+            *pos += 1;
+        }
+
+        *value = (GraphIndex)x;
+        return *pos != start;
+    }
+
+    static inline void graph_io_import_skip_line(ByteSlice text, size_t *pos) {
+        while (*pos < text.len and get(text, *pos) != '\n') {
+            *pos += 1;
+        }
+        if (*pos < text.len) {
+            *pos += 1;
+        }
+    }
+
+    // Parse the line at *pos and move past it, DIMACS 'p' lines are skipped
+    // here and read by graph_io_import_dimacs_header
+    static inline GraphIoImportLine graph_io_import_line(
+        ByteSlice text,
+        size_t *pos,
+        GraphIoImportFormat format,
+        GraphIoEdge *edge
+    ) {
+        graph_io_import_skip_space(text, pos);
+        if (*pos == text.len or get(text, *pos) == '\n') {
+            graph_io_import_skip_line(text, pos);
+            return GRAPH_IO_IMPORT_LINE_NONE;
+        }
+
+        unsigned char c = get(text, *pos);
+        GraphIndex offset = 0;
+        if (format == GRAPH_IO_IMPORT_FORMAT_DIMACS) {
+            if (c != 'e') {
+                graph_io_import_skip_line(text, pos);
+                return GRAPH_IO_IMPORT_LINE_NONE;
+            }
+            *pos += 1;
+            offset = 1;
+        } else if (c == '#' or c == '%') {
+            graph_io_import_skip_line(text, pos);
+            return GRAPH_IO_IMPORT_LINE_NONE;
+        }
+
+        bool valid = graph_io_import_parse_index(text, pos, &edge->u) and
+            graph_io_import_parse_index(text, pos, &edge->v) and
+            edge->u >= offset and
+            edge->v >= offset;
+        if (valid and *pos < text.len) {
+            unsigned char end = get(text, *pos);
+            valid = end == '\n' or graph_io_import_is_space(end);
+        }
+        graph_io_import_skip_line(text, pos);
+        if (!valid) {
+            return GRAPH_IO_IMPORT_LINE_ERROR;
+        }
+
+        edge->u -= offset;
+        edge->v -= offset;
+        return GRAPH_IO_IMPORT_LINE_EDGE;
+    }
+
+    typedef struct {
+        GraphIndex len;
+        // start of the edge lines
+        size_t pos;
+    } GraphIoDimacsHeader;
+
+    typedef Result(GraphIoDimacsHeader, int) GraphIoDimacsHeaderResult;
+
+    static inline GraphIoDimacsHeaderResult graph_io_import_dimacs_header(
+        ByteSlice text
+    ) {
+        size_t pos = 0;
+        while (pos < text.len) {
+            graph_io_import_skip_space(text, &pos);
+            if (pos == text.len) {
+                break;
+            }
+
+            unsigned char c = get(text, pos);
+            if (c == 'c' or c == '\n') {
+                graph_io_import_skip_line(text, &pos);
+                continue;
+            }
+            if (c != 'p') {
+                break;
+            }
+
+            pos += 1;
+            graph_io_import_skip_space(text, &pos);
+            while (
+                pos < text.len and
+                get(text, pos) >= 'a' and
+                get(text, pos) <= 'z'
+            ) {
+                pos += 1;
+            }
+
+            GraphIndex len;
+            GraphIndex edges;
+            if (
+                !graph_io_import_parse_index(text, &pos, &len) or
+                !graph_io_import_parse_index(text, &pos, &edges)
+            ) {
+                break;
+            }
+            graph_io_import_skip_line(text, &pos);
+
+            return (GraphIoDimacsHeaderResult){
+                .payload = { .len = len, .pos = pos },
+            };
+        }
+
+        return (GraphIoDimacsHeaderResult){
+            .error = AVEN_IO_ERROR_MISMATCH,
+        };
+    }
+
+    static inline Graph graph_io_import_alloc(
+        size_t nvertices,
+        size_t nedges,
+        AvenArena *arena
+    ) {
+        Graph graph = {
+            .adj = { .len = nvertices },
+            .nb = { .len = 2 * nedges },
+        };
+        graph.adj.ptr = aven_arena_create_array(
+            GraphAdj,
+            arena,
+            graph.adj.len
+        );
+        graph.nb.ptr = aven_arena_create_array(
+            GraphIndex,
+            arena,
+            graph.nb.len
+        );
+        return graph;
+    }
+
+    // Counting sort of the edges into the allocated graph, the lengths
+    // count the degrees and are then reused as insertion cursors
+    static inline void graph_io_import_csr_fill(
+        Graph graph,
+        GraphIoEdgeSlice edges
+    ) {
+        assert(graph.nb.len == 2 * edges.len);
+
+        for (GraphIndex v = 0; v < graph.adj.len; v += 1) {
+            get(graph.adj, v) = (GraphAdj){ 0 };
+        }
+        for (size_t i = 0; i < edges.len; i += 1) {
+            GraphIoEdge edge = get(edges, i);
+            get(graph.adj, edge.u).len += 1;
+            get(graph.adj, edge.v).len += 1;
+        }
+
+        GraphIndex index = 0;
+        for (GraphIndex v = 0; v < graph.adj.len; v += 1) {
+            GraphAdj *v_adj = &get(graph.adj, v);
+            v_adj->index = index;
+            index += v_adj->len;
+            v_adj->len = 0;
+        }
+
+        for (size_t i = 0; i < edges.len; i += 1) {
+            GraphIoEdge edge = get(edges, i);
+            GraphAdj *u_adj = &get(graph.adj, edge.u);
+            GraphAdj *v_adj = &get(graph.adj, edge.v);
+            get(graph.nb, u_adj->index + u_adj->len) = edge.v;
+            u_adj->len += 1;
+            get(graph.nb, v_adj->index + v_adj->len) = edge.u;
+            v_adj->len += 1;
+        }
+    }
+
+    static inline Graph graph_io_import_csr(
+        size_t nvertices,
+        GraphIoEdgeSlice edges,
+        AvenArena *arena
+    ) {
+        Graph graph = graph_io_import_alloc(nvertices, edges.len, arena);
+        graph_io_import_csr_fill(graph, edges);
+        return graph;
+    }
+
+    // A first pass counts the edges and vertices so the graph is allocated
+    // before the edges are parsed into scratch space behind it
+    static inline GraphIoResult graph_io_import_text(
+        ByteSlice text,
+        size_t start,
+        GraphIoImportFormat format,
+        GraphIndex nvertices,
+        AvenArena *arena
+    ) {
+        size_t nedges = 0;
+        GraphIndex max_vertex = 0;
+        for (size_t pos = start; pos < text.len;) {
+            GraphIoEdge edge;
+            switch (graph_io_import_line(text, &pos, format, &edge)) {
+                case GRAPH_IO_IMPORT_LINE_EDGE:
+                    nedges += 1;
+                    max_vertex = max(max_vertex, max(edge.u, edge.v));
+                    break;
+                case GRAPH_IO_IMPORT_LINE_ERROR:
+                    return (GraphIoResult){ .error = AVEN_IO_ERROR_MISMATCH };
+                case GRAPH_IO_IMPORT_LINE_NONE:
+                    break;
+            }
+        }
+
+        if (format == GRAPH_IO_IMPORT_FORMAT_EDGE_LIST and nedges > 0) {
+            nvertices = max_vertex + 1;
+        }
+        if (
+            (nedges > 0 and max_vertex >= nvertices) or
+            nedges > GRAPH_INDEX_MAX / 2
+        ) {
+            return (GraphIoResult){ .error = AVEN_IO_ERROR_MISMATCH };
+        }
+
+        Graph graph = graph_io_import_alloc(nvertices, nedges, arena);
+
+        AvenArena temp_arena = *arena;
+        GraphIoEdgeSlice edges = aven_arena_create_slice(
+            GraphIoEdge,
+            &temp_arena,
+            nedges
+        );
+
+        size_t i = 0;
+        for (size_t pos = start; pos < text.len;) {
+            GraphIoEdge edge;
+            GraphIoImportLine line = graph_io_import_line(
+                text,
+                &pos,
+                format,
+                &edge
+            );
+            if (line == GRAPH_IO_IMPORT_LINE_EDGE) {
+                get(edges, i) = edge;
+                i += 1;
+            }
+        }
+
+        graph_io_import_csr_fill(graph, edges);
+
+        return (GraphIoResult){ .payload = graph };
+    }
+
+    static inline GraphIoResult graph_io_import_edge_list(
+        ByteSlice text,
+        AvenArena *arena
+    ) {
+        return graph_io_import_text(
+            text,
+            0,
+            GRAPH_IO_IMPORT_FORMAT_EDGE_LIST,
+            0,
+            arena
+        );
+    }
+
+    static inline GraphIoResult graph_io_import_dimacs(
+        ByteSlice text,
+        AvenArena *arena
+    ) {
+        GraphIoDimacsHeaderResult header_res =
+            graph_io_import_dimacs_header(text);
+        if (header_res.error != 0) {
+            return (GraphIoResult){ .error = header_res.error };
+        }
+
+        return graph_io_import_text(
+            text,
+            header_res.payload.pos,
+            GRAPH_IO_IMPORT_FORMAT_DIMACS,
+            header_res.payload.len,
+            arena
+        );
+    }
+
+    // Plantri planar code: an optional ">>planar_code<<" header, then per
+    // graph the vertex count and each clockwise rotation of 1-based
+    // neighbors ended by 0. A count of 0 switches the graph to 16-bit
+    // entries, the count following as one, which are little endian unless
+    // the header reads ">>planar_code be<<".
+
+    typedef struct {
+        ByteSlice bytes;
+        size_t pos;
+        bool big_endian;
+    } GraphIoPlanarCodeReader;
+
+    static inline bool graph_io_planar_code_match(
+        ByteSlice bytes,
+        AvenStr prefix
+    ) {
+        if (bytes.len < prefix.len) {
+            return false;
+        }
+        for (size_t i = 0; i < prefix.len; i += 1) {
+            if (get(bytes, i) != (unsigned char)get(prefix, i)) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    static inline GraphIoPlanarCodeReader graph_io_planar_code_init(
+        ByteSlice bytes
+    ) {
+        GraphIoPlanarCodeReader reader = { .bytes = bytes };
+
+        AvenStr headers[] = {
+            aven_str(">>planar_code<<"),
+            aven_str(">>planar_code le<<"),
+            aven_str(">>planar_code be<<"),
+        };
+        for (size_t i = 0; i < countof(headers); i += 1) {
+            if (graph_io_planar_code_match(bytes, headers[i])) {
+                reader.pos = headers[i].len;
+                reader.big_endian = i == 2;
+                break;
+            }
+        }
+
+        return reader;
+    }
+
+    static inline bool graph_io_planar_code_done(
+        GraphIoPlanarCodeReader *reader
+    ) {
+        return reader->pos >= reader->bytes.len;
+    }
+
+    typedef struct {
+        GraphIndex len;
+        size_t entry_size;
+        bool big_endian;
+        // first entry of the rotations and number of entries
+        size_t start;
+        size_t nentries;
+        size_t nb_len;
+    } GraphIoPlanarCodeRecord;
+
+    typedef Result(GraphIoPlanarCodeRecord, int) GraphIoPlanarCodeRecordResult;
+
+    static inline GraphIndex graph_io_planar_code_entry(
+        ByteSlice bytes,
+        GraphIoPlanarCodeRecord record,
+        size_t pos
+    ) {
+        if (record.entry_size == 1) {
+            return get(bytes, pos);
+        }
+        GraphIndex lo = get(bytes, pos);
+        GraphIndex hi = get(bytes, pos + 1);
+        if (record.big_endian) {
+            GraphIndex tmp = lo;
+            lo = hi;
+            hi = tmp;
+        }
+        return lo | (hi << 8);
+    }
+
+    // Read the vertex count and entry size of the next graph
+    static inline GraphIoPlanarCodeRecordResult graph_io_planar_code_header(
+        GraphIoPlanarCodeReader *reader
+    ) {
+        ByteSlice bytes = reader->bytes;
+        size_t pos = reader->pos;
+        if (pos >= bytes.len) {
+            return (GraphIoPlanarCodeRecordResult){
+                .error = AVEN_IO_ERROR_MISMATCH,
+            };
+        }
+
+        GraphIoPlanarCodeRecord record = {
+            .len = get(bytes, pos),
+            .entry_size = 1,
+            .big_endian = reader->big_endian,
+        };
+        pos += 1;
+        if (record.len == 0) {
+            if (bytes.len - pos < 2) {
+                return (GraphIoPlanarCodeRecordResult){
+                    .error = AVEN_IO_ERROR_MISMATCH,
+                };
+            }
+            record.entry_size = 2;
+            record.len = graph_io_planar_code_entry(bytes, record, pos);
+            pos += 2;
+        }
+        record.start = pos;
+
+        return (GraphIoPlanarCodeRecordResult){ .payload = record };
+    }
+
+    // Find the extent of the next graph by counting terminators
+    static inline GraphIoPlanarCodeRecordResult graph_io_planar_code_record(
+        GraphIoPlanarCodeReader *reader
+    ) {
+        GraphIoPlanarCodeRecordResult header_res = graph_io_planar_code_header(
+            reader
+        );
+        if (header_res.error != 0) {
+            return header_res;
+        }
+        GraphIoPlanarCodeRecord record = header_res.payload;
+
+        ByteSlice bytes = reader->bytes;
+        size_t pos = record.start;
+        GraphIndex nzeros = 0;
+        while (nzeros < record.len) {
+            if (bytes.len - pos < record.entry_size) {
+                return (GraphIoPlanarCodeRecordResult){
+                    .error = AVEN_IO_ERROR_MISMATCH,
+                };
+            }
+            if (graph_io_planar_code_entry(bytes, record, pos) == 0) {
+                nzeros += 1;
+            }
+            pos += record.entry_size;
+        }
+
+        record.nentries = (pos - record.start) / record.entry_size;
+        record.nb_len = record.nentries - record.len;
+        if (record.nb_len > GRAPH_INDEX_MAX) {
+            return (GraphIoPlanarCodeRecordResult){
+                .error = AVEN_IO_ERROR_MISMATCH,
+            };
+        }
+
+        reader->pos = pos;
+        return (GraphIoPlanarCodeRecordResult){ .payload = record };
+    }
+
+    static inline GraphIoResult graph_io_planar_code_pop(
+        GraphIoPlanarCodeReader *reader,
+        AvenArena *arena
+    ) {
+        GraphIoPlanarCodeRecordResult record_res = graph_io_planar_code_record(
+            reader
+        );
+        if (record_res.error != 0) {
+            return (GraphIoResult){ .error = record_res.error };
+        }
+        GraphIoPlanarCodeRecord record = record_res.payload;
+
+        Graph graph = {
+            .adj = { .len = record.len },
+            .nb = { .len = record.nb_len },
+        };
+        graph.adj.ptr = aven_arena_create_array(
+            GraphAdj,
+            arena,
+            graph.adj.len
+        );
+        graph.nb.ptr = aven_arena_create_array(
+            GraphIndex,
+            arena,
+            graph.nb.len
+        );
+
+        GraphIndex v = 0;
+        GraphIndex index = 0;
+        if (graph.adj.len > 0) {
+            get(graph.adj, 0) = (GraphAdj){ 0 };
+        }
+        for (size_t i = 0; i < record.nentries; i += 1) {
+            GraphIndex u = graph_io_planar_code_entry(
+                reader->bytes,
+                record,
+                record.start + i * record.entry_size
+            );
+            if (u == 0) {
+                v += 1;
+                if (v < graph.adj.len) {
+                    get(graph.adj, v) = (GraphAdj){ .index = index };
+                }
+            } else if (u > graph.adj.len) {
+                return (GraphIoResult){ .error = AVEN_IO_ERROR_MISMATCH };
+            } else {
+                get(graph.nb, index) = u - 1;
+                get(graph.adj, v).len += 1;
+                index += 1;
+            }
+        }
+
+        return (GraphIoResult){ .payload = graph };
+    }
+
+#endif // GRAPH_IO_IMPORT_H
@@ -0,0 +1,716 @@
+#ifndef GRAPH_IO_IMPORT_THREAD_H
+    #define GRAPH_IO_IMPORT_THREAD_H
+
+    #include <aven.h>
+    #include <aven/arena.h>
+    #include <aven/io.h>
+    #include <aven/thread/pool.h>
+
+    #if !defined(__STDC_VERSION__) or __STDC_VERSION__ < 201112L
+        #error "C11 or later is required"
+    #endif
+
+    #include <stdatomic.h>
+
+    #include "../../../graph.h"
+    #include "../../io.h"
+    #include "../../thread.h"
+    #include "../import.h"
+    #include "../thread.h"
+
+    // Multi-threaded importers producing the same graphs as the sequential
+    // ones. Text is split into one range of whole lines per thread. A first
+    // pass parses it to size the graph, then a counting sort builds the
+    // rotations in phases separated by waiting on the pool:
+    //   1. each thread counts the edge lines in its range and clears the
+    //      degree counters of its range of vertices;
+    //   2. each thread parses its edges into its own part of the edge list
+    //      and counts degrees by atomic adds;
+    //   3. the degrees are summed over each range of vertices;
+    //   4. the sums become rotation indices and insertion cursors;
+    //   5. each thread scatters 2 * i and 2 * i + 1 for its edges i into
+    //      the rotations of their ends through the cursors;
+    //   6. each rotation is sorted, putting its edges in file order, and
+    //      2 * i + side becomes the other end of edge i.
+    // Planar code is split into ranges of entries, counting terminators
+    // gives the vertex each range starts in and entry p of vertex v lands
+    // at half-edge p - v.
+
+    #ifndef GRAPH_IO_IMPORT_THREAD_MIN_ENTRIES
+        #define GRAPH_IO_IMPORT_THREAD_MIN_ENTRIES ((size_t)1 << 16)
+    #endif
+
+    typedef struct {
+        ByteSlice text;
+        GraphIoImportFormat format;
+        size_t start;
+        size_t end;
+        size_t nedges;
+        GraphIndex max_vertex;
+        bool error;
+        GraphIoEdgeSlice edges;
+        size_t edge_offset;
+        Graph graph;
+        GraphThreadAtomicIndexSlice cursors;
+        GraphNbSlice scratch;
+        GraphIndex start_vertex;
+        GraphIndex end_vertex;
+        GraphIndex range_len;
+        GraphIndex range_index;
+    } GraphIoImportThreadWorker;
+    typedef Slice(GraphIoImportThreadWorker) GraphIoImportThreadWorkerSlice;
+
+    // Split the text after start into one range of whole lines per worker
+    static inline void graph_io_import_thread_split(
+        GraphIoImportThreadWorkerSlice workers,
+        ByteSlice text,
+        size_t start,
+        GraphIoImportFormat format
+    ) {
+        size_t text_chunk = (text.len - start) / workers.len;
+        size_t prev_end = start;
+        for (uint32_t i = 0; i < workers.len; i += 1) {
+            size_t end = text.len;
+            if (i + 1 < workers.len) {
+                end = max(prev_end, start + (i + 1) * text_chunk);
+                graph_io_import_skip_line(text, &end);
+            }
+
+            get(workers, i) = (GraphIoImportThreadWorker){
+                .text = text,
+                .format = format,
+                .start = prev_end,
+                .end = end,
+            };
+            prev_end = end;
+        }
+    }
+
+    static void graph_io_import_thread_parse_count_worker(void *args) {
+        GraphIoImportThreadWorker *worker = args;
+
+        for (size_t pos = worker->start; pos < worker->end;) {
+            GraphIoEdge edge;
+            GraphIoImportLine line = graph_io_import_line(
+                worker->text,
+                &pos,
+                worker->format,
+                &edge
+            );
+            if (line == GRAPH_IO_IMPORT_LINE_ERROR) {
+                worker->error = true;
+                return;
+            }
+            if (line == GRAPH_IO_IMPORT_LINE_EDGE) {
+                worker->nedges += 1;
+                worker->max_vertex = max(
+                    worker->max_vertex,
+                    max(edge.u, edge.v)
+                );
+            }
+        }
+    }
+
+    // The text has already parsed without errors, so the edge lines are
+    // told apart from the rest by their first character alone
+    static void graph_io_import_thread_count_worker(void *args) {
+        GraphIoImportThreadWorker *worker = args;
+        ByteSlice text = worker->text;
+
+        for (
+            GraphIndex v = worker->start_vertex;
+            v != worker->end_vertex;
+            v += 1
+        ) {
+            atomic_store_explicit(
+                &get(worker->cursors, v),
+                0,
+                memory_order_relaxed
+            );
+        }
+
+        size_t nedges = 0;
+        for (size_t pos = worker->start; pos < worker->end;) {
+            graph_io_import_skip_space(text, &pos);
+            if (pos < text.len) {
+                unsigned char c = get(text, pos);
+                if (worker->format == GRAPH_IO_IMPORT_FORMAT_DIMACS) {
+                    if (c == 'e') {
+                        nedges += 1;
+                    }
+                } else if (c != '\n' and c != '#' and c != '%') {
+                    nedges += 1;
+                }
+            }
+            graph_io_import_skip_line(text, &pos);
+        }
+        worker->nedges = nedges;
+    }
+
+    static void graph_io_import_thread_parse_worker(void *args) {
+        GraphIoImportThreadWorker *worker = args;
+
+        size_t i = worker->edge_offset;
+        for (size_t pos = worker->start; pos < worker->end;) {
+            GraphIoEdge edge;
+            GraphIoImportLine line = graph_io_import_line(
+                worker->text,
+                &pos,
+                worker->format,
+                &edge
+            );
+            if (line == GRAPH_IO_IMPORT_LINE_EDGE) {
+                get(worker->edges, i) = edge;
+                atomic_fetch_add_explicit(
+                    &get(worker->cursors, edge.u),
+                    1,
+                    memory_order_relaxed
+                );
+                atomic_fetch_add_explicit(
+                    &get(worker->cursors, edge.v),
+                    1,
+                    memory_order_relaxed
+                );
+                i += 1;
+            }
+        }
+    }
+
+    static void graph_io_import_thread_sum_worker(void *args) {
+        GraphIoImportThreadWorker *worker = args;
+
+        worker->range_len = 0;
+        for (
+            GraphIndex v = worker->start_vertex;
+            v != worker->end_vertex;
+            v += 1
+        ) {
+            worker->range_len += (GraphIndex)atomic_load_explicit(
+                &get(worker->cursors, v),
+                memory_order_relaxed
+            );
+        }
+    }
+
+    static void graph_io_import_thread_offset_worker(void *args) {
+        GraphIoImportThreadWorker *worker = args;
+
+        GraphIndex index = worker->range_index;
+        for (
+            GraphIndex v = worker->start_vertex;
+            v != worker->end_vertex;
+            v += 1
+        ) {
+            GraphThreadAtomicIndex *cursor = &get(worker->cursors, v);
+            GraphIndex len = (GraphIndex)atomic_load_explicit(
+                cursor,
+                memory_order_relaxed
+            );
+            atomic_store_explicit(cursor, index, memory_order_relaxed);
+            get(worker->graph.adj, v) = (GraphAdj){
+                .index = index,
+                .len = len,
+            };
+            index += len;
+        }
+    }
+
+    static void graph_io_import_thread_scatter_worker(void *args) {
+        GraphIoImportThreadWorker *worker = args;
+        Graph graph = worker->graph;
+
+        for (size_t i = 0; i < worker->nedges; i += 1) {
+            GraphIndex e = (GraphIndex)(worker->edge_offset + i);
+            GraphIoEdge edge = get(worker->edges, e);
+            GraphIndex u_slot = (GraphIndex)atomic_fetch_add_explicit(
+                &get(worker->cursors, edge.u),
+                1,
+                memory_order_relaxed
+            );
+            get(graph.nb, u_slot) = 2 * e;
+            GraphIndex v_slot = (GraphIndex)atomic_fetch_add_explicit(
+                &get(worker->cursors, edge.v),
+                1,
+                memory_order_relaxed
+            );
+            get(graph.nb, v_slot) = 2 * e + 1;
+        }
+    }
+
+    static void graph_io_import_thread_sort_worker(void *args) {
+        GraphIoImportThreadWorker *worker = args;
+        Graph graph = worker->graph;
+
+        for (
+            GraphIndex v = worker->start_vertex;
+            v != worker->end_vertex;
+            v += 1
+        ) {
+            GraphAdj v_adj = get(graph.adj, v);
+            graph_io_thread_sort(
+                graph.nb,
+                worker->scratch,
+                v_adj.index,
+                v_adj.len
+            );
+
+            for (GraphIndex i = 0; i < v_adj.len; i += 1) {
+                GraphIndex *half_edge = &get(graph.nb, v_adj.index + i);
+                GraphIoEdge edge = get(worker->edges, *half_edge / 2);
+                *half_edge = (*half_edge % 2 == 0) ? edge.v : edge.u;
+            }
+        }
+    }
+
+    static inline GraphIoResult graph_io_import_text_thread(
+        ByteSlice text,
+        size_t start,
+        GraphIoImportFormat format,
+        GraphIndex nvertices,
+        AvenThreadPool *thread_pool,
+        size_t nthreads,
+        AvenArena *arena
+    ) {
+        assert(nthreads > 0);
+
+        AvenArena temp_arena = *arena;
+        GraphIoImportThreadWorkerSlice workers = aven_arena_create_slice(
+            GraphIoImportThreadWorker,
+            &temp_arena,
+            nthreads
+        );
+        AvenThreadPoolJobSlice jobs = aven_arena_create_slice(
+            AvenThreadPoolJob,
+            &temp_arena,
+            nthreads - 1
+        );
+
+        graph_io_import_thread_split(workers, text, start, format);
+        graph_thread_run_phase(
+            thread_pool,
+            jobs,
+            workers,
+            graph_io_import_thread_parse_count_worker
+        );
+
+        size_t nedges = 0;
+        GraphIndex max_vertex = 0;
+        for (uint32_t i = 0; i < workers.len; i += 1) {
+            GraphIoImportThreadWorker *worker = &get(workers, i);
+            if (worker->error) {
+                return (GraphIoResult){ .error = AVEN_IO_ERROR_MISMATCH };
+            }
+            nedges += worker->nedges;
+            max_vertex = max(max_vertex, worker->max_vertex);
+        }
+
+        if (format == GRAPH_IO_IMPORT_FORMAT_EDGE_LIST and nedges > 0) {
+            nvertices = max_vertex + 1;
+        }
+        if (
+            (nedges > 0 and max_vertex >= nvertices) or
+            nedges > GRAPH_INDEX_MAX / 2
+        ) {
+            return (GraphIoResult){ .error = AVEN_IO_ERROR_MISMATCH };
+        }
+
+        // the graph takes the place of the first pass, whose per-thread
+        // edge counts are found again by the cheaper count phase
+        Graph graph = graph_io_import_alloc(nvertices, nedges, arena);
+
+        temp_arena = *arena;
+        workers.ptr = aven_arena_create_array(
+            GraphIoImportThreadWorker,
+            &temp_arena,
+            workers.len
+        );
+        jobs.ptr = aven_arena_create_array(
+            AvenThreadPoolJob,
+            &temp_arena,
+            jobs.len
+        );
+        GraphIoEdgeSlice edges = aven_arena_create_slice(
+            GraphIoEdge,
+            &temp_arena,
+            nedges
+        );
+        GraphThreadAtomicIndexSlice cursors = { .len = nvertices };
+        cursors.ptr = aven_arena_create_array(
+            GraphThreadAtomicIndex,
+            &temp_arena,
+            cursors.len
+        );
+        GraphNbSlice scratch = { .len = graph.nb.len };
+        scratch.ptr = aven_arena_create_array(
+            GraphIndex,
+            &temp_arena,
+            scratch.len
+        );
+
+        graph_io_import_thread_split(workers, text, start, format);
+        GraphIndex vertex_chunk = (GraphIndex)(nvertices / workers.len);
+        for (uint32_t i = 0; i < workers.len; i += 1) {
+            GraphIoImportThreadWorker *worker = &get(workers, i);
+            worker->edges = edges;
+            worker->graph = graph;
+            worker->cursors = cursors;
+            worker->scratch = scratch;
+            worker->start_vertex = i * vertex_chunk;
+            worker->end_vertex = (i + 1) * vertex_chunk;
+            if (i + 1 == workers.len) {
+                worker->end_vertex = nvertices;
+            }
+        }
+
+        graph_thread_run_phase(
+            thread_pool,
+            jobs,
+            workers,
+            graph_io_import_thread_count_worker
+        );
+
+        size_t edge_offset = 0;
+        for (uint32_t i = 0; i < workers.len; i += 1) {
+            get(workers, i).edge_offset = edge_offset;
+            edge_offset += get(workers, i).nedges;
+        }
+        assert(edge_offset == nedges);
+
+        graph_thread_run_phase(
+            thread_pool,
+            jobs,
+            workers,
+            graph_io_import_thread_parse_worker
+        );
+        graph_thread_run_phase(
+            thread_pool,
+            jobs,
+            workers,
+            graph_io_import_thread_sum_worker
+        );
+
+        GraphIndex index = 0;
+        for (uint32_t i = 0; i < workers.len; i += 1) {
+            get(workers, i).range_index = index;
+            index += get(workers, i).range_len;
+        }
+
+        void (*phase_fns[])(void *) = {
+            graph_io_import_thread_offset_worker,
+            graph_io_import_thread_scatter_worker,
+            graph_io_import_thread_sort_worker,
+        };
+        for (size_t phase = 0; phase < countof(phase_fns); phase += 1) {
+            graph_thread_run_phase(
+                thread_pool,
+                jobs,
+                workers,
+                phase_fns[phase]
+            );
+        }
+
+        return (GraphIoResult){ .payload = graph };
+    }
+
+    static inline GraphIoResult graph_io_import_edge_list_thread(
+        ByteSlice text,
+        AvenThreadPool *thread_pool,
+        size_t nthreads,
+        AvenArena *arena
+    ) {
+        return graph_io_import_text_thread(
+            text,
+            0,
+            GRAPH_IO_IMPORT_FORMAT_EDGE_LIST,
+            0,
+            thread_pool,
+            nthreads,
+            arena
+        );
+    }
+
+    static inline GraphIoResult graph_io_import_dimacs_thread(
+        ByteSlice text,
+        AvenThreadPool *thread_pool,
+        size_t nthreads,
+        AvenArena *arena
+    ) {
+        GraphIoDimacsHeaderResult header_res = graph_io_import_dimacs_header(
+            text
+        );
+        if (header_res.error != 0) {
+            return (GraphIoResult){ .error = header_res.error };
+        }
+
+        return graph_io_import_text_thread(
+            text,
+            header_res.payload.pos,
+            GRAPH_IO_IMPORT_FORMAT_DIMACS,
+            header_res.payload.len,
+            thread_pool,
+            nthreads,
+            arena
+        );
+    }
+
+    typedef struct {
+        ByteSlice bytes;
+        GraphIoPlanarCodeRecord record;
+        // entry range from the start of the record
+        size_t start_entry;
+        size_t end_entry;
+        GraphIndex nzeros;
+        GraphIndex start_vertex;
+        bool error;
+        Graph graph;
+        GraphPropIndex ends;
+    } GraphIoPlanarCodeThreadWorker;
+    typedef Slice(GraphIoPlanarCodeThreadWorker)
+        GraphIoPlanarCodeThreadWorkerSlice;
+
+    static inline void graph_io_planar_code_thread_split(
+        GraphIoPlanarCodeThreadWorkerSlice workers,
+        size_t start_entry,
+        size_t end_entry
+    ) {
+        size_t chunk = (end_entry - start_entry) / workers.len;
+        for (uint32_t i = 0; i < workers.len; i += 1) {
+            GraphIoPlanarCodeThreadWorker *worker = &get(workers, i);
+            worker->start_entry = start_entry + i * chunk;
+            worker->end_entry = start_entry + (i + 1) * chunk;
+            if (i + 1 == workers.len) {
+                worker->end_entry = end_entry;
+            }
+        }
+    }
+
+    static inline GraphIndex graph_io_planar_code_thread_entry(
+        GraphIoPlanarCodeThreadWorker *worker,
+        size_t entry
+    ) {
+        return graph_io_planar_code_entry(
+            worker->bytes,
+            worker->record,
+            worker->record.start + entry * worker->record.entry_size
+        );
+    }
+
+    static void graph_io_planar_code_thread_count_worker(void *args) {
+        GraphIoPlanarCodeThreadWorker *worker = args;
+
+        GraphIndex nzeros = 0;
+        for (size_t p = worker->start_entry; p < worker->end_entry; p += 1) {
+            if (graph_io_planar_code_thread_entry(worker, p) == 0) {
+                nzeros += 1;
+            }
+        }
+        worker->nzeros = nzeros;
+    }
+
+    static void graph_io_planar_code_thread_fill_worker(void *args) {
+        GraphIoPlanarCodeThreadWorker *worker = args;
+        Graph graph = worker->graph;
+
+        GraphIndex v = worker->start_vertex;
+        for (size_t p = worker->start_entry; p < worker->end_entry; p += 1) {
+            GraphIndex u = graph_io_planar_code_thread_entry(worker, p);
+            if (u == 0) {
+                get(worker->ends, v) = (GraphIndex)(p - v);
+                v += 1;
+            } else if (u > graph.adj.len) {
+                worker->error = true;
+                return;
+            } else {
+                get(graph.nb, p - v) = u - 1;
+            }
+        }
+    }
+
+    static void graph_io_planar_code_thread_adj_worker(void *args) {
+        GraphIoPlanarCodeThreadWorker *worker = args;
+
+        // the vertex ranges reuse the entry ranges of the workers
+        for (size_t v = worker->start_entry; v < worker->end_entry; v += 1) {
+            GraphIndex index = 0;
+            if (v > 0) {
+                index = get(worker->ends, v - 1);
+            }
+            get(worker->graph.adj, v) = (GraphAdj){
+                .index = index,
+                .len = get(worker->ends, v) - index,
+            };
+        }
+    }
+
+    // The end of the graph is found by counting terminators over windows
+    // of doubling size, so a file holding many graphs is not scanned past
+    // a constant factor of the graph being read
+    static inline GraphIoResult graph_io_planar_code_pop_thread(
+        GraphIoPlanarCodeReader *reader,
+        AvenThreadPool *thread_pool,
+        size_t nthreads,
+        AvenArena *arena
+    ) {
+        assert(nthreads > 0);
+
+        GraphIoPlanarCodeRecordResult header_res = graph_io_planar_code_header(
+            reader
+        );
+        if (header_res.error != 0) {
+            return (GraphIoResult){ .error = header_res.error };
+        }
+        GraphIoPlanarCodeRecord record = header_res.payload;
+
+        AvenArena temp_arena = *arena;
+        GraphIoPlanarCodeThreadWorkerSlice workers = aven_arena_create_slice(
+            GraphIoPlanarCodeThreadWorker,
+            &temp_arena,
+            nthreads
+        );
+        AvenThreadPoolJobSlice jobs = aven_arena_create_slice(
+            AvenThreadPoolJob,
+            &temp_arena,
+            nthreads - 1
+        );
+        for (uint32_t i = 0; i < workers.len; i += 1) {
+            get(workers, i) = (GraphIoPlanarCodeThreadWorker){
+                .bytes = reader->bytes,
+                .record = record,
+            };
+        }
+
+        size_t max_entries = (reader->bytes.len - record.start) /
+            record.entry_size;
+        size_t window_start = 0;
+        size_t window_len = GRAPH_IO_IMPORT_THREAD_MIN_ENTRIES;
+        GraphIndex nzeros = 0;
+        size_t nentries = 0;
+        while (nzeros < record.len) {
+            if (window_start == max_entries) {
+                return (GraphIoResult){ .error = AVEN_IO_ERROR_MISMATCH };
+            }
+            size_t window_end = window_start + min(
+                window_len,
+                max_entries - window_start
+            );
+
+            graph_io_planar_code_thread_split(
+                workers,
+                window_start,
+                window_end
+            );
+            graph_thread_run_phase(
+                thread_pool,
+                jobs,
+                workers,
+                graph_io_planar_code_thread_count_worker
+            );
+
+            for (uint32_t i = 0; i < workers.len; i += 1) {
+                GraphIoPlanarCodeThreadWorker *worker = &get(workers, i);
+                if (nzeros + worker->nzeros < record.len) {
+                    nzeros += worker->nzeros;
+                    continue;
+                }
+
+                size_t p = worker->start_entry;
+                while (nzeros < record.len) {
+                    if (graph_io_planar_code_thread_entry(worker, p) == 0) {
+                        nzeros += 1;
+                    }
+                    p += 1;
+                }
+                nentries = p;
+                break;
+            }
+
+            window_start = window_end;
+            window_len *= 2;
+        }
+
+        record.nentries = nentries;
+        record.nb_len = nentries - record.len;
+        if (record.nb_len > GRAPH_INDEX_MAX) {
+            return (GraphIoResult){ .error = AVEN_IO_ERROR_MISMATCH };
+        }
+
+        Graph graph = {
+            .adj = { .len = record.len },
+            .nb = { .len = record.nb_len },
+        };
+        graph.adj.ptr = aven_arena_create_array(
+            GraphAdj,
+            arena,
+            graph.adj.len
+        );
+        graph.nb.ptr = aven_arena_create_array(
+            GraphIndex,
+            arena,
+            graph.nb.len
+        );
+
+        // the graph takes the place of the workers that found its extent
+        temp_arena = *arena;
+        workers.ptr = aven_arena_create_array(
+            GraphIoPlanarCodeThreadWorker,
+            &temp_arena,
+            workers.len
+        );
+        jobs.ptr = aven_arena_create_array(
+            AvenThreadPoolJob,
+            &temp_arena,
+            jobs.len
+        );
+        GraphPropIndex ends = aven_arena_create_slice(
+            GraphIndex,
+            &temp_arena,
+            graph.adj.len
+        );
+        for (uint32_t i = 0; i < workers.len; i += 1) {
+            get(workers, i) = (GraphIoPlanarCodeThreadWorker){
+                .bytes = reader->bytes,
+                .record = record,
+                .graph = graph,
+                .ends = ends,
+            };
+        }
+
+        graph_io_planar_code_thread_split(workers, 0, nentries);
+        graph_thread_run_phase(
+            thread_pool,
+            jobs,
+            workers,
+            graph_io_planar_code_thread_count_worker
+        );
+
+        GraphIndex start_vertex = 0;
+        for (uint32_t i = 0; i < workers.len; i += 1) {
+            get(workers, i).start_vertex = start_vertex;
+            start_vertex += get(workers, i).nzeros;
+        }
+
+        graph_thread_run_phase(
+            thread_pool,
+            jobs,
+            workers,
+            graph_io_planar_code_thread_fill_worker
+        );
+        for (uint32_t i = 0; i < workers.len; i += 1) {
+            if (get(workers, i).error) {
+                return (GraphIoResult){ .error = AVEN_IO_ERROR_MISMATCH };
+            }
+        }
+
+        graph_io_planar_code_thread_split(workers, 0, graph.adj.len);
+        graph_thread_run_phase(
+            thread_pool,
+            jobs,
+            workers,
+            graph_io_planar_code_thread_adj_worker
+        );
+
+        reader->pos = record.start + nentries * record.entry_size;
+        return (GraphIoResult){ .payload = graph };
+    }
+
+#endif // GRAPH_IO_IMPORT_THREAD_H
@@ -0,0 +1,233 @@
+#ifndef GRAPH_IO_MAP_H
+    #define GRAPH_IO_MAP_H
+
+    #include <aven.h>
+    #include <aven/arena.h>
+    #include <aven/str.h>
+
+    #include "../../graph.h"
+    #include "../io.h"
+
+    // Memory mapped graph files in the aligned format. A read-only mapping
+    // is shared through the page cache, so loading is a header check and
+    // processes opening the same file share one copy of the graph.
+
+    #ifdef _WIN32
+        AVEN_WIN32_FN(void *) CreateFileA(
+            const char *name,
+            uint32_t access,
+            uint32_t share_mode,
+            void *security,
+            uint32_t disposition,
+            uint32_t flags,
+            void *template_file
+        );
+        AVEN_WIN32_FN(int) GetFileSizeEx(void *file, int64_t *size);
+        AVEN_WIN32_FN(void *) CreateFileMappingA(
+            void *file,
+            void *security,
+            uint32_t protect,
+            uint32_t size_high,
+            uint32_t size_low,
+            const char *name
+        );
+        AVEN_WIN32_FN(void *) MapViewOfFile(
+            void *mapping,
+            uint32_t access,
+            uint32_t offset_high,
+            uint32_t offset_low,
+            size_t size
+        );
+        AVEN_WIN32_FN(int) UnmapViewOfFile(const void *addr);
+        AVEN_WIN32_FN(int) CloseHandle(void *handle);
+
+        #define GRAPH_IO_MAP_WIN32_GENERIC_READ 0x80000000U
+        #define GRAPH_IO_MAP_WIN32_GENERIC_WRITE 0x40000000U
+        #define GRAPH_IO_MAP_WIN32_FILE_SHARE_READ 0x1U
+        #define GRAPH_IO_MAP_WIN32_CREATE_ALWAYS 2U
+        #define GRAPH_IO_MAP_WIN32_OPEN_EXISTING 3U
+        #define GRAPH_IO_MAP_WIN32_FILE_ATTRIBUTE_NORMAL 0x80U
+        #define GRAPH_IO_MAP_WIN32_PAGE_READONLY 0x2U
+        #define GRAPH_IO_MAP_WIN32_PAGE_READWRITE 0x4U
+        #define GRAPH_IO_MAP_WIN32_FILE_MAP_WRITE 0x2U
+        #define GRAPH_IO_MAP_WIN32_FILE_MAP_READ 0x4U
+        #define GRAPH_IO_MAP_WIN32_INVALID_HANDLE ((void *)(intptr_t)-1)
+    #else
+        #include <fcntl.h>
+        #include <sys/mman.h>
+        #include <sys/stat.h>
+        #include <unistd.h>
+    #endif
+
+    typedef enum {
+        GRAPH_IO_MAP_ERROR_NONE = 0,
+        GRAPH_IO_MAP_ERROR_OPEN,
+        GRAPH_IO_MAP_ERROR_SIZE,
+        GRAPH_IO_MAP_ERROR_MAP,
+    } GraphIoMapError;
+
+    typedef struct {
+        ByteSlice bytes;
+    #ifdef _WIN32
+        void *mapping;
+    #endif
+    } GraphIoMap;
+
+    typedef Result(GraphIoMap, int) GraphIoMapResult;
+
+    static inline char *graph_io_map_cstr(AvenStr path, AvenArena *arena) {
+        char *cpath = aven_arena_create_array(char, arena, path.len + 1);
+        for (size_t i = 0; i < path.len; i += 1) {
+            cpath[i] = get(path, i);
+        }
+        cpath[path.len] = 0;
+        return cpath;
+    }
+
+    // Map size bytes of the file at path, creating or truncating it first
+    // when writable is set
+    static inline GraphIoMapResult graph_io_map_internal(
+        AvenStr path,
+        size_t size,
+        bool writable,
+        AvenArena temp_arena
+    ) {
+        char *cpath = graph_io_map_cstr(path, &temp_arena);
+
+    #ifdef _WIN32
+        uint32_t access = GRAPH_IO_MAP_WIN32_GENERIC_READ;
+        uint32_t disposition = GRAPH_IO_MAP_WIN32_OPEN_EXISTING;
+        uint32_t protect = GRAPH_IO_MAP_WIN32_PAGE_READONLY;
+        uint32_t view_access = GRAPH_IO_MAP_WIN32_FILE_MAP_READ;
+        if (writable) {
+            access |= GRAPH_IO_MAP_WIN32_GENERIC_WRITE;
+            disposition = GRAPH_IO_MAP_WIN32_CREATE_ALWAYS;
+            protect = GRAPH_IO_MAP_WIN32_PAGE_READWRITE;
+            view_access = GRAPH_IO_MAP_WIN32_FILE_MAP_WRITE;
+        }
+
+        void *file = CreateFileA(
+            cpath,
+            access,
+            GRAPH_IO_MAP_WIN32_FILE_SHARE_READ,
+            NULL,
+            disposition,
+            GRAPH_IO_MAP_WIN32_FILE_ATTRIBUTE_NORMAL,
+            NULL
+        );
+        if (file == GRAPH_IO_MAP_WIN32_INVALID_HANDLE) {
+            return (GraphIoMapResult){ .error = GRAPH_IO_MAP_ERROR_OPEN };
+        }
+
+        if (!writable) {
+            int64_t file_size = 0;
+            if (GetFileSizeEx(file, &file_size) == 0 or file_size <= 0) {
+                CloseHandle(file);
+                return (GraphIoMapResult){ .error = GRAPH_IO_MAP_ERROR_SIZE };
+            }
+            size = (size_t)file_size;
+        }
+
+        void *mapping = CreateFileMappingA(
+            file,
+            NULL,
+            protect,
+            (uint32_t)((uint64_t)size >> 32),
+            (uint32_t)size,
+            NULL
+        );
+        CloseHandle(file);
+        if (mapping == NULL) {
+            return (GraphIoMapResult){ .error = GRAPH_IO_MAP_ERROR_MAP };
+        }
+
+        void *ptr = MapViewOfFile(mapping, view_access, 0, 0, size);
+        if (ptr == NULL) {
+            CloseHandle(mapping);
+            return (GraphIoMapResult){ .error = GRAPH_IO_MAP_ERROR_MAP };
+        }
+
+        return (GraphIoMapResult){
+            .payload = {
+                .bytes = { .ptr = ptr, .len = size },
+                .mapping = mapping,
+            },
+        };
+    #else
+        int fd = -1;
+        if (writable) {
+            fd = open(cpath, O_RDWR | O_CREAT | O_TRUNC, 0644);
+        } else {
+            fd = open(cpath, O_RDONLY);
+        }
+        if (fd < 0) {
+            return (GraphIoMapResult){ .error = GRAPH_IO_MAP_ERROR_OPEN };
+        }
+
+        if (writable) {
+            if (ftruncate(fd, (off_t)size) != 0) {
+                close(fd);
+                return (GraphIoMapResult){ .error = GRAPH_IO_MAP_ERROR_SIZE };
+            }
+        } else {
+            struct stat st;
+            if (fstat(fd, &st) != 0 or st.st_size <= 0) {
+                close(fd);
+                return (GraphIoMapResult){ .error = GRAPH_IO_MAP_ERROR_SIZE };
+            }
+            size = (size_t)st.st_size;
+        }
+
+        int prot = PROT_READ;
+        if (writable) {
+            prot |= PROT_WRITE;
+        }
+        void *ptr = mmap(NULL, size, prot, MAP_SHARED, fd, 0);
+        close(fd);
+        if (ptr == MAP_FAILED) {
+            return (GraphIoMapResult){ .error = GRAPH_IO_MAP_ERROR_MAP };
+        }
+
+        return (GraphIoMapResult){
+            .payload = { .bytes = { .ptr = ptr, .len = size } },
+        };
+    #endif
+    }
+
+    // Map an existing file read-only, the bytes must not be written
+    static inline GraphIoMapResult graph_io_map_open(
+        AvenStr path,
+        AvenArena temp_arena
+    ) {
+        return graph_io_map_internal(path, 0, false, temp_arena);
+    }
+
+    // Create a file of the given size and map it for writing
+    static inline GraphIoMapResult graph_io_map_create(
+        AvenStr path,
+        size_t size,
+        AvenArena temp_arena
+    ) {
+        assert(size > 0);
+        return graph_io_map_internal(path, size, true, temp_arena);
+    }
+
+    static inline void graph_io_map_close(GraphIoMap *map) {
+    #ifdef _WIN32
+        UnmapViewOfFile(map->bytes.ptr);
+        CloseHandle(map->mapping);
+    #else
+        munmap(map->bytes.ptr, map->bytes.len);
+    #endif
+        *map = (GraphIoMap){ 0 };
+    }
+
+    static inline GraphIoResult graph_io_map_graph(GraphIoMap map) {
+        return graph_io_aligned_view(map.bytes);
+    }
+
+    static inline GraphIoAugResult graph_io_map_aug_graph(GraphIoMap map) {
+        return graph_io_aug_aligned_view(map.bytes);
+    }
+
+#endif // GRAPH_IO_MAP_H
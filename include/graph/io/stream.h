@@ -0,0 +1,320 @@
+#ifndef GRAPH_IO_STREAM_H
+    #define GRAPH_IO_STREAM_H
+
+    #include <aven.h>
+    #include <aven/arena.h>
+    #include <aven/io.h>
+
+    #include "../../graph.h"
+    #include "../io.h"
+
+    // Streamed graph files written and read a chunk of vertices at a time.
+    // The header fixes the largest chunk, so neither side ever holds more
+    // than one chunk of rotations. Each chunk header gives the lengths of
+    // the adjacency and rotation arrays that follow it. Adjacency indices
+    // are global, as if the chunks were concatenated into one graph, and a
+    // final empty chunk records the totals.
+
+    #ifdef GRAPH_WIDE_INDEX
+        #define GRAPH_IO_TYPE_STREAM ((uint64_t)0x57ea7ad7062af64UL)
+    #else
+        #define GRAPH_IO_TYPE_STREAM ((uint64_t)0x57ea7ad7062af0UL)
+    #endif
+
+    typedef struct {
+        uint64_t type;
+        // most vertices and half-edges in any one chunk
+        uint64_t chunk_len;
+        uint64_t chunk_nb_len;
+    } GraphIoStreamHeader;
+
+    typedef struct {
+        uint64_t first_vertex;
+        uint64_t first_nb;
+        uint64_t len;
+        uint64_t nb_len;
+    } GraphIoStreamChunkHeader;
+
+    typedef struct {
+        AvenIoWriter *io;
+        List(GraphAdj) adj;
+        List(GraphIndex) nb;
+        GraphIndex first_vertex;
+        GraphIndex first_nb;
+        bool started;
+    } GraphIoStreamWriter;
+
+    static inline GraphIoStreamWriter graph_io_stream_writer_init(
+        AvenIoWriter *io,
+        size_t chunk_len,
+        size_t chunk_nb_len,
+        AvenArena *arena
+    ) {
+        assert(chunk_len > 0);
+
+        GraphIoStreamWriter writer = { .io = io };
+        writer.adj.ptr = aven_arena_create_array(GraphAdj, arena, chunk_len);
+        writer.adj.cap = chunk_len;
+        writer.nb.ptr = aven_arena_create_array(
+            GraphIndex,
+            arena,
+            chunk_nb_len
+        );
+        writer.nb.cap = chunk_nb_len;
+
+        return writer;
+    }
+
+    static inline int graph_io_stream_writer_flush(
+        GraphIoStreamWriter *writer
+    ) {
+        if (!writer->started) {
+            GraphIoStreamHeader header = {
+                .type = GRAPH_IO_TYPE_STREAM,
+                .chunk_len = writer->adj.cap,
+                .chunk_nb_len = writer->nb.cap,
+            };
+            int hd_error = aven_io_writer_push_struct(writer->io, &header);
+            if (hd_error != 0) {
+                return hd_error;
+            }
+            writer->started = true;
+        }
+
+        if (writer->adj.len == 0) {
+            return AVEN_IO_ERROR_NONE;
+        }
+
+        GraphIoStreamChunkHeader chunk_header = {
+            .first_vertex = writer->first_vertex,
+            .first_nb = writer->first_nb,
+            .len = writer->adj.len,
+            .nb_len = writer->nb.len,
+        };
+        int ch_error = aven_io_writer_push_struct(writer->io, &chunk_header);
+        if (ch_error != 0) {
+            return ch_error;
+        }
+
+        for (size_t i = 0; i < writer->adj.len; i += 1) {
+            int adj_error = aven_io_writer_push_struct(
+                writer->io,
+                &get(writer->adj, i)
+            );
+            if (adj_error != 0) {
+                return adj_error;
+            }
+        }
+        for (size_t i = 0; i < writer->nb.len; i += 1) {
+            int nb_error = aven_io_writer_push_struct(
+                writer->io,
+                &get(writer->nb, i)
+            );
+            if (nb_error != 0) {
+                return nb_error;
+            }
+        }
+
+        writer->first_vertex += (GraphIndex)writer->adj.len;
+        writer->first_nb += (GraphIndex)writer->nb.len;
+        writer->adj.len = 0;
+        writer->nb.len = 0;
+
+        return AVEN_IO_ERROR_NONE;
+    }
+
+    // Append the rotation of the next vertex, flushing the buffered chunk
+    // first if it is full. The degree may not exceed the chunk half-edges.
+    static inline int graph_io_stream_writer_push(
+        GraphIoStreamWriter *writer,
+        GraphNbSlice rotation
+    ) {
+        assert(rotation.len <= writer->nb.cap);
+
+        if (
+            writer->adj.len == writer->adj.cap or
+            writer->nb.len + rotation.len > writer->nb.cap
+        ) {
+            int error = graph_io_stream_writer_flush(writer);
+            if (error != 0) {
+                return error;
+            }
+        }
+
+        list_push(writer->adj) = (GraphAdj){
+            .index = writer->first_nb + (GraphIndex)writer->nb.len,
+            .len = (GraphIndex)rotation.len,
+        };
+        for (size_t i = 0; i < rotation.len; i += 1) {
+            list_push(writer->nb) = get(rotation, i);
+        }
+
+        return AVEN_IO_ERROR_NONE;
+    }
+
+    // Flush the last chunk and write the end marker with the totals
+    static inline int graph_io_stream_writer_finish(
+        GraphIoStreamWriter *writer
+    ) {
+        int error = graph_io_stream_writer_flush(writer);
+        if (error != 0) {
+            return error;
+        }
+
+        GraphIoStreamChunkHeader end_header = {
+            .first_vertex = writer->first_vertex,
+            .first_nb = writer->first_nb,
+        };
+        return aven_io_writer_push_struct(writer->io, &end_header);
+    }
+
+    typedef struct {
+        AvenIoReader *io;
+        GraphIoStreamHeader header;
+        GraphIndex next_vertex;
+        GraphIndex next_nb;
+        bool done;
+    } GraphIoStreamReader;
+
+    typedef Result(GraphIoStreamReader, int) GraphIoStreamReaderResult;
+
+    static inline GraphIoStreamReaderResult graph_io_stream_reader_init(
+        AvenIoReader *io
+    ) {
+        GraphIoStreamReader reader = { .io = io };
+        int hd_error = aven_io_reader_pop_struct(io, &reader.header);
+        if (hd_error != 0) {
+            return (GraphIoStreamReaderResult){ .error = hd_error };
+        }
+        if (
+            reader.header.type != GRAPH_IO_TYPE_STREAM or
+            reader.header.chunk_len == 0
+        ) {
+            return (GraphIoStreamReaderResult){
+                .error = AVEN_IO_ERROR_MISMATCH,
+            };
+        }
+
+        return (GraphIoStreamReaderResult){ .payload = reader };
+    }
+
+    // Vertices first_vertex, ..., first_vertex + adj.len - 1 with their
+    // rotations, get(adj, i).index counts from the start of the graph
+    typedef struct {
+        GraphIndex first_vertex;
+        GraphIndex first_nb;
+        GraphAdjSlice adj;
+        GraphNbSlice nb;
+    } GraphIoStreamChunk;
+
+    typedef Result(GraphIoStreamChunk, int) GraphIoStreamChunkResult;
+
+    static inline GraphIndex graph_io_stream_chunk_nb(
+        GraphIoStreamChunk chunk,
+        GraphAdj v_adj,
+        GraphIndex i
+    ) {
+        return get(chunk.nb, v_adj.index - chunk.first_nb + i);
+    }
+
+    // Pop the next chunk onto the arena, an empty chunk marks the end of
+    // the graph and sets reader->done. Rotations are checked to tile the
+    // chunk but neighbors are not bounded by the final vertex count.
+    static inline GraphIoStreamChunkResult graph_io_stream_reader_pop(
+        GraphIoStreamReader *reader,
+        AvenArena *arena
+    ) {
+        assert(!reader->done);
+
+        GraphIoStreamChunkHeader chunk_header = { 0 };
+        int ch_error = aven_io_reader_pop_struct(reader->io, &chunk_header);
+        if (ch_error != 0) {
+            return (GraphIoStreamChunkResult){ .error = ch_error };
+        }
+        if (
+            chunk_header.first_vertex != reader->next_vertex or
+            chunk_header.first_nb != reader->next_nb or
+            chunk_header.len > reader->header.chunk_len or
+            chunk_header.nb_len > reader->header.chunk_nb_len or
+            chunk_header.len > GRAPH_INDEX_MAX - reader->next_vertex or
+            chunk_header.nb_len > GRAPH_INDEX_MAX - reader->next_nb
+        ) {
+            return (GraphIoStreamChunkResult){
+                .error = AVEN_IO_ERROR_MISMATCH,
+            };
+        }
+
+        GraphIoStreamChunk chunk = {
+            .first_vertex = reader->next_vertex,
+            .first_nb = reader->next_nb,
+        };
+        if (chunk_header.len == 0) {
+            if (chunk_header.nb_len != 0) {
+                return (GraphIoStreamChunkResult){
+                    .error = AVEN_IO_ERROR_MISMATCH,
+                };
+            }
+            reader->done = true;
+            return (GraphIoStreamChunkResult){ .payload = chunk };
+        }
+
+        // the lengths were bounded by the stream header above, so a corrupt
+        // chunk cannot make us allocate more than one chunk of rotations
+        GraphAdjSlice adj = aven_arena_create_slice(
+            GraphAdj,
+            arena,
+            (size_t)chunk_header.len
+        );
+        for (GraphIndex v = 0; v < adj.len; v += 1) {
+            int adj_error = aven_io_reader_pop_struct(
+                reader->io,
+                &get(adj, v)
+            );
+            if (adj_error != 0) {
+                return (GraphIoStreamChunkResult){ .error = adj_error };
+            }
+        }
+
+        GraphNbSlice nb = aven_arena_create_slice(
+            GraphIndex,
+            arena,
+            (size_t)chunk_header.nb_len
+        );
+        for (GraphIndex i = 0; i < nb.len; i += 1) {
+            int nb_error = aven_io_reader_pop_struct(
+                reader->io,
+                &get(nb, i)
+            );
+            if (nb_error != 0) {
+                return (GraphIoStreamChunkResult){ .error = nb_error };
+            }
+        }
+
+        GraphIndex index = chunk.first_nb;
+        for (GraphIndex v = 0; v < adj.len; v += 1) {
+            GraphAdj v_adj = get(adj, v);
+            if (
+                v_adj.index != index or
+                v_adj.len > chunk.first_nb + nb.len - index
+            ) {
+                return (GraphIoStreamChunkResult){
+                    .error = AVEN_IO_ERROR_MISMATCH,
+                };
+            }
+            index += v_adj.len;
+        }
+        if (index != chunk.first_nb + nb.len) {
+            return (GraphIoStreamChunkResult){
+                .error = AVEN_IO_ERROR_MISMATCH,
+            };
+        }
+
+        chunk.adj = adj;
+        chunk.nb = nb;
+        reader->next_vertex += (GraphIndex)adj.len;
+        reader->next_nb += (GraphIndex)nb.len;
+
+        return (GraphIoStreamChunkResult){ .payload = chunk };
+    }
+
+#endif // GRAPH_IO_STREAM_H
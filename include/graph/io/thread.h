@@ -0,0 +1,379 @@
+#ifndef GRAPH_IO_THREAD_H
+    #define GRAPH_IO_THREAD_H
+
+    #include <aven.h>
+    #include <aven/arena.h>
+    #include <aven/thread/pool.h>
+
+    #include "../../graph.h"
+    #include "../io.h"
+    #include "../thread.h"
+
+    // Multi-threaded validation of untrusted graphs. Every thread owns a
+    // contiguous range of vertices and records the first offending vertex
+    // in its range, the smallest of these is the first offending vertex of
+    // the graph, or GRAPH_INDEX_MAX if there is none.
+
+    typedef enum {
+        // the rotation itself is out of bounds
+        GRAPH_IO_THREAD_ROTATION_INVALID = 0,
+        GRAPH_IO_THREAD_ROTATION_SORTED,
+        // in bounds but not sorted, either past the space for sorted copies
+        // or holding neighbors out of range, searched linearly
+        GRAPH_IO_THREAD_ROTATION_UNSORTED,
+    } GraphIoThreadRotation;
+
+    typedef struct {
+        Graph graph;
+        GraphAug aug_graph;
+        // sorted copy of the rotation of v starts at get(offsets, v)
+        GraphPropIndex offsets;
+        GraphPropUint8 rotations;
+        GraphNbSlice sorted;
+        GraphNbSlice scratch;
+        GraphIndex start_vertex;
+        GraphIndex end_vertex;
+        GraphIndex first;
+    } GraphIoThreadWorker;
+    typedef Slice(GraphIoThreadWorker) GraphIoThreadWorkerSlice;
+
+    static inline bool graph_io_thread_adj_in_bounds(
+        GraphAdj v_adj,
+        size_t nb_len
+    ) {
+        return v_adj.index <= nb_len and v_adj.len <= nb_len - v_adj.index;
+    }
+
+    // Bottom-up merge sort of the len values starting at index
+    static inline void graph_io_thread_sort(
+        GraphNbSlice values,
+        GraphNbSlice scratch,
+        GraphIndex index,
+        GraphIndex len
+    ) {
+        GraphIndex *src = &get(values, index);
+        GraphIndex *dst = &get(scratch, index);
+        for (GraphIndex width = 1; width < len; width *= 2) {
+            for (GraphIndex lo = 0; lo < len; lo += 2 * width) {
+                GraphIndex mid = min(lo + width, len);
+                GraphIndex hi = min(lo + 2 * width, len);
+
+                GraphIndex i = lo;
+                GraphIndex j = mid;
+                for (GraphIndex k = lo; k < hi; k += 1) {
+                    if (j == hi or (i < mid and src[i] <= src[j])) {
+                        dst[k] = src[i];
+                        i += 1;
+                    } else {
+                        dst[k] = src[j];
+                        j += 1;
+                    }
+                }
+            }
+
+            GraphIndex *tmp = src;
+            src = dst;
+            dst = tmp;
+        }
+
+        if (src != &get(values, index)) {
+            for (GraphIndex k = 0; k < len; k += 1) {
+                get(values, index + k) = src[k];
+            }
+        }
+    }
+
+    // Whether u appears in the rotation of v
+    static inline bool graph_io_thread_has_nb(
+        GraphIoThreadWorker *worker,
+        GraphIndex v,
+        GraphIndex u
+    ) {
+        GraphAdj v_adj = get(worker->graph.adj, v);
+
+        if (get(worker->rotations, v) == GRAPH_IO_THREAD_ROTATION_UNSORTED) {
+            for (GraphIndex i = 0; i < v_adj.len; i += 1) {
+                if (graph_nb(worker->graph.nb, v_adj, i) == u) {
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        GraphIndex *sorted = &get(worker->sorted, get(worker->offsets, v));
+        GraphIndex lo = 0;
+        GraphIndex hi = v_adj.len;
+        while (lo < hi) {
+            GraphIndex mid = lo + (hi - lo) / 2;
+            if (sorted[mid] < u) {
+                lo = mid + 1;
+            } else {
+                hi = mid;
+            }
+        }
+
+        return lo < v_adj.len and sorted[lo] == u;
+    }
+
+    // Bounds check and sort each rotation, a repeated neighbor shows up as
+    // two equal neighbors next to each other
+    static void graph_io_thread_sort_worker(void *args) {
+        GraphIoThreadWorker *worker = args;
+        Graph graph = worker->graph;
+
+        for (
+            GraphIndex v = worker->start_vertex;
+            v != worker->end_vertex;
+            v += 1
+        ) {
+            GraphAdj v_adj = get(graph.adj, v);
+            if (!graph_io_thread_adj_in_bounds(v_adj, graph.nb.len)) {
+                get(worker->rotations, v) = GRAPH_IO_THREAD_ROTATION_INVALID;
+                worker->first = min(worker->first, v);
+                continue;
+            }
+
+            bool nbs_valid = true;
+            for (GraphIndex i = 0; nbs_valid and i < v_adj.len; i += 1) {
+                nbs_valid = graph_nb(graph.nb, v_adj, i) < graph.adj.len;
+            }
+            if (!nbs_valid) {
+                worker->first = min(worker->first, v);
+            }
+
+            GraphIndex offset = get(worker->offsets, v);
+            if (!nbs_valid or offset == GRAPH_INDEX_MAX) {
+                get(worker->rotations, v) = GRAPH_IO_THREAD_ROTATION_UNSORTED;
+                continue;
+            }
+            get(worker->rotations, v) = GRAPH_IO_THREAD_ROTATION_SORTED;
+
+            for (GraphIndex i = 0; i < v_adj.len; i += 1) {
+                get(worker->sorted, offset + i) = graph_nb(graph.nb, v_adj, i);
+            }
+            graph_io_thread_sort(
+                worker->sorted,
+                worker->scratch,
+                offset,
+                v_adj.len
+            );
+            for (GraphIndex i = 1; i < v_adj.len; i += 1) {
+                if (
+                    get(worker->sorted, offset + i - 1) ==
+                    get(worker->sorted, offset + i)
+                ) {
+                    worker->first = min(worker->first, v);
+                    break;
+                }
+            }
+        }
+    }
+
+    static void graph_io_thread_symmetry_worker(void *args) {
+        GraphIoThreadWorker *worker = args;
+        Graph graph = worker->graph;
+
+        for (
+            GraphIndex v = worker->start_vertex;
+            v != worker->end_vertex and v < worker->first;
+            v += 1
+        ) {
+            GraphAdj v_adj = get(graph.adj, v);
+            for (GraphIndex i = 0; i < v_adj.len; i += 1) {
+                GraphIndex u = graph_nb(graph.nb, v_adj, i);
+                if (
+                    get(worker->rotations, u) ==
+                        GRAPH_IO_THREAD_ROTATION_INVALID or
+                    !graph_io_thread_has_nb(worker, u, v)
+                ) {
+                    worker->first = v;
+                    break;
+                }
+            }
+        }
+    }
+
+    static void graph_io_thread_aug_worker(void *args) {
+        GraphIoThreadWorker *worker = args;
+        GraphAug graph = worker->aug_graph;
+
+        for (
+            GraphIndex v = worker->start_vertex;
+            v != worker->end_vertex;
+            v += 1
+        ) {
+            GraphAdj v_adj = get(graph.adj, v);
+            bool valid = graph_io_thread_adj_in_bounds(v_adj, graph.nb.len);
+            for (GraphIndex i = 0; valid and i < v_adj.len; i += 1) {
+                GraphAugNb vu = graph_aug_nb(graph.nb, v_adj, i);
+                if (vu.vertex >= graph.adj.len) {
+                    valid = false;
+                    break;
+                }
+
+                GraphAdj u_adj = get(graph.adj, vu.vertex);
+                if (
+                    !graph_io_thread_adj_in_bounds(u_adj, graph.nb.len) or
+                    vu.back_index >= u_adj.len
+                ) {
+                    valid = false;
+                    break;
+                }
+
+                GraphAugNb uv = graph_aug_nb(graph.nb, u_adj, vu.back_index);
+                valid = uv.vertex == v and uv.back_index == i;
+            }
+
+            if (!valid) {
+                worker->first = v;
+                return;
+            }
+        }
+    }
+
+    static inline GraphIndex graph_io_thread_run(
+        GraphIoThreadWorker base,
+        void (**phase_fns)(void *),
+        size_t nphases,
+        AvenThreadPool *thread_pool,
+        size_t nthreads,
+        AvenArena temp_arena
+    ) {
+        assert(nthreads > 0);
+
+        size_t nvertices = base.graph.adj.len + base.aug_graph.adj.len;
+        GraphIoThreadWorkerSlice workers = aven_arena_create_slice(
+            GraphIoThreadWorker,
+            &temp_arena,
+            nthreads
+        );
+        AvenThreadPoolJobSlice jobs = aven_arena_create_slice(
+            AvenThreadPoolJob,
+            &temp_arena,
+            nthreads - 1
+        );
+
+        GraphIndex chunk_size = (GraphIndex)(nvertices / workers.len);
+        for (uint32_t i = 0; i < workers.len; i += 1) {
+            GraphIoThreadWorker *worker = &get(workers, i);
+            *worker = base;
+            worker->start_vertex = i * chunk_size;
+            worker->end_vertex = (i + 1) * chunk_size;
+            if (i + 1 == workers.len) {
+                worker->end_vertex = (GraphIndex)nvertices;
+            }
+        }
+
+        for (size_t phase = 0; phase < nphases; phase += 1) {
+            graph_thread_run_phase(
+                thread_pool,
+                jobs,
+                workers,
+                phase_fns[phase]
+            );
+        }
+
+        GraphIndex first = GRAPH_INDEX_MAX;
+        for (uint32_t i = 0; i < workers.len; i += 1) {
+            first = min(first, get(workers, i).first);
+        }
+
+        return first;
+    }
+
+    // Bounds, symmetry and the absence of repeated edges: v offends if its
+    // rotation leaves the graph, lists a neighbor twice or lists a
+    // neighbor u that does not list v. Rotations may not hold more
+    // half-edges in total than the graph, the first vertex whose rotation
+    // passes that total offends as well.
+    static inline GraphIndex graph_io_validate_thread(
+        Graph graph,
+        AvenThreadPool *thread_pool,
+        size_t nthreads,
+        AvenArena temp_arena
+    ) {
+        GraphIoThreadWorker base = {
+            .graph = graph,
+            .offsets = { .len = graph.adj.len },
+            .rotations = { .len = graph.adj.len },
+            .sorted = { .len = graph.nb.len },
+            .scratch = { .len = graph.nb.len },
+            .first = GRAPH_INDEX_MAX,
+        };
+        base.offsets.ptr = aven_arena_create_array(
+            GraphIndex,
+            &temp_arena,
+            base.offsets.len
+        );
+        base.rotations.ptr = aven_arena_create_array(
+            uint8_t,
+            &temp_arena,
+            base.rotations.len
+        );
+        base.sorted.ptr = aven_arena_create_array(
+            GraphIndex,
+            &temp_arena,
+            base.sorted.len
+        );
+        base.scratch.ptr = aven_arena_create_array(
+            GraphIndex,
+            &temp_arena,
+            base.scratch.len
+        );
+
+        size_t total = 0;
+        for (GraphIndex v = 0; v < graph.adj.len; v += 1) {
+            GraphAdj v_adj = get(graph.adj, v);
+            if (
+                base.first != GRAPH_INDEX_MAX or
+                !graph_io_thread_adj_in_bounds(v_adj, graph.nb.len)
+            ) {
+                get(base.offsets, v) = GRAPH_INDEX_MAX;
+            } else if (v_adj.len > graph.nb.len - total) {
+                get(base.offsets, v) = GRAPH_INDEX_MAX;
+                base.first = v;
+            } else {
+                get(base.offsets, v) = (GraphIndex)total;
+                total += v_adj.len;
+            }
+        }
+
+        void (*phase_fns[])(void *) = {
+            graph_io_thread_sort_worker,
+            graph_io_thread_symmetry_worker,
+        };
+        return graph_io_thread_run(
+            base,
+            phase_fns,
+            countof(phase_fns),
+            thread_pool,
+            nthreads,
+            temp_arena
+        );
+    }
+
+    // Bounds and reciprocity: v offends if its rotation leaves the graph or
+    // some v -> u does not lead back to the same half-edge of v
+    static inline GraphIndex graph_io_aug_validate_thread(
+        GraphAug graph,
+        AvenThreadPool *thread_pool,
+        size_t nthreads,
+        AvenArena temp_arena
+    ) {
+        GraphIoThreadWorker base = {
+            .aug_graph = graph,
+            .first = GRAPH_INDEX_MAX,
+        };
+
+        void (*phase_fns[])(void *) = { graph_io_thread_aug_worker };
+        return graph_io_thread_run(
+            base,
+            phase_fns,
+            countof(phase_fns),
+            thread_pool,
+            nthreads,
+            temp_arena
+        );
+    }
+
+#endif // GRAPH_IO_THREAD_H
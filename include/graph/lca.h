@@ -0,0 +1,250 @@
+#ifndef GRAPH_LCA_H
+    #define GRAPH_LCA_H
+
+    #include <aven.h>
+    #include <aven/arena.h>
+
+    #include "../graph.h"
+    #include "bfs.h"
+    #include "dfs.h"
+
+    // Binary lifting index over a rooted tree or forest: level j holds the
+    // 2^j-th ancestor of every vertex, with roots as their own ancestors.
+    // Lowest common ancestors, tree distances and k-th ancestors take
+    // O(log n) jumps and a u-v path is built in O(path length) without
+    // walking on to the root.
+
+    typedef struct {
+        // get(up, j * depth.len + v) is the 2^j-th ancestor of v
+        GraphPropIndex up;
+        // depth of each vertex, GRAPH_INDEX_MAX if it is not in the tree
+        GraphPropIndex depth;
+        size_t levels;
+    } GraphLca;
+
+    static inline GraphLca graph_lca_alloc(
+        GraphPropIndex depth,
+        AvenArena *arena
+    ) {
+        GraphIndex max_depth = 0;
+        for (GraphIndex v = 0; v < depth.len; v += 1) {
+            if (get(depth, v) != GRAPH_INDEX_MAX) {
+                max_depth = max(max_depth, get(depth, v));
+            }
+        }
+
+        size_t levels = 1;
+        while ((max_depth >> levels) != 0) {
+            levels += 1;
+        }
+
+        GraphLca lca = {
+            .up = { .len = levels * depth.len },
+            .depth = depth,
+            .levels = levels,
+        };
+        lca.up.ptr = aven_arena_create_array(GraphIndex, arena, lca.up.len);
+
+        return lca;
+    }
+
+    // Fill every level above zero once the parents are in level zero
+    static inline void graph_lca_lift(GraphLca *lca) {
+        size_t n = lca->depth.len;
+        for (size_t j = 1; j < lca->levels; j += 1) {
+            GraphIndex *prev = &get(lca->up, (j - 1) * n);
+            GraphIndex *next = &get(lca->up, j * n);
+            for (size_t v = 0; v < n; v += 1) {
+                next[v] = prev[prev[v]];
+            }
+        }
+    }
+
+    // Build from explicit parents and depths, roots are their own parent and
+    // vertices outside the tree have depth GRAPH_INDEX_MAX
+    static inline GraphLca graph_lca_init(
+        GraphPropIndex parent,
+        GraphPropIndex depth,
+        AvenArena *arena
+    ) {
+        assert(parent.len == depth.len);
+
+        GraphLca lca = graph_lca_alloc(depth, arena);
+        for (GraphIndex v = 0; v < depth.len; v += 1) {
+            if (get(depth, v) == GRAPH_INDEX_MAX) {
+                get(lca.up, v) = v;
+            } else {
+                get(lca.up, v) = get(parent, v);
+            }
+        }
+        graph_lca_lift(&lca);
+
+        return lca;
+    }
+
+    static inline GraphLca graph_lca_init_bfs(
+        GraphBfsTree tree,
+        AvenArena *arena
+    ) {
+        GraphPropIndex depth = aven_arena_create_slice(
+            GraphIndex,
+            arena,
+            tree.len
+        );
+        for (GraphIndex v = 0; v < tree.len; v += 1) {
+            if (graph_bfs_tree_contains(tree, v)) {
+                get(depth, v) = get(tree, v).dist;
+            } else {
+                get(depth, v) = GRAPH_INDEX_MAX;
+            }
+        }
+
+        GraphLca lca = graph_lca_alloc(depth, arena);
+        for (GraphIndex v = 0; v < tree.len; v += 1) {
+            if (graph_bfs_tree_contains(tree, v)) {
+                get(lca.up, v) = graph_bfs_tree_parent(tree, v);
+            } else {
+                get(lca.up, v) = v;
+            }
+        }
+        graph_lca_lift(&lca);
+
+        return lca;
+    }
+
+    // The numbering lists parents before children, which gives the depths
+    // in a single pass
+    static inline GraphLca graph_lca_init_dfs(
+        GraphDfsData data,
+        AvenArena *arena
+    ) {
+        GraphPropIndex depth = aven_arena_create_slice(
+            GraphIndex,
+            arena,
+            data.tree.len
+        );
+        for (GraphIndex v = 0; v < depth.len; v += 1) {
+            get(depth, v) = GRAPH_INDEX_MAX;
+        }
+        for (GraphIndex n = 0; n < data.numbering.len; n += 1) {
+            GraphIndex v = get(data.numbering, n);
+            GraphIndex p = graph_dfs_tree_parent(data.tree, v);
+            if (p == v) {
+                get(depth, v) = 0;
+            } else {
+                get(depth, v) = get(depth, p) + 1;
+            }
+        }
+
+        GraphLca lca = graph_lca_alloc(depth, arena);
+        for (GraphIndex v = 0; v < depth.len; v += 1) {
+            if (get(depth, v) != GRAPH_INDEX_MAX) {
+                get(lca.up, v) = graph_dfs_tree_parent(data.tree, v);
+            } else {
+                get(lca.up, v) = v;
+            }
+        }
+        graph_lca_lift(&lca);
+
+        return lca;
+    }
+
+    static inline bool graph_lca_contains(GraphLca lca, GraphIndex v) {
+        return get(lca.depth, v) != GRAPH_INDEX_MAX;
+    }
+
+    // The ancestor k levels above v, k must not exceed the depth of v
+    static inline GraphIndex graph_lca_ancestor(
+        GraphLca lca,
+        GraphIndex v,
+        GraphIndex k
+    ) {
+        assert(graph_lca_contains(lca, v));
+        assert(k <= get(lca.depth, v));
+
+        size_t n = lca.depth.len;
+        for (size_t j = 0; k != 0; j += 1) {
+            if ((k & 1) != 0) {
+                v = get(lca.up, j * n + v);
+            }
+            k >>= 1;
+        }
+
+        return v;
+    }
+
+    // Lowest common ancestor, u and v must lie in the same tree
+    static inline GraphIndex graph_lca(
+        GraphLca lca,
+        GraphIndex u,
+        GraphIndex v
+    ) {
+        assert(graph_lca_contains(lca, u));
+        assert(graph_lca_contains(lca, v));
+
+        GraphIndex u_depth = get(lca.depth, u);
+        GraphIndex v_depth = get(lca.depth, v);
+        if (u_depth > v_depth) {
+            u = graph_lca_ancestor(lca, u, u_depth - v_depth);
+        } else if (v_depth > u_depth) {
+            v = graph_lca_ancestor(lca, v, v_depth - u_depth);
+        }
+
+        if (u == v) {
+            return u;
+        }
+
+        size_t n = lca.depth.len;
+        for (size_t j = lca.levels; j > 0; j -= 1) {
+            GraphIndex u_up = get(lca.up, (j - 1) * n + u);
+            GraphIndex v_up = get(lca.up, (j - 1) * n + v);
+            if (u_up != v_up) {
+                u = u_up;
+                v = v_up;
+            }
+        }
+
+        assert(get(lca.up, u) == get(lca.up, v));
+        return get(lca.up, u);
+    }
+
+    static inline GraphIndex graph_lca_dist(
+        GraphLca lca,
+        GraphIndex u,
+        GraphIndex v
+    ) {
+        GraphIndex w = graph_lca(lca, u, v);
+        return get(lca.depth, u) + get(lca.depth, v) - 2 * get(lca.depth, w);
+    }
+
+    // The tree path from u to v inclusive, in order
+    static inline GraphSubset graph_lca_path(
+        GraphLca lca,
+        GraphIndex u,
+        GraphIndex v,
+        AvenArena *arena
+    ) {
+        GraphIndex w = graph_lca(lca, u, v);
+        GraphIndex u_len = get(lca.depth, u) - get(lca.depth, w);
+        GraphIndex v_len = get(lca.depth, v) - get(lca.depth, w);
+
+        GraphSubset path = aven_arena_create_slice(
+            GraphIndex,
+            arena,
+            u_len + v_len + 1
+        );
+
+        for (GraphIndex i = 0; i < u_len; i += 1) {
+            get(path, i) = u;
+            u = get(lca.up, u);
+        }
+        get(path, u_len) = w;
+        for (GraphIndex i = 0; i < v_len; i += 1) {
+            get(path, path.len - 1 - i) = v;
+            v = get(lca.up, v);
+        }
+
+        return path;
+    }
+
+#endif // GRAPH_LCA_H
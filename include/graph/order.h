@@ -0,0 +1,392 @@
+#ifndef GRAPH_ORDER_H
+    #define GRAPH_ORDER_H
+
+    #include <aven.h>
+    #include <aven/arena.h>
+
+    #include "../graph.h"
+
+    // Vertex permutation: forward maps an old label to its new label and
+    // inverse maps a new label back to the old vertex
+
+    typedef struct {
+        GraphPropIndex forward;
+        GraphPropIndex inverse;
+    } GraphPerm;
+
+    static inline GraphPerm graph_perm_invert(GraphPerm perm) {
+        return (GraphPerm){ .forward = perm.inverse, .inverse = perm.forward };
+    }
+
+    static inline GraphPerm graph_perm_from_inverse(
+        GraphPropIndex inverse,
+        AvenArena *arena
+    ) {
+        GraphPerm perm = {
+            .forward = { .len = inverse.len },
+            .inverse = inverse,
+        };
+        perm.forward.ptr = aven_arena_create_array(
+            GraphIndex,
+            arena,
+            perm.forward.len
+        );
+
+        for (GraphIndex i = 0; i < inverse.len; i += 1) {
+            get(perm.forward, get(inverse, i)) = i;
+        }
+
+        return perm;
+    }
+
+    // Stable LSD radix sort of the vertices by key, writes the vertices in
+    // sorted order to order
+
+    static inline void graph_order_sort_keys(
+        GraphPropIndex order,
+        GraphPropUint32 keys,
+        AvenArena temp_arena
+    ) {
+        assert(order.len == keys.len);
+
+        GraphPropIndex scratch = aven_arena_create_slice(
+            GraphIndex,
+            &temp_arena,
+            keys.len
+        );
+
+        for (GraphIndex v = 0; v < order.len; v += 1) {
+            get(order, v) = v;
+        }
+
+        GraphPropIndex src = order;
+        GraphPropIndex dst = scratch;
+        for (uint32_t shift = 0; shift < 32; shift += 8) {
+            size_t counts[256] = { 0 };
+            for (GraphIndex i = 0; i < src.len; i += 1) {
+                counts[(get(keys, get(src, i)) >> shift) & 0xff] += 1;
+            }
+
+            size_t total = 0;
+            for (size_t b = 0; b < countof(counts); b += 1) {
+                size_t count = counts[b];
+                counts[b] = total;
+                total += count;
+            }
+
+            for (GraphIndex i = 0; i < src.len; i += 1) {
+                GraphIndex v = get(src, i);
+                get(dst, counts[(get(keys, v) >> shift) & 0xff]++) = v;
+            }
+
+            GraphPropIndex tmp = src;
+            src = dst;
+            dst = tmp;
+        }
+
+        // an even number of passes leaves the result in order
+        assert(src.ptr == order.ptr);
+    }
+
+    // Breadth-first order from root, remaining components are started from
+    // their least vertex; neighbors are visited in rotation order
+
+    static inline GraphPerm graph_order_bfs(
+        Graph graph,
+        GraphIndex root,
+        AvenArena *arena
+    ) {
+        assert(root < graph.adj.len or graph.adj.len == 0);
+
+        GraphPropIndex inverse = { .len = graph.adj.len };
+        inverse.ptr = aven_arena_create_array(GraphIndex, arena, inverse.len);
+
+        AvenArena temp_arena = *arena;
+        Slice(bool) visited = aven_arena_create_slice(
+            bool,
+            &temp_arena,
+            graph.adj.len
+        );
+        for (GraphIndex v = 0; v < visited.len; v += 1) {
+            get(visited, v) = false;
+        }
+
+        // inverse doubles as the queue: the vertices in it are exactly the
+        // vertices labeled so far
+        GraphIndex front = 0;
+        GraphIndex back = 0;
+        GraphIndex next_root = 0;
+        while (back < inverse.len) {
+            if (front == back) {
+                GraphIndex r = root;
+                if (back != 0) {
+                    while (get(visited, next_root)) {
+                        next_root += 1;
+                    }
+                    r = next_root;
+                }
+                get(visited, r) = true;
+                get(inverse, back) = r;
+                back += 1;
+            }
+
+            GraphIndex v = get(inverse, front);
+            front += 1;
+
+            GraphAdj v_adj = get(graph.adj, v);
+            for (GraphIndex i = 0; i < v_adj.len; i += 1) {
+                GraphIndex u = graph_nb(graph.nb, v_adj, i);
+                if (!get(visited, u)) {
+                    get(visited, u) = true;
+                    get(inverse, back) = u;
+                    back += 1;
+                }
+            }
+        }
+
+        return graph_perm_from_inverse(inverse, arena);
+    }
+
+    // Cuthill-McKee order: breadth-first from root with the unvisited
+    // neighbors of each vertex labeled in increasing degree
+
+    static inline GraphPerm graph_order_cuthill_mckee(
+        Graph graph,
+        GraphIndex root,
+        AvenArena *arena
+    ) {
+        assert(root < graph.adj.len or graph.adj.len == 0);
+
+        GraphPropIndex inverse = { .len = graph.adj.len };
+        inverse.ptr = aven_arena_create_array(GraphIndex, arena, inverse.len);
+
+        AvenArena temp_arena = *arena;
+        Slice(bool) visited = aven_arena_create_slice(
+            bool,
+            &temp_arena,
+            graph.adj.len
+        );
+        for (GraphIndex v = 0; v < visited.len; v += 1) {
+            get(visited, v) = false;
+        }
+
+        GraphIndex front = 0;
+        GraphIndex back = 0;
+        GraphIndex next_root = 0;
+        while (back < inverse.len) {
+            if (front == back) {
+                GraphIndex r = root;
+                if (back != 0) {
+                    while (get(visited, next_root)) {
+                        next_root += 1;
+                    }
+                    r = next_root;
+                }
+                get(visited, r) = true;
+                get(inverse, back) = r;
+                back += 1;
+            }
+
+            GraphIndex v = get(inverse, front);
+            front += 1;
+
+            GraphIndex first = back;
+            GraphAdj v_adj = get(graph.adj, v);
+            for (GraphIndex i = 0; i < v_adj.len; i += 1) {
+                GraphIndex u = graph_nb(graph.nb, v_adj, i);
+                if (get(visited, u)) {
+                    continue;
+                }
+                get(visited, u) = true;
+
+                // insertion sort, stable so ties keep rotation order
+                GraphIndex u_deg = get(graph.adj, u).len;
+                GraphIndex j = back;
+                while (
+                    j > first and
+                    get(graph.adj, get(inverse, j - 1)).len > u_deg
+                ) {
+                    get(inverse, j) = get(inverse, j - 1);
+                    j -= 1;
+                }
+                get(inverse, j) = u;
+                back += 1;
+            }
+        }
+
+        return graph_perm_from_inverse(inverse, arena);
+    }
+
+    // Order by decreasing degree, ties keep their original order
+
+    static inline GraphPerm graph_order_degree(Graph graph, AvenArena *arena) {
+        GraphPropIndex inverse = { .len = graph.adj.len };
+        inverse.ptr = aven_arena_create_array(GraphIndex, arena, inverse.len);
+
+        AvenArena temp_arena = *arena;
+        GraphPropUint32 keys = aven_arena_create_slice(
+            uint32_t,
+            &temp_arena,
+            graph.adj.len
+        );
+        for (GraphIndex v = 0; v < keys.len; v += 1) {
+            get(keys, v) = UINT32_MAX - (uint32_t)get(graph.adj, v).len;
+        }
+
+        graph_order_sort_keys(inverse, keys, temp_arena);
+
+        return graph_perm_from_inverse(inverse, arena);
+    }
+
+    // Relabel a graph by a permutation: new vertex i is old vertex
+    // inverse[i] and neighbor lists are laid out in the new order with their
+    // rotation order unchanged
+
+    static inline Graph graph_relabel(
+        Graph graph,
+        GraphPerm perm,
+        AvenArena *arena
+    ) {
+        assert(perm.forward.len == graph.adj.len);
+        assert(perm.inverse.len == graph.adj.len);
+
+        Graph new_graph = {
+            .nb = { .len = graph.nb.len },
+            .adj = { .len = graph.adj.len },
+        };
+        new_graph.nb.ptr = aven_arena_create_array(
+            GraphIndex,
+            arena,
+            new_graph.nb.len
+        );
+        new_graph.adj.ptr = aven_arena_create_array(
+            GraphAdj,
+            arena,
+            new_graph.adj.len
+        );
+
+        GraphIndex index = 0;
+        for (GraphIndex i = 0; i < new_graph.adj.len; i += 1) {
+            GraphAdj v_adj = get(graph.adj, get(perm.inverse, i));
+            get(new_graph.adj, i) = (GraphAdj){
+                .index = index,
+                .len = v_adj.len,
+            };
+
+            for (GraphIndex j = 0; j < v_adj.len; j += 1) {
+                get(new_graph.nb, index + j) = get(
+                    perm.forward,
+                    graph_nb(graph.nb, v_adj, j)
+                );
+            }
+
+            index += v_adj.len;
+        }
+
+        return new_graph;
+    }
+
+    // Back indices are positions in the rotation, which relabeling preserves
+
+    static inline GraphAug graph_aug_relabel(
+        GraphAug graph,
+        GraphPerm perm,
+        AvenArena *arena
+    ) {
+        assert(perm.forward.len == graph.adj.len);
+        assert(perm.inverse.len == graph.adj.len);
+
+        GraphAug new_graph = {
+            .nb = { .len = graph.nb.len },
+            .adj = { .len = graph.adj.len },
+        };
+        new_graph.nb.ptr = aven_arena_create_array(
+            GraphAugNb,
+            arena,
+            new_graph.nb.len
+        );
+        new_graph.adj.ptr = aven_arena_create_array(
+            GraphAdj,
+            arena,
+            new_graph.adj.len
+        );
+
+        GraphIndex index = 0;
+        for (GraphIndex i = 0; i < new_graph.adj.len; i += 1) {
+            GraphAdj v_adj = get(graph.adj, get(perm.inverse, i));
+            get(new_graph.adj, i) = (GraphAdj){
+                .index = index,
+                .len = v_adj.len,
+            };
+
+            for (GraphIndex j = 0; j < v_adj.len; j += 1) {
+                GraphAugNb vu = graph_aug_nb(graph.nb, v_adj, j);
+                get(new_graph.nb, index + j) = (GraphAugNb){
+                    .vertex = get(perm.forward, vu.vertex),
+                    .back_index = vu.back_index,
+                };
+            }
+
+            index += v_adj.len;
+        }
+
+        return new_graph;
+    }
+
+    static inline GraphSubset graph_perm_subset(
+        GraphSubset subset,
+        GraphPerm perm,
+        AvenArena *arena
+    ) {
+        GraphSubset new_subset = { .len = subset.len };
+        new_subset.ptr = aven_arena_create_array(
+            GraphIndex,
+            arena,
+            new_subset.len
+        );
+
+        for (GraphIndex i = 0; i < subset.len; i += 1) {
+            get(new_subset, i) = get(perm.forward, get(subset, i));
+        }
+
+        return new_subset;
+    }
+
+    // Move per-vertex properties to the new labels, use graph_perm_invert to
+    // map a result on the relabeled graph back to the original labels
+
+    static inline GraphPropUint32 graph_perm_prop_uint32(
+        GraphPropUint32 prop,
+        GraphPerm perm,
+        AvenArena *arena
+    ) {
+        assert(prop.len == perm.forward.len);
+
+        GraphPropUint32 new_prop = { .len = prop.len };
+        new_prop.ptr = aven_arena_create_array(uint32_t, arena, new_prop.len);
+
+        for (GraphIndex i = 0; i < new_prop.len; i += 1) {
+            get(new_prop, i) = get(prop, get(perm.inverse, i));
+        }
+
+        return new_prop;
+    }
+
+    static inline GraphPropUint8 graph_perm_prop_uint8(
+        GraphPropUint8 prop,
+        GraphPerm perm,
+        AvenArena *arena
+    ) {
+        assert(prop.len == perm.forward.len);
+
+        GraphPropUint8 new_prop = { .len = prop.len };
+        new_prop.ptr = aven_arena_create_array(uint8_t, arena, new_prop.len);
+
+        for (GraphIndex i = 0; i < new_prop.len; i += 1) {
+            get(new_prop, i) = get(prop, get(perm.inverse, i));
+        }
+
+        return new_prop;
+    }
+
+#endif // GRAPH_ORDER_H
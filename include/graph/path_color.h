@@ -7,9 +7,9 @@
         Graph graph;
         GraphPropUint8 coloring;
         GraphPropUint8 visited;
-        uint32_t next;
-        uint32_t checked;
-        Optional(uint32_t) maybe_v;
+        GraphIndex next;
+        GraphIndex checked;
+        Optional(GraphIndex) maybe_v;
     } GraphPathColorVerifyCtx;
 
     static inline GraphPathColorVerifyCtx graph_path_color_verify_init(
@@ -28,7 +28,7 @@
             arena,
             ctx.visited.len
         );
-        for (uint32_t i = 0; i < ctx.visited.len; i += 1) {
+        for (GraphIndex i = 0; i < ctx.visited.len; i += 1) {
             get(ctx.visited, i) = 0;
         }
 
@@ -39,7 +39,7 @@
         GraphPathColorVerifyCtx *ctx
     ) {
         while (!ctx->maybe_v.valid and ctx->next < ctx->graph.adj.len) {
-            uint32_t v;
+            GraphIndex v;
             do {
                 v = ctx->next;
                 ctx->next += 1;
@@ -49,11 +49,11 @@
             } while (get(ctx->visited, v) != 0);
 
             uint8_t color = get(ctx->coloring, v);
-            uint32_t color_degree = 0;
+            GraphIndex color_degree = 0;
 
             GraphAdj v_adj = get(ctx->graph.adj, v);
-            for (uint32_t i = 0; i < v_adj.len; i += 1) {
-                uint32_t n = graph_nb(ctx->graph.nb, v_adj, i);
+            for (GraphIndex i = 0; i < v_adj.len; i += 1) {
+                GraphIndex n = graph_nb(ctx->graph.nb, v_adj, i);
                 if (get(ctx->coloring, n) == color) {
                     color_degree += 1;
                     if (color_degree > 1) {
@@ -72,7 +72,7 @@
             return true;
         }
 
-        uint32_t v = ctx->maybe_v.value;
+        GraphIndex v = ctx->maybe_v.value;
         uint8_t color = get(ctx->coloring, v);
 
         get(ctx->visited, v) = 1;
@@ -80,8 +80,8 @@
         ctx->maybe_v.valid = false;
 
         GraphAdj v_adj = get(ctx->graph.adj, v);
-        for (uint32_t i = 0; i < v_adj.len; i += 1) {
-            uint32_t n = graph_nb(ctx->graph.nb, v_adj, i);
+        for (GraphIndex i = 0; i < v_adj.len; i += 1) {
+            GraphIndex n = graph_nb(ctx->graph.nb, v_adj, i);
             if (get(ctx->coloring, n) == color and get(ctx->visited, n) == 0) {
                 if (ctx->maybe_v.valid) {
                     return true;
@@ -95,6 +95,21 @@
         return false;
     }
 
+    // Check at most budget vertex steps, returns true once the verification
+    // is finished and graph_path_color_verify_result is valid
+    static inline bool graph_path_color_verify_run(
+        GraphPathColorVerifyCtx *ctx,
+        size_t budget
+    ) {
+        for (; budget > 0; budget -= 1) {
+            if (graph_path_color_verify_step(ctx)) {
+                return true;
+            }
+        }
+
+        return false;
+    }
+
     static inline bool graph_path_color_verify_result(
         GraphPathColorVerifyCtx *ctx
     ) {
@@ -24,12 +24,12 @@
             &temp_arena,
             graph.nb.len
         );
-        for (uint32_t i = 0; i < visited.len; i += 1) {
+        for (GraphIndex i = 0; i < visited.len; i += 1) {
             get(visited, i) = false;
         }
 
-        uint32_t vertices = (uint32_t)graph.adj.len;
-        uint32_t edges = (uint32_t)graph.nb.len / 2;
+        GraphIndex vertices = (GraphIndex)graph.adj.len;
+        GraphIndex edges = (GraphIndex)graph.nb.len / 2;
 
         if (vertices > 2) {
             if (edges > 3 * vertices - 6) {
@@ -47,15 +47,15 @@
             return false;
         }
 
-        uint32_t faces = 0;
+        GraphIndex faces = 0;
 
-        for (uint32_t v = 0; v < graph.adj.len; v += 1) {
+        for (GraphIndex v = 0; v < graph.adj.len; v += 1) {
             GraphAdj v_adj = get(graph.adj, v);
-            for (uint32_t i = 0; i < v_adj.len; i += 1) {
-                uint32_t count = 0;
-                uint32_t u = v;
+            for (GraphIndex i = 0; i < v_adj.len; i += 1) {
+                GraphIndex count = 0;
+                GraphIndex u = v;
                 GraphAdj u_adj = v_adj;
-                uint32_t uw_index = i;
+                GraphIndex uw_index = i;
                 GraphAugNb uw = graph_aug_nb(graph.nb, u_adj, uw_index);
 
                 while (
@@ -88,7 +88,7 @@
             }
         }
 
-        for (uint32_t i = 0; i < visited.len; i += 1) {
+        for (GraphIndex i = 0; i < visited.len; i += 1) {
             if (!get(visited, i)) {
                 return false;
             }
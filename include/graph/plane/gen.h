@@ -86,7 +86,7 @@
                 float x_scale = (x_end - x_start - 2.0f * side_space) /
                     (float)(width + 1);
                 for (uint32_t x = 0; x < width; x += 1) {
-                    uint32_t v = graph_gen_pyramid_coord(k, x, y);
+                    GraphIndex v = graph_gen_pyramid_coord(k, x, y);
                     float x_coord = x_start +
                         side_space +
                         (float)(x + 1) * x_scale;
@@ -99,9 +99,9 @@
             }
             for (uint32_t y = 0; y < min(2, k); y += 1) {
                 uint32_t width = k - y;
-                uint32_t v = graph_gen_pyramid_coord(k, 0, y);
+                GraphIndex v = graph_gen_pyramid_coord(k, 0, y);
                 if (y == 0) {
-                    uint32_t u = (width == 1) ?
+                    GraphIndex u = (width == 1) ?
                         1 :
                         graph_gen_pyramid_coord(k, 1, y);
                     area = min(
@@ -605,7 +605,7 @@
         Graph graph = { .nb = { .len = 6 * size - 12 }, .adj = { .len = size } };
 
         graph.adj.ptr = aven_arena_create_array(GraphAdj, arena, graph.adj.len);
-        graph.nb.ptr = aven_arena_create_array(uint32_t, arena, graph.nb.len);
+        graph.nb.ptr = aven_arena_create_array(GraphIndex, arena, graph.nb.len);
 
         return graph;
     }
@@ -715,4 +715,171 @@
 
         return graph_plane_gen_triangulation_data(&ctx, graph);
     }
+
+    typedef struct {
+        GraphAug graph;
+        GraphPlaneEmbedding embedding;
+    } GraphPlaneGenAugData;
+
+    static inline GraphAug graph_plane_gen_triangulation_aug_graph_alloc(
+        uint32_t size,
+        AvenArena *arena
+    ) {
+        assert(size >= 3);
+
+        GraphAug graph = {
+            .nb = { .len = 6 * size - 12 },
+            .adj = { .len = size },
+        };
+
+        graph.adj.ptr = aven_arena_create_array(GraphAdj, arena, graph.adj.len);
+        graph.nb.ptr = aven_arena_create_array(GraphAugNb, arena, graph.nb.len);
+
+        return graph;
+    }
+
+    // Like graph_plane_gen_triangulation_data, but the back indices are read
+    // off the face adjacency instead of requiring a graph_aug pass
+    static inline GraphPlaneGenAugData graph_plane_gen_triangulation_aug_data(
+        GraphPlaneGenTriangulationCtx *ctx,
+        GraphAug graph,
+        AvenArena temp_arena
+    ) {
+        assert(graph.adj.len >= ctx->embedding.len);
+        graph.adj.len = ctx->embedding.len;
+        for (uint32_t v = 0; v < graph.adj.len; v += 1) {
+            get(graph.adj, v) = (GraphAdj){ 0 };
+        }
+
+        // the half-edge from vertices[k] to vertices[(k + 1) % 3] of face f
+        // is stored at nb index get(corners, 3 * f + k), the removed
+        // diagonal of the square is marked with GRAPH_INDEX_MAX
+        GraphPropIndex corners = aven_arena_create_slice(
+            GraphIndex,
+            &temp_arena,
+            3 * ctx->faces.len
+        );
+        for (uint32_t i = 0; i < corners.len; i += 1) {
+            get(corners, i) = GRAPH_INDEX_MAX;
+        }
+
+        uint32_t nb_index = 0;
+        for (uint32_t i = 0; i < ctx->faces.len; i += 1) {
+            GraphPlaneGenFace *face = &list_get(ctx->faces, i);
+
+            for (uint32_t j = 0; j < 3; j += 1) {
+                uint32_t v = face->vertices[j];
+                if (get(graph.adj, v).len != 0) {
+                    continue;
+                }
+
+                get(graph.adj, v).index = nb_index;
+
+                uint32_t face_index = i;
+                uint32_t k = j;
+                do {
+                    GraphPlaneGenFace *cur_face = &list_get(
+                        ctx->faces,
+                        face_index
+                    );
+                    if (face_index != i) {
+                        k = 0;
+                        for (; k < 3; k += 1) {
+                            if (cur_face->vertices[k] == v) {
+                                break;
+                            }
+                        }
+                        assert(k < 3);
+                    }
+
+                    uint32_t u = cur_face->vertices[(k + 1) % 3];
+                    if (
+                        !ctx->square or
+                        ((u != 1 or v != 3) and (u != 3 or v != 1))
+                    ) {
+                        get(graph.nb, nb_index) = (GraphAugNb){ .vertex = u };
+                        get(corners, 3 * face_index + k) = nb_index;
+                        nb_index += 1;
+                    }
+                    face_index = cur_face->neighbors[k];
+                } while (face_index != i);
+
+                get(graph.adj, v).len = nb_index - get(graph.adj, v).index;
+            }
+        }
+
+        // the twin of the half-edge from v to u in a face runs from u to v in
+        // the neighboring face across that edge
+        for (uint32_t i = 0; i < ctx->faces.len; i += 1) {
+            GraphPlaneGenFace *face = &list_get(ctx->faces, i);
+
+            for (uint32_t j = 0; j < 3; j += 1) {
+                GraphIndex vu_index = get(corners, 3 * i + j);
+                if (vu_index == GRAPH_INDEX_MAX) {
+                    continue;
+                }
+
+                uint32_t u = face->vertices[(j + 1) % 3];
+                uint32_t twin_face_index = face->neighbors[j];
+                GraphPlaneGenFace *twin_face = &list_get(
+                    ctx->faces,
+                    twin_face_index
+                );
+
+                uint32_t k = 0;
+                for (; k < 3; k += 1) {
+                    if (twin_face->vertices[k] == u) {
+                        break;
+                    }
+                }
+                assert(k < 3);
+                assert(twin_face->vertices[(k + 1) % 3] == face->vertices[j]);
+
+                get(graph.nb, vu_index).back_index =
+                    get(corners, 3 * twin_face_index + k) -
+                    get(graph.adj, u).index;
+            }
+        }
+
+        return (GraphPlaneGenAugData){
+            .graph = graph,
+            .embedding = (GraphPlaneEmbedding){
+                .ptr = ctx->embedding.ptr,
+                .len = ctx->embedding.len,
+            },
+        };
+    }
+
+    static inline GraphPlaneGenAugData graph_plane_gen_triangulation_aug(
+        uint32_t size,
+        Aff2 trans,
+        float min_area,
+        float min_coeff,
+        bool square,
+        AvenRng rng,
+        AvenArena *arena
+    ) {
+        assert(size >= 3);
+
+        GraphAug graph = graph_plane_gen_triangulation_aug_graph_alloc(
+            size,
+            arena
+        );
+        GraphPlaneEmbedding embedding = { .len = size };
+        embedding.ptr = aven_arena_create_array(Vec2, arena, embedding.len);
+
+        AvenArena temp_arena = *arena;
+        GraphPlaneGenTriangulationCtx ctx = graph_plane_gen_triangulation_init(
+            embedding,
+            trans,
+            min_area,
+            min_coeff,
+            square,
+            &temp_arena
+        );
+        while (!graph_plane_gen_triangulation_step(&ctx, rng)) {}
+
+        return graph_plane_gen_triangulation_aug_data(&ctx, graph, temp_arena);
+    }
 #endif // GRAPH_PLANE_GEN_H
+
@@ -0,0 +1,157 @@
+#ifndef GRAPH_PLANE_ORDER_H
+    #define GRAPH_PLANE_ORDER_H
+
+    #include <aven.h>
+    #include <aven/arena.h>
+    #include <aven/math.h>
+
+    #include "../../graph.h"
+    #include "../order.h"
+    #include "../plane.h"
+
+    // Space filling curve orders: vertex positions are snapped to a
+    // 2^16 x 2^16 grid over the bounding box of the embedding and sorted by
+    // their index along the curve
+
+    #define GRAPH_PLANE_ORDER_GRID_BITS 16
+
+    typedef uint32_t (*GraphPlaneOrderCurveFn)(uint32_t x, uint32_t y);
+
+    static inline uint32_t graph_plane_order_morton_index(
+        uint32_t x,
+        uint32_t y
+    ) {
+        uint32_t d = 0;
+        for (uint32_t i = 0; i < GRAPH_PLANE_ORDER_GRID_BITS; i += 1) {
+            d |= ((x >> i) & 1) << (2 * i);
+            d |= ((y >> i) & 1) << (2 * i + 1);
+        }
+        return d;
+    }
+
+    static inline uint32_t graph_plane_order_hilbert_index(
+        uint32_t x,
+        uint32_t y
+    ) {
+        uint32_t n = 1U << GRAPH_PLANE_ORDER_GRID_BITS;
+        uint32_t d = 0;
+        for (uint32_t s = n / 2; s > 0; s /= 2) {
+            uint32_t rx = (x & s) != 0;
+            uint32_t ry = (y & s) != 0;
+            d += s * s * ((3 * rx) ^ ry);
+
+            // rotate the quadrant so the curve enters at the origin
+            if (ry == 0) {
+                if (rx == 1) {
+                    x = n - 1 - x;
+                    y = n - 1 - y;
+                }
+                uint32_t t = x;
+                x = y;
+                y = t;
+            }
+        }
+        return d;
+    }
+
+    static inline GraphPerm graph_plane_order_curve(
+        GraphPlaneEmbedding embedding,
+        GraphPlaneOrderCurveFn curve_fn,
+        AvenArena *arena
+    ) {
+        GraphPropIndex inverse = { .len = embedding.len };
+        inverse.ptr = aven_arena_create_array(GraphIndex, arena, inverse.len);
+
+        AvenArena temp_arena = *arena;
+        GraphPropUint32 keys = aven_arena_create_slice(
+            uint32_t,
+            &temp_arena,
+            embedding.len
+        );
+
+        Vec2 min_pos = { 0.0f, 0.0f };
+        Vec2 max_pos = { 0.0f, 0.0f };
+        if (embedding.len > 0) {
+            vec2_copy(min_pos, get(embedding, 0));
+            vec2_copy(max_pos, get(embedding, 0));
+        }
+        for (uint32_t v = 0; v < embedding.len; v += 1) {
+            for (size_t k = 0; k < 2; k += 1) {
+                min_pos[k] = min(min_pos[k], get(embedding, v)[k]);
+                max_pos[k] = max(max_pos[k], get(embedding, v)[k]);
+            }
+        }
+
+        float grid_max = (float)((1U << GRAPH_PLANE_ORDER_GRID_BITS) - 1);
+        Vec2 scale = { 0.0f, 0.0f };
+        for (size_t k = 0; k < 2; k += 1) {
+            if (max_pos[k] > min_pos[k]) {
+                scale[k] = grid_max / (max_pos[k] - min_pos[k]);
+            }
+        }
+
+        for (uint32_t v = 0; v < embedding.len; v += 1) {
+            uint32_t x = (uint32_t)(
+                (get(embedding, v)[0] - min_pos[0]) * scale[0]
+            );
+            uint32_t y = (uint32_t)(
+                (get(embedding, v)[1] - min_pos[1]) * scale[1]
+            );
+            get(keys, v) = curve_fn(
+                min(x, (uint32_t)grid_max),
+                min(y, (uint32_t)grid_max)
+            );
+        }
+
+        graph_order_sort_keys(inverse, keys, temp_arena);
+
+        return graph_perm_from_inverse(inverse, arena);
+    }
+
+    static inline GraphPerm graph_plane_order_hilbert(
+        GraphPlaneEmbedding embedding,
+        AvenArena *arena
+    ) {
+        return graph_plane_order_curve(
+            embedding,
+            graph_plane_order_hilbert_index,
+            arena
+        );
+    }
+
+    static inline GraphPerm graph_plane_order_morton(
+        GraphPlaneEmbedding embedding,
+        AvenArena *arena
+    ) {
+        return graph_plane_order_curve(
+            embedding,
+            graph_plane_order_morton_index,
+            arena
+        );
+    }
+
+    static inline GraphPlaneEmbedding graph_plane_embedding_relabel(
+        GraphPlaneEmbedding embedding,
+        GraphPerm perm,
+        AvenArena *arena
+    ) {
+        assert(embedding.len == perm.inverse.len);
+
+        GraphPlaneEmbedding new_embedding = { .len = embedding.len };
+        new_embedding.ptr = aven_arena_create_array(
+            Vec2,
+            arena,
+            new_embedding.len
+        );
+
+        for (uint32_t i = 0; i < new_embedding.len; i += 1) {
+            vec2_copy(
+                get(new_embedding, i),
+                get(embedding, get(perm.inverse, i))
+            );
+        }
+
+        return new_embedding;
+    }
+
+#endif // GRAPH_PLANE_ORDER_H
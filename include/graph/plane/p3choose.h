@@ -13,13 +13,13 @@
     typedef Slice(GraphPlaneP3ChooseList) GraphPlaneP3ChooseListProp;
 
     typedef struct {
-        uint32_t first;
-        uint32_t last;
+        GraphIndex first;
+        GraphIndex last;
     } GraphPlaneP3ChooseNeighbors;
 
     typedef struct {
         GraphPlaneP3ChooseNeighbors nb;
-        uint32_t mark;
+        GraphIndex mark;
     } GraphPlaneP3ChooseVertexLoc;
 
     typedef struct {
@@ -29,9 +29,9 @@
     } GraphPlaneP3ChooseVertex;
 
     typedef struct {
-        uint32_t x;
-        uint32_t y;
-        uint32_t z;
+        GraphIndex x;
+        GraphIndex y;
+        GraphIndex z;
         GraphPlaneP3ChooseVertexLoc x_loc;
         GraphPlaneP3ChooseVertexLoc y_loc;
         GraphPlaneP3ChooseVertexLoc z_loc;
@@ -42,10 +42,12 @@
 
     typedef struct {
         GraphAugNbSlice nb;
-        Slice(GraphPlaneP3ChooseVertex) vertex_info;
-        Slice(uint32_t) marks;
+        GraphAdjSlice adj;
+        Slice(GraphPlaneP3ChooseVertexLoc) locs;
+        GraphPlaneP3ChooseListProp colors;
+        Slice(GraphIndex) marks;
         List(GraphPlaneP3ChooseFrame) frames;
-        uint32_t next_mark;
+        GraphIndex next_mark;
     } GraphPlaneP3ChooseCtx;
 
     static inline GraphPlaneP3ChooseCtx graph_plane_p3choose_init(
@@ -56,7 +58,9 @@
     ) {
         GraphPlaneP3ChooseCtx ctx = {
             .nb = graph.nb,
-            .vertex_info = { .len = graph.adj.len },
+            .adj = graph.adj,
+            .locs = { .len = graph.adj.len },
+            .colors = { .len = graph.adj.len },
             // Each new unique results from a different edge of the graph:
             .marks = { .len = (3 * graph.adj.len - 6) + 1 },
             // A new frame only occurs when splitting across an edge
@@ -69,48 +73,55 @@
             arena,
             ctx.frames.cap
         );
-        ctx.vertex_info.ptr = aven_arena_create_array(
-            GraphPlaneP3ChooseVertex,
+        ctx.locs.ptr = aven_arena_create_array(
+            GraphPlaneP3ChooseVertexLoc,
             arena,
-            ctx.vertex_info.len
+            ctx.locs.len
+        );
+        ctx.colors.ptr = aven_arena_create_array(
+            GraphPlaneP3ChooseList,
+            arena,
+            ctx.colors.len
+        );
+        ctx.marks.ptr = aven_arena_create_array(
+            GraphIndex,
+            arena,
+            ctx.marks.len
         );
-        ctx.marks.ptr = aven_arena_create_array(uint32_t, arena, ctx.marks.len);
 
-        for (uint32_t v = 0; v < ctx.vertex_info.len; v += 1) {
-            get(ctx.vertex_info, v) = (GraphPlaneP3ChooseVertex){
-                .adj = get(graph.adj, v),
-                .colors = get(color_lists, v),
-            };
+        for (GraphIndex v = 0; v < ctx.adj.len; v += 1) {
+            get(ctx.locs, v) = (GraphPlaneP3ChooseVertexLoc){ 0 };
+            get(ctx.colors, v) = get(color_lists, v);
         }
 
-        for (uint32_t i = 0; i < ctx.marks.len; i += 1) {
+        for (GraphIndex i = 0; i < ctx.marks.len; i += 1) {
             get(ctx.marks, i) = i;
         }
 
-        uint32_t face_mark = ctx.next_mark++;
+        GraphIndex face_mark = ctx.next_mark++;
 
-        uint32_t u = get(cwise_outer_face, cwise_outer_face.len - 1);
-        for (uint32_t i = 0; i < cwise_outer_face.len; i += 1) {
-            uint32_t v = get(cwise_outer_face, i);
-            GraphAdj v_adj = get(ctx.vertex_info, v).adj;
+        GraphIndex u = get(cwise_outer_face, cwise_outer_face.len - 1);
+        for (GraphIndex i = 0; i < cwise_outer_face.len; i += 1) {
+            GraphIndex v = get(cwise_outer_face, i);
+            GraphAdj v_adj = get(ctx.adj, v);
 
-            uint32_t vu_index = graph_aug_nb_index(graph.nb, v_adj, u);
-            uint32_t uv_index = graph_aug_nb(graph.nb, v_adj, vu_index)
+            GraphIndex vu_index = graph_aug_nb_index(graph.nb, v_adj, u);
+            GraphIndex uv_index = graph_aug_nb(graph.nb, v_adj, vu_index)
                 .back_index;
 
-            get(ctx.vertex_info, v).loc.nb.first = vu_index;
-            get(ctx.vertex_info, u).loc.nb.last = uv_index;
+            get(ctx.locs, v).nb.first = vu_index;
+            get(ctx.locs, u).nb.last = uv_index;
 
-            get(ctx.vertex_info, v).loc.mark = face_mark;
+            get(ctx.locs, v).mark = face_mark;
 
             u = v;
         }
 
-        uint32_t xyv = get(cwise_outer_face, 0);
-        GraphPlaneP3ChooseVertexLoc *xyv_loc = &get(ctx.vertex_info, xyv).loc;
+        GraphIndex xyv = get(cwise_outer_face, 0);
+        GraphPlaneP3ChooseVertexLoc *xyv_loc = &get(ctx.locs, xyv);
         xyv_loc->mark = ctx.next_mark++;
 
-        GraphPlaneP3ChooseList *xyv_colors = &get(ctx.vertex_info, xyv).colors;
+        GraphPlaneP3ChooseList *xyv_colors = &get(ctx.colors, xyv);
         assert(xyv_colors->len > 0);
         xyv_colors->len = 1;
 
@@ -127,7 +138,7 @@
     static inline GraphPlaneP3ChooseVertexLoc *graph_plane_p3choose_vloc(
         GraphPlaneP3ChooseCtx *ctx,
         GraphPlaneP3ChooseFrame *frame,
-        uint32_t v
+        GraphIndex v
     ) {
         if (v == frame->x) {
             return &frame->x_loc;
@@ -141,7 +152,7 @@
             return &frame->z_loc;
         }
 
-        return &get(ctx->vertex_info, v).loc;
+        return &get(ctx->locs, v);
     }
 
     static bool graph_plane_p3choose_has_color(
@@ -202,20 +213,19 @@
         GraphPlaneP3ChooseCtx *ctx,
         GraphPlaneP3ChooseFrame *frame
     ) {
-        GraphAdj z_adj = get(ctx->vertex_info, frame->z).adj;
+        GraphAdj z_adj = get(ctx->adj, frame->z);
         GraphPlaneP3ChooseVertexLoc *z_loc = graph_plane_p3choose_vloc(
             ctx,
             frame,
             frame->z
         );
-        GraphPlaneP3ChooseList *z_colors = &get(ctx->vertex_info, frame->z)
-            .colors;
+        GraphPlaneP3ChooseList *z_colors = &get(ctx->colors, frame->z);
         uint8_t z_color = get(*z_colors, 0);
 
-        uint32_t zu_index = z_loc->nb.first;
+        GraphIndex zu_index = z_loc->nb.first;
         GraphAugNb zu = graph_aug_nb(ctx->nb, z_adj, zu_index);
 
-        uint32_t u = zu.vertex;
+        GraphIndex u = zu.vertex;
         GraphPlaneP3ChooseVertexLoc *u_loc = graph_plane_p3choose_vloc(
             ctx,
             frame,
@@ -226,7 +236,7 @@
             if (frame->x == frame->y) {
                 assert(frame->z == frame->x);
                 graph_plane_p3choose_color_differently(
-                    &get(ctx->vertex_info, u).colors,
+                    &get(ctx->colors, u),
                     z_color
                 );
             }
@@ -249,13 +259,13 @@
             return false;
         }
 
-        GraphAdj u_adj = get(ctx->vertex_info, u).adj;
+        GraphAdj u_adj = get(ctx->adj, u);
         u_loc->nb.last = graph_adj_prev(u_adj, u_loc->nb.last);
         z_loc->nb.first = graph_adj_next(z_adj, z_loc->nb.first);
 
         if (frame->z == frame->x) {
             graph_plane_p3choose_color_differently(
-                &get(ctx->vertex_info, u).colors,
+                &get(ctx->colors, u),
                 z_color
             );
 
@@ -273,17 +283,17 @@
             z_loc = graph_plane_p3choose_vloc(ctx, frame, frame->z);
         }
 
-        uint32_t zv_index = graph_adj_next(z_adj, zu_index);
+        GraphIndex zv_index = graph_adj_next(z_adj, zu_index);
         GraphAugNb zv = graph_aug_nb(ctx->nb, z_adj, zv_index);
 
-        uint32_t v = zv.vertex;
-        GraphAdj v_adj = get(ctx->vertex_info, v).adj;
+        GraphIndex v = zv.vertex;
+        GraphAdj v_adj = get(ctx->adj, v);
         GraphPlaneP3ChooseVertexLoc *v_loc = graph_plane_p3choose_vloc(
             ctx,
             frame,
             v
         );
-        GraphPlaneP3ChooseList *v_colors = &get(ctx->vertex_info, v).colors;
+        GraphPlaneP3ChooseList *v_colors = &get(ctx->colors, v);
 
         if (v_loc->mark == 0) {
             *v_loc = (GraphPlaneP3ChooseVertexLoc){
@@ -303,7 +313,7 @@
                 frame->y = frame->x;
                 frame->z = frame->x;
             } else {
-                uint32_t new_mark = ctx->next_mark++;
+                GraphIndex new_mark = ctx->next_mark++;
                 list_push(ctx->frames) = (GraphPlaneP3ChooseFrame){
                     .x = v,
                     .y = v,
@@ -320,7 +330,7 @@
             }
         } else if (get(ctx->marks, v_loc->mark) == frame->y_loc.mark) {
             if (v_loc->nb.first != zv.back_index) {
-                uint32_t new_mark = ctx->next_mark++;
+                GraphIndex new_mark = ctx->next_mark++;
                 list_push(ctx->frames) = (GraphPlaneP3ChooseFrame){
                     .x = v,
                     .y = frame->z,
@@ -389,6 +399,34 @@
         return false;
     }
 
+    // Run at most budget frame steps, popping the next frame when the
+    // current one is done. The frame starts invalid and keeps the progress
+    // between calls, returns true when no frames remain.
+    static inline bool graph_plane_p3choose_run(
+        GraphPlaneP3ChooseCtx *ctx,
+        GraphPlaneP3ChooseFrameOptional *frame,
+        size_t budget
+    ) {
+        GraphPlaneP3ChooseFrameOptional cur_frame = *frame;
+        bool done = false;
+
+        for (; budget > 0; budget -= 1) {
+            if (!cur_frame.valid) {
+                cur_frame = graph_plane_p3choose_next_frame(ctx);
+                if (!cur_frame.valid) {
+                    done = true;
+                    break;
+                }
+            }
+            if (graph_plane_p3choose_frame_step(ctx, &cur_frame.value)) {
+                cur_frame.valid = false;
+            }
+        }
+
+        *frame = cur_frame;
+        return done;
+    }
+
     static inline GraphPropUint8 graph_plane_p3choose(
         GraphAug aug_graph,
         GraphPlaneP3ChooseListProp color_lists,
@@ -415,9 +453,9 @@
             frame = graph_plane_p3choose_next_frame(&ctx);
         } while (frame.valid);
 
-        for (uint32_t v = 0; v < coloring.len; v += 1) {
-            assert(get(ctx.vertex_info, v).colors.len == 1);
-            get(coloring, v) = get(get(ctx.vertex_info, v).colors, 0);
+        for (GraphIndex v = 0; v < coloring.len; v += 1) {
+            assert(get(ctx.colors, v).len == 1);
+            get(coloring, v) = get(get(ctx.colors, v), 0);
         }
 
         return coloring;
@@ -442,20 +480,19 @@
         GraphPlaneP3ChooseCtx *ctx,
         GraphPlaneP3ChooseFrame *frame
     ) {
-        GraphAdj z_adj = get(ctx->vertex_info, frame->z).adj;
+        GraphAdj z_adj = get(ctx->adj, frame->z);
         GraphPlaneP3ChooseVertexLoc *z_loc = graph_plane_p3choose_vloc(
             ctx,
             frame,
             frame->z
         );
-        GraphPlaneP3ChooseList *z_colors = &get(ctx->vertex_info, frame->z)
-            .colors;
+        GraphPlaneP3ChooseList *z_colors = &get(ctx->colors, frame->z);
         uint32_t z_color = get(*z_colors, 0);
 
-        uint32_t zu_index = z_loc->nb.first;
+        GraphIndex zu_index = z_loc->nb.first;
         GraphAugNb zu = graph_aug_nb(ctx->nb, z_adj, zu_index);
 
-        uint32_t u = zu.vertex;
+        GraphIndex u = zu.vertex;
 
         if (zu_index == z_loc->nb.last) {
             return GRAPH_PLANE_P3CHOOSE_CASE_BASE;
@@ -469,16 +506,16 @@
             return GRAPH_PLANE_P3CHOOSE_CASE_2;
         }
 
-        uint32_t zv_index = graph_adj_next(z_adj, zu_index);
+        GraphIndex zv_index = graph_adj_next(z_adj, zu_index);
         GraphAugNb zv = graph_aug_nb(ctx->nb, z_adj, zv_index);
 
-        uint32_t v = zv.vertex;
+        GraphIndex v = zv.vertex;
         GraphPlaneP3ChooseVertexLoc *v_loc = graph_plane_p3choose_vloc(
             ctx,
             frame,
             v
         );
-        GraphPlaneP3ChooseList *v_colors = &get(ctx->vertex_info, v).colors;
+        GraphPlaneP3ChooseList *v_colors = &get(ctx->colors, v);
 
         if (v_loc->mark == 0) {
             return GRAPH_PLANE_P3CHOOSE_CASE_3_1;
@@ -77,7 +77,7 @@
         };
         vec4_copy(simple_edge_info.color, edge_color);
 
-        GraphAdj z_adj = get(ctx->vertex_info, frame->z).adj;
+        GraphAdj z_adj = get(ctx->adj, frame->z);
 
         if (z_loc.nb.last != z_loc.nb.first) {
             uint32_t v = graph_aug_nb(
@@ -157,7 +157,7 @@
             GraphPlaneP3ChooseNeighbors v_nb = frame->x_loc.nb;
             uint32_t v_mark = get(ctx->marks, frame->x_loc.mark);
             do {
-                GraphAdj v_aug_adj = get(ctx->vertex_info, v).adj;
+                GraphAdj v_aug_adj = get(ctx->adj, v);
                 Vec2 v_pos;
                 vec2_copy(v_pos, get(embedding, v));
                 aff2_transform(v_pos, trans, v_pos);
@@ -284,7 +284,7 @@
             //         frame,
             //         frame->z
             //     );
-            //     GraphAugAdjList z_adj = get(ctx->vertex_info, frame->z).adj;
+            //     GraphAugAdjList z_adj = get(ctx->adj, frame->z);
             //     uint32_t u = get(z_adj, z_loc->nb.first).vertex;
             //     if (z_loc->nb.first != z_loc->nb.last) {
             //         u = get(
@@ -313,7 +313,7 @@
                     frame,
                     v
                 );
-                GraphAdj v_adj = get(ctx->vertex_info, v).adj;
+                GraphAdj v_adj = get(ctx->adj, v);
                 for (
                     uint32_t i = v_loc->nb.first;
                     i != v_loc->nb.last;
@@ -369,8 +369,8 @@
             };
 
             vec4_copy(edge_info.color, info->uncolored_edge_color);
-            for (uint32_t v = 0; v < ctx->vertex_info.len; v += 1) {
-                GraphAdj v_adj = get(ctx->vertex_info, v).adj;
+            for (uint32_t v = 0; v < ctx->adj.len; v += 1) {
+                GraphAdj v_adj = get(ctx->adj, v);
 
                 for (uint32_t i = 0; i < v_adj.len; i += 1) {
                     uint32_t u = graph_aug_nb(ctx->nb, v_adj, i).vertex;
@@ -457,8 +457,8 @@
             }
 
             vec4_copy(edge_info.color, info->edge_color);
-            for (uint32_t v = 0; v < ctx->vertex_info.len; v += 1) {
-                GraphAdj v_adj = get(ctx->vertex_info, v).adj;
+            for (uint32_t v = 0; v < ctx->adj.len; v += 1) {
+                GraphAdj v_adj = get(ctx->adj, v);
 
                 for (uint32_t i = 0; i < v_adj.len; i += 1) {
                     uint32_t u = graph_aug_nb(ctx->nb, v_adj, i).vertex;
@@ -467,8 +467,8 @@
                     }
 
                     if (
-                        get(ctx->vertex_info, v).loc.mark != 0 or
-                        get(ctx->vertex_info, u).loc.mark != 0
+                        get(ctx->locs, v).mark != 0 or
+                        get(ctx->locs, u).mark != 0
                     ) {
                         continue;
                     }
@@ -484,17 +484,15 @@
                 }
             }
 
-            for (uint32_t v = 0; v < ctx->vertex_info.len; v += 1) {
-                GraphAdj v_adj = get(ctx->vertex_info, v).adj;
-                GraphPlaneP3ChooseList *v_colors = &get(ctx->vertex_info, v)
-                    .colors;
+            for (uint32_t v = 0; v < ctx->adj.len; v += 1) {
+                GraphAdj v_adj = get(ctx->adj, v);
+                GraphPlaneP3ChooseList *v_colors = &get(ctx->colors, v);
                 for (uint32_t i = 0; i < v_adj.len; i += 1) {
                     uint32_t u = graph_aug_nb(ctx->nb, v_adj, i).vertex;
                     if (u < v) {
                         continue;
                     }
-                    GraphPlaneP3ChooseList *u_colors = &get(ctx->vertex_info, u)
-                        .colors;
+                    GraphPlaneP3ChooseList *u_colors = &get(ctx->colors, u);
                     if (
                         v_colors->len == 1 and
                         u_colors->len == 1 and
@@ -519,7 +517,7 @@
 
         // Draw vertex color lists
 
-        for (uint32_t v = 0; v < ctx->vertex_info.len; v += 1) {
+        for (uint32_t v = 0; v < ctx->adj.len; v += 1) {
             Vec2 v_pos;
             vec2_copy(v_pos, get(embedding, v));
             aff2_transform(v_pos, trans, v_pos);
@@ -539,7 +537,7 @@
                 info->outline_color
             );
 
-            GraphPlaneP3ChooseList v_list = get(ctx->vertex_info, v).colors;
+            GraphPlaneP3ChooseList v_list = get(ctx->colors, v);
             switch (v_list.len) {
                 case 1: {
                     Aff2 node_trans;
@@ -4,7 +4,6 @@
     #include <aven.h>
     #include <aven/arena.h>
     #include <aven/thread/pool.h>
-    #include <aven/thread/spinlock.h>
 
     #if !defined(__STDC_VERSION__) or __STDC_VERSION__ < 201112L
         #error "C11 or later is required"
@@ -13,41 +12,30 @@
     #include <stdatomic.h>
 
     #include "../../../graph.h"
+    #include "../../thread.h"
     #include "../p3choose.h"
 
     #define GRAPH_PLANE_P3CHOOSE_THREAD_MARK_SET_SIZE 64
-
-    typedef struct {
-        GraphAdj adj;
-        GraphPlaneP3ChooseVertexLoc loc;
-        GraphPlaneP3ChooseList colors;
-        uint32_t entry_index;
-    } GraphPlaneP3ChooseThreadVertex;
-
-    typedef List(GraphPlaneP3ChooseFrame) GraphPlaneP3ChooseThreadFrameList;
+    #define GRAPH_PLANE_P3CHOOSE_THREAD_ENTRY_SET_SIZE 64
 
     typedef struct {
         GraphPlaneP3ChooseFrame frame;
-        uint32_t parent;
+        GraphIndex parent;
     } GraphPlaneP3ChooseThreadEntry;
 
-    typedef struct {
-        uint32_t *ptr;
-        atomic_size_t len;
-        size_t cap;
-    } GraphPlaneP3ChooseThreadUint32List;
-
     typedef struct {
         GraphAugNbSlice nb;
-        Slice(GraphPlaneP3ChooseThreadVertex) vertex_info;
-        Slice(uint32_t) marks;
-        GraphPlaneP3ChooseThreadUint32List valid_entries;
-        Pool(GraphPlaneP3ChooseThreadEntry) entry_pool;
+        GraphAdjSlice adj;
+        Slice(GraphPlaneP3ChooseVertexLoc) locs;
+        GraphPlaneP3ChooseListProp colors;
+        // head of the chain of entries waiting on each vertex, stored + 1
+        Slice(GraphThreadAtomicIndex) entry_indices;
+        Slice(GraphIndex) marks;
+        Slice(GraphPlaneP3ChooseThreadEntry) entries;
+        GraphThreadStealCtx steal;
         size_t nthreads;
-        atomic_int threads_active;
-        atomic_int frames_active;
-        atomic_uint_least32_t next_mark;
-        AvenThreadSpinlock lock;
+        GraphThreadAtomicIndex next_mark;
+        GraphThreadAtomicIndex next_entry;
     } GraphPlaneP3ChooseThreadCtx;
 
     static inline GraphPlaneP3ChooseThreadCtx graph_plane_p3choose_thread_init(
@@ -59,253 +47,253 @@
     ) {
         GraphPlaneP3ChooseThreadCtx ctx = {
             .nb = graph.nb,
-            .vertex_info = { .len = graph.adj.len },
+            .adj = graph.adj,
+            .locs = { .len = graph.adj.len },
+            .colors = { .len = graph.adj.len },
+            .entry_indices = { .len = graph.adj.len },
             // Each unique mark results from a diferent edge of the graph:
             .marks = {
                 .len = nthreads * GRAPH_PLANE_P3CHOOSE_THREAD_MARK_SET_SIZE +
                     (3 * graph.adj.len - 6) +
                     1,
             },
-            // A new frame only occurs when splitting across an edge
-            .entry_pool = { .cap = 3 * graph.adj.len - 6 },
-            .valid_entries = { .cap = 3 * graph.adj.len - 6 },
+            // A new frame only occurs when splitting across an edge, entries
+            // are handed out to threads in blocks and never reused
+            .entries = {
+                .len = nthreads * GRAPH_PLANE_P3CHOOSE_THREAD_ENTRY_SET_SIZE +
+                    (3 * graph.adj.len - 6),
+            },
+            .steal = graph_thread_steal_init(
+                GraphPlaneP3ChooseFrame,
+                nthreads,
+                3 * graph.adj.len - 6,
+                arena
+            ),
             .nthreads = nthreads,
-            .next_mark = 1,
         };
 
-        ctx.vertex_info.ptr = aven_arena_create_array(
-            GraphPlaneP3ChooseThreadVertex,
+        ctx.locs.ptr = aven_arena_create_array(
+            GraphPlaneP3ChooseVertexLoc,
             arena,
-            ctx.vertex_info.len
+            ctx.locs.len
         );
-        ctx.marks.ptr = aven_arena_create_array(uint32_t, arena, ctx.marks.len);
-        ctx.entry_pool.ptr = (void *)aven_arena_create_array(
-            PoolEntry(GraphPlaneP3ChooseThreadEntry),
+        ctx.colors.ptr = aven_arena_create_array(
+            GraphPlaneP3ChooseList,
             arena,
-            ctx.entry_pool.cap
+            ctx.colors.len
         );
-        ctx.valid_entries.ptr = aven_arena_create_array(
-            uint32_t,
+        ctx.entry_indices.ptr = aven_arena_create_array(
+            GraphThreadAtomicIndex,
             arena,
-            ctx.valid_entries.cap
+            ctx.entry_indices.len
+        );
+        ctx.marks.ptr = aven_arena_create_array(
+            GraphIndex,
+            arena,
+            ctx.marks.len
+        );
+        ctx.entries.ptr = aven_arena_create_array(
+            GraphPlaneP3ChooseThreadEntry,
+            arena,
+            ctx.entries.len
         );
-
-        atomic_init(&ctx.valid_entries.len, 0);
-        atomic_init(&ctx.threads_active, 0);
-        atomic_init(&ctx.frames_active, 0);
         atomic_init(&ctx.next_mark, 1);
-        aven_thread_spinlock_init(&ctx.lock);
+        atomic_init(&ctx.next_entry, 0);
 
-        for (uint32_t v = 0; v < ctx.vertex_info.len; v += 1) {
-            get(ctx.vertex_info, v) = (GraphPlaneP3ChooseThreadVertex){
-                .adj = get(graph.adj, v),
-                .colors = get(color_lists, v),
-            };
+        for (GraphIndex v = 0; v < ctx.adj.len; v += 1) {
+            get(ctx.locs, v) = (GraphPlaneP3ChooseVertexLoc){ 0 };
+            get(ctx.colors, v) = get(color_lists, v);
+            atomic_init(&get(ctx.entry_indices, v), 0);
         }
 
-        for (uint32_t i = 0; i < ctx.marks.len; i += 1) {
+        for (GraphIndex i = 0; i < ctx.marks.len; i += 1) {
             get(ctx.marks, i) = i;
         }
 
-        uint32_t face_mark = ctx.next_mark++;
+        GraphIndex face_mark = (GraphIndex)atomic_fetch_add_explicit(
+            &ctx.next_mark,
+            1,
+            memory_order_relaxed
+        );
 
-        uint32_t u = get(cwise_outer_face, cwise_outer_face.len - 1);
-        for (uint32_t i = 0; i < cwise_outer_face.len; i += 1) {
-            uint32_t v = get(cwise_outer_face, i);
-            GraphAdj v_adj = get(ctx.vertex_info, v).adj;
+        GraphIndex u = get(cwise_outer_face, cwise_outer_face.len - 1);
+        for (GraphIndex i = 0; i < cwise_outer_face.len; i += 1) {
+            GraphIndex v = get(cwise_outer_face, i);
+            GraphAdj v_adj = get(ctx.adj, v);
 
-            uint32_t vu_index = graph_aug_nb_index(graph.nb, v_adj, u);
-            uint32_t uv_index = graph_aug_nb(graph.nb, v_adj, vu_index)
+            GraphIndex vu_index = graph_aug_nb_index(graph.nb, v_adj, u);
+            GraphIndex uv_index = graph_aug_nb(graph.nb, v_adj, vu_index)
                 .back_index;
 
-            get(ctx.vertex_info, v).loc.nb.first = vu_index;
-            get(ctx.vertex_info, u).loc.nb.last = uv_index;
+            get(ctx.locs, v).nb.first = vu_index;
+            get(ctx.locs, u).nb.last = uv_index;
 
-            get(ctx.vertex_info, v).loc.mark = face_mark;
+            get(ctx.locs, v).mark = face_mark;
 
             u = v;
         }
 
-        uint32_t xyv = get(cwise_outer_face, 0);
-        GraphPlaneP3ChooseVertexLoc *xyv_loc = &get(ctx.vertex_info, xyv).loc;
-        xyv_loc->mark = ctx.next_mark++;
+        GraphIndex xyv = get(cwise_outer_face, 0);
+        GraphPlaneP3ChooseVertexLoc *xyv_loc = &get(ctx.locs, xyv);
+        xyv_loc->mark = (GraphIndex)atomic_fetch_add_explicit(
+            &ctx.next_mark,
+            1,
+            memory_order_relaxed
+        );
 
-        GraphPlaneP3ChooseList *xyv_colors = &get(ctx.vertex_info, xyv).colors;
+        GraphPlaneP3ChooseList *xyv_colors = &get(ctx.colors, xyv);
         assert(xyv_colors->len > 0);
         xyv_colors->len = 1;
 
-        uint32_t entry_index = (uint32_t)pool_create(ctx.entry_pool);
-        pool_get(ctx.entry_pool, entry_index) = (GraphPlaneP3ChooseThreadEntry){
-            .frame = { .z = xyv, .x = xyv, .y = xyv, .x_loc = *xyv_loc },
+        GraphPlaneP3ChooseFrame frame = {
+            .z = xyv,
+            .x = xyv,
+            .y = xyv,
+            .x_loc = *xyv_loc,
         };
-        list_push(ctx.valid_entries) = entry_index;
+        graph_thread_steal_push_overflow(&ctx.steal, &frame);
 
         return ctx;
     }
 
-    static inline void graph_plane_p3choose_thread_pop_internal(
+    static inline void graph_plane_p3choose_thread_push_frame(
         GraphPlaneP3ChooseThreadCtx *ctx,
-        GraphPlaneP3ChooseThreadFrameList *local_frames
+        GraphThreadDeque *deque,
+        GraphPlaneP3ChooseFrame *frame
     ) {
-        int frames_active = atomic_fetch_sub_explicit(
-                &ctx->frames_active,
-                1,
-                memory_order_relaxed
-            ) +
-            1;
+        graph_thread_steal_push(&ctx->steal, deque, frame);
+    }
 
-        for (;;) {
-            size_t available_entries = atomic_load_explicit(
-                &ctx->valid_entries.len,
+    typedef struct {
+        GraphIndex next_entry;
+        GraphIndex final_entry;
+        GraphIndex block_size;
+    } GraphPlaneP3ChooseThreadEntrySet;
+
+    static inline GraphIndex graph_plane_p3choose_thread_next_entry(
+        GraphPlaneP3ChooseThreadCtx *ctx,
+        GraphPlaneP3ChooseThreadEntrySet *entry_set
+    ) {
+        if (entry_set->next_entry == entry_set->final_entry) {
+            entry_set->next_entry = (GraphIndex)atomic_fetch_add_explicit(
+                &ctx->next_entry,
+                entry_set->block_size,
                 memory_order_relaxed
             );
-            if (available_entries > 0 or frames_active == 0) {
-                aven_thread_spinlock_lock(&ctx->lock);
-                available_entries = atomic_load_explicit(
-                    &ctx->valid_entries.len,
-                    memory_order_relaxed
-                );
-                if (available_entries > 0) {
-                    size_t frames_moved = min(
-                        local_frames->cap / 2,
-                        available_entries
-                    );
-                    size_t valid_index = atomic_fetch_sub_explicit(
-                            &ctx->valid_entries.len,
-                            frames_moved,
-                            memory_order_relaxed
-                        ) -
-                        frames_moved;
-                    for (size_t i = 0; i < frames_moved; i += 1) {
-                        uint32_t entry_index = ctx->valid_entries.ptr[
-                            valid_index + i
-                        ];
-                        list_push(*local_frames) = pool_get(
-                            ctx->entry_pool,
-                            entry_index
-                        ).frame;
-                        pool_delete(ctx->entry_pool, entry_index);
-                    }
-                    atomic_fetch_add_explicit(
-                        &ctx->frames_active,
-                        1,
-                        memory_order_relaxed
-                    );
-                    aven_thread_spinlock_unlock(&ctx->lock);
-
-                    return;
-                }
-                frames_active = atomic_load_explicit(
-                    &ctx->frames_active,
-                    memory_order_relaxed
-                );
-
-                if (ctx->entry_pool.used == 0 and frames_active == 0) {
-                    aven_thread_spinlock_unlock(&ctx->lock);
-                    return;
-                }
+            entry_set->final_entry = entry_set->next_entry +
+                entry_set->block_size;
+        }
 
-                aven_thread_spinlock_unlock(&ctx->lock);
-            }
+        GraphIndex next_entry = entry_set->next_entry;
+        assert(next_entry < ctx->entries.len);
+        entry_set->next_entry += 1;
+        return next_entry;
+    }
 
-    #if __has_builtin(__builtin_ia32_pause)
-            __builtin_ia32_pause();
-    #endif
-            frames_active = atomic_load_explicit(
-                &ctx->frames_active,
-                memory_order_relaxed
+    // Move every frame waiting on a vertex onto the local deque
+    static inline void graph_plane_p3choose_thread_release_entries(
+        GraphPlaneP3ChooseThreadCtx *ctx,
+        GraphThreadDeque *deque,
+        GraphIndex v
+    ) {
+        GraphIndex entry_index = (GraphIndex)atomic_exchange_explicit(
+            &get(ctx->entry_indices, v),
+            0,
+            memory_order_acquire
+        );
+        while (entry_index != 0) {
+            GraphPlaneP3ChooseThreadEntry *entry = &get(
+                ctx->entries,
+                entry_index - 1
             );
+            graph_plane_p3choose_thread_push_frame(ctx, deque, &entry->frame);
+            entry_index = entry->parent;
         }
     }
 
     static inline void graph_plane_p3choose_thread_push_entries(
         GraphPlaneP3ChooseThreadCtx *ctx,
-        GraphPlaneP3ChooseThreadFrameList *local_frames,
-        uint32_t v,
+        GraphThreadDeque *deque,
+        GraphPlaneP3ChooseThreadEntrySet *entry_set,
+        GraphIndex v,
         GraphPlaneP3ChooseFrameOptional *maybe_frame,
-        uint32_t u
+        GraphIndex u
     ) {
-        GraphPlaneP3ChooseThreadVertex *v_info = &get(ctx->vertex_info, v);
-        GraphPlaneP3ChooseThreadVertex *u_info = &get(ctx->vertex_info, u);
-        bool v_push = (v_info->entry_index != 0) and (v_info->colors.len == 1);
+        GraphPlaneP3ChooseList *v_colors = &get(ctx->colors, v);
+        GraphThreadAtomicIndex *v_entry_index = &get(
+            ctx->entry_indices,
+            v
+        );
+        GraphPlaneP3ChooseList *u_colors = &get(ctx->colors, u);
+        GraphThreadAtomicIndex *u_entry_index = &get(
+            ctx->entry_indices,
+            u
+        );
+
+        // pairs with the fence after parking a frame: either we see the
+        // parked frame here or the parking thread sees the final color
+        atomic_thread_fence(memory_order_seq_cst);
+
+        bool v_push = (v_colors->len == 1) and
+            atomic_load_explicit(v_entry_index, memory_order_relaxed) !=
+                0;
         bool u_push = (v != u) and
-            (u_info->entry_index != 0) and
-            (u_info->colors.len == 1);
-        bool frame_wait = (maybe_frame->valid) and (v_info->colors.len != 1);
-
-        if (
-            v_push or
-            u_push or
-            frame_wait or
-            local_frames->len == local_frames->cap
-        ) {
-            aven_thread_spinlock_lock(&ctx->lock);
-            if (local_frames->len > (local_frames->cap / 2)) {
-                size_t frames_over = local_frames->len - (local_frames->cap / 2);
-                size_t len = atomic_fetch_add_explicit(
-                    &ctx->valid_entries.len,
-                    frames_over,
+            (u_colors->len == 1) and
+            atomic_load_explicit(u_entry_index, memory_order_relaxed) !=
+                0;
+        bool frame_wait = (maybe_frame->valid) and (v_colors->len != 1);
+
+        if (v_push) {
+            graph_plane_p3choose_thread_release_entries(ctx, deque, v);
+        }
+        if (u_push) {
+            graph_plane_p3choose_thread_release_entries(ctx, deque, u);
+        }
+        if (frame_wait) {
+            // park the frame on v until v is colored
+            GraphIndex entry_index = graph_plane_p3choose_thread_next_entry(
+                ctx,
+                entry_set
+            );
+            GraphPlaneP3ChooseThreadEntry *entry = &get(
+                ctx->entries,
+                entry_index
+            );
+            entry->frame = maybe_frame->value;
+
+            GraphIndex parent = (GraphIndex)atomic_load_explicit(
+                v_entry_index,
+                memory_order_relaxed
+            );
+            do {
+                entry->parent = parent;
+            } while (
+                !atomic_compare_exchange_weak_explicit(
+                    v_entry_index,
+                    &parent,
+                    entry_index + 1,
+                    memory_order_release,
                     memory_order_relaxed
-                );
-                assert((len + frames_over) <= ctx->valid_entries.cap);
-                for (size_t i = 0; i < frames_over; i += 1) {
-                    uint32_t entry_index = (uint32_t)pool_create(
-                        ctx->entry_pool
-                    );
-                    pool_get(ctx->entry_pool, entry_index) = (
-                        GraphPlaneP3ChooseThreadEntry
-                    ){ .frame = list_pop(*local_frames) };
-                    ctx->valid_entries.ptr[len + i] = entry_index;
-                }
-            }
-            if (v_push) {
-                do {
-                    assert(ctx->valid_entries.len < ctx->valid_entries.cap);
-                    size_t back_index = atomic_fetch_add_explicit(
-                        &ctx->valid_entries.len,
-                        1,
-                        memory_order_relaxed
-                    );
-                    ctx->valid_entries.ptr[back_index] = v_info->entry_index - 1;
-                    v_info->entry_index = pool_get(
-                        ctx->entry_pool,
-                        v_info->entry_index - 1
-                    ).parent;
-                } while (v_info->entry_index != 0);
-            }
-            if (u_push) {
-                do {
-                    assert(ctx->valid_entries.len < ctx->valid_entries.cap);
-                    size_t back_index = atomic_fetch_add_explicit(
-                        &ctx->valid_entries.len,
-                        1,
-                        memory_order_relaxed
-                    );
-                    ctx->valid_entries.ptr[back_index] = u_info->entry_index - 1;
-                    u_info->entry_index = pool_get(
-                        ctx->entry_pool,
-                        u_info->entry_index - 1
-                    ).parent;
-                } while (u_info->entry_index != 0);
-            }
-            if (frame_wait) {
-                uint32_t entry_index = (uint32_t)pool_create(ctx->entry_pool);
-                pool_get(ctx->entry_pool, entry_index) = (
-                    GraphPlaneP3ChooseThreadEntry
-                ){ .frame = maybe_frame->value, .parent = v_info->entry_index };
-                v_info->entry_index = entry_index + 1;
+                )
+            );
+
+            atomic_thread_fence(memory_order_seq_cst);
+            if (v_colors->len == 1) {
+                graph_plane_p3choose_thread_release_entries(ctx, deque, v);
             }
-            aven_thread_spinlock_unlock(&ctx->lock);
-        }
-        if (maybe_frame->valid and !frame_wait) {
-            list_push(*local_frames) = maybe_frame->value;
+        } else if (maybe_frame->valid) {
+            graph_plane_p3choose_thread_push_frame(
+                ctx,
+                deque,
+                &maybe_frame->value
+            );
         }
     }
 
     static inline GraphPlaneP3ChooseVertexLoc *graph_plane_p3choose_thread_vloc(
         GraphPlaneP3ChooseThreadCtx *ctx,
         GraphPlaneP3ChooseFrame *frame,
-        uint32_t v
+        GraphIndex v
     ) {
         if (v == frame->x) {
             return &frame->x_loc;
@@ -319,21 +307,21 @@
             return &frame->z_loc;
         }
 
-        return &get(ctx->vertex_info, v).loc;
+        return &get(ctx->locs, v);
     }
 
     typedef struct {
-        uint32_t next_mark;
-        uint32_t final_mark;
-        uint32_t block_size;
+        GraphIndex next_mark;
+        GraphIndex final_mark;
+        GraphIndex block_size;
     } GraphPlaneP3ChooseThreadMarkSet;
 
-    static inline uint32_t graph_plane_p3choose_thread_next_mark(
+    static inline GraphIndex graph_plane_p3choose_thread_next_mark(
         GraphPlaneP3ChooseThreadCtx *ctx,
         GraphPlaneP3ChooseThreadMarkSet *mark_set
     ) {
         if (mark_set->next_mark == mark_set->final_mark) {
-            mark_set->next_mark = (uint32_t)atomic_fetch_add_explicit(
+            mark_set->next_mark = (GraphIndex)atomic_fetch_add_explicit(
                 &ctx->next_mark,
                 mark_set->block_size,
                 memory_order_relaxed
@@ -341,31 +329,32 @@
             mark_set->final_mark = mark_set->next_mark + mark_set->block_size;
         }
 
-        uint32_t next_mark = mark_set->next_mark;
+        GraphIndex next_mark = mark_set->next_mark;
+        assert(next_mark < ctx->marks.len);
         mark_set->next_mark += 1;
         return next_mark;
     }
 
     static inline bool graph_plane_p3choose_thread_frame_step(
         GraphPlaneP3ChooseThreadCtx *ctx,
-        GraphPlaneP3ChooseThreadFrameList *local_frames,
+        GraphThreadDeque *deque,
+        GraphPlaneP3ChooseThreadEntrySet *entry_set,
         GraphPlaneP3ChooseThreadMarkSet *mark_set,
         GraphPlaneP3ChooseFrame *frame
     ) {
-        GraphAdj z_adj = get(ctx->vertex_info, frame->z).adj;
+        GraphAdj z_adj = get(ctx->adj, frame->z);
         GraphPlaneP3ChooseVertexLoc *z_loc = graph_plane_p3choose_thread_vloc(
             ctx,
             frame,
             frame->z
         );
-        GraphPlaneP3ChooseList *z_colors = &get(ctx->vertex_info, frame->z)
-            .colors;
+        GraphPlaneP3ChooseList *z_colors = &get(ctx->colors, frame->z);
         uint8_t z_color = get(*z_colors, 0);
 
-        uint32_t zu_index = z_loc->nb.first;
+        GraphIndex zu_index = z_loc->nb.first;
         GraphAugNb zu = graph_aug_nb(ctx->nb, z_adj, zu_index);
 
-        uint32_t u = zu.vertex;
+        GraphIndex u = zu.vertex;
         GraphPlaneP3ChooseVertexLoc *u_loc = graph_plane_p3choose_thread_vloc(
             ctx,
             frame,
@@ -376,12 +365,13 @@
             if (frame->x == frame->y) {
                 assert(frame->z == frame->x);
                 graph_plane_p3choose_color_differently(
-                    &get(ctx->vertex_info, u).colors,
+                    &get(ctx->colors, u),
                     z_color
                 );
                 graph_plane_p3choose_thread_push_entries(
                     ctx,
-                    local_frames,
+                    deque,
+                    entry_set,
                     u,
                     &(GraphPlaneP3ChooseFrameOptional){ 0 },
                     u
@@ -409,7 +399,7 @@
             return false;
         }
 
-        GraphAdj u_adj = get(ctx->vertex_info, u).adj;
+        GraphAdj u_adj = get(ctx->adj, u);
         u_loc->nb.last = graph_adj_prev(u_adj, u_loc->nb.last);
         z_loc->nb.first = graph_adj_next(z_adj, z_loc->nb.first);
 
@@ -417,7 +407,7 @@
 
         if (frame->z == frame->x) {
             graph_plane_p3choose_color_differently(
-                &get(ctx->vertex_info, u).colors,
+                &get(ctx->colors, u),
                 z_color
             );
             u_colored = true;
@@ -439,17 +429,17 @@
             z_loc = graph_plane_p3choose_thread_vloc(ctx, frame, frame->z);
         }
 
-        uint32_t zv_index = graph_adj_next(z_adj, zu_index);
+        GraphIndex zv_index = graph_adj_next(z_adj, zu_index);
         GraphAugNb zv = graph_aug_nb(ctx->nb, z_adj, zv_index);
 
-        uint32_t v = zv.vertex;
-        GraphAdj v_adj = get(ctx->vertex_info, v).adj;
+        GraphIndex v = zv.vertex;
+        GraphAdj v_adj = get(ctx->adj, v);
         GraphPlaneP3ChooseVertexLoc *v_loc = graph_plane_p3choose_thread_vloc(
             ctx,
             frame,
             v
         );
-        GraphPlaneP3ChooseList *v_colors = &get(ctx->vertex_info, v).colors;
+        GraphPlaneP3ChooseList *v_colors = &get(ctx->colors, v);
 
         GraphPlaneP3ChooseFrameOptional maybe_frame = { 0 };
 
@@ -474,7 +464,7 @@
                 frame->y = frame->x;
                 frame->z = frame->x;
             } else {
-                uint32_t new_mark = graph_plane_p3choose_thread_next_mark(
+                GraphIndex new_mark = graph_plane_p3choose_thread_next_mark(
                     ctx,
                     mark_set
                 );
@@ -502,7 +492,7 @@
             }
         } else if (get(ctx->marks, v_loc->mark) == frame->y_loc.mark) {
             if (v_loc->nb.first != zv.back_index) {
-                uint32_t new_mark = graph_plane_p3choose_thread_next_mark(
+                GraphIndex new_mark = graph_plane_p3choose_thread_next_mark(
                     ctx,
                     mark_set
                 );
@@ -577,7 +567,8 @@
 
         graph_plane_p3choose_thread_push_entries(
             ctx,
-            local_frames,
+            deque,
+            entry_set,
             v,
             &maybe_frame,
             u_colored ? u : v
@@ -589,67 +580,58 @@
     typedef struct {
         GraphPropUint8 coloring;
         GraphPlaneP3ChooseThreadCtx *thread_ctx;
-        uint32_t start_vertex;
-        uint32_t end_vertex;
-        uint32_t thread_index;
+        GraphIndex start_vertex;
+        GraphIndex end_vertex;
+        GraphThreadStealWorker steal_worker;
     } GraphPlaneP3ChooseThreadWorker;
 
     static inline void graph_plane_p3choose_thread_worker(void *args) {
         GraphPlaneP3ChooseThreadWorker *worker = args;
         GraphPlaneP3ChooseThreadCtx *ctx = worker->thread_ctx;
 
-        atomic_fetch_add_explicit(&ctx->threads_active, 1, memory_order_relaxed);
-        atomic_fetch_add_explicit(&ctx->frames_active, 1, memory_order_relaxed);
+        graph_thread_steal_start(&ctx->steal);
 
-        GraphPlaneP3ChooseFrame local_frame_data[16];
-        GraphPlaneP3ChooseThreadFrameList local_frames = list_array(
-            local_frame_data
+        GraphThreadDeque *deque = graph_thread_steal_deque(
+            &ctx->steal,
+            &worker->steal_worker
         );
 
         GraphPlaneP3ChooseThreadMarkSet mark_set = {
             .block_size = GRAPH_PLANE_P3CHOOSE_THREAD_MARK_SET_SIZE,
         };
+        GraphPlaneP3ChooseThreadEntrySet entry_set = {
+            .block_size = GRAPH_PLANE_P3CHOOSE_THREAD_ENTRY_SET_SIZE,
+        };
 
-        graph_plane_p3choose_thread_pop_internal(ctx, &local_frames);
-
-        while (local_frames.len > 0) {
-            GraphPlaneP3ChooseFrame cur_frame = list_pop(local_frames);
+        GraphPlaneP3ChooseFrame cur_frame;
+        while (
+            graph_thread_steal_next(
+                &ctx->steal,
+                &worker->steal_worker,
+                &cur_frame
+            )
+        ) {
             while (
                 !graph_plane_p3choose_thread_frame_step(
                     ctx,
-                    &local_frames,
+                    deque,
+                    &entry_set,
                     &mark_set,
                     &cur_frame
                 )
             ) {}
-
-            if (local_frames.len == 0) {
-                graph_plane_p3choose_thread_pop_internal(ctx, &local_frames);
-            }
         }
 
-        // synchronize all threads writes to the marks array
-        atomic_fetch_sub_explicit(&ctx->threads_active, 1, memory_order_release);
+        // synchronize all threads writes to the colors array
+        graph_thread_steal_finish(&ctx->steal);
 
-        for (;;) {
-            int threads_active = atomic_load_explicit(
-                &ctx->threads_active,
-                memory_order_acquire
-            );
-            if (threads_active == 0) {
-                break;
-            }
-            while (threads_active != 0) {
-                threads_active = atomic_load_explicit(
-                    &ctx->threads_active,
-                    memory_order_relaxed
-                );
-            }
-        }
-
-        for (uint32_t v = worker->start_vertex; v != worker->end_vertex; v += 1) {
-            assert(get(ctx->vertex_info, v).colors.len == 1);
-            get(worker->coloring, v) = get(get(ctx->vertex_info, v).colors, 0);
+        for (
+            GraphIndex v = worker->start_vertex;
+            v != worker->end_vertex;
+            v += 1
+        ) {
+            assert(get(ctx->colors, v).len == 1);
+            get(worker->coloring, v) = get(get(ctx->colors, v), 0);
         }
     }
 
@@ -684,33 +666,28 @@
             nthreads - 1
         );
 
-        uint32_t chunk_size = (uint32_t)(aug_graph.adj.len / workers.len);
+        GraphIndex chunk_size = (GraphIndex)(aug_graph.adj.len / workers.len);
         for (uint32_t i = 0; i < workers.len; i += 1) {
-            uint32_t start_vertex = i * chunk_size;
-            uint32_t end_vertex = (i + 1) * chunk_size;
+            GraphIndex start_vertex = i * chunk_size;
+            GraphIndex end_vertex = (i + 1) * chunk_size;
             if (i + 1 == workers.len) {
-                end_vertex = (uint32_t)aug_graph.adj.len;
+                end_vertex = (GraphIndex)aug_graph.adj.len;
             }
 
             get(workers, i) = (GraphPlaneP3ChooseThreadWorker){
                 .coloring = coloring,
                 .thread_ctx = &ctx,
-                .thread_index = i,
+                .steal_worker = graph_thread_steal_worker(i),
                 .start_vertex = start_vertex,
                 .end_vertex = end_vertex,
             };
         }
-        for (uint32_t i = 0; i < jobs.len; i += 1) {
-            get(jobs, i) = (AvenThreadPoolJob){
-                .fn = graph_plane_p3choose_thread_worker,
-                .args = &get(workers, i),
-            };
-        }
-
-        aven_thread_pool_submit_slice(thread_pool, jobs);
-        graph_plane_p3choose_thread_worker(&get(workers, workers.len - 1));
-
-        aven_thread_pool_wait(thread_pool);
+        graph_thread_run_phase(
+            thread_pool,
+            jobs,
+            workers,
+            graph_plane_p3choose_thread_worker
+        );
 
         return coloring;
     }
@@ -55,7 +55,7 @@
             float dir_score[8] = { 0 };
             float dir_bonus[8] = { 0 };
 
-            GraphAdj v_adj = get(ctx->vertex_info, v).adj;
+            GraphAdj v_adj = get(ctx->adj, v);
             for (uint32_t i = 0; i < v_adj.len; i += 1) {
                 uint32_t u = graph_aug_nb(ctx->nb, v_adj, i).vertex;
 
@@ -98,7 +98,7 @@
                 (unsigned int)v_mark
             );
 
-            GraphPlaneP3ChooseList v_colors = get(ctx->vertex_info, v).colors;
+            GraphPlaneP3ChooseList v_colors = get(ctx->colors, v);
             for (uint8_t i = 0; i < v_colors.len - 1; i += 1) {
                 printf("%u,", get(v_colors, i));
             }
@@ -166,11 +166,11 @@
         GraphPlaneP3ChooseTikzDrawGraph draw_graph = aven_arena_create_slice(
             GraphPlaneP3ChooseTikzDrawSlice,
             &temp_arena,
-            ctx->vertex_info.len
+            ctx->adj.len
         );
 
-        for (uint32_t v = 0; v < ctx->vertex_info.len; v += 1) {
-            get(draw_graph, v).len = get(ctx->vertex_info, v).adj.len;
+        for (uint32_t v = 0; v < ctx->adj.len; v += 1) {
+            get(draw_graph, v).len = get(ctx->adj, v).len;
             get(draw_graph, v).ptr = aven_arena_create_array(
                 bool,
                 &temp_arena,
@@ -185,7 +185,7 @@
         printf("\t\\begin{pgfonlayer}{bg}\n");
 
         {
-            GraphAdj z_adj = get(ctx->vertex_info, frame->z).adj;
+            GraphAdj z_adj = get(ctx->adj, frame->z);
             GraphPlaneP3ChooseTikzDrawSlice z_drawn = get(draw_graph, frame->z);
             GraphPlaneP3ChooseVertexLoc *z_loc = graph_plane_p3choose_vloc(
                 ctx,
@@ -223,7 +223,7 @@
             uint32_t v = cur_frame->z;
 
             do {
-                GraphAdj v_adj = get(ctx->vertex_info, v).adj;
+                GraphAdj v_adj = get(ctx->adj, v);
                 GraphPlaneP3ChooseTikzDrawSlice v_drawn = get(draw_graph, v);
                 GraphPlaneP3ChooseVertexLoc *v_info = graph_plane_p3choose_vloc(
                     ctx,
@@ -266,15 +266,15 @@
             }
         } while (frame_index < ctx->frames.len);
 
-        for (uint32_t v = 0; v < ctx->vertex_info.len; v += 1) {
-            GraphAdj v_adj = get(ctx->vertex_info, v).adj;
+        for (uint32_t v = 0; v < ctx->adj.len; v += 1) {
+            GraphAdj v_adj = get(ctx->adj, v);
             GraphPlaneP3ChooseTikzDrawSlice v_drawn = get(draw_graph, v);
 
             for (uint32_t i = 0; i < v_adj.len; i += 1) {
                 uint32_t u = graph_aug_nb(ctx->nb, v_adj, i).vertex;
                 if (u > v and !get(v_drawn, i)) {
                     get(v_drawn, i) = true;
-                    if (get(ctx->vertex_info, v).loc.mark == 0) {
+                    if (get(ctx->locs, v).mark == 0) {
                         printf(
                             "\t\t\\draw (v%u) edge (v%u);\n",
                             (unsigned int)v,
@@ -0,0 +1,605 @@
+// Path 3-coloring engine template, included once per index width. The
+// includer defines:
+//  P3COLOR_T(name), P3COLOR_FN(name): engine type and function names
+//  P3COLOR_GRAPH_T(name), P3COLOR_GRAPH_FN(name): graph type and function
+//      names, e.g. P3COLOR_GRAPH_T(Adj) and P3COLOR_GRAPH_FN(_nb)
+//  P3COLOR_INDEX, P3COLOR_MARK: vertex index and face mark types
+//  P3COLOR_DISPATCH_SMALL: optional, convert small graphs to GraphSmall
+// and undefines them afterwards.
+
+#if !defined(P3COLOR_T) or !defined(P3COLOR_FN) or \
+    !defined(P3COLOR_GRAPH_T) or !defined(P3COLOR_GRAPH_FN) or \
+    !defined(P3COLOR_INDEX) or !defined(P3COLOR_MARK)
+    #error "define the P3COLOR_* template parameters before including"
+#endif
+
+#include <aven.h>
+#include <aven/arena.h>
+
+#include "../../../graph.h"
+
+    typedef struct {
+        P3COLOR_INDEX u;
+        P3COLOR_INDEX u_nb_first;
+        P3COLOR_INDEX x;
+        P3COLOR_INDEX x_nb_first;
+        P3COLOR_INDEX y;
+        P3COLOR_INDEX z;
+        P3COLOR_INDEX edge_index;
+        P3COLOR_MARK face_mark;
+        uint8_t q_color;
+        uint8_t p_color;
+        bool above_path;
+        bool last_colored;
+    } P3COLOR_T(Frame);
+
+    typedef Optional(P3COLOR_T(Frame)) P3COLOR_T(FrameOptional);
+    typedef Slice(P3COLOR_T(FrameOptional))
+        P3COLOR_T(FrameOptionalSlice);
+
+    typedef struct {
+        P3COLOR_GRAPH_T(NbSlice) nb;
+        P3COLOR_GRAPH_T(AdjSlice) adj;
+        Slice(P3COLOR_MARK) marks;
+        List(P3COLOR_T(Frame)) frames;
+    } P3COLOR_T(Ctx);
+
+    // GraphAug frames also record where the rotations of y and z continue,
+    // which the Graph engine has no back_index to look up
+    typedef struct {
+        P3COLOR_INDEX u;
+        P3COLOR_INDEX u_nb_first;
+        P3COLOR_INDEX x;
+        P3COLOR_INDEX x_nb_first;
+        P3COLOR_INDEX y;
+        P3COLOR_INDEX y_nb_first;
+        P3COLOR_INDEX z;
+        P3COLOR_INDEX z_nb_first;
+        P3COLOR_INDEX edge_index;
+        P3COLOR_MARK face_mark;
+        uint8_t q_color;
+        uint8_t p_color;
+        bool above_path;
+        bool last_colored;
+    } P3COLOR_T(AugFrame);
+
+    typedef Optional(P3COLOR_T(AugFrame))
+        P3COLOR_T(AugFrameOptional);
+
+    typedef struct {
+        P3COLOR_GRAPH_T(AugNbSlice) nb;
+        P3COLOR_GRAPH_T(AdjSlice) adj;
+        Slice(P3COLOR_MARK) marks;
+        List(P3COLOR_T(AugFrame)) frames;
+    } P3COLOR_T(AugCtx);
+
+    static inline P3COLOR_T(Ctx) P3COLOR_FN(_init)(
+        P3COLOR_GRAPH_T() graph,
+        GraphSubset p,
+        GraphSubset q,
+        AvenArena *arena
+    ) {
+        P3COLOR_INDEX p1 = (P3COLOR_INDEX)get(p, 0);
+        P3COLOR_INDEX q1 = (P3COLOR_INDEX)get(q, 0);
+
+        P3COLOR_T(Ctx) ctx = {
+            .nb = graph.nb,
+            .adj = graph.adj,
+            .marks = { .len = graph.adj.len },
+            .frames = { .cap = graph.adj.len - 2 },
+        };
+
+        ctx.marks.ptr = aven_arena_create_array(
+            P3COLOR_MARK,
+            arena,
+            ctx.marks.len
+        );
+        ctx.frames.ptr = aven_arena_create_array(
+            P3COLOR_T(Frame),
+            arena,
+            ctx.frames.cap
+        );
+
+        for (P3COLOR_INDEX v = 0; v < ctx.marks.len; v += 1) {
+            get(ctx.marks, v) = 0;
+        }
+
+        for (P3COLOR_INDEX i = 0; i < p.len; i += 1) {
+            get(ctx.marks, get(p, i)) = -1;
+        }
+
+        get(ctx.marks, p1) = 1;
+
+        for (P3COLOR_INDEX i = 0; i < q.len; i += 1) {
+            get(ctx.marks, get(q, i)) = 2;
+        }
+
+        list_push(ctx.frames) = (P3COLOR_T(Frame)){
+            .p_color = 3,
+            .q_color = 2,
+            .u = p1,
+            .u_nb_first = P3COLOR_GRAPH_FN(_nb_index)(
+                graph.nb,
+                get(graph.adj, p1),
+                q1
+            ),
+            .x = p1,
+            .y = p1,
+            .z = p1,
+            .face_mark = -1,
+        };
+
+        return ctx;
+    }
+
+    static inline P3COLOR_T(AugCtx) P3COLOR_FN(_aug_init)(
+        P3COLOR_GRAPH_T(Aug) graph,
+        GraphSubset p,
+        GraphSubset q,
+        AvenArena *arena
+    ) {
+        P3COLOR_INDEX p1 = (P3COLOR_INDEX)get(p, 0);
+        P3COLOR_INDEX q1 = (P3COLOR_INDEX)get(q, 0);
+
+        P3COLOR_T(AugCtx) ctx = {
+            .nb = graph.nb,
+            .adj = graph.adj,
+            .marks = { .len = graph.adj.len },
+            .frames = { .cap = graph.adj.len - 2 },
+        };
+
+        ctx.marks.ptr = aven_arena_create_array(
+            P3COLOR_MARK,
+            arena,
+            ctx.marks.len
+        );
+        ctx.frames.ptr = aven_arena_create_array(
+            P3COLOR_T(AugFrame),
+            arena,
+            ctx.frames.cap
+        );
+
+        for (P3COLOR_INDEX v = 0; v < ctx.marks.len; v += 1) {
+            get(ctx.marks, v) = 0;
+        }
+
+        for (P3COLOR_INDEX i = 0; i < p.len; i += 1) {
+            get(ctx.marks, get(p, i)) = -1;
+        }
+
+        get(ctx.marks, p1) = 1;
+
+        for (P3COLOR_INDEX i = 0; i < q.len; i += 1) {
+            get(ctx.marks, get(q, i)) = 2;
+        }
+
+        list_push(ctx.frames) = (P3COLOR_T(AugFrame)){
+            .p_color = 3,
+            .q_color = 2,
+            .u = p1,
+            .u_nb_first = P3COLOR_GRAPH_FN(_aug_nb_index)(
+                graph.nb,
+                get(graph.adj, p1),
+                q1
+            ),
+            .x = p1,
+            .y = p1,
+            .z = p1,
+            .face_mark = -1,
+        };
+
+        return ctx;
+    }
+
+    static inline P3COLOR_T(FrameOptional) P3COLOR_FN(_next_frame)(
+        P3COLOR_T(Ctx) *ctx
+    ) {
+        if (ctx->frames.len == 0) {
+            return (P3COLOR_T(FrameOptional)){ 0 };
+        }
+
+        return (P3COLOR_T(FrameOptional)){
+            .value = list_pop(ctx->frames),
+            .valid = true,
+        };
+    }
+
+    static inline bool P3COLOR_FN(_frame_step)(
+        P3COLOR_T(Ctx) *ctx,
+        P3COLOR_T(Frame) *frame
+    ) {
+        uint8_t path_color = frame->p_color ^ frame->q_color;
+
+        P3COLOR_GRAPH_T(Adj) u_adj = get(ctx->adj, frame->u);
+
+        if (frame->edge_index == u_adj.len) {
+            assert(frame->z == frame->u);
+
+            if (frame->y == frame->u) {
+                assert(frame->x == frame->u);
+                return true;
+            }
+
+            if (frame->x == frame->u) {
+                frame->x = frame->y;
+            }
+
+            P3COLOR_GRAPH_T(Adj) y_adj = get(ctx->adj, frame->y);
+            frame->u_nb_first = P3COLOR_GRAPH_FN(_adj_next)(
+                y_adj,
+                P3COLOR_GRAPH_FN(_nb_index)(ctx->nb, y_adj, frame->u)
+            );
+            frame->u = frame->y;
+            frame->z = frame->y;
+            frame->edge_index = 0;
+            frame->above_path = false;
+            frame->last_colored = false;
+            return false;
+        }
+
+        P3COLOR_INDEX v_index = frame->u_nb_first + frame->edge_index;
+        if (v_index >= u_adj.len) {
+            v_index -= u_adj.len;
+        }
+
+        P3COLOR_INDEX v = P3COLOR_GRAPH_FN(_nb)(ctx->nb, u_adj, v_index);
+        P3COLOR_MARK *v_mark = &get(ctx->marks, v);
+
+        frame->edge_index += 1;
+
+        if (frame->above_path) {
+            if (*v_mark <= 0) {
+                if (frame->last_colored) {
+                    frame->z = v;
+                    *v_mark = (P3COLOR_MARK)frame->q_color;
+                } else {
+                    *v_mark = frame->face_mark - 1;
+                }
+                frame->last_colored = false;
+            } else {
+                frame->last_colored = true;
+                if (frame->z != frame->u) {
+                    P3COLOR_GRAPH_T(Adj) z_adj = get(ctx->adj, frame->z);
+                    list_push(ctx->frames) = (P3COLOR_T(Frame)){
+                        .p_color = path_color,
+                        .q_color = frame->p_color,
+                        .u = frame->z,
+                        .u_nb_first = P3COLOR_GRAPH_FN(_adj_next)(
+                            z_adj,
+                            P3COLOR_GRAPH_FN(_nb_index)(
+                                ctx->nb,
+                                z_adj,
+                                frame->u
+                            )
+                        ),
+                        .x = frame->z,
+                        .y = frame->z,
+                        .z = frame->z,
+                        .face_mark = frame->face_mark - 1,
+                    };
+                    frame->z = frame->u;
+                }
+            }
+        } else if (v != frame->x) {
+            if (*v_mark > 0) {
+                if (*v_mark == (P3COLOR_MARK)frame->p_color) {
+                    frame->above_path = true;
+                    frame->last_colored = true;
+                }
+                if (frame->x != frame->u) {
+                    list_push(ctx->frames) = (P3COLOR_T(Frame)){
+                        .p_color = path_color,
+                        .q_color = frame->q_color,
+                        .u = frame->x,
+                        .u_nb_first = frame->x_nb_first,
+                        .x = frame->x,
+                        .y = frame->x,
+                        .z = frame->x,
+                        .face_mark = frame->face_mark - 1,
+                    };
+
+                    frame->x = frame->u;
+                }
+            } else if (*v_mark == frame->face_mark) {
+                *v_mark = (P3COLOR_MARK)path_color;
+                frame->y = v;
+                frame->above_path = true;
+            } else {
+                if (*v_mark <= 0) {
+                    *v_mark = frame->face_mark - 1;
+                }
+
+                if (frame->x == frame->u) {
+                    P3COLOR_GRAPH_T(Adj) v_adj = get(ctx->adj, v);
+                    frame->x = v;
+                    frame->x_nb_first = P3COLOR_GRAPH_FN(_adj_next)(
+                        v_adj,
+                        P3COLOR_GRAPH_FN(_nb_index)(ctx->nb, v_adj, frame->u)
+                    );
+
+                    *v_mark = (P3COLOR_MARK)frame->p_color;
+                }
+            }
+        }
+
+        return false;
+    }
+
+    // Run at most budget frame steps, taking the next frame from the context
+    // whenever the current one finishes. Start with an invalid frame, returns
+    // true once every frame is done and can be called again with the same
+    // frame to resume.
+    static inline bool P3COLOR_FN(_run)(
+        P3COLOR_T(Ctx) *ctx,
+        P3COLOR_T(FrameOptional) *frame,
+        size_t budget
+    ) {
+        P3COLOR_T(FrameOptional) cur_frame = *frame;
+        bool done = false;
+
+        for (; budget > 0; budget -= 1) {
+            if (!cur_frame.valid) {
+                cur_frame = P3COLOR_FN(_next_frame)(ctx);
+                if (!cur_frame.valid) {
+                    done = true;
+                    break;
+                }
+            }
+            if (P3COLOR_FN(_frame_step)(ctx, &cur_frame.value)) {
+                cur_frame.valid = false;
+            }
+        }
+
+        *frame = cur_frame;
+        return done;
+    }
+
+    static inline P3COLOR_T(AugFrameOptional)
+        P3COLOR_FN(_aug_next_frame)(
+            P3COLOR_T(AugCtx) *ctx
+        ) {
+        if (ctx->frames.len == 0) {
+            return (P3COLOR_T(AugFrameOptional)){ 0 };
+        }
+
+        return (P3COLOR_T(AugFrameOptional)){
+            .value = list_pop(ctx->frames),
+            .valid = true,
+        };
+    }
+
+    static inline bool P3COLOR_FN(_aug_frame_step)(
+        P3COLOR_T(AugCtx) *ctx,
+        P3COLOR_T(AugFrame) *frame
+    ) {
+        uint8_t path_color = frame->p_color ^ frame->q_color;
+
+        P3COLOR_GRAPH_T(Adj) u_adj = get(ctx->adj, frame->u);
+
+        if (frame->edge_index == u_adj.len) {
+            assert(frame->z == frame->u);
+
+            if (frame->y == frame->u) {
+                assert(frame->x == frame->u);
+                return true;
+            }
+
+            if (frame->x == frame->u) {
+                frame->x = frame->y;
+            }
+
+            frame->u_nb_first = frame->y_nb_first;
+            frame->u = frame->y;
+            frame->z = frame->y;
+            frame->edge_index = 0;
+            frame->above_path = false;
+            frame->last_colored = false;
+            return false;
+        }
+
+        P3COLOR_INDEX v_index = frame->u_nb_first + frame->edge_index;
+        if (v_index >= u_adj.len) {
+            v_index -= u_adj.len;
+        }
+
+        P3COLOR_GRAPH_T(AugNb) v_nb = P3COLOR_GRAPH_FN(_aug_nb)(
+            ctx->nb,
+            u_adj,
+            v_index
+        );
+        P3COLOR_INDEX v = v_nb.vertex;
+        P3COLOR_MARK *v_mark = &get(ctx->marks, v);
+
+        frame->edge_index += 1;
+
+        if (frame->above_path) {
+            if (*v_mark <= 0) {
+                if (frame->last_colored) {
+                    P3COLOR_GRAPH_T(Adj) v_adj = get(ctx->adj, v);
+                    frame->z = v;
+                    frame->z_nb_first = P3COLOR_GRAPH_FN(_adj_next)(
+                        v_adj,
+                        v_nb.back_index
+                    );
+                    *v_mark = (P3COLOR_MARK)frame->q_color;
+                } else {
+                    *v_mark = frame->face_mark - 1;
+                }
+                frame->last_colored = false;
+            } else {
+                frame->last_colored = true;
+                if (frame->z != frame->u) {
+                    list_push(ctx->frames) = (P3COLOR_T(AugFrame)){
+                        .p_color = path_color,
+                        .q_color = frame->p_color,
+                        .u = frame->z,
+                        .u_nb_first = frame->z_nb_first,
+                        .x = frame->z,
+                        .y = frame->z,
+                        .z = frame->z,
+                        .face_mark = frame->face_mark - 1,
+                    };
+                    frame->z = frame->u;
+                }
+            }
+        } else if (v != frame->x) {
+            if (*v_mark > 0) {
+                if (*v_mark == (P3COLOR_MARK)frame->p_color) {
+                    frame->above_path = true;
+                    frame->last_colored = true;
+                }
+                if (frame->x != frame->u) {
+                    list_push(ctx->frames) = (P3COLOR_T(AugFrame)){
+                        .p_color = path_color,
+                        .q_color = frame->q_color,
+                        .u = frame->x,
+                        .u_nb_first = frame->x_nb_first,
+                        .x = frame->x,
+                        .y = frame->x,
+                        .z = frame->x,
+                        .face_mark = frame->face_mark - 1,
+                    };
+
+                    frame->x = frame->u;
+                }
+            } else if (*v_mark == frame->face_mark) {
+                *v_mark = (P3COLOR_MARK)path_color;
+                P3COLOR_GRAPH_T(Adj) v_adj = get(ctx->adj, v);
+                frame->y = v;
+                frame->y_nb_first = P3COLOR_GRAPH_FN(_adj_next)(
+                    v_adj,
+                    v_nb.back_index
+                );
+                frame->above_path = true;
+            } else {
+                if (*v_mark <= 0) {
+                    *v_mark = frame->face_mark - 1;
+                }
+
+                if (frame->x == frame->u) {
+                    P3COLOR_GRAPH_T(Adj) v_adj = get(ctx->adj, v);
+                    frame->x = v;
+                    frame->x_nb_first = P3COLOR_GRAPH_FN(_adj_next)(
+                        v_adj,
+                        v_nb.back_index
+                    );
+
+                    *v_mark = (P3COLOR_MARK)frame->p_color;
+                }
+            }
+        }
+
+        return false;
+    }
+
+    static inline bool P3COLOR_FN(_aug_run)(
+        P3COLOR_T(AugCtx) *ctx,
+        P3COLOR_T(AugFrameOptional) *frame,
+        size_t budget
+    ) {
+        P3COLOR_T(AugFrameOptional) cur_frame = *frame;
+        bool done = false;
+
+        for (; budget > 0; budget -= 1) {
+            if (!cur_frame.valid) {
+                cur_frame = P3COLOR_FN(_aug_next_frame)(ctx);
+                if (!cur_frame.valid) {
+                    done = true;
+                    break;
+                }
+            }
+            if (P3COLOR_FN(_aug_frame_step)(ctx, &cur_frame.value)) {
+                cur_frame.valid = false;
+            }
+        }
+
+        *frame = cur_frame;
+        return done;
+    }
+
+    static inline GraphPropUint8 P3COLOR_FN()(
+        P3COLOR_GRAPH_T() graph,
+        GraphSubset p,
+        GraphSubset q,
+        AvenArena *arena
+    ) {
+        GraphPropUint8 coloring = { .len = graph.adj.len };
+        coloring.ptr = aven_arena_create_array(uint8_t, arena, coloring.len);
+
+        AvenArena temp_arena = *arena;
+
+    #ifdef P3COLOR_DISPATCH_SMALL
+        // halving the index width pays for the conversion on small graphs
+        if (graph_small_fits(graph.adj.len, graph.nb.len)) {
+            GraphPropUint8 small_coloring = graph_plane_p3color_small(
+                graph_small(graph, &temp_arena),
+                p,
+                q,
+                &temp_arena
+            );
+            for (GraphIndex v = 0; v < coloring.len; v += 1) {
+                get(coloring, v) = get(small_coloring, v);
+            }
+            return coloring;
+        }
+    #endif
+
+        P3COLOR_T(Ctx) ctx = P3COLOR_FN(_init)(
+            graph,
+            p,
+            q,
+            &temp_arena
+        );
+
+        P3COLOR_T(FrameOptional) cur_frame =
+            P3COLOR_FN(_next_frame)(&ctx);
+
+        do {
+            while (!P3COLOR_FN(_frame_step)(&ctx, &cur_frame.value)) {}
+            cur_frame = P3COLOR_FN(_next_frame)(&ctx);
+        } while (cur_frame.valid);
+
+        for (P3COLOR_INDEX v = 0; v < coloring.len; v += 1) {
+            P3COLOR_MARK v_mark = get(ctx.marks, v);
+            assert(v_mark > 0 and v_mark <= 3);
+            get(coloring, v) = (uint8_t)v_mark;
+        }
+
+        return coloring;
+    }
+
+    static inline GraphPropUint8 P3COLOR_FN(_aug)(
+        P3COLOR_GRAPH_T(Aug) graph,
+        GraphSubset p,
+        GraphSubset q,
+        AvenArena *arena
+    ) {
+        GraphPropUint8 coloring = { .len = graph.adj.len };
+        coloring.ptr = aven_arena_create_array(uint8_t, arena, coloring.len);
+
+        AvenArena temp_arena = *arena;
+        P3COLOR_T(AugCtx) ctx = P3COLOR_FN(_aug_init)(
+            graph,
+            p,
+            q,
+            &temp_arena
+        );
+
+        P3COLOR_T(AugFrameOptional) cur_frame =
+            P3COLOR_FN(_aug_next_frame)(&ctx);
+
+        do {
+            while (
+                !P3COLOR_FN(_aug_frame_step)(&ctx, &cur_frame.value)
+            ) {}
+            cur_frame = P3COLOR_FN(_aug_next_frame)(&ctx);
+        } while (cur_frame.valid);
+
+        for (P3COLOR_INDEX v = 0; v < coloring.len; v += 1) {
+            P3COLOR_MARK v_mark = get(ctx.marks, v);
+            assert(v_mark > 0 and v_mark <= 3);
+            get(coloring, v) = (uint8_t)v_mark;
+        }
+
+        return coloring;
+    }
@@ -140,7 +140,7 @@
                 &outline_node_info
             );
 
-            int32_t mark = get(ctx->vertex_info, v).mark;
+            int32_t mark = get(ctx->marks, v);
             uint32_t color = mark > 0 ? (uint32_t)mark : 0;
             graph_plane_geometry_push_vertex(
                 rounded_geometry,
@@ -158,11 +158,11 @@
         GraphPlaneP3ColorGeometryDrawGraph draw_graph = aven_arena_create_slice(
             GraphPlaneP3ColorGeometryDrawSlice,
             &temp_arena,
-            ctx->vertex_info.len
+            ctx->adj.len
         );
 
-        for (uint32_t v = 0; v < ctx->vertex_info.len; v += 1) {
-            get(draw_graph, v).len = get(ctx->vertex_info, v).adj.len;
+        for (uint32_t v = 0; v < ctx->adj.len; v += 1) {
+            get(draw_graph, v).len = get(ctx->adj, v).len;
             get(draw_graph, v).ptr = aven_arena_create_array(
                 int32_t,
                 &temp_arena,
@@ -179,29 +179,23 @@
             if (maybe_frame->valid) {
                 GraphPlaneP3ColorFrame *frame = &maybe_frame->value;
 
-                GraphPlaneP3ColorVertex fu_info = get(
-                    ctx->vertex_info,
-                    frame->u
-                );
+                GraphAdj fu_adj = get(ctx->adj, frame->u);
 
-                if (frame->edge_index < fu_info.adj.len) {
+                if (frame->edge_index < fu_adj.len) {
                     uint32_t n_index = frame->u_nb_first + frame->edge_index;
-                    if (n_index >= fu_info.adj.len) {
-                        n_index -= fu_info.adj.len;
+                    if (n_index >= fu_adj.len) {
+                        n_index -= fu_adj.len;
                     }
 
-                    if (n_index < fu_info.adj.len) {
-                        uint32_t n = graph_nb(ctx->nb, fu_info.adj, n_index);
+                    if (n_index < fu_adj.len) {
+                        uint32_t n = graph_nb(ctx->nb, fu_adj, n_index);
                         if (n > frame->u) {
                             get(get(draw_graph, frame->u), n_index) = -3;
                         } else {
-                            GraphPlaneP3ColorVertex n_info = get(
-                                ctx->vertex_info,
-                                n
-                            );
+                            GraphAdj n_adj = get(ctx->adj, n);
                             uint32_t nu_index = graph_nb_index(
                                 ctx->nb,
-                                n_info.adj,
+                                n_adj,
                                 frame->u
                             );
                             get(get(draw_graph, n), nu_index) = -3;
@@ -214,15 +208,15 @@
         Queue(uint32_t) vertices = aven_arena_create_queue(
             uint32_t,
             &temp_arena,
-            ctx->vertex_info.len
+            ctx->adj.len
         );
         Slice(uint32_t) visited = aven_arena_create_slice(
             uint32_t,
             &temp_arena,
-            ctx->vertex_info.len
+            ctx->adj.len
         );
 
-        for (uint32_t v = 0; v < ctx->vertex_info.len; v += 1) {
+        for (uint32_t v = 0; v < ctx->adj.len; v += 1) {
             get(visited, v) = 0;
         }
 
@@ -269,18 +263,19 @@
             vec4_copy(edge_info->color, info->colors[i + 1]);
         }
 
-        for (uint32_t v = 0; v < ctx->vertex_info.len; v += 1) {
-            GraphPlaneP3ColorVertex v_info = get(ctx->vertex_info, v);
-            if (v_info.mark <= 0) {
+        for (uint32_t v = 0; v < ctx->adj.len; v += 1) {
+            GraphAdj v_adj = get(ctx->adj, v);
+            int32_t v_mark = get(ctx->marks, v);
+            if (v_mark <= 0) {
                 continue;
             }
             GraphPlaneP3ColorGeometryDrawSlice v_drawn = get(draw_graph, v);
-            for (uint32_t i = 0; i < v_info.adj.len; i += 1) {
-                uint32_t u = graph_nb(ctx->nb, v_info.adj, i);
-                GraphPlaneP3ColorVertex u_info = get(ctx->vertex_info, u);
-                if (u > v and u_info.mark == v_info.mark) {
+            for (uint32_t i = 0; i < v_adj.len; i += 1) {
+                uint32_t u = graph_nb(ctx->nb, v_adj, i);
+                int32_t u_mark = get(ctx->marks, u);
+                if (u > v and u_mark == v_mark) {
                     if (get(v_drawn, i) == 0) {
-                        get(v_drawn, i) = v_info.mark;
+                        get(v_drawn, i) = v_mark;
                     }
                 }
             }
@@ -329,10 +324,7 @@
 
             get(visited, cur_frame->u) = mark;
 
-            GraphPlaneP3ColorVertex cfu_info = get(
-                ctx->vertex_info,
-                cur_frame->u
-            );
+            GraphAdj cfu_adj = get(ctx->adj, cur_frame->u);
             GraphPlaneP3ColorGeometryDrawSlice cfu_drawn = get(
                 draw_graph,
                 cur_frame->u
@@ -343,15 +335,15 @@
             }
             for (
                 uint32_t i = cur_frame->edge_index;
-                i < cfu_info.adj.len;
+                i < cfu_adj.len;
                 i += 1
             ) {
                 uint32_t n_index = cur_frame->u_nb_first + i;
-                if (n_index >= cfu_info.adj.len) {
-                    n_index -= cfu_info.adj.len;
+                if (n_index >= cfu_adj.len) {
+                    n_index -= cfu_adj.len;
                 }
-                uint32_t n = graph_nb(ctx->nb, cfu_info.adj, n_index);
-                if (get(ctx->vertex_info, n).mark <= 0) {
+                uint32_t n = graph_nb(ctx->nb, cfu_adj, n_index);
+                if (get(ctx->marks, n) <= 0) {
                     get(visited, n) = mark;
                     queue_push(vertices) = n;
                 }
@@ -362,10 +354,10 @@
                         get(cfu_drawn, n_index) = -2;
                     }
                 } else {
-                    GraphPlaneP3ColorVertex n_info = get(ctx->vertex_info, n);
+                    GraphAdj n_adj = get(ctx->adj, n);
                     uint32_t nu_index = graph_nb_index(
                         ctx->nb,
-                        n_info.adj,
+                        n_adj,
                         cur_frame->u
                     );
                     GraphPlaneP3ColorGeometryDrawSlice n_drawn = get(
@@ -400,13 +392,13 @@
             while (vertices.used > 0) {
                 uint32_t v = queue_pop(vertices);
                 GraphPlaneP3ColorGeometryDrawSlice v_drawn = get(draw_graph, v);
-                GraphPlaneP3ColorVertex v_info = get(ctx->vertex_info, v);
+                GraphAdj v_adj = get(ctx->adj, v);
 
-                for (uint32_t i = 0; i < v_info.adj.len; i += 1) {
-                    uint32_t u = graph_nb(ctx->nb, v_info.adj, i);
-                    GraphPlaneP3ColorVertex u_info = get(ctx->vertex_info, u);
+                for (uint32_t i = 0; i < v_adj.len; i += 1) {
+                    uint32_t u = graph_nb(ctx->nb, v_adj, i);
+                    int32_t u_mark = get(ctx->marks, u);
 
-                    if (u_info.mark <= 0) {
+                    if (u_mark <= 0) {
                         if (get(visited, u) != mark) {
                             queue_push(vertices) = u;
                             get(visited, u) = mark;
@@ -425,26 +417,26 @@
 
             for (
                 uint32_t i = cur_frame->edge_index;
-                i < cfu_info.adj.len - 1;
+                i < cfu_adj.len - 1;
                 i += 1
             ) {
                 uint32_t n_index = cur_frame->u_nb_first + i;
-                if (n_index >= cfu_info.adj.len) {
-                    n_index -= cfu_info.adj.len;
+                if (n_index >= cfu_adj.len) {
+                    n_index -= cfu_adj.len;
                 }
 
-                uint32_t v1 = graph_nb(ctx->nb, cfu_info.adj, n_index);
+                uint32_t v1 = graph_nb(ctx->nb, cfu_adj, n_index);
                 uint32_t v2 = graph_nb(
                     ctx->nb,
-                    cfu_info.adj,
-                    graph_adj_next(cfu_info.adj, n_index)
+                    cfu_adj,
+                    graph_adj_next(cfu_adj, n_index)
                 );
 
                 if (v1 > v2) {
-                    GraphPlaneP3ColorVertex v2_info = get(ctx->vertex_info, v2);
+                    GraphAdj v2_adj = get(ctx->adj, v2);
                     uint32_t v2v1_index = graph_nb_index(
                         ctx->nb,
-                        v2_info.adj,
+                        v2_adj,
                         v1
                     );
                     GraphPlaneP3ColorGeometryDrawSlice v2_drawn = get(
@@ -459,10 +451,10 @@
                         }
                     }
                 } else {
-                    GraphPlaneP3ColorVertex v1_info = get(ctx->vertex_info, v1);
+                    GraphAdj v1_adj = get(ctx->adj, v1);
                     uint32_t v1v2_index = graph_nb_index(
                         ctx->nb,
-                        v1_info.adj,
+                        v1_adj,
                         v2
                     );
                     GraphPlaneP3ColorGeometryDrawSlice v1_drawn = get(
@@ -482,21 +474,21 @@
             get(visited, cur_frame->u) = 0;
         }
 
-        for (uint32_t v = 0; v < ctx->vertex_info.len; v += 1) {
+        for (uint32_t v = 0; v < ctx->adj.len; v += 1) {
             GraphPlaneP3ColorGeometryDrawSlice v_drawn = get(draw_graph, v);
-            GraphPlaneP3ColorVertex v_info = get(ctx->vertex_info, v);
+            GraphAdj v_adj = get(ctx->adj, v);
 
-            for (uint32_t i = 0; i < v_info.adj.len; i += 1) {
-                uint32_t u = graph_nb(ctx->nb, v_info.adj, i);
+            for (uint32_t i = 0; i < v_adj.len; i += 1) {
+                uint32_t u = graph_nb(ctx->nb, v_adj, i);
                 if (u < v or get(v_drawn, i) != 0) {
                     continue;
                 }
 
-                uint32_t i_prev = graph_adj_prev(v_info.adj, i);
-                uint32_t i_next = graph_adj_next(v_info.adj, i);
+                uint32_t i_prev = graph_adj_prev(v_adj, i);
+                uint32_t i_next = graph_adj_next(v_adj, i);
 
-                uint32_t u_prev = graph_nb(ctx->nb, v_info.adj, i_prev);
-                uint32_t u_next = graph_nb(ctx->nb, v_info.adj, i_next);
+                uint32_t u_prev = graph_nb(ctx->nb, v_adj, i_prev);
+                uint32_t u_next = graph_nb(ctx->nb, v_adj, i_next);
 
                 uint32_t min_mark = get(visited, u_prev);
                 uint32_t u_mark = get(visited, u);
@@ -522,12 +514,12 @@
             }
         }
 
-        for (uint32_t v = 0; v < ctx->vertex_info.len; v += 1) {
+        for (uint32_t v = 0; v < ctx->adj.len; v += 1) {
             GraphPlaneP3ColorGeometryDrawSlice v_drawn = get(draw_graph, v);
-            GraphPlaneP3ColorVertex v_info = get(ctx->vertex_info, v);
+            GraphAdj v_adj = get(ctx->adj, v);
 
-            for (uint32_t i = 0; i < v_info.adj.len; i += 1) {
-                uint32_t u = graph_nb(ctx->nb, v_info.adj, i);
+            for (uint32_t i = 0; i < v_adj.len; i += 1) {
+                uint32_t u = graph_nb(ctx->nb, v_adj, i);
                 if (u < v or get(v_drawn, i) != 0) {
                     continue;
                 }
@@ -541,12 +533,12 @@
                 );
             }
         }
-        for (uint32_t v = 0; v < ctx->vertex_info.len; v += 1) {
+        for (uint32_t v = 0; v < ctx->adj.len; v += 1) {
             GraphPlaneP3ColorGeometryDrawSlice v_drawn = get(draw_graph, v);
-            GraphPlaneP3ColorVertex v_info = get(ctx->vertex_info, v);
+            GraphAdj v_adj = get(ctx->adj, v);
 
-            for (uint32_t i = 0; i < v_info.adj.len; i += 1) {
-                uint32_t u = graph_nb(ctx->nb, v_info.adj, i);
+            for (uint32_t i = 0; i < v_adj.len; i += 1) {
+                uint32_t u = graph_nb(ctx->nb, v_adj, i);
                 if (u < v or get(v_drawn, i) != -2) {
                     continue;
                 }
@@ -560,12 +552,12 @@
                 );
             }
         }
-        for (uint32_t v = 0; v < ctx->vertex_info.len; v += 1) {
+        for (uint32_t v = 0; v < ctx->adj.len; v += 1) {
             GraphPlaneP3ColorGeometryDrawSlice v_drawn = get(draw_graph, v);
-            GraphPlaneP3ColorVertex v_info = get(ctx->vertex_info, v);
+            GraphAdj v_adj = get(ctx->adj, v);
 
-            for (uint32_t i = 0; i < v_info.adj.len; i += 1) {
-                uint32_t u = graph_nb(ctx->nb, v_info.adj, i);
+            for (uint32_t i = 0; i < v_adj.len; i += 1) {
+                uint32_t u = graph_nb(ctx->nb, v_adj, i);
                 if (u < v or get(v_drawn, i) != -1) {
                     continue;
                 }
@@ -579,12 +571,12 @@
                 );
             }
         }
-        for (uint32_t v = 0; v < ctx->vertex_info.len; v += 1) {
+        for (uint32_t v = 0; v < ctx->adj.len; v += 1) {
             GraphPlaneP3ColorGeometryDrawSlice v_drawn = get(draw_graph, v);
-            GraphPlaneP3ColorVertex v_info = get(ctx->vertex_info, v);
+            GraphAdj v_adj = get(ctx->adj, v);
 
-            for (uint32_t i = 0; i < v_info.adj.len; i += 1) {
-                uint32_t u = graph_nb(ctx->nb, v_info.adj, i);
+            for (uint32_t i = 0; i < v_adj.len; i += 1) {
+                uint32_t u = graph_nb(ctx->nb, v_adj, i);
                 if (u < v or get(v_drawn, i) <= 0) {
                     continue;
                 }
@@ -598,12 +590,13 @@
                 );
             }
         }
-        for (uint32_t v = 0; v < ctx->vertex_info.len; v += 1) {
+        for (uint32_t v = 0; v < ctx->adj.len; v += 1) {
             GraphPlaneP3ColorGeometryDrawSlice v_drawn = get(draw_graph, v);
-            GraphPlaneP3ColorVertex v_info = get(ctx->vertex_info, v);
+            GraphAdj v_adj = get(ctx->adj, v);
+            int32_t v_mark = get(ctx->marks, v);
 
-            for (uint32_t i = 0; i < v_info.adj.len; i += 1) {
-                uint32_t u = graph_nb(ctx->nb, v_info.adj, i);
+            for (uint32_t i = 0; i < v_adj.len; i += 1) {
+                uint32_t u = graph_nb(ctx->nb, v_adj, i);
                 if (u < v or get(v_drawn, i) != -3) {
                     continue;
                 }
@@ -615,15 +608,15 @@
                     trans,
                     &active_edge_info
                 );
-                GraphPlaneP3ColorVertex u_info = get(ctx->vertex_info, u);
-                if (v_info.mark > 0 and v_info.mark == u_info.mark) {
+                int32_t u_mark = get(ctx->marks, u);
+                if (v_mark > 0 and v_mark == u_mark) {
                     graph_plane_geometry_push_edge(
                         geometry,
                         embedding,
                         v,
                         u,
                         trans,
-                        &get(color_edge_infos, (size_t)v_info.mark - 1)
+                        &get(color_edge_infos, (size_t)v_mark - 1)
                     );
                 } else {
                     graph_plane_geometry_push_edge(
@@ -0,0 +1,26 @@
+#ifndef GRAPH_PLANE_P3COLOR_SMALL_H
+    #define GRAPH_PLANE_P3COLOR_SMALL_H
+
+    #include <aven.h>
+    #include <aven/arena.h>
+
+    #include "../../../graph.h"
+    #include "../../small.h"
+
+    // The p3color engine on 16-bit indices and 16-bit face marks
+    #define P3COLOR_T(name) GraphPlaneP3ColorSmall##name
+    #define P3COLOR_FN(name) graph_plane_p3color_small##name
+    #define P3COLOR_GRAPH_T(name) GraphSmall##name
+    #define P3COLOR_GRAPH_FN(name) graph_small##name
+    #define P3COLOR_INDEX uint16_t
+    #define P3COLOR_MARK int16_t
+
+    #include "engine.h"
+
+    #undef P3COLOR_T
+    #undef P3COLOR_FN
+    #undef P3COLOR_GRAPH_T
+    #undef P3COLOR_GRAPH_FN
+    #undef P3COLOR_INDEX
+    #undef P3COLOR_MARK
+#endif // GRAPH_PLANE_P3COLOR_SMALL_H
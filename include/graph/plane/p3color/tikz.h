@@ -55,9 +55,10 @@
             float dir_score[8] = { 0 };
             float dir_bonus[8] = { 0 };
 
-            GraphPlaneP3ColorVertex v_info = get(ctx->vertex_info, v);
-            for (uint32_t i = 0; i < v_info.adj.len; i += 1) {
-                uint32_t u = graph_nb(ctx->nb, v_info.adj, i);
+            GraphAdj v_adj = get(ctx->adj, v);
+            int32_t v_mark = get(ctx->marks, v);
+            for (uint32_t i = 0; i < v_adj.len; i += 1) {
+                uint32_t u = graph_nb(ctx->nb, v_adj, i);
 
                 Vec2 u_pos;
                 vec2_copy(u_pos, get(embedding, u));
@@ -94,7 +95,7 @@
                 "\t\\node (v%u) [label=%s:{%d}] at (%fcm, %fcm) {",
                 (unsigned int)v,
                 dir_names[dir_index],
-                (int)v_info.mark,
+                (int)v_mark,
                 (double)pos_cm[0],
                 (double)pos_cm[1]
             );
@@ -172,11 +173,11 @@
         GraphPlaneP3ColorTikzDrawGraph draw_graph = aven_arena_create_slice(
             GraphPlaneP3ColorTikzDrawSlice,
             &temp_arena,
-            ctx->vertex_info.len
+            ctx->adj.len
         );
 
-        for (uint32_t v = 0; v < ctx->vertex_info.len; v += 1) {
-            get(draw_graph, v).len = get(ctx->vertex_info, v).adj.len;
+        for (uint32_t v = 0; v < ctx->adj.len; v += 1) {
+            get(draw_graph, v).len = get(ctx->adj, v).len;
             get(draw_graph, v).ptr = aven_arena_create_array(
                 bool,
                 &temp_arena,
@@ -191,29 +192,29 @@
         Queue(uint32_t) vertices = aven_arena_create_queue(
             uint32_t,
             &temp_arena,
-            ctx->vertex_info.len
+            ctx->adj.len
         );
         Slice(uint32_t) visited = aven_arena_create_slice(
             uint32_t,
             &temp_arena,
-            ctx->vertex_info.len
+            ctx->adj.len
         );
 
-        for (uint32_t v = 0; v < ctx->vertex_info.len; v += 1) {
+        for (uint32_t v = 0; v < ctx->adj.len; v += 1) {
             get(visited, v) = 0;
         }
 
         printf("\t\\begin{pgfonlayer}{bg}\n");
         {
-            GraphPlaneP3ColorVertex fu_info = get(ctx->vertex_info, frame->u);
+            GraphAdj fu_adj = get(ctx->adj, frame->u);
             uint32_t n_index = frame->u_nb_first + frame->edge_index;
             if (frame->edge_index != 0) {
                 n_index -= 1;
             }
-            if (n_index >= fu_info.adj.len) {
-                n_index -= fu_info.adj.len;
+            if (n_index >= fu_adj.len) {
+                n_index -= fu_adj.len;
             }
-            uint32_t n = graph_nb(ctx->nb, fu_info.adj, n_index);
+            uint32_t n = graph_nb(ctx->nb, fu_adj, n_index);
             if (n > frame->u) {
                 get(get(draw_graph, frame->u), n_index) = true;
                 printf(
@@ -222,9 +223,9 @@
                     (unsigned int)n
                 );
             } else {
-                GraphPlaneP3ColorVertex n_info = get(ctx->vertex_info, n);
-                for (uint32_t i = 0; i < n_info.adj.len; i += 1) {
-                    if (graph_nb(ctx->nb, n_info.adj, i) == frame->u) {
+                GraphAdj n_adj = get(ctx->adj, n);
+                for (uint32_t i = 0; i < n_adj.len; i += 1) {
+                    if (graph_nb(ctx->nb, n_adj, i) == frame->u) {
                         get(get(draw_graph, n), i) = true;
                         printf(
                             "\t\t\\draw (v%u) edge "
@@ -248,10 +249,7 @@
 
             get(visited, cur_frame->u) = mark;
 
-            GraphPlaneP3ColorVertex cfu_info = get(
-                ctx->vertex_info,
-                cur_frame->u
-            );
+            GraphAdj cfu_adj = get(ctx->adj, cur_frame->u);
             GraphPlaneP3ColorTikzDrawSlice cfu_drawn = get(
                 draw_graph,
                 cur_frame->u
@@ -262,15 +260,15 @@
             }
             for (
                 uint32_t i = cur_frame->edge_index;
-                i < cfu_info.adj.len;
+                i < cfu_adj.len;
                 i += 1
             ) {
                 uint32_t n_index = cur_frame->u_nb_first + i;
-                if (n_index >= cfu_info.adj.len) {
-                    n_index -= cfu_info.adj.len;
+                if (n_index >= cfu_adj.len) {
+                    n_index -= cfu_adj.len;
                 }
-                uint32_t n = graph_nb(ctx->nb, cfu_info.adj, n_index);
-                if (get(ctx->vertex_info, n).mark <= 0) {
+                uint32_t n = graph_nb(ctx->nb, cfu_adj, n_index);
+                if (get(ctx->marks, n) <= 0) {
                     get(visited, n) = mark;
                     queue_push(vertices) = n;
                 }
@@ -310,13 +308,13 @@
             while (vertices.used > 0) {
                 uint32_t v = queue_pop(vertices);
                 GraphPlaneP3ColorTikzDrawSlice v_drawn = get(draw_graph, v);
-                GraphPlaneP3ColorVertex v_info = get(ctx->vertex_info, v);
+                GraphAdj v_adj = get(ctx->adj, v);
 
-                for (uint32_t i = 0; i < v_info.adj.len; i += 1) {
-                    uint32_t u = graph_nb(ctx->nb, v_info.adj, i);
-                    GraphPlaneP3ColorVertex u_info = get(ctx->vertex_info, u);
+                for (uint32_t i = 0; i < v_adj.len; i += 1) {
+                    uint32_t u = graph_nb(ctx->nb, v_adj, i);
+                    int32_t u_mark = get(ctx->marks, u);
 
-                    if (u_info.mark <= 0) {
+                    if (u_mark <= 0) {
                         if (get(visited, u) != mark) {
                             queue_push(vertices) = u;
                             get(visited, u) = mark;
@@ -342,21 +340,21 @@
                 }
             }
 
-            for (uint32_t v = 0; v < ctx->vertex_info.len; v += 1) {
+            for (uint32_t v = 0; v < ctx->adj.len; v += 1) {
                 GraphPlaneP3ColorTikzDrawSlice v_drawn = get(draw_graph, v);
-                GraphPlaneP3ColorVertex v_info = get(ctx->vertex_info, v);
+                GraphAdj v_adj = get(ctx->adj, v);
 
-                for (uint32_t i = 0; i < v_info.adj.len; i += 1) {
-                    uint32_t u = graph_nb(ctx->nb, v_info.adj, i);
+                for (uint32_t i = 0; i < v_adj.len; i += 1) {
+                    uint32_t u = graph_nb(ctx->nb, v_adj, i);
                     if (u < v or get(v_drawn, i)) {
                         continue;
                     }
 
-                    uint32_t i_prev = graph_adj_prev(v_info.adj, i);
-                    uint32_t i_next = graph_adj_next(v_info.adj, i);
+                    uint32_t i_prev = graph_adj_prev(v_adj, i);
+                    uint32_t i_next = graph_adj_next(v_adj, i);
 
-                    uint32_t u_prev = graph_nb(ctx->nb, v_info.adj, i_prev);
-                    uint32_t u_next = graph_nb(ctx->nb, v_info.adj, i_next);
+                    uint32_t u_prev = graph_nb(ctx->nb, v_adj, i_prev);
+                    uint32_t u_next = graph_nb(ctx->nb, v_adj, i_next);
 
                     bool u_prev_visited = get(visited, u_prev) == mark;
                     bool u_next_visited = get(visited, u_next) == mark;
@@ -370,16 +368,16 @@
                         bool valid = false;
                         for (
                             uint32_t j = cur_frame->edge_index;
-                            j < cfu_info.adj.len;
+                            j < cfu_adj.len;
                             j += 1
                         ) {
                             uint32_t n_index = cur_frame->u_nb_first + j;
-                            if (n_index >= cfu_info.adj.len) {
-                                n_index -= cfu_info.adj.len;
+                            if (n_index >= cfu_adj.len) {
+                                n_index -= cfu_adj.len;
                             }
                             uint32_t n = graph_nb(
                                 ctx->nb,
-                                cfu_info.adj,
+                                cfu_adj,
                                 n_index
                             );
                             if (n == v) {
@@ -425,12 +423,12 @@
             }
         } while (frame_index < ctx->frames.len);
 
-        for (uint32_t v = 0; v < ctx->vertex_info.len; v += 1) {
+        for (uint32_t v = 0; v < ctx->adj.len; v += 1) {
             GraphPlaneP3ColorTikzDrawSlice v_drawn = get(draw_graph, v);
-            GraphPlaneP3ColorVertex v_info = get(ctx->vertex_info, v);
+            GraphAdj v_adj = get(ctx->adj, v);
 
-            for (uint32_t i = 0; i < v_info.adj.len; i += 1) {
-                uint32_t u = graph_nb(ctx->nb, v_info.adj, i);
+            for (uint32_t i = 0; i < v_adj.len; i += 1) {
+                uint32_t u = graph_nb(ctx->nb, v_adj, i);
                 if (u < v or get(v_drawn, i)) {
                     continue;
                 }
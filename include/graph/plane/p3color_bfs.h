@@ -7,13 +7,13 @@
     #include "../../graph.h"
 
     typedef struct {
-        uint32_t v1;
-        uint32_t vk;
-        uint32_t vi;
-        uint32_t vi1;
-        uint32_t v1vk_index;
-        uint32_t uj;
-        uint32_t edge_index;
+        GraphIndex v1;
+        GraphIndex vk;
+        GraphIndex vi;
+        GraphIndex vi1;
+        GraphIndex v1vk_index;
+        GraphIndex uj;
+        GraphIndex edge_index;
         int32_t mark;
     } GraphPlaneP3ColorBfsFrame;
 
@@ -22,17 +22,13 @@
     typedef Slice(GraphPlaneP3ColorBfsFrameOptional)
         GraphPlaneP3ColorBfsFrameOptionalSlice;
 
-    typedef struct {
-        GraphAdj adj;
-        int32_t mark;
-        uint32_t parent;
-    } GraphPlaneP3ColorBfsVertex;
-
-    typedef Queue(uint32_t) GraphPlaneP3ColorBfsQueue;
+    typedef Queue(GraphIndex) GraphPlaneP3ColorBfsQueue;
 
     typedef struct {
         GraphNbSlice nb;
-        Slice(GraphPlaneP3ColorBfsVertex) vertex_info;
+        GraphAdjSlice adj;
+        Slice(int32_t) marks;
+        Slice(GraphIndex) parents;
         List(GraphPlaneP3ColorBfsFrame) frames;
     } GraphPlaneP3ColorBfsCtx;
 
@@ -44,14 +40,17 @@
     ) {
         GraphPlaneP3ColorBfsCtx ctx = {
             .nb = graph.nb,
-            .vertex_info = { .len = graph.adj.len },
+            .adj = graph.adj,
+            .marks = { .len = graph.adj.len },
+            .parents = { .len = graph.adj.len },
             .frames = { .cap = 3 * graph.adj.len - 6 },
         };
 
-        ctx.vertex_info.ptr = aven_arena_create_array(
-            GraphPlaneP3ColorBfsVertex,
+        ctx.marks.ptr = aven_arena_create_array(int32_t, arena, ctx.marks.len);
+        ctx.parents.ptr = aven_arena_create_array(
+            GraphIndex,
             arena,
-            ctx.vertex_info.len
+            ctx.parents.len
         );
         ctx.frames.ptr = aven_arena_create_array(
             GraphPlaneP3ColorBfsFrame,
@@ -59,29 +58,28 @@
             ctx.frames.cap
         );
 
-        for (uint32_t v = 0; v < ctx.vertex_info.len; v += 1) {
-            get(ctx.vertex_info, v) = (GraphPlaneP3ColorBfsVertex){
-                .adj = get(graph.adj, v),
-            };
+        for (GraphIndex v = 0; v < ctx.marks.len; v += 1) {
+            get(ctx.marks, v) = 0;
+            get(ctx.parents, v) = 0;
         }
 
-        for (uint32_t i = 0; i < path1.len; i += 1) {
-            uint32_t v = get(path1, i);
-            get(ctx.vertex_info, v).mark = 1;
+        for (GraphIndex i = 0; i < path1.len; i += 1) {
+            GraphIndex v = get(path1, i);
+            get(ctx.marks, v) = 1;
         }
 
-        for (uint32_t i = 0; i < path2.len; i += 1) {
-            uint32_t v = get(path2, i);
-            get(ctx.vertex_info, v).mark = 2;
+        for (GraphIndex i = 0; i < path2.len; i += 1) {
+            GraphIndex v = get(path2, i);
+            get(ctx.marks, v) = 2;
         }
 
-        uint32_t v1 = get(path1, 0);
-        uint32_t vi = get(path1, path1.len - 1);
-        uint32_t vk = get(path2, 0);
-        uint32_t vi1 = get(path2, path2.len - 1);
+        GraphIndex v1 = get(path1, 0);
+        GraphIndex vi = get(path1, path1.len - 1);
+        GraphIndex vk = get(path2, 0);
+        GraphIndex vi1 = get(path2, path2.len - 1);
 
         GraphAdj v1_adj = get(graph.adj, v1);
-        uint32_t v1vk_index = graph_nb_index(graph.nb, v1_adj, vk);
+        GraphIndex v1vk_index = graph_nb_index(graph.nb, v1_adj, vk);
         list_push(ctx.frames) = (GraphPlaneP3ColorBfsFrame){
             .v1 = v1,
             .vk = vk,
@@ -112,33 +110,34 @@
         GraphPlaneP3ColorBfsFrame *frame,
         GraphPlaneP3ColorBfsQueue *bfs_queue
     ) {
-        GraphPlaneP3ColorBfsVertex *v1_info = &get(ctx->vertex_info, frame->v1);
-        GraphPlaneP3ColorBfsVertex *vk_info = &get(ctx->vertex_info, frame->vk);
+        GraphAdj v1_adj = get(ctx->adj, frame->v1);
+        int32_t *v1_mark = &get(ctx->marks, frame->v1);
+        int32_t *vk_mark = &get(ctx->marks, frame->vk);
 
         if (frame->uj == frame->vk) {
             if (frame->v1 == frame->vi and frame->vk == frame->vi1) {
                 return true;
             }
 
-            uint32_t v1u_index = graph_adj_next(v1_info->adj, frame->v1vk_index);
-            uint32_t u = graph_nb(ctx->nb, v1_info->adj, v1u_index);
+            GraphIndex v1u_index = graph_adj_next(v1_adj, frame->v1vk_index);
+            GraphIndex u = graph_nb(ctx->nb, v1_adj, v1u_index);
 
-            GraphPlaneP3ColorBfsVertex *u_info = &get(ctx->vertex_info, u);
-            if (u_info->mark <= 0) {
+            int32_t *u_mark = &get(ctx->marks, u);
+            if (*u_mark <= 0) {
                 frame->uj = u;
-                u_info->mark = frame->mark;
-                u_info->parent = u;
-            } else if (u_info->mark == vk_info->mark) {
+                *u_mark = frame->mark;
+                get(ctx->parents, u) = u;
+            } else if (*u_mark == *vk_mark) {
                 assert(frame->vk != frame->vi1);
                 frame->vk = u;
                 frame->v1vk_index = v1u_index;
                 frame->uj = u;
-            } else if (u_info->mark == v1_info->mark) {
+            } else if (*u_mark == *v1_mark) {
                 assert(frame->v1 != frame->vi);
                 frame->v1 = u;
                 frame->v1vk_index = graph_nb_index(
                     ctx->nb,
-                    u_info->adj,
+                    get(ctx->adj, u),
                     frame->vk
                 );
             } else {
@@ -148,43 +147,44 @@
             return false;
         }
 
-        GraphPlaneP3ColorBfsVertex *uj_info = &get(ctx->vertex_info, frame->uj);
-        if (frame->edge_index == uj_info->adj.len) {
+        GraphAdj uj_adj = get(ctx->adj, frame->uj);
+        if (frame->edge_index == uj_adj.len) {
             frame->uj = queue_pop(*bfs_queue);
             frame->edge_index = 0;
             return false;
         }
 
-        uint32_t ujy_index = frame->edge_index;
-        uint32_t y = graph_nb(ctx->nb, uj_info->adj, ujy_index);
-        GraphPlaneP3ColorBfsVertex *y_info = &get(ctx->vertex_info, y);
+        GraphIndex ujy_index = frame->edge_index;
+        GraphIndex y = graph_nb(ctx->nb, uj_adj, ujy_index);
+        int32_t *y_mark = &get(ctx->marks, y);
         frame->edge_index += 1;
 
-        if (y_info->mark == vk_info->mark) {
-            uint32_t next_index = frame->edge_index;
-            if (next_index >= uj_info->adj.len) {
-                next_index -= (uint32_t)uj_info->adj.len;
+        if (*y_mark == *vk_mark) {
+            GraphIndex next_index = frame->edge_index;
+            if (next_index >= uj_adj.len) {
+                next_index -= (GraphIndex)uj_adj.len;
             }
-            uint32_t x = graph_nb(ctx->nb, uj_info->adj, next_index);
-            GraphPlaneP3ColorBfsVertex *x_info = &get(ctx->vertex_info, x);
+            GraphIndex x = graph_nb(ctx->nb, uj_adj, next_index);
+            int32_t *x_mark = &get(ctx->marks, x);
 
-            if (x_info->mark == v1_info->mark) {
+            if (*x_mark == *v1_mark) {
                 if (x != frame->vi or y != frame->vi1) {
-                    uint32_t xy_index;
+                    GraphAdj x_adj = get(ctx->adj, x);
+                    GraphIndex xy_index;
                     if (x == frame->v1) {
                         xy_index = frame->v1vk_index;
-                        for (uint32_t i = 0; i < x_info->adj.len; i += 1) {
+                        for (GraphIndex i = 0; i < x_adj.len; i += 1) {
                             xy_index = xy_index + 1;
-                            if (xy_index >= x_info->adj.len) {
-                                xy_index -= x_info->adj.len;
+                            if (xy_index >= x_adj.len) {
+                                xy_index -= x_adj.len;
                             }
-                            if (graph_nb(ctx->nb, x_info->adj, xy_index) == y) {
+                            if (graph_nb(ctx->nb, x_adj, xy_index) == y) {
                                 break;
                             }
                         }
                         assert(xy_index != frame->v1vk_index);
                     } else {
-                        xy_index = graph_nb_index(ctx->nb, x_info->adj, y);
+                        xy_index = graph_nb_index(ctx->nb, x_adj, y);
                     }
                     list_push(ctx->frames) = (GraphPlaneP3ColorBfsFrame){
                         .v1 = x,
@@ -197,23 +197,21 @@
                     };
                 }
 
-                int32_t p3_color = v1_info->mark ^ vk_info->mark;
+                int32_t p3_color = *v1_mark ^ *vk_mark;
 
-                uint32_t w = frame->uj;
-                uint32_t u = frame->uj;
-                GraphPlaneP3ColorBfsVertex *u_info = &get(ctx->vertex_info, w);
+                GraphIndex w = frame->uj;
+                GraphIndex u = frame->uj;
 
-                u_info->mark = p3_color;
+                get(ctx->marks, u) = p3_color;
 
-                while (u_info->parent != u) {
-                    u = u_info->parent;
-                    u_info = &get(ctx->vertex_info, u);
-                    u_info->mark = p3_color;
+                while (get(ctx->parents, u) != u) {
+                    u = get(ctx->parents, u);
+                    get(ctx->marks, u) = p3_color;
                 }
 
-                uint32_t uvk_index = graph_nb_index(
+                GraphIndex uvk_index = graph_nb_index(
                     ctx->nb,
-                    u_info->adj,
+                    get(ctx->adj, u),
                     frame->vk
                 );
                 list_push(ctx->frames) = (GraphPlaneP3ColorBfsFrame){
@@ -226,8 +224,8 @@
                     .mark = frame->mark - 1,
                 };
 
-                uint32_t v1u_index = graph_adj_next(
-                    v1_info->adj,
+                GraphIndex v1u_index = graph_adj_next(
+                    v1_adj,
                     frame->v1vk_index
                 );
                 *frame = (GraphPlaneP3ColorBfsFrame){
@@ -241,15 +239,50 @@
                 };
                 queue_clear(*bfs_queue);
             }
-        } else if (y_info->mark <= 0 and y_info->mark != frame->mark) {
-            y_info->parent = frame->uj;
-            y_info->mark = frame->mark;
+        } else if (*y_mark <= 0 and *y_mark != frame->mark) {
+            get(ctx->parents, y) = frame->uj;
+            *y_mark = frame->mark;
             queue_push(*bfs_queue) = y;
         }
 
         return false;
     }
 
+    // Budgeted form of the frame loop in graph_plane_p3color_bfs, frame
+    // starts invalid and carries the progress between calls, returns true
+    // once the frame stack is empty
+    static inline bool graph_plane_p3color_bfs_run(
+        GraphPlaneP3ColorBfsCtx *ctx,
+        GraphPlaneP3ColorBfsFrameOptional *frame,
+        GraphPlaneP3ColorBfsQueue *bfs_queue,
+        size_t budget
+    ) {
+        GraphPlaneP3ColorBfsFrameOptional cur_frame = *frame;
+        bool done = false;
+
+        for (; budget > 0; budget -= 1) {
+            if (!cur_frame.valid) {
+                cur_frame = graph_plane_p3color_bfs_next_frame(ctx);
+                if (!cur_frame.valid) {
+                    done = true;
+                    break;
+                }
+            }
+            if (
+                graph_plane_p3color_bfs_frame_step(
+                    ctx,
+                    &cur_frame.value,
+                    bfs_queue
+                )
+            ) {
+                cur_frame.valid = false;
+            }
+        }
+
+        *frame = cur_frame;
+        return done;
+    }
+
     static inline GraphPropUint8 graph_plane_p3color_bfs(
         Graph graph,
         GraphSubset p,
@@ -268,7 +301,7 @@
         );
 
         GraphPlaneP3ColorBfsQueue bfs_queue = aven_arena_create_queue(
-            uint32_t,
+            GraphIndex,
             &temp_arena,
             graph.adj.len
         );
@@ -287,8 +320,8 @@
             cur_frame = graph_plane_p3color_bfs_next_frame(&ctx);
         } while (cur_frame.valid);
 
-        for (uint32_t v = 0; v < coloring.len; v += 1) {
-            int32_t v_mark = get(ctx.vertex_info, v).mark;
+        for (GraphIndex v = 0; v < coloring.len; v += 1) {
+            int32_t v_mark = get(ctx.marks, v);
             assert(v_mark > 0 and v_mark <= 3);
             get(coloring, v) = (uint8_t)v_mark;
         }
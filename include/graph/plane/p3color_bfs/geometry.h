@@ -96,11 +96,11 @@
             aven_arena_create_slice(
                 GraphPlaneP3ColorBfsGeometryDrawSlice,
                 &temp_arena,
-                ctx->vertex_info.len
+                ctx->adj.len
             );
 
-        for (uint32_t v = 0; v < ctx->vertex_info.len; v += 1) {
-            get(draw_graph, v).len = get(ctx->vertex_info, v).adj.len;
+        for (uint32_t v = 0; v < ctx->adj.len; v += 1) {
+            get(draw_graph, v).len = get(ctx->adj, v).len;
             get(draw_graph, v).ptr = aven_arena_create_array(
                 int32_t,
                 &temp_arena,
@@ -128,12 +128,12 @@
                 v = frame->v1;
                 edge_index = frame->v1vk_index;
             }
-            GraphPlaneP3ColorBfsVertex v_info = get(ctx->vertex_info, v);
+            GraphAdj v_adj = get(ctx->adj, v);
             GraphPlaneP3ColorBfsGeometryDrawSlice v_drawn = get(draw_graph, v);
 
-            if (edge_index < v_info.adj.len) {
-                uint32_t u = graph_nb(ctx->nb, v_info.adj, edge_index);
-                GraphPlaneP3ColorBfsVertex u_info = get(ctx->vertex_info, u);
+            if (edge_index < v_adj.len) {
+                uint32_t u = graph_nb(ctx->nb, v_adj, edge_index);
+                GraphAdj u_adj = get(ctx->adj, u);
                 GraphPlaneP3ColorBfsGeometryDrawSlice u_drawn = get(
                     draw_graph,
                     u
@@ -141,7 +141,7 @@
                 if (u > v) {
                     get(v_drawn, edge_index) = -4;
                 } else {
-                    uint32_t uv_index = graph_nb_index(ctx->nb, u_info.adj, v);
+                    uint32_t uv_index = graph_nb_index(ctx->nb, u_adj, v);
                     get(u_drawn, uv_index) = -4;
                 }
             }
@@ -150,12 +150,12 @@
         Queue(uint32_t) bfs_queue = aven_arena_create_queue(
             uint32_t,
             &temp_arena,
-            ctx->vertex_info.len
+            ctx->adj.len
         );
         Slice(bool) visited = aven_arena_create_slice(
             bool,
             &temp_arena,
-            ctx->vertex_info.len
+            ctx->adj.len
         );
         for (uint32_t v = 0; v < visited.len; v += 1) {
             get(visited, v) = 0;
@@ -184,41 +184,40 @@
 
                 bool done = false;
                 while (!done) {
-                    GraphPlaneP3ColorBfsVertex v_info = get(ctx->vertex_info, v);
+                    GraphAdj v_adj = get(ctx->adj, v);
+                    int32_t v_mark = get(ctx->marks, v);
                     GraphPlaneP3ColorBfsGeometryDrawSlice v_drawn = get(
                         draw_graph,
                         v
                     );
 
                     uint32_t edge_index = vl_index;
-                    for (uint32_t j = 0; j < v_info.adj.len; j += 1) {
-                        uint32_t u = graph_nb(ctx->nb, v_info.adj, edge_index);
-                        GraphPlaneP3ColorBfsVertex u_info = get(
-                            ctx->vertex_info,
-                            u
-                        );
+                    for (uint32_t j = 0; j < v_adj.len; j += 1) {
+                        uint32_t u = graph_nb(ctx->nb, v_adj, edge_index);
+                        GraphAdj u_adj = get(ctx->adj, u);
+                        int32_t u_mark = get(ctx->marks, u);
 
                         if (u > v and get(v_drawn, edge_index) == 0) {
-                            if (v_info.mark == u_info.mark) {
-                                get(v_drawn, edge_index) = v_info.mark;
+                            if (v_mark == u_mark) {
+                                get(v_drawn, edge_index) = v_mark;
                             } else {
                                 get(v_drawn, edge_index) = active ? -1 : -2;
                             }
                         }
 
-                        if (u_info.mark <= 0) {
+                        if (u_mark <= 0) {
                             if (
                                 !get(visited, u) and
-                                get(ctx->vertex_info, u).mark <= 0
+                                get(ctx->marks, u) <= 0
                             ) {
                                 queue_push(bfs_queue) = u;
                                 get(visited, u) = true;
                             }
                         } else if (
-                            (j > 0 and u_info.mark == v_info.mark) or
+                            (j > 0 and u_mark == v_mark) or
                             (v == frame->vi and u == frame->vi1)
                         ) {
-                            vl_index = graph_nb_index(ctx->nb, u_info.adj, v);
+                            vl_index = graph_nb_index(ctx->nb, u_adj, v);
                             v = u;
                             break;
                         } else if (v == frame->vk and u == frame->v1) {
@@ -226,30 +225,33 @@
                             break;
                         }
 
-                        edge_index = graph_adj_next(v_info.adj, edge_index);
+                        edge_index = graph_adj_next(v_adj, edge_index);
                     }
                 }
             }
 
             while (bfs_queue.used > 0) {
                 uint32_t v = queue_pop(bfs_queue);
-                GraphPlaneP3ColorBfsVertex v_info = get(ctx->vertex_info, v);
+                GraphAdj v_adj = get(ctx->adj, v);
+                int32_t v_mark = get(ctx->marks, v);
+                uint32_t v_parent = get(ctx->parents, v);
                 GraphPlaneP3ColorBfsGeometryDrawSlice v_drawn = get(
                     draw_graph,
                     v
                 );
 
-                for (uint32_t j = 0; j < v_info.adj.len; j += 1) {
-                    uint32_t u = graph_nb(ctx->nb, v_info.adj, j);
-                    GraphPlaneP3ColorBfsVertex u_info = get(ctx->vertex_info, u);
+                for (uint32_t j = 0; j < v_adj.len; j += 1) {
+                    uint32_t u = graph_nb(ctx->nb, v_adj, j);
+                    int32_t u_mark = get(ctx->marks, u);
+                    uint32_t u_parent = get(ctx->parents, u);
 
                     if (u > v and get(v_drawn, j) == 0) {
                         if (
                             (
-                                v_info.mark == frame->mark and
-                                u_info.mark == frame->mark
+                                v_mark == frame->mark and
+                                u_mark == frame->mark
                             ) and
-                            (v_info.parent == u or u_info.parent == v)
+                            (v_parent == u or u_parent == v)
                         ) {
                             get(v_drawn, j) = -3;
                         } else {
@@ -257,14 +259,14 @@
                         }
                     }
 
-                    if (!get(visited, u) and u_info.mark <= 0) {
+                    if (!get(visited, u) and u_mark <= 0) {
                         queue_push(bfs_queue) = u;
                         get(visited, u) = true;
                     }
                 }
 
-                if (v_info.mark == frame->mark) {
-                    if (v_info.parent == v) {
+                if (v_mark == frame->mark) {
+                    if (v_parent == v) {
                         graph_plane_geometry_push_vertex(
                             rounded_geometry,
                             embedding,
@@ -323,18 +325,19 @@
             vec4_copy(edge_info->color, info->colors[i + 1]);
         }
 
-        for (uint32_t v = 0; v < ctx->vertex_info.len; v += 1) {
-            GraphPlaneP3ColorBfsVertex v_info = get(ctx->vertex_info, v);
-            if (v_info.mark <= 0) {
+        for (uint32_t v = 0; v < ctx->adj.len; v += 1) {
+            GraphAdj v_adj = get(ctx->adj, v);
+            int32_t v_mark = get(ctx->marks, v);
+            if (v_mark <= 0) {
                 continue;
             }
             GraphPlaneP3ColorBfsGeometryDrawSlice v_drawn = get(draw_graph, v);
-            for (uint32_t i = 0; i < v_info.adj.len; i += 1) {
-                uint32_t u = graph_nb(ctx->nb, v_info.adj, i);
-                GraphPlaneP3ColorBfsVertex u_info = get(ctx->vertex_info, u);
-                if (u > v and u_info.mark == v_info.mark) {
+            for (uint32_t i = 0; i < v_adj.len; i += 1) {
+                uint32_t u = graph_nb(ctx->nb, v_adj, i);
+                int32_t u_mark = get(ctx->marks, u);
+                if (u > v and u_mark == v_mark) {
                     if (get(v_drawn, i) == 0) {
-                        get(v_drawn, i) = v_info.mark;
+                        get(v_drawn, i) = v_mark;
                     }
                 }
             }
@@ -373,7 +376,7 @@
                 &outline_node_info
             );
 
-            int32_t mark = get(ctx->vertex_info, v).mark;
+            int32_t mark = get(ctx->marks, v);
             uint32_t color = mark > 0 ? (uint32_t)mark : 0;
             graph_plane_geometry_push_vertex(
                 rounded_geometry,
@@ -384,12 +387,12 @@
             );
         }
 
-        for (uint32_t v = 0; v < ctx->vertex_info.len; v += 1) {
+        for (uint32_t v = 0; v < ctx->adj.len; v += 1) {
             GraphPlaneP3ColorBfsGeometryDrawSlice v_drawn = get(draw_graph, v);
-            GraphPlaneP3ColorBfsVertex v_info = get(ctx->vertex_info, v);
+            GraphAdj v_adj = get(ctx->adj, v);
 
-            for (uint32_t i = 0; i < v_info.adj.len; i += 1) {
-                uint32_t u = graph_nb(ctx->nb, v_info.adj, i);
+            for (uint32_t i = 0; i < v_adj.len; i += 1) {
+                uint32_t u = graph_nb(ctx->nb, v_adj, i);
                 if (u < v or get(v_drawn, i) != 0) {
                     continue;
                 }
@@ -403,12 +406,12 @@
                 );
             }
         }
-        for (uint32_t v = 0; v < ctx->vertex_info.len; v += 1) {
+        for (uint32_t v = 0; v < ctx->adj.len; v += 1) {
             GraphPlaneP3ColorBfsGeometryDrawSlice v_drawn = get(draw_graph, v);
-            GraphPlaneP3ColorBfsVertex v_info = get(ctx->vertex_info, v);
+            GraphAdj v_adj = get(ctx->adj, v);
 
-            for (uint32_t i = 0; i < v_info.adj.len; i += 1) {
-                uint32_t u = graph_nb(ctx->nb, v_info.adj, i);
+            for (uint32_t i = 0; i < v_adj.len; i += 1) {
+                uint32_t u = graph_nb(ctx->nb, v_adj, i);
                 if (u < v or get(v_drawn, i) != -2) {
                     continue;
                 }
@@ -422,12 +425,12 @@
                 );
             }
         }
-        for (uint32_t v = 0; v < ctx->vertex_info.len; v += 1) {
+        for (uint32_t v = 0; v < ctx->adj.len; v += 1) {
             GraphPlaneP3ColorBfsGeometryDrawSlice v_drawn = get(draw_graph, v);
-            GraphPlaneP3ColorBfsVertex v_info = get(ctx->vertex_info, v);
+            GraphAdj v_adj = get(ctx->adj, v);
 
-            for (uint32_t i = 0; i < v_info.adj.len; i += 1) {
-                uint32_t u = graph_nb(ctx->nb, v_info.adj, i);
+            for (uint32_t i = 0; i < v_adj.len; i += 1) {
+                uint32_t u = graph_nb(ctx->nb, v_adj, i);
                 if (u < v or get(v_drawn, i) != -1) {
                     continue;
                 }
@@ -441,12 +444,12 @@
                 );
             }
         }
-        for (uint32_t v = 0; v < ctx->vertex_info.len; v += 1) {
+        for (uint32_t v = 0; v < ctx->adj.len; v += 1) {
             GraphPlaneP3ColorBfsGeometryDrawSlice v_drawn = get(draw_graph, v);
-            GraphPlaneP3ColorBfsVertex v_info = get(ctx->vertex_info, v);
+            GraphAdj v_adj = get(ctx->adj, v);
 
-            for (uint32_t i = 0; i < v_info.adj.len; i += 1) {
-                uint32_t u = graph_nb(ctx->nb, v_info.adj, i);
+            for (uint32_t i = 0; i < v_adj.len; i += 1) {
+                uint32_t u = graph_nb(ctx->nb, v_adj, i);
                 if (u < v or get(v_drawn, i) <= 0) {
                     continue;
                 }
@@ -460,12 +463,12 @@
                 );
             }
         }
-        for (uint32_t v = 0; v < ctx->vertex_info.len; v += 1) {
+        for (uint32_t v = 0; v < ctx->adj.len; v += 1) {
             GraphPlaneP3ColorBfsGeometryDrawSlice v_drawn = get(draw_graph, v);
-            GraphPlaneP3ColorBfsVertex v_info = get(ctx->vertex_info, v);
+            GraphAdj v_adj = get(ctx->adj, v);
 
-            for (uint32_t i = 0; i < v_info.adj.len; i += 1) {
-                uint32_t u = graph_nb(ctx->nb, v_info.adj, i);
+            for (uint32_t i = 0; i < v_adj.len; i += 1) {
+                uint32_t u = graph_nb(ctx->nb, v_adj, i);
                 if (u < v or get(v_drawn, i) != -3) {
                     continue;
                 }
@@ -487,12 +490,12 @@
                 );
             }
         }
-        for (uint32_t v = 0; v < ctx->vertex_info.len; v += 1) {
+        for (uint32_t v = 0; v < ctx->adj.len; v += 1) {
             GraphPlaneP3ColorBfsGeometryDrawSlice v_drawn = get(draw_graph, v);
-            GraphPlaneP3ColorBfsVertex v_info = get(ctx->vertex_info, v);
+            GraphAdj v_adj = get(ctx->adj, v);
 
-            for (uint32_t i = 0; i < v_info.adj.len; i += 1) {
-                uint32_t u = graph_nb(ctx->nb, v_info.adj, i);
+            for (uint32_t i = 0; i < v_adj.len; i += 1) {
+                uint32_t u = graph_nb(ctx->nb, v_adj, i);
                 if (u < v or get(v_drawn, i) != -4) {
                     continue;
                 }
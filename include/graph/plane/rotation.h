@@ -0,0 +1,236 @@
+#ifndef GRAPH_PLANE_ROTATION_H
+    #define GRAPH_PLANE_ROTATION_H
+
+    #include <aven.h>
+    #include <aven/arena.h>
+    #include <aven/math.h>
+
+    #include "../../graph.h"
+    #include "../plane.h"
+    #include "../io/import.h"
+
+    // Build the rotation system of a straight-line drawing: every rotation
+    // lists its neighbors by increasing angle from the positive x-axis,
+    // the orientation of the generated plane embeddings. Angles are
+    // compared by half-plane and cross product in double precision, which
+    // is exact for single precision coordinates of similar magnitude.
+
+    // Direction from a vertex to the neighbor at the same half-edge, the
+    // half-plane is 1 for angles in [0, pi) and 2 for [pi, 2 pi), loops
+    // and coincident points have no angle and come first with 0
+    typedef struct {
+        double x;
+        double y;
+        GraphIndex vertex;
+        GraphIndex half;
+    } GraphPlaneRotationKey;
+    typedef Slice(GraphPlaneRotationKey) GraphPlaneRotationKeySlice;
+
+    #ifndef GRAPH_PLANE_ROTATION_INSERTION_LEN
+        #define GRAPH_PLANE_ROTATION_INSERTION_LEN 16
+    #endif
+
+    static inline GraphPlaneRotationKey graph_plane_rotation_key(
+        GraphPlaneEmbedding embedding,
+        GraphIndex v,
+        GraphIndex u
+    ) {
+        double x = (double)get(embedding, u)[0] - (double)get(embedding, v)[0];
+        double y = (double)get(embedding, u)[1] - (double)get(embedding, v)[1];
+        GraphIndex half = 1;
+        if (y < 0.0 or (y == 0.0 and x < 0.0)) {
+            half = 2;
+        } else if (y == 0.0 and x == 0.0) {
+            half = 0;
+        }
+
+        return (GraphPlaneRotationKey){
+            .x = x,
+            .y = y,
+            .vertex = u,
+            .half = half,
+        };
+    }
+
+    // Whether a comes strictly before b, neighbors in the same direction
+    // are ordered by index so the result does not depend on input order
+    static inline bool graph_plane_rotation_key_less(
+        GraphPlaneRotationKey a,
+        GraphPlaneRotationKey b
+    ) {
+        if (a.half != b.half) {
+            return a.half < b.half;
+        }
+        double cross = a.x * b.y - a.y * b.x;
+        if (cross != 0.0) {
+            return cross > 0.0;
+        }
+        return a.vertex < b.vertex;
+    }
+
+    // Sort the len keys starting at index, short rotations by insertion
+    // and longer ones by bottom-up merge sort through the scratch keys
+    static inline void graph_plane_rotation_sort_keys(
+        GraphPlaneRotationKeySlice keys,
+        GraphPlaneRotationKeySlice scratch,
+        GraphIndex index,
+        GraphIndex len
+    ) {
+        GraphPlaneRotationKey *src = &get(keys, index);
+        if (len <= GRAPH_PLANE_ROTATION_INSERTION_LEN) {
+            for (GraphIndex i = 1; i < len; i += 1) {
+                GraphPlaneRotationKey key = src[i];
+                GraphIndex j = i;
+                while (
+                    j > 0 and
+                    graph_plane_rotation_key_less(key, src[j - 1])
+                ) {
+                    src[j] = src[j - 1];
+                    j -= 1;
+                }
+                src[j] = key;
+            }
+            return;
+        }
+
+        GraphPlaneRotationKey *dst = &get(scratch, index);
+        for (GraphIndex width = 1; width < len; width *= 2) {
+            for (GraphIndex lo = 0; lo < len; lo += 2 * width) {
+                GraphIndex mid = min(lo + width, len);
+                GraphIndex hi = min(lo + 2 * width, len);
+
+                GraphIndex i = lo;
+                GraphIndex j = mid;
+                for (GraphIndex k = lo; k < hi; k += 1) {
+                    if (
+                        j == hi or
+                        (
+                            i < mid and
+                            !graph_plane_rotation_key_less(src[j], src[i])
+                        )
+                    ) {
+                        dst[k] = src[i];
+                        i += 1;
+                    } else {
+                        dst[k] = src[j];
+                        j += 1;
+                    }
+                }
+            }
+
+            GraphPlaneRotationKey *tmp = src;
+            src = dst;
+            dst = tmp;
+        }
+
+        if (src != &get(keys, index)) {
+            for (GraphIndex k = 0; k < len; k += 1) {
+                get(keys, index + k) = src[k];
+            }
+        }
+    }
+
+    // Sort the rotation of v in place, keys and scratch parallel graph.nb
+    static inline void graph_plane_rotation_sort_vertex(
+        Graph graph,
+        GraphPlaneEmbedding embedding,
+        GraphPlaneRotationKeySlice keys,
+        GraphPlaneRotationKeySlice scratch,
+        GraphIndex v
+    ) {
+        GraphAdj v_adj = get(graph.adj, v);
+        for (GraphIndex i = 0; i < v_adj.len; i += 1) {
+            get(keys, v_adj.index + i) = graph_plane_rotation_key(
+                embedding,
+                v,
+                graph_nb(graph.nb, v_adj, i)
+            );
+        }
+
+        graph_plane_rotation_sort_keys(keys, scratch, v_adj.index, v_adj.len);
+
+        for (GraphIndex i = 0; i < v_adj.len; i += 1) {
+            get(graph.nb, v_adj.index + i) = get(keys, v_adj.index + i).vertex;
+        }
+    }
+
+    static inline void graph_plane_rotation_sort(
+        Graph graph,
+        GraphPlaneEmbedding embedding,
+        AvenArena temp_arena
+    ) {
+        assert(embedding.len == graph.adj.len);
+
+        GraphPlaneRotationKeySlice keys = aven_arena_create_slice(
+            GraphPlaneRotationKey,
+            &temp_arena,
+            graph.nb.len
+        );
+        GraphPlaneRotationKeySlice scratch = aven_arena_create_slice(
+            GraphPlaneRotationKey,
+            &temp_arena,
+            graph.nb.len
+        );
+
+        for (GraphIndex v = 0; v < graph.adj.len; v += 1) {
+            graph_plane_rotation_sort_vertex(
+                graph,
+                embedding,
+                keys,
+                scratch,
+                v
+            );
+        }
+    }
+
+    // Graph of the undirected edges drawn as segments between the points
+    // of the embedding, each edge listed once
+    static inline Graph graph_plane_rotation_graph(
+        GraphPlaneEmbedding embedding,
+        GraphIoEdgeSlice edges,
+        AvenArena *arena
+    ) {
+        Graph graph = graph_io_import_csr(embedding.len, edges, arena);
+        graph_plane_rotation_sort(graph, embedding, *arena);
+        return graph;
+    }
+
+    static inline GraphAug graph_plane_rotation_aug_graph(
+        GraphPlaneEmbedding embedding,
+        GraphIoEdgeSlice edges,
+        AvenArena *arena
+    ) {
+        GraphAug aug_graph = {
+            .adj = { .len = embedding.len },
+            .nb = { .len = 2 * edges.len },
+        };
+        aug_graph.adj.ptr = aven_arena_create_array(
+            GraphAdj,
+            arena,
+            aug_graph.adj.len
+        );
+        aug_graph.nb.ptr = aven_arena_create_array(
+            GraphAugNb,
+            arena,
+            aug_graph.nb.len
+        );
+
+        AvenArena temp_arena = *arena;
+        Graph graph = graph_plane_rotation_graph(
+            embedding,
+            edges,
+            &temp_arena
+        );
+        GraphAug temp_aug_graph = graph_aug(graph, &temp_arena);
+
+        for (GraphIndex v = 0; v < aug_graph.adj.len; v += 1) {
+            get(aug_graph.adj, v) = get(temp_aug_graph.adj, v);
+        }
+        for (GraphIndex i = 0; i < aug_graph.nb.len; i += 1) {
+            get(aug_graph.nb, i) = get(temp_aug_graph.nb, i);
+        }
+
+        return aug_graph;
+    }
+
+#endif // GRAPH_PLANE_ROTATION_H
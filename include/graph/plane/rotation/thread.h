@@ -0,0 +1,167 @@
+#ifndef GRAPH_PLANE_ROTATION_THREAD_H
+    #define GRAPH_PLANE_ROTATION_THREAD_H
+
+    #include <aven.h>
+    #include <aven/arena.h>
+    #include <aven/thread/pool.h>
+
+    #include "../../../graph.h"
+    #include "../../thread.h"
+    #include "../rotation.h"
+
+    // Rotations are independent, so each thread sorts those of a
+    // contiguous range of vertices with its own part of the shared keys
+
+    typedef struct {
+        Graph graph;
+        GraphPlaneEmbedding embedding;
+        GraphPlaneRotationKeySlice keys;
+        GraphPlaneRotationKeySlice scratch;
+        GraphIndex start_vertex;
+        GraphIndex end_vertex;
+    } GraphPlaneRotationThreadWorker;
+    typedef Slice(GraphPlaneRotationThreadWorker)
+        GraphPlaneRotationThreadWorkerSlice;
+
+    static void graph_plane_rotation_thread_sort_worker(void *args) {
+        GraphPlaneRotationThreadWorker *worker = args;
+
+        for (
+            GraphIndex v = worker->start_vertex;
+            v != worker->end_vertex;
+            v += 1
+        ) {
+            graph_plane_rotation_sort_vertex(
+                worker->graph,
+                worker->embedding,
+                worker->keys,
+                worker->scratch,
+                v
+            );
+        }
+    }
+
+    static inline void graph_plane_rotation_sort_thread(
+        Graph graph,
+        GraphPlaneEmbedding embedding,
+        AvenThreadPool *thread_pool,
+        size_t nthreads,
+        AvenArena temp_arena
+    ) {
+        assert(nthreads > 0);
+        assert(embedding.len == graph.adj.len);
+
+        GraphPlaneRotationKeySlice keys = aven_arena_create_slice(
+            GraphPlaneRotationKey,
+            &temp_arena,
+            graph.nb.len
+        );
+        GraphPlaneRotationKeySlice scratch = aven_arena_create_slice(
+            GraphPlaneRotationKey,
+            &temp_arena,
+            graph.nb.len
+        );
+
+        GraphPlaneRotationThreadWorkerSlice workers = aven_arena_create_slice(
+            GraphPlaneRotationThreadWorker,
+            &temp_arena,
+            nthreads
+        );
+        AvenThreadPoolJobSlice jobs = aven_arena_create_slice(
+            AvenThreadPoolJob,
+            &temp_arena,
+            nthreads - 1
+        );
+
+        GraphIndex chunk_size = (GraphIndex)(graph.adj.len / workers.len);
+        for (GraphIndex i = 0; i < workers.len; i += 1) {
+            GraphIndex start_vertex = i * chunk_size;
+            GraphIndex end_vertex = (i + 1) * chunk_size;
+            if (i + 1 == workers.len) {
+                end_vertex = (GraphIndex)graph.adj.len;
+            }
+
+            get(workers, i) = (GraphPlaneRotationThreadWorker){
+                .graph = graph,
+                .embedding = embedding,
+                .keys = keys,
+                .scratch = scratch,
+                .start_vertex = start_vertex,
+                .end_vertex = end_vertex,
+            };
+        }
+
+        graph_thread_run_phase(
+            thread_pool,
+            jobs,
+            workers,
+            graph_plane_rotation_thread_sort_worker
+        );
+    }
+
+    static inline Graph graph_plane_rotation_graph_thread(
+        GraphPlaneEmbedding embedding,
+        GraphIoEdgeSlice edges,
+        AvenThreadPool *thread_pool,
+        size_t nthreads,
+        AvenArena *arena
+    ) {
+        Graph graph = graph_io_import_csr(embedding.len, edges, arena);
+        graph_plane_rotation_sort_thread(
+            graph,
+            embedding,
+            thread_pool,
+            nthreads,
+            *arena
+        );
+        return graph;
+    }
+
+    static inline GraphAug graph_plane_rotation_aug_graph_thread(
+        GraphPlaneEmbedding embedding,
+        GraphIoEdgeSlice edges,
+        AvenThreadPool *thread_pool,
+        size_t nthreads,
+        AvenArena *arena
+    ) {
+        GraphAug aug_graph = {
+            .adj = { .len = embedding.len },
+            .nb = { .len = 2 * edges.len },
+        };
+        aug_graph.adj.ptr = aven_arena_create_array(
+            GraphAdj,
+            arena,
+            aug_graph.adj.len
+        );
+        aug_graph.nb.ptr = aven_arena_create_array(
+            GraphAugNb,
+            arena,
+            aug_graph.nb.len
+        );
+
+        AvenArena temp_arena = *arena;
+        Graph graph = graph_plane_rotation_graph_thread(
+            embedding,
+            edges,
+            thread_pool,
+            nthreads,
+            &temp_arena
+        );
+        GraphAug temp_aug_graph = graph_aug_thread(
+            graph,
+            thread_pool,
+            nthreads,
+            &temp_arena
+        );
+
+        for (GraphIndex v = 0; v < aug_graph.adj.len; v += 1) {
+            get(aug_graph.adj, v) = get(temp_aug_graph.adj, v);
+        }
+        for (GraphIndex i = 0; i < aug_graph.nb.len; i += 1) {
+            get(aug_graph.nb, i) = get(temp_aug_graph.nb, i);
+        }
+
+        return aug_graph;
+    }
+
+#endif // GRAPH_PLANE_ROTATION_THREAD_H
@@ -0,0 +1,184 @@
+#ifndef GRAPH_SMALL_H
+    #define GRAPH_SMALL_H
+
+    #include <aven.h>
+    #include <aven/arena.h>
+
+    #include "../graph.h"
+
+    // 16-bit index versions of Graph and GraphAug for graphs with at most
+    // GRAPH_SMALL_MAX_VERTICES vertices and GRAPH_SMALL_MAX_NB half-edges.
+    // The vertex bound leaves room for the signed face marks of p3color.
+
+    #define GRAPH_SMALL_MAX_VERTICES 0x7fff
+    #define GRAPH_SMALL_MAX_NB 0xffff
+
+    typedef struct {
+        uint16_t index;
+        uint16_t len;
+    } GraphSmallAdj;
+
+    typedef Slice(GraphSmallAdj) GraphSmallAdjSlice;
+    typedef Slice(uint16_t) GraphSmallNbSlice;
+
+    typedef struct {
+        GraphSmallNbSlice nb;
+        GraphSmallAdjSlice adj;
+    } GraphSmall;
+
+    typedef struct {
+        uint16_t vertex;
+        uint16_t back_index;
+    } GraphSmallAugNb;
+    typedef Slice(GraphSmallAugNb) GraphSmallAugNbSlice;
+
+    typedef struct {
+        GraphSmallAugNbSlice nb;
+        GraphSmallAdjSlice adj;
+    } GraphSmallAug;
+
+    static inline bool graph_small_fits(size_t vertices, size_t nb_len) {
+        return vertices <= GRAPH_SMALL_MAX_VERTICES and
+            nb_len <= GRAPH_SMALL_MAX_NB;
+    }
+
+    static inline uint16_t graph_small_nb(
+        GraphSmallNbSlice nb,
+        GraphSmallAdj v_adj,
+        uint16_t i
+    ) {
+        assert(i < v_adj.len);
+        return get(nb, v_adj.index + i);
+    }
+
+    static inline GraphSmallAugNb graph_small_aug_nb(
+        GraphSmallAugNbSlice nb,
+        GraphSmallAdj v_adj,
+        uint16_t i
+    ) {
+        assert(i < v_adj.len);
+        return get(nb, v_adj.index + i);
+    }
+
+    static inline uint16_t graph_small_adj_next(
+        GraphSmallAdj v_adj,
+        uint16_t i
+    ) {
+        assert(i < v_adj.len);
+        if (i == v_adj.len - 1) {
+            return 0;
+        }
+        return (uint16_t)(i + 1);
+    }
+
+    static inline uint16_t graph_small_adj_prev(
+        GraphSmallAdj v_adj,
+        uint16_t i
+    ) {
+        assert(i < v_adj.len);
+        if (i == 0) {
+            return (uint16_t)(v_adj.len - 1);
+        }
+        return (uint16_t)(i - 1);
+    }
+
+    static inline uint16_t graph_small_nb_index(
+        GraphSmallNbSlice nb,
+        GraphSmallAdj v_adj,
+        uint16_t u
+    ) {
+        for (uint16_t i = 0; i < v_adj.len; i += 1) {
+            if (graph_small_nb(nb, v_adj, i) == u) {
+                return i;
+            }
+        }
+
+        assert(false);
+        return 0xffff;
+    }
+
+    static inline uint16_t graph_small_aug_nb_index(
+        GraphSmallAugNbSlice nb,
+        GraphSmallAdj v_adj,
+        uint16_t u
+    ) {
+        for (uint16_t i = 0; i < v_adj.len; i += 1) {
+            if (graph_small_aug_nb(nb, v_adj, i).vertex == u) {
+                return i;
+            }
+        }
+
+        assert(false);
+        return 0xffff;
+    }
+
+    static inline GraphSmallAdjSlice graph_small_adj(
+        GraphAdjSlice adj,
+        AvenArena *arena
+    ) {
+        GraphSmallAdjSlice small_adj = { .len = adj.len };
+        small_adj.ptr = aven_arena_create_array(
+            GraphSmallAdj,
+            arena,
+            small_adj.len
+        );
+
+        for (uint32_t v = 0; v < adj.len; v += 1) {
+            GraphAdj v_adj = get(adj, v);
+            get(small_adj, v) = (GraphSmallAdj){
+                .index = (uint16_t)v_adj.index,
+                .len = (uint16_t)v_adj.len,
+            };
+        }
+
+        return small_adj;
+    }
+
+    static inline GraphSmall graph_small(Graph graph, AvenArena *arena) {
+        assert(graph_small_fits(graph.adj.len, graph.nb.len));
+
+        GraphSmall small_graph = {
+            .nb = { .len = graph.nb.len },
+            .adj = graph_small_adj(graph.adj, arena),
+        };
+        small_graph.nb.ptr = aven_arena_create_array(
+            uint16_t,
+            arena,
+            small_graph.nb.len
+        );
+
+        for (uint32_t i = 0; i < graph.nb.len; i += 1) {
+            get(small_graph.nb, i) = (uint16_t)get(graph.nb, i);
+        }
+
+        return small_graph;
+    }
+
+    static inline GraphSmallAug graph_small_aug(
+        GraphAug graph,
+        AvenArena *arena
+    ) {
+        assert(graph_small_fits(graph.adj.len, graph.nb.len));
+
+        GraphSmallAug small_graph = {
+            .nb = { .len = graph.nb.len },
+            .adj = graph_small_adj(graph.adj, arena),
+        };
+        small_graph.nb.ptr = aven_arena_create_array(
+            GraphSmallAugNb,
+            arena,
+            small_graph.nb.len
+        );
+
+        for (uint32_t i = 0; i < graph.nb.len; i += 1) {
+            GraphAugNb nb = get(graph.nb, i);
+            get(small_graph.nb, i) = (GraphSmallAugNb){
+                .vertex = (uint16_t)nb.vertex,
+                .back_index = (uint16_t)nb.back_index,
+            };
+        }
+
+        return small_graph;
+    }
+
+#endif // GRAPH_SMALL_H
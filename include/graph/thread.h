@@ -0,0 +1,891 @@
+#ifndef GRAPH_THREAD_H
+    #define GRAPH_THREAD_H
+
+    #include <aven.h>
+    #include <aven/arena.h>
+    #include <aven/thread/pool.h>
+    #include <aven/thread/spinlock.h>
+
+    #if !defined(__STDC_VERSION__) or __STDC_VERSION__ < 201112L
+        #error "C11 or later is required"
+    #endif
+
+    #include <stdatomic.h>
+    #include <string.h>
+
+    #include "../graph.h"
+
+    #ifdef GRAPH_WIDE_INDEX
+        typedef atomic_uint_least64_t GraphThreadAtomicIndex;
+    #else
+        typedef atomic_uint_least32_t GraphThreadAtomicIndex;
+    #endif
+    typedef Slice(GraphThreadAtomicIndex) GraphThreadAtomicIndexSlice;
+
+    // Run one phase of a multi-threaded algorithm: fn runs on every worker,
+    // the pool takes all but the last, which runs on the calling thread,
+    // and the phase ends once the pool is idle. There is one job for each
+    // worker but the last.
+    static inline void graph_thread_run_phase_internal(
+        AvenThreadPool *thread_pool,
+        AvenThreadPoolJobSlice jobs,
+        unsigned char *workers,
+        size_t worker_size,
+        void (*fn)(void *)
+    ) {
+        for (size_t i = 0; i < jobs.len; i += 1) {
+            get(jobs, i) = (AvenThreadPoolJob){
+                .fn = fn,
+                .args = workers + i * worker_size,
+            };
+        }
+
+        aven_thread_pool_submit_slice(thread_pool, jobs);
+        fn(workers + jobs.len * worker_size);
+
+        aven_thread_pool_wait(thread_pool);
+    }
+
+    #define graph_thread_run_phase(thread_pool, jobs, workers, fn) ( \
+            assert((workers).len == (jobs).len + 1), \
+            graph_thread_run_phase_internal( \
+                thread_pool, \
+                jobs, \
+                (unsigned char *)(workers).ptr, \
+                sizeof(*(workers).ptr), \
+                fn \
+            ) \
+        )
+
+    // Work stealing for engines that split their work into frames. Each
+    // worker owns a Chase-Lev deque, it pushes and takes frames at the
+    // bottom while other workers steal from the top, and a full deque
+    // spills into a shared overflow list. Frames are copied as blocks of
+    // frame_size bytes, the macros pass the size of the frame type.
+
+    #ifndef GRAPH_THREAD_DEQUE_SIZE
+        #define GRAPH_THREAD_DEQUE_SIZE 1024
+    #endif
+
+    #if (GRAPH_THREAD_DEQUE_SIZE & (GRAPH_THREAD_DEQUE_SIZE - 1)) != 0
+        #error "GRAPH_THREAD_DEQUE_SIZE must be a power of two"
+    #endif
+
+    typedef struct {
+        _Alignas(64) atomic_ptrdiff_t top;
+        _Alignas(64) atomic_ptrdiff_t bottom;
+        unsigned char *ptr;
+    } GraphThreadDeque;
+
+    typedef struct {
+        Slice(GraphThreadDeque) deques;
+        unsigned char *frames;
+        atomic_size_t frames_len;
+        size_t frames_cap;
+        size_t frame_size;
+        atomic_int threads_active;
+        atomic_int threads_started;
+        atomic_int threads_idle;
+        AvenThreadSpinlock lock;
+    } GraphThreadStealCtx;
+
+    typedef struct {
+        uint32_t thread_index;
+        uint32_t rng_state;
+    } GraphThreadStealWorker;
+
+    static inline GraphThreadStealCtx graph_thread_steal_init_internal(
+        size_t nthreads,
+        size_t frame_size,
+        size_t frames_cap,
+        AvenArena *arena
+    ) {
+        GraphThreadStealCtx ctx = {
+            .deques = { .len = nthreads },
+            .frames_cap = frames_cap,
+            .frame_size = frame_size,
+        };
+
+        ctx.deques.ptr = aven_arena_create_array(
+            GraphThreadDeque,
+            arena,
+            ctx.deques.len
+        );
+        ctx.frames = aven_arena_create_array(
+            unsigned char,
+            arena,
+            ctx.frames_cap * frame_size
+        );
+
+        for (size_t i = 0; i < ctx.deques.len; i += 1) {
+            GraphThreadDeque *deque = &get(ctx.deques, i);
+            atomic_init(&deque->top, 0);
+            atomic_init(&deque->bottom, 0);
+            deque->ptr = aven_arena_create_array(
+                unsigned char,
+                arena,
+                GRAPH_THREAD_DEQUE_SIZE * frame_size
+            );
+        }
+
+        atomic_init(&ctx.frames_len, 0);
+        atomic_init(&ctx.threads_active, 0);
+        atomic_init(&ctx.threads_started, 0);
+        atomic_init(&ctx.threads_idle, 0);
+        aven_thread_spinlock_init(&ctx.lock);
+
+        return ctx;
+    }
+
+    // Work stealing for nthreads workers with frames of type t and room for
+    // frames_cap frames in the overflow list
+    #define graph_thread_steal_init(t, nthreads, frames_cap, arena) \
+        graph_thread_steal_init_internal( \
+            nthreads, \
+            sizeof(t), \
+            frames_cap, \
+            arena \
+        )
+
+    static inline GraphThreadStealWorker graph_thread_steal_worker(
+        uint32_t thread_index
+    ) {
+        return (GraphThreadStealWorker){
+            .thread_index = thread_index,
+            .rng_state = 0x9e3779b9U ^ (thread_index + 1),
+        };
+    }
+
+    static inline GraphThreadDeque *graph_thread_steal_deque(
+        GraphThreadStealCtx *ctx,
+        GraphThreadStealWorker *worker
+    ) {
+        return &get(ctx->deques, worker->thread_index);
+    }
+
+    static inline bool graph_thread_deque_take_internal(
+        GraphThreadDeque *deque,
+        unsigned char *frame,
+        size_t frame_size
+    ) {
+        ptrdiff_t b = atomic_load_explicit(
+            &deque->bottom,
+            memory_order_relaxed
+        ) - 1;
+        atomic_store_explicit(&deque->bottom, b, memory_order_relaxed);
+        atomic_thread_fence(memory_order_seq_cst);
+        ptrdiff_t t = atomic_load_explicit(&deque->top, memory_order_relaxed);
+
+        if (t > b) {
+            atomic_store_explicit(&deque->bottom, b + 1, memory_order_relaxed);
+            return false;
+        }
+
+        memcpy(
+            frame,
+            deque->ptr +
+                ((size_t)b & (GRAPH_THREAD_DEQUE_SIZE - 1)) * frame_size,
+            frame_size
+        );
+        if (t == b) {
+            // last frame in the deque, race any thieves for it
+            bool won = atomic_compare_exchange_strong_explicit(
+                &deque->top,
+                &t,
+                t + 1,
+                memory_order_seq_cst,
+                memory_order_relaxed
+            );
+            atomic_store_explicit(&deque->bottom, b + 1, memory_order_relaxed);
+            return won;
+        }
+
+        return true;
+    }
+
+    static inline bool graph_thread_deque_steal_internal(
+        GraphThreadDeque *deque,
+        unsigned char *frame,
+        size_t frame_size
+    ) {
+        ptrdiff_t t = atomic_load_explicit(&deque->top, memory_order_acquire);
+        atomic_thread_fence(memory_order_seq_cst);
+        ptrdiff_t b = atomic_load_explicit(
+            &deque->bottom,
+            memory_order_acquire
+        );
+
+        if (t >= b) {
+            return false;
+        }
+
+        memcpy(
+            frame,
+            deque->ptr +
+                ((size_t)t & (GRAPH_THREAD_DEQUE_SIZE - 1)) * frame_size,
+            frame_size
+        );
+        return atomic_compare_exchange_strong_explicit(
+            &deque->top,
+            &t,
+            t + 1,
+            memory_order_seq_cst,
+            memory_order_relaxed
+        );
+    }
+
+    static inline bool graph_thread_deque_empty(GraphThreadDeque *deque) {
+        ptrdiff_t t = atomic_load_explicit(&deque->top, memory_order_relaxed);
+        ptrdiff_t b = atomic_load_explicit(
+            &deque->bottom,
+            memory_order_relaxed
+        );
+        return t >= b;
+    }
+
+    static inline void graph_thread_steal_push_overflow_internal(
+        GraphThreadStealCtx *ctx,
+        unsigned char const *frame,
+        size_t frame_size
+    ) {
+        assert(frame_size == ctx->frame_size);
+
+        aven_thread_spinlock_lock(&ctx->lock);
+        size_t len = atomic_load_explicit(
+            &ctx->frames_len,
+            memory_order_relaxed
+        );
+        assert(len < ctx->frames_cap);
+        memcpy(ctx->frames + len * frame_size, frame, frame_size);
+        atomic_store_explicit(&ctx->frames_len, len + 1, memory_order_seq_cst);
+        aven_thread_spinlock_unlock(&ctx->lock);
+    }
+
+    // Push straight to the overflow list, where any worker may take it, as
+    // must be done for the first frame before the workers start
+    #define graph_thread_steal_push_overflow(ctx, frame) \
+        graph_thread_steal_push_overflow_internal( \
+            ctx, \
+            (unsigned char const *)(frame), \
+            sizeof(*(frame)) \
+        )
+
+    static inline void graph_thread_steal_push_internal(
+        GraphThreadStealCtx *ctx,
+        GraphThreadDeque *deque,
+        unsigned char const *frame,
+        size_t frame_size
+    ) {
+        assert(frame_size == ctx->frame_size);
+
+        ptrdiff_t b = atomic_load_explicit(
+            &deque->bottom,
+            memory_order_relaxed
+        );
+        ptrdiff_t t = atomic_load_explicit(&deque->top, memory_order_acquire);
+
+        if (b - t < GRAPH_THREAD_DEQUE_SIZE) {
+            memcpy(
+                deque->ptr +
+                    ((size_t)b & (GRAPH_THREAD_DEQUE_SIZE - 1)) * frame_size,
+                frame,
+                frame_size
+            );
+            atomic_thread_fence(memory_order_release);
+            atomic_store_explicit(&deque->bottom, b + 1, memory_order_relaxed);
+            return;
+        }
+
+        // the local deque is full, spill into the shared overflow list
+        graph_thread_steal_push_overflow_internal(ctx, frame, frame_size);
+    }
+
+    // Push a frame to the deque of the calling worker
+    #define graph_thread_steal_push(ctx, deque, frame) \
+        graph_thread_steal_push_internal( \
+            ctx, \
+            deque, \
+            (unsigned char const *)(frame), \
+            sizeof(*(frame)) \
+        )
+
+    static inline bool graph_thread_steal_pop_overflow_internal(
+        GraphThreadStealCtx *ctx,
+        unsigned char *frame,
+        size_t frame_size
+    ) {
+        if (
+            atomic_load_explicit(&ctx->frames_len, memory_order_seq_cst) == 0
+        ) {
+            return false;
+        }
+
+        bool found = false;
+        aven_thread_spinlock_lock(&ctx->lock);
+        size_t len = atomic_load_explicit(
+            &ctx->frames_len,
+            memory_order_relaxed
+        );
+        if (len > 0) {
+            memcpy(frame, ctx->frames + (len - 1) * frame_size, frame_size);
+            atomic_store_explicit(
+                &ctx->frames_len,
+                len - 1,
+                memory_order_relaxed
+            );
+            found = true;
+        }
+        aven_thread_spinlock_unlock(&ctx->lock);
+
+        return found;
+    }
+
+    static inline bool graph_thread_steal_any_internal(
+        GraphThreadStealCtx *ctx,
+        GraphThreadStealWorker *worker,
+        unsigned char *frame,
+        size_t frame_size
+    ) {
+        uint32_t ndeques = (uint32_t)ctx->deques.len;
+
+        // xorshift32 to pick a random starting victim
+        worker->rng_state ^= worker->rng_state << 13;
+        worker->rng_state ^= worker->rng_state >> 17;
+        worker->rng_state ^= worker->rng_state << 5;
+
+        uint32_t start = worker->rng_state % ndeques;
+        for (uint32_t i = 0; i < ndeques; i += 1) {
+            uint32_t victim = start + i;
+            if (victim >= ndeques) {
+                victim -= ndeques;
+            }
+            if (victim == worker->thread_index) {
+                continue;
+            }
+
+            GraphThreadDeque *deque = &get(ctx->deques, victim);
+            while (!graph_thread_deque_empty(deque)) {
+                if (
+                    graph_thread_deque_steal_internal(deque, frame, frame_size)
+                ) {
+                    return true;
+                }
+            }
+        }
+
+        return graph_thread_steal_pop_overflow_internal(ctx, frame, frame_size);
+    }
+
+    static inline bool graph_thread_steal_work_available(
+        GraphThreadStealCtx *ctx
+    ) {
+        if (atomic_load_explicit(&ctx->frames_len, memory_order_relaxed) > 0) {
+            return true;
+        }
+        for (size_t i = 0; i < ctx->deques.len; i += 1) {
+            if (!graph_thread_deque_empty(&get(ctx->deques, i))) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    static inline bool graph_thread_steal_next_internal(
+        GraphThreadStealCtx *ctx,
+        GraphThreadStealWorker *worker,
+        unsigned char *frame,
+        size_t frame_size
+    ) {
+        assert(frame_size == ctx->frame_size);
+
+        GraphThreadDeque *deque = graph_thread_steal_deque(ctx, worker);
+        if (graph_thread_deque_take_internal(deque, frame, frame_size)) {
+            return true;
+        }
+        if (graph_thread_steal_pop_overflow_internal(ctx, frame, frame_size)) {
+            return true;
+        }
+
+        // an idle worker owns no frames and pushes none, so once all started
+        // workers are idle every deque and the overflow list must be empty;
+        // workers the pool has not started yet own empty deques, so they
+        // are not waited for
+        atomic_fetch_add_explicit(&ctx->threads_idle, 1, memory_order_seq_cst);
+        for (;;) {
+            int threads_idle = atomic_load_explicit(
+                &ctx->threads_idle,
+                memory_order_seq_cst
+            );
+            int threads_started = atomic_load_explicit(
+                &ctx->threads_started,
+                memory_order_seq_cst
+            );
+            if (threads_idle == threads_started) {
+                return false;
+            }
+
+            if (graph_thread_steal_work_available(ctx)) {
+                atomic_fetch_sub_explicit(
+                    &ctx->threads_idle,
+                    1,
+                    memory_order_seq_cst
+                );
+                if (
+                    graph_thread_steal_any_internal(
+                        ctx,
+                        worker,
+                        frame,
+                        frame_size
+                    )
+                ) {
+                    return true;
+                }
+                atomic_fetch_add_explicit(
+                    &ctx->threads_idle,
+                    1,
+                    memory_order_seq_cst
+                );
+            }
+
+    #if __has_builtin(__builtin_ia32_pause)
+            __builtin_ia32_pause();
+    #endif
+        }
+    }
+
+    // Next frame for the worker, from its own deque, the overflow list or
+    // another deque. Returns false once every worker is idle and no frames
+    // remain.
+    #define graph_thread_steal_next(ctx, worker, frame) \
+        graph_thread_steal_next_internal( \
+            ctx, \
+            worker, \
+            (unsigned char *)(frame), \
+            sizeof(*(frame)) \
+        )
+
+    // Called by each worker before it takes its first frame
+    static inline void graph_thread_steal_start(GraphThreadStealCtx *ctx) {
+        atomic_fetch_add_explicit(
+            &ctx->threads_active,
+            1,
+            memory_order_relaxed
+        );
+        atomic_fetch_add_explicit(
+            &ctx->threads_started,
+            1,
+            memory_order_seq_cst
+        );
+    }
+
+    // Called by each worker once graph_thread_steal_next returns false, it
+    // returns after every started worker has called it, so the writes of
+    // all workers are visible
+    static inline void graph_thread_steal_finish(GraphThreadStealCtx *ctx) {
+        atomic_fetch_sub_explicit(
+            &ctx->threads_active,
+            1,
+            memory_order_release
+        );
+
+        for (;;) {
+            int threads_active = atomic_load_explicit(
+                &ctx->threads_active,
+                memory_order_acquire
+            );
+            if (threads_active == 0) {
+                break;
+            }
+            while (threads_active != 0) {
+                threads_active = atomic_load_explicit(
+                    &ctx->threads_active,
+                    memory_order_relaxed
+                );
+            }
+        }
+    }
+
+    // Multi-threaded graph_aug. Every thread owns a contiguous range of
+    // vertices and the phases are separated by waiting on the pool:
+    //   1. point a shared cursor at the start of the bucket of each vertex,
+    //      in a symmetric graph the bucket of v has the slots of v's own
+    //      rotation;
+    //   2. scatter each half-edge w -> v into the bucket of v through an
+    //      atomic add on its cursor;
+    //   3. each vertex sorts its bucket by (w, index), exactly the order of
+    //      the sequential work lists, and looks up every half-edge of the
+    //      bucket in its own rotation to find its twin.
+    // Parallel edges are paired in reverse order, as in graph_aug, so the
+    // output is identical to the sequential version.
+
+    #define GRAPH_AUG_THREAD_SCAN_LEN 32
+
+    typedef struct {
+        Graph graph;
+        GraphAug aug_graph;
+        GraphThreadAtomicIndexSlice cursors;
+        GraphAugNbSlice buckets;
+        GraphNbSlice sorted;
+        GraphNbSlice scratch;
+        GraphIndex start_vertex;
+        GraphIndex end_vertex;
+        uint32_t thread_index;
+    } GraphAugThreadWorker;
+
+    // Stable merge sort of the rotation positions of v by neighbor, written
+    // to sorted starting at v_adj.index
+    static inline void graph_aug_thread_sort_rotation(
+        GraphNbSlice nb,
+        GraphAdj v_adj,
+        GraphNbSlice sorted,
+        GraphNbSlice scratch
+    ) {
+        GraphIndex base = v_adj.index;
+        for (GraphIndex i = 0; i < v_adj.len; i += 1) {
+            get(sorted, base + i) = i;
+        }
+
+        GraphNbSlice src = sorted;
+        GraphNbSlice dst = scratch;
+        for (GraphIndex width = 1; width < v_adj.len; width *= 2) {
+            for (GraphIndex lo = 0; lo < v_adj.len; lo += 2 * width) {
+                GraphIndex mid = min(lo + width, v_adj.len);
+                GraphIndex hi = min(lo + 2 * width, v_adj.len);
+
+                GraphIndex i = lo;
+                GraphIndex j = mid;
+                for (GraphIndex k = lo; k < hi; k += 1) {
+                    bool take_left = j == hi or (
+                        i < mid and
+                        get(nb, base + get(src, base + i)) <=
+                            get(nb, base + get(src, base + j))
+                    );
+                    if (take_left) {
+                        get(dst, base + k) = get(src, base + i);
+                        i += 1;
+                    } else {
+                        get(dst, base + k) = get(src, base + j);
+                        j += 1;
+                    }
+                }
+            }
+
+            GraphNbSlice tmp = src;
+            src = dst;
+            dst = tmp;
+        }
+
+        if (src.ptr != sorted.ptr) {
+            for (GraphIndex i = 0; i < v_adj.len; i += 1) {
+                get(sorted, base + i) = get(src, base + i);
+            }
+        }
+    }
+
+    // Rotation index of the n-th (from 0) occurrence of w around v
+    static inline GraphIndex graph_aug_thread_scan_rotation(
+        GraphNbSlice nb,
+        GraphAdj v_adj,
+        GraphIndex w,
+        GraphIndex n
+    ) {
+        for (GraphIndex i = 0; i < v_adj.len; i += 1) {
+            if (graph_nb(nb, v_adj, i) == w) {
+                if (n == 0) {
+                    return i;
+                }
+                n -= 1;
+            }
+        }
+
+        assert(false);
+        return GRAPH_INDEX_MAX;
+    }
+
+    static inline bool graph_aug_thread_nb_less(GraphAugNb a, GraphAugNb b) {
+        return a.vertex < b.vertex or (
+            a.vertex == b.vertex and a.back_index < b.back_index
+        );
+    }
+
+    static inline void graph_aug_thread_sift_down(
+        GraphAugNb *heap,
+        GraphIndex parent,
+        GraphIndex len
+    ) {
+        for (;;) {
+            GraphIndex child = 2 * parent + 1;
+            if (child >= len) {
+                break;
+            }
+            if (
+                child + 1 < len and
+                graph_aug_thread_nb_less(heap[child], heap[child + 1])
+            ) {
+                child += 1;
+            }
+            if (!graph_aug_thread_nb_less(heap[parent], heap[child])) {
+                break;
+            }
+
+            GraphAugNb tmp = heap[parent];
+            heap[parent] = heap[child];
+            heap[child] = tmp;
+            parent = child;
+        }
+    }
+
+    // Sort the bucket of v by (vertex, back_index) in place, the pairs are
+    // distinct so the sort need not be stable
+    static inline void graph_aug_thread_sort_bucket(
+        GraphAugNbSlice buckets,
+        GraphAdj v_adj
+    ) {
+        GraphAugNb *bucket = &get(buckets, v_adj.index);
+        GraphIndex len = v_adj.len;
+
+        if (len <= GRAPH_AUG_THREAD_SCAN_LEN) {
+            for (GraphIndex i = 1; i < len; i += 1) {
+                GraphAugNb item = bucket[i];
+                GraphIndex j = i;
+                while (
+                    j > 0 and
+                    graph_aug_thread_nb_less(item, bucket[j - 1])
+                ) {
+                    bucket[j] = bucket[j - 1];
+                    j -= 1;
+                }
+                bucket[j] = item;
+            }
+            return;
+        }
+
+        for (GraphIndex i = len / 2; i > 0; i -= 1) {
+            graph_aug_thread_sift_down(bucket, i - 1, len);
+        }
+        for (GraphIndex end = len - 1; end > 0; end -= 1) {
+            GraphAugNb tmp = bucket[0];
+            bucket[0] = bucket[end];
+            bucket[end] = tmp;
+            graph_aug_thread_sift_down(bucket, 0, end);
+        }
+    }
+
+    static void graph_aug_thread_cursor_worker(void *args) {
+        GraphAugThreadWorker *worker = args;
+        Graph graph = worker->graph;
+        GraphAug aug_graph = worker->aug_graph;
+
+        for (
+            GraphIndex v = worker->start_vertex;
+            v != worker->end_vertex;
+            v += 1
+        ) {
+            GraphAdj v_adj = get(graph.adj, v);
+            get(aug_graph.adj, v) = v_adj;
+            atomic_store_explicit(
+                &get(worker->cursors, v),
+                v_adj.index,
+                memory_order_relaxed
+            );
+        }
+    }
+
+    static void graph_aug_thread_scatter_worker(void *args) {
+        GraphAugThreadWorker *worker = args;
+        Graph graph = worker->graph;
+
+        for (
+            GraphIndex v = worker->start_vertex;
+            v != worker->end_vertex;
+            v += 1
+        ) {
+            GraphAdj v_adj = get(graph.adj, v);
+            for (GraphIndex i = 0; i < v_adj.len; i += 1) {
+                GraphIndex u = graph_nb(graph.nb, v_adj, i);
+                GraphIndex slot = (GraphIndex)atomic_fetch_add_explicit(
+                    &get(worker->cursors, u),
+                    1,
+                    memory_order_relaxed
+                );
+
+                // the graph must be symmetric
+                assert(
+                    slot < get(graph.adj, u).index + get(graph.adj, u).len
+                );
+
+                get(worker->buckets, slot) = (GraphAugNb){
+                    .vertex = v,
+                    .back_index = i,
+                };
+            }
+        }
+    }
+
+    static void graph_aug_thread_match_worker(void *args) {
+        GraphAugThreadWorker *worker = args;
+        Graph graph = worker->graph;
+        GraphAug aug_graph = worker->aug_graph;
+
+        for (
+            GraphIndex v = worker->start_vertex;
+            v != worker->end_vertex;
+            v += 1
+        ) {
+            GraphAdj v_adj = get(graph.adj, v);
+            graph_aug_thread_sort_bucket(worker->buckets, v_adj);
+
+            // long rotations are sorted so that they list their neighbors
+            // in the same order as the bucket, short ones are scanned
+            bool long_rotation = v_adj.len > GRAPH_AUG_THREAD_SCAN_LEN;
+            if (long_rotation) {
+                graph_aug_thread_sort_rotation(
+                    graph.nb,
+                    v_adj,
+                    worker->sorted,
+                    worker->scratch
+                );
+            }
+
+            GraphIndex i = 0;
+            while (i < v_adj.len) {
+                GraphIndex w = get(worker->buckets, v_adj.index + i).vertex;
+
+                GraphIndex k = 1;
+                while (
+                    i + k < v_adj.len and
+                    get(worker->buckets, v_adj.index + i + k).vertex == w
+                ) {
+                    k += 1;
+                }
+
+                // runs of parallel edges are matched in reverse order
+                for (GraphIndex rank = 0; rank < k; rank += 1) {
+                    GraphIndex n = k - 1 - rank;
+                    GraphIndex vw_index;
+                    if (long_rotation) {
+                        vw_index = get(worker->sorted, v_adj.index + i + n);
+                    } else {
+                        vw_index = graph_aug_thread_scan_rotation(
+                            graph.nb,
+                            v_adj,
+                            w,
+                            n
+                        );
+                    }
+                    assert(graph_nb(graph.nb, v_adj, vw_index) == w);
+
+                    get(aug_graph.nb, v_adj.index + vw_index) = (GraphAugNb){
+                        .vertex = w,
+                        .back_index = get(
+                            worker->buckets,
+                            v_adj.index + i + rank
+                        ).back_index,
+                    };
+                }
+
+                i += k;
+            }
+        }
+    }
+
+    static inline GraphAug graph_aug_thread(
+        Graph graph,
+        AvenThreadPool *thread_pool,
+        size_t nthreads,
+        AvenArena *arena
+    ) {
+        assert(nthreads > 0);
+
+        GraphAug aug_graph = {
+            .nb = { .len = graph.nb.len },
+            .adj = { .len = graph.adj.len },
+        };
+        aug_graph.nb.ptr = aven_arena_create_array(
+            GraphAugNb,
+            arena,
+            aug_graph.nb.len
+        );
+        aug_graph.adj.ptr = aven_arena_create_array(
+            GraphAdj,
+            arena,
+            aug_graph.adj.len
+        );
+
+        AvenArena temp_arena = *arena;
+
+        GraphThreadAtomicIndexSlice cursors = { .len = graph.adj.len };
+        cursors.ptr = aven_arena_create_array(
+            GraphThreadAtomicIndex,
+            &temp_arena,
+            cursors.len
+        );
+        GraphAugNbSlice buckets = { .len = graph.nb.len };
+        buckets.ptr = aven_arena_create_array(
+            GraphAugNb,
+            &temp_arena,
+            buckets.len
+        );
+        GraphNbSlice sorted = { .len = graph.nb.len };
+        sorted.ptr = aven_arena_create_array(
+            GraphIndex,
+            &temp_arena,
+            sorted.len
+        );
+        GraphNbSlice scratch = { .len = graph.nb.len };
+        scratch.ptr = aven_arena_create_array(
+            GraphIndex,
+            &temp_arena,
+            scratch.len
+        );
+
+        Slice(GraphAugThreadWorker) workers = aven_arena_create_slice(
+            GraphAugThreadWorker,
+            &temp_arena,
+            nthreads
+        );
+        AvenThreadPoolJobSlice jobs = aven_arena_create_slice(
+            AvenThreadPoolJob,
+            &temp_arena,
+            nthreads - 1
+        );
+
+        GraphIndex chunk_size = (GraphIndex)(graph.adj.len / workers.len);
+        for (uint32_t i = 0; i < workers.len; i += 1) {
+            GraphIndex start_vertex = i * chunk_size;
+            GraphIndex end_vertex = (i + 1) * chunk_size;
+            if (i + 1 == workers.len) {
+                end_vertex = (GraphIndex)graph.adj.len;
+            }
+
+            get(workers, i) = (GraphAugThreadWorker){
+                .graph = graph,
+                .aug_graph = aug_graph,
+                .cursors = cursors,
+                .buckets = buckets,
+                .sorted = sorted,
+                .scratch = scratch,
+                .start_vertex = start_vertex,
+                .end_vertex = end_vertex,
+                .thread_index = i,
+            };
+        }
+
+        void (*phase_fns[])(void *) = {
+            graph_aug_thread_cursor_worker,
+            graph_aug_thread_scatter_worker,
+            graph_aug_thread_match_worker,
+        };
+        for (size_t phase = 0; phase < countof(phase_fns); phase += 1) {
+            graph_thread_run_phase(
+                thread_pool,
+                jobs,
+                workers,
+                phase_fns[phase]
+            );
+        }
+
+        return aug_graph;
+    }
+
+#endif // GRAPH_THREAD_H
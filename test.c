@@ -13,9 +13,14 @@
 
 #include <stdlib.h>
 
+#include "test/bcc.h"
 #include "test/bfs.h"
+#include "test/compressed.h"
 #include "test/dfs.h"
+#include "test/gen.h"
 #include "test/io.h"
+#include "test/lca.h"
+#include "test/order.h"
 #include "test/plane.h"
 #include "test/p3color.h"
 #include "test/p3choose.h"
@@ -30,9 +35,14 @@ int main(void) {
     }
     AvenArena test_arena = aven_arena_init(mem, ARENA_SIZE);
 
+    test_bcc(test_arena);
     test_bfs(test_arena);
+    test_compressed(test_arena);
     test_dfs(test_arena);
+    test_gen(test_arena);
     test_io(test_arena);
+    test_lca(test_arena);
+    test_order(test_arena);
     test_plane(test_arena);
     test_p3color(test_arena);
     test_p3choose(test_arena);
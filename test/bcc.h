@@ -0,0 +1,430 @@
+#ifndef TEST_BCC_H
+    #define TEST_BCC_H
+
+    #include <aven.h>
+    #include <aven/arena.h>
+    #include <aven/fmt.h>
+    #include <aven/test.h>
+
+    #include <graph.h>
+    #include <graph/bcc.h>
+    #include <graph/gen.h>
+
+    #include "gen.h"
+
+    // Number of connected components after removing the vertex skip and the
+    // half-edges skip_edge and its reverse, pass GRAPH_INDEX_MAX to keep all
+    static GraphIndex test_bcc_components(
+        Graph graph,
+        GraphIndex skip,
+        GraphIndex skip_u,
+        GraphIndex skip_v,
+        AvenArena arena
+    ) {
+        GraphPropUint8 seen = aven_arena_create_slice(
+            uint8_t,
+            &arena,
+            graph.adj.len
+        );
+        GraphSubset stack = aven_arena_create_slice(
+            GraphIndex,
+            &arena,
+            graph.adj.len
+        );
+        for (GraphIndex v = 0; v < graph.adj.len; v += 1) {
+            get(seen, v) = 0;
+        }
+
+        GraphIndex ncomponents = 0;
+        for (GraphIndex r = 0; r < graph.adj.len; r += 1) {
+            if (r == skip or get(seen, r) != 0) {
+                continue;
+            }
+
+            ncomponents += 1;
+            get(seen, r) = 1;
+            size_t top = 0;
+            get(stack, top++) = r;
+            while (top > 0) {
+                GraphIndex v = get(stack, --top);
+                GraphAdj v_adj = get(graph.adj, v);
+                for (GraphIndex i = 0; i < v_adj.len; i += 1) {
+                    GraphIndex u = graph_nb(graph.nb, v_adj, i);
+                    if (u == skip or get(seen, u) != 0) {
+                        continue;
+                    }
+                    if (
+                        (v == skip_u and u == skip_v) or
+                        (v == skip_v and u == skip_u)
+                    ) {
+                        continue;
+                    }
+                    get(seen, u) = 1;
+                    get(stack, top++) = u;
+                }
+            }
+        }
+
+        return ncomponents;
+    }
+
+    static AvenTestResult test_bcc_check(
+        AvenArena *emsg_arena,
+        Graph graph,
+        GraphBcc bcc,
+        AvenArena arena
+    ) {
+        GraphIndex ncomponents = test_bcc_components(
+            graph,
+            GRAPH_INDEX_MAX,
+            GRAPH_INDEX_MAX,
+            GRAPH_INDEX_MAX,
+            arena
+        );
+
+        for (GraphIndex v = 0; v < graph.adj.len; v += 1) {
+            GraphIndex v_components = test_bcc_components(
+                graph,
+                v,
+                GRAPH_INDEX_MAX,
+                GRAPH_INDEX_MAX,
+                arena
+            );
+            bool is_cut = v_components > ncomponents and
+                get(graph.adj, v).len > 0;
+            if (is_cut != (get(bcc.cut, v) != 0)) {
+                return (AvenTestResult){
+                    .error = 1,
+                    .message = aven_fmt(
+                        emsg_arena,
+                        "articulation point mismatch at {}",
+                        aven_fmt_uint(v)
+                    ),
+                };
+            }
+        }
+
+        size_t nbridges = 0;
+        for (GraphIndex v = 0; v < graph.adj.len; v += 1) {
+            GraphAdj v_adj = get(graph.adj, v);
+            for (GraphIndex i = 0; i < v_adj.len; i += 1) {
+                GraphIndex u = graph_nb(graph.nb, v_adj, i);
+                if (u < v) {
+                    continue;
+                }
+
+                GraphIndex e_components = test_bcc_components(
+                    graph,
+                    GRAPH_INDEX_MAX,
+                    v,
+                    u,
+                    arena
+                );
+                if (e_components > ncomponents) {
+                    nbridges += 1;
+                }
+
+                GraphIndex back = get(graph.adj, u).index +
+                    graph_nb_index(graph.nb, get(graph.adj, u), v);
+                GraphIndex b = get(bcc.edge_block, v_adj.index + i);
+                if (b != get(bcc.edge_block, back) or b >= bcc.blocks.len) {
+                    return (AvenTestResult){
+                        .error = 1,
+                        .message = aven_fmt(
+                            emsg_arena,
+                            "half-edges of {}{} in different blocks",
+                            aven_fmt_uint(v),
+                            aven_fmt_uint(u)
+                        ),
+                    };
+                }
+
+                GraphSubset block = graph_bcc_block(bcc, b);
+                bool has_v = false;
+                bool has_u = false;
+                for (GraphIndex j = 0; j < block.len; j += 1) {
+                    has_v = has_v or get(block, j) == v;
+                    has_u = has_u or get(block, j) == u;
+                }
+                if (!has_v or !has_u) {
+                    return (AvenTestResult){
+                        .error = 1,
+                        .message = aven_fmt(
+                            emsg_arena,
+                            "block {} is missing an endpoint of {}{}",
+                            aven_fmt_uint(b),
+                            aven_fmt_uint(v),
+                            aven_fmt_uint(u)
+                        ),
+                    };
+                }
+            }
+        }
+
+        if (nbridges != bcc.bridges.len) {
+            return (AvenTestResult){
+                .error = 1,
+                .message = aven_fmt(
+                    emsg_arena,
+                    "expected {} bridges, found {}",
+                    aven_fmt_uint(nbridges),
+                    aven_fmt_uint(bcc.bridges.len)
+                ),
+            };
+        }
+
+        // The block-cut tree is a forest with one tree per component
+        Graph tree = graph_bcc_tree(bcc, &arena);
+        GraphIndex tree_components = test_bcc_components(
+            tree,
+            GRAPH_INDEX_MAX,
+            GRAPH_INDEX_MAX,
+            GRAPH_INDEX_MAX,
+            arena
+        );
+        if (
+            tree_components != ncomponents or
+            tree.nb.len != 2 * (tree.adj.len - tree_components)
+        ) {
+            return (AvenTestResult){
+                .error = 1,
+                .message = aven_fmt(
+                    emsg_arena,
+                    "block-cut tree with {} nodes and {} half-edges "
+                    "is not a forest of {} trees",
+                    aven_fmt_uint(tree.adj.len),
+                    aven_fmt_uint(tree.nb.len),
+                    aven_fmt_uint(ncomponents)
+                ),
+            };
+        }
+
+        return (AvenTestResult){ 0 };
+    }
+
+    typedef struct {
+        GraphIndex v;
+        GraphIndex u;
+    } TestBccEdge;
+    typedef Slice(TestBccEdge) TestBccEdgeSlice;
+
+    static Graph test_bcc_graph_from_edges(
+        GraphIndex nvertices,
+        TestBccEdgeSlice edges,
+        AvenArena *arena
+    ) {
+        Graph graph = {
+            .nb = { .len = 2 * edges.len },
+            .adj = { .len = nvertices },
+        };
+        graph.nb.ptr = aven_arena_create_array(GraphIndex, arena, graph.nb.len);
+        graph.adj.ptr = aven_arena_create_array(GraphAdj, arena, graph.adj.len);
+
+        for (GraphIndex v = 0; v < graph.adj.len; v += 1) {
+            get(graph.adj, v) = (GraphAdj){ 0 };
+        }
+        for (size_t i = 0; i < edges.len; i += 1) {
+            get(graph.adj, get(edges, i).v).len += 1;
+            get(graph.adj, get(edges, i).u).len += 1;
+        }
+
+        GraphIndex index = 0;
+        for (GraphIndex v = 0; v < graph.adj.len; v += 1) {
+            get(graph.adj, v).index = index;
+            index += get(graph.adj, v).len;
+            get(graph.adj, v).len = 0;
+        }
+
+        for (size_t i = 0; i < edges.len; i += 1) {
+            TestBccEdge edge = get(edges, i);
+            GraphAdj *v_adj = &get(graph.adj, edge.v);
+            GraphAdj *u_adj = &get(graph.adj, edge.u);
+            get(graph.nb, v_adj->index + v_adj->len) = edge.u;
+            get(graph.nb, u_adj->index + u_adj->len) = edge.v;
+            v_adj->len += 1;
+            u_adj->len += 1;
+        }
+
+        return graph;
+    }
+
+    static AvenTestResult test_bcc_bowtie(
+        AvenArena *emsg_arena,
+        AvenArena arena,
+        void *opaque_args
+    ) {
+        (void)opaque_args;
+
+        // Two triangles sharing 2, a pendant edge 45, an isolated vertex 6
+        // and a separate edge 78
+        TestBccEdge edge_data[] = {
+            { 0, 1 }, { 1, 2 }, { 2, 0 },
+            { 2, 3 }, { 3, 4 }, { 4, 2 },
+            { 4, 5 },
+            { 7, 8 },
+        };
+        Graph graph = test_bcc_graph_from_edges(
+            9,
+            (TestBccEdgeSlice)slice_array(edge_data),
+            &arena
+        );
+
+        GraphBcc bcc = graph_bcc(graph, &arena);
+
+        if (
+            bcc.blocks.len != 5 or
+            bcc.cut_vertices.len != 2 or
+            get(bcc.cut_vertices, 0) != 2 or
+            get(bcc.cut_vertices, 1) != 4 or
+            bcc.bridges.len != 2
+        ) {
+            return (AvenTestResult){
+                .error = 1,
+                .message = aven_fmt(
+                    emsg_arena,
+                    "expected 5 blocks, cut vertices 2 and 4 and 2 bridges, "
+                    "found {} blocks, {} cut vertices and {} bridges",
+                    aven_fmt_uint(bcc.blocks.len),
+                    aven_fmt_uint(bcc.cut_vertices.len),
+                    aven_fmt_uint(bcc.bridges.len)
+                ),
+            };
+        }
+
+        Graph tree = graph_bcc_tree(bcc, &arena);
+        if (tree.adj.len != 7 or tree.nb.len != 8) {
+            return (AvenTestResult){
+                .error = 1,
+                .message = aven_fmt(
+                    emsg_arena,
+                    "expected block-cut tree with 7 nodes and 4 edges, "
+                    "found {} nodes and {} half-edges",
+                    aven_fmt_uint(tree.adj.len),
+                    aven_fmt_uint(tree.nb.len)
+                ),
+            };
+        }
+
+        return test_bcc_check(emsg_arena, graph, bcc, arena);
+    }
+
+    typedef enum {
+        TEST_BCC_GRAPH_PATH,
+        TEST_BCC_GRAPH_CACTUS,
+        TEST_BCC_GRAPH_GEN,
+    } TestBccGraph;
+
+    typedef struct {
+        uint32_t size;
+        TestBccGraph graph;
+        TestGenGraphType type;
+    } TestBccArgs;
+
+    static AvenTestResult test_bcc_graph(
+        AvenArena *emsg_arena,
+        AvenArena arena,
+        void *opaque_args
+    ) {
+        TestBccArgs *args = opaque_args;
+
+        Graph graph;
+        if (args->graph == TEST_BCC_GRAPH_PATH) {
+            graph = graph_gen_path(args->size, &arena);
+        } else if (args->graph == TEST_BCC_GRAPH_CACTUS) {
+            // A chain of 4-cycles glued at single vertices, with a pendant
+            // vertex on every cycle and a chord in every third one
+            TestBccEdgeSlice edges = aven_arena_create_slice(
+                TestBccEdge,
+                &arena,
+                6 * args->size
+            );
+            size_t nedges = 0;
+            for (GraphIndex i = 0; i < args->size; i += 1) {
+                GraphIndex v = 4 * i;
+                get(edges, nedges++) = (TestBccEdge){ v, v + 1 };
+                get(edges, nedges++) = (TestBccEdge){ v + 1, v + 2 };
+                get(edges, nedges++) = (TestBccEdge){ v + 2, v + 4 };
+                get(edges, nedges++) = (TestBccEdge){ v + 4, v };
+                get(edges, nedges++) = (TestBccEdge){ v + 1, v + 3 };
+                if (i % 3 == 0) {
+                    get(edges, nedges++) = (TestBccEdge){ v, v + 2 };
+                }
+            }
+            edges.len = nedges;
+            graph = test_bcc_graph_from_edges(
+                4 * args->size + 1,
+                edges,
+                &arena
+            );
+        } else {
+            graph = test_gen_graph(args->size, args->type, &arena);
+        }
+
+        GraphBcc bcc = graph_bcc(graph, &arena);
+        return test_bcc_check(emsg_arena, graph, bcc, arena);
+    }
+
+    static void test_bcc(AvenArena arena) {
+        AvenTestCase tcase_data[] = {
+            {
+                .desc = aven_str("bowtie with pendant and isolated vertex"),
+                .fn = test_bcc_bowtie,
+            },
+            {
+                .desc = aven_str("P_1"),
+                .args = &(TestBccArgs){
+                    .size = 1,
+                    .graph = TEST_BCC_GRAPH_PATH,
+                },
+                .fn = test_bcc_graph,
+            },
+            {
+                .desc = aven_str("P_9"),
+                .args = &(TestBccArgs){
+                    .size = 9,
+                    .graph = TEST_BCC_GRAPH_PATH,
+                },
+                .fn = test_bcc_graph,
+            },
+            {
+                .desc = aven_str("chain of 11 4-cycles with pendants"),
+                .args = &(TestBccArgs){
+                    .size = 11,
+                    .graph = TEST_BCC_GRAPH_CACTUS,
+                },
+                .fn = test_bcc_graph,
+            },
+            {
+                .desc = aven_str("K_2"),
+                .args = &(TestBccArgs){
+                    .size = 2,
+                    .graph = TEST_BCC_GRAPH_GEN,
+                    .type = TEST_GEN_GRAPH_TYPE_COMPLETE,
+                },
+                .fn = test_bcc_graph,
+            },
+            {
+                .desc = aven_str("7x7 grid"),
+                .args = &(TestBccArgs){
+                    .size = 7,
+                    .graph = TEST_BCC_GRAPH_GEN,
+                    .type = TEST_GEN_GRAPH_TYPE_GRID,
+                },
+                .fn = test_bcc_graph,
+            },
+            {
+                .desc = aven_str("order 50 triangulation"),
+                .args = &(TestBccArgs){
+                    .size = 50,
+                    .graph = TEST_BCC_GRAPH_GEN,
+                    .type = TEST_GEN_GRAPH_TYPE_TRIANGULATION,
+                },
+                .fn = test_bcc_graph,
+            },
+        };
+        AvenTestCaseSlice tcases = slice_array(tcase_data);
+
+        aven_test(tcases, arena);
+    }
+
+#endif // TEST_BCC_H
@@ -5,13 +5,19 @@
     #include <aven/arena.h>
     #include <aven/fmt.h>
     #include <aven/test.h>
+    #include <aven/thread/pool.h>
 
     #include <graph.h>
     #include <graph/bfs.h>
+    #include <graph/bfs/multi.h>
+    #include <graph/bfs/thread.h>
     #include <graph/gen.h>
+    #include <graph/io/import.h>
 
     #include <stdio.h>
 
+    #include "gen.h"
+
     typedef struct {
         uint32_t size;
         uint32_t start;
@@ -26,7 +32,7 @@
         Graph g = graph_gen_complete(args->size, &arena);
         GraphBfsTree tree = graph_bfs(g, args->start, &arena);
 
-        uint32_t root_dist = 0;
+        GraphIndex root_dist = 0;
         size_t in_tree_valid = 0;
         size_t parents_valid = 0;
         size_t dists_valid = 0;
@@ -139,9 +145,9 @@
                         dists_valid += 1;
                     }
                 } else {
-                    uint32_t u = graph_bfs_tree_parent(tree, v);
-                    uint32_t u_x = u % args->width;
-                    uint32_t u_y = u / args->width;
+                    GraphIndex u = graph_bfs_tree_parent(tree, v);
+                    uint32_t u_x = (uint32_t)u % args->width;
+                    uint32_t u_y = (uint32_t)u / args->width;
 
                     uint32_t vu_dist = ((u_x > x) ? (u_x - x) : (x - u_x)) +
                         ((u_y > y) ? (u_y - y) : (y - u_y));
@@ -205,6 +211,419 @@
         return (AvenTestResult){ 0 };
     }
 
+    // A BFS tree with the same distances as expected whose parents are all
+    // adjacent and one level closer to the root
+    static bool test_bfs_tree_matches(
+        Graph graph,
+        GraphBfsTree expected_tree,
+        GraphBfsTree tree
+    ) {
+        if (tree.len != expected_tree.len) {
+            return false;
+        }
+
+        for (uint32_t v = 0; v < tree.len; v += 1) {
+            if (
+                graph_bfs_tree_contains(tree, v) !=
+                graph_bfs_tree_contains(expected_tree, v)
+            ) {
+                return false;
+            }
+            if (!graph_bfs_tree_contains(tree, v)) {
+                continue;
+            }
+            if (get(tree, v).dist != get(expected_tree, v).dist) {
+                return false;
+            }
+
+            GraphIndex u = graph_bfs_tree_parent(tree, v);
+            if (get(tree, v).dist == 0) {
+                if (u != v) {
+                    return false;
+                }
+                continue;
+            }
+
+            if (get(tree, u).dist + 1 != get(tree, v).dist) {
+                return false;
+            }
+
+            GraphAdj v_adj = get(graph.adj, v);
+            bool adjacent = false;
+            for (uint32_t i = 0; i < v_adj.len; i += 1) {
+                if (graph_nb(graph.nb, v_adj, i) == u) {
+                    adjacent = true;
+                    break;
+                }
+            }
+            if (!adjacent) {
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+    typedef struct {
+        uint32_t size;
+        uint32_t start;
+        TestGenGraphType type;
+    } TestBfsGenArgs;
+
+    static AvenTestResult test_bfs_dir(
+        AvenArena *emsg_arena,
+        AvenArena arena,
+        void *opaque_args
+    ) {
+        (void)emsg_arena;
+        TestBfsGenArgs *args = opaque_args;
+
+        Graph graph = test_gen_graph(args->size, args->type, &arena);
+        GraphBfsTree expected_tree = graph_bfs(graph, args->start, &arena);
+        GraphBfsTree tree = graph_bfs_dir(graph, args->start, &arena);
+
+        if (!test_bfs_tree_matches(graph, expected_tree, tree)) {
+            return (AvenTestResult){
+                .error = 1,
+                .message = aven_str("direction-optimizing BFS tree mismatch"),
+            };
+        }
+
+        return (AvenTestResult){ 0 };
+    }
+
+    typedef struct {
+        uint32_t nhubs;
+        uint32_t hub_size;
+        uint32_t path_len;
+    } TestBfsDirHubsArgs;
+
+    // Wheels around hubs, each an eighth the size of the one before, joined
+    // by paths from hub to hub. A search from the first hub goes bottom-up
+    // at each wheel and back top-down along each path.
+    static AvenTestResult test_bfs_dir_hubs(
+        AvenArena *emsg_arena,
+        AvenArena arena,
+        void *opaque_args
+    ) {
+        TestBfsDirHubsArgs *args = opaque_args;
+
+        size_t nedges = 0;
+        size_t nvertices = 0;
+        for (uint32_t i = 0; i < args->nhubs; i += 1) {
+            uint32_t wheel_size = max(args->hub_size >> (3 * i), 3);
+            nvertices += 1 + wheel_size;
+            nedges += 2 * wheel_size;
+            if (i > 0) {
+                nvertices += args->path_len;
+                nedges += args->path_len + 1;
+            }
+        }
+
+        GraphIoEdgeSlice edges = aven_arena_create_slice(
+            GraphIoEdge,
+            &arena,
+            nedges
+        );
+        List(GraphIoEdge) edge_list = { .ptr = edges.ptr, .cap = edges.len };
+        GraphIndex nvertex = 0;
+        GraphIndex prev_hub = 0;
+        for (uint32_t i = 0; i < args->nhubs; i += 1) {
+            if (i > 0) {
+                GraphIndex prev = prev_hub;
+                for (uint32_t j = 0; j < args->path_len; j += 1) {
+                    list_push(edge_list) = (GraphIoEdge){
+                        .u = prev,
+                        .v = nvertex,
+                    };
+                    prev = nvertex;
+                    nvertex += 1;
+                }
+                list_push(edge_list) = (GraphIoEdge){
+                    .u = prev,
+                    .v = nvertex,
+                };
+            }
+
+            GraphIndex hub = nvertex;
+            nvertex += 1;
+            uint32_t wheel_size = max(args->hub_size >> (3 * i), 3);
+            for (uint32_t j = 0; j < wheel_size; j += 1) {
+                list_push(edge_list) = (GraphIoEdge){
+                    .u = hub,
+                    .v = nvertex + j,
+                };
+                list_push(edge_list) = (GraphIoEdge){
+                    .u = nvertex + j,
+                    .v = nvertex + (j + 1) % wheel_size,
+                };
+            }
+            nvertex += wheel_size;
+            prev_hub = hub;
+        }
+        assert(edge_list.len == nedges);
+        assert(nvertex == nvertices);
+
+        Graph graph = graph_io_import_csr(nvertices, edges, &arena);
+        GraphBfsTree expected_tree = graph_bfs(graph, 0, &arena);
+
+        GraphBfsDirCtx ctx = graph_bfs_dir_init(graph, 0, &arena);
+        bool bottom_up = false;
+        size_t nswitches = 0;
+        while (!graph_bfs_dir_step(&ctx)) {
+            if (ctx.bottom_up != bottom_up) {
+                nswitches += 1;
+                bottom_up = ctx.bottom_up;
+            }
+        }
+
+        if (!test_bfs_tree_matches(graph, expected_tree, ctx.tree)) {
+            return (AvenTestResult){
+                .error = 1,
+                .message = aven_str("direction-optimizing BFS tree mismatch"),
+            };
+        }
+
+        // down and back up at every wheel but the last
+        size_t expected_switches = 2 * (size_t)args->nhubs - 1;
+        if (nswitches < expected_switches) {
+            return (AvenTestResult){
+                .error = 1,
+                .message = aven_fmt(
+                    emsg_arena,
+                    "expected at least {} direction switches, found {}",
+                    aven_fmt_uint(expected_switches),
+                    aven_fmt_uint(nswitches)
+                ),
+            };
+        }
+
+        return (AvenTestResult){ 0 };
+    }
+
+    static AvenTestResult test_bfs_run(
+        AvenArena *emsg_arena,
+        AvenArena arena,
+        void *opaque_args
+    ) {
+        (void)emsg_arena;
+        TestBfsGenArgs *args = opaque_args;
+
+        Graph graph = test_gen_graph(args->size, args->type, &arena);
+        GraphBfsTree expected_tree = graph_bfs(graph, args->start, &arena);
+
+        GraphBfsCtx ctx = graph_bfs_init(graph, args->start, &arena);
+        while (!graph_bfs_run(&ctx, 3)) {}
+
+        for (GraphIndex v = 0; v < ctx.tree.len; v += 1) {
+            GraphBfsTreeNode node = get(ctx.tree, v);
+            GraphBfsTreeNode expected = get(expected_tree, v);
+            if (node.parent != expected.parent or node.dist != expected.dist) {
+                return (AvenTestResult){
+                    .error = 1,
+                    .message = aven_str("budgeted BFS tree mismatch"),
+                };
+            }
+        }
+
+        return (AvenTestResult){ 0 };
+    }
+
+    typedef struct {
+        uint32_t size;
+        uint32_t nroots;
+        TestGenGraphType type;
+    } TestBfsMultiArgs;
+
+    static AvenTestResult test_bfs_multi(
+        AvenArena *emsg_arena,
+        AvenArena arena,
+        void *opaque_args
+    ) {
+        TestBfsMultiArgs *args = opaque_args;
+
+        Graph graph = test_gen_graph(args->size, args->type, &arena);
+
+        GraphSubset roots = aven_arena_create_slice(
+            GraphIndex,
+            &arena,
+            args->nroots
+        );
+        for (uint32_t i = 0; i < roots.len; i += 1) {
+            get(roots, i) = (GraphIndex)((i * 7919) % graph.adj.len);
+        }
+
+        GraphPropIndex dists = graph_bfs_multi_dists(graph, roots, &arena);
+        GraphPropIndex ecc = graph_bfs_multi_ecc(graph, roots, &arena);
+
+        for (uint32_t i = 0; i < roots.len; i += 1) {
+            AvenArena temp_arena = arena;
+            GraphBfsTree tree = graph_bfs(graph, get(roots, i), &temp_arena);
+
+            GraphIndex root_ecc = 0;
+            for (uint32_t v = 0; v < tree.len; v += 1) {
+                GraphIndex dist = get(dists, i * graph.adj.len + v);
+                if (dist != get(tree, v).dist) {
+                    return (AvenTestResult){
+                        .error = 1,
+                        .message = aven_fmt(
+                            emsg_arena,
+                            "expected dist {} from root {} to {}, found {}",
+                            aven_fmt_uint(get(tree, v).dist),
+                            aven_fmt_uint(get(roots, i)),
+                            aven_fmt_uint(v),
+                            aven_fmt_uint(dist)
+                        ),
+                    };
+                }
+                root_ecc = max(root_ecc, dist);
+            }
+
+            if (get(ecc, i) != root_ecc) {
+                return (AvenTestResult){
+                    .error = 1,
+                    .message = aven_fmt(
+                        emsg_arena,
+                        "expected eccentricity {} for root {}, found {}",
+                        aven_fmt_uint(root_ecc),
+                        aven_fmt_uint(get(roots, i)),
+                        aven_fmt_uint(get(ecc, i))
+                    ),
+                };
+            }
+        }
+
+        return (AvenTestResult){ 0 };
+    }
+
+    static AvenTestResult test_bfs_epoch(
+        AvenArena *emsg_arena,
+        AvenArena arena,
+        void *opaque_args
+    ) {
+        TestBfsMultiArgs *args = opaque_args;
+
+        Graph graph = test_gen_graph(args->size, args->type, &arena);
+        GraphBfsEpochCtx ctx = graph_bfs_epoch_init(graph, &arena);
+
+        for (GraphIndex v = 0; v < graph.adj.len; v += 1) {
+            if (graph_bfs_epoch_contains(&ctx, v)) {
+                return (AvenTestResult){
+                    .error = 1,
+                    .message = aven_fmt(
+                        emsg_arena,
+                        "vertex {} contained before any search started",
+                        aven_fmt_uint(v)
+                    ),
+                };
+            }
+        }
+
+        for (uint32_t i = 0; i < args->nroots; i += 1) {
+            GraphIndex root = (GraphIndex)((i * 7919) % graph.adj.len);
+
+            // abandon a partial search to check that start discards it
+            graph_bfs_epoch_start(
+                &ctx,
+                (GraphIndex)((root + 1) % graph.adj.len)
+            );
+            for (uint32_t j = 0; j < i; j += 1) {
+                if (graph_bfs_epoch_step(&ctx)) {
+                    break;
+                }
+            }
+
+            graph_bfs_epoch_start(&ctx, root);
+            while (!graph_bfs_epoch_step(&ctx)) {}
+
+            AvenArena temp_arena = arena;
+            GraphBfsTree tree = graph_bfs(graph, root, &temp_arena);
+
+            for (uint32_t v = 0; v < tree.len; v += 1) {
+                if (
+                    !graph_bfs_epoch_contains(&ctx, v) or
+                    graph_bfs_epoch_parent(&ctx, v) !=
+                        graph_bfs_tree_parent(tree, v) or
+                    graph_bfs_epoch_dist(&ctx, v) != get(tree, v).dist
+                ) {
+                    return (AvenTestResult){
+                        .error = 1,
+                        .message = aven_fmt(
+                            emsg_arena,
+                            "reused BFS context mismatch from root {} at {}",
+                            aven_fmt_uint(root),
+                            aven_fmt_uint(v)
+                        ),
+                    };
+                }
+            }
+        }
+
+        return (AvenTestResult){ 0 };
+    }
+
+    typedef struct {
+        uint32_t size;
+        uint32_t start;
+        TestGenGraphType type;
+        size_t nthreads;
+    } TestBfsThreadArgs;
+
+    static AvenTestResult test_bfs_thread(
+        AvenArena *emsg_arena,
+        AvenArena arena,
+        void *opaque_args
+    ) {
+        TestBfsThreadArgs *args = opaque_args;
+
+        Graph graph = test_gen_graph(args->size, args->type, &arena);
+        GraphBfsTree expected_tree = graph_bfs(graph, args->start, &arena);
+
+        AvenThreadPool thread_pool = aven_thread_pool_init(
+            args->nthreads - 1,
+            args->nthreads - 1,
+            &arena
+        );
+        aven_thread_pool_run(&thread_pool);
+
+        GraphBfsTree tree = graph_bfs_thread(
+            graph,
+            args->start,
+            &thread_pool,
+            args->nthreads,
+            &arena
+        );
+
+        aven_thread_pool_halt_and_destroy(&thread_pool);
+
+        size_t nreached = 0;
+        for (GraphIndex v = 0; v < tree.len; v += 1) {
+            if (graph_bfs_tree_contains(tree, v)) {
+                nreached += 1;
+            }
+        }
+        if (nreached != graph.adj.len) {
+            return (AvenTestResult){
+                .error = 1,
+                .message = aven_fmt(
+                    emsg_arena,
+                    "expected all {} vertices in threaded BFS tree, found {}",
+                    aven_fmt_uint(graph.adj.len),
+                    aven_fmt_uint(nreached)
+                ),
+            };
+        }
+
+        if (!test_bfs_tree_matches(graph, expected_tree, tree)) {
+            return (AvenTestResult){
+                .error = 1,
+                .message = aven_str("threaded BFS tree mismatch"),
+            };
+        }
+
+        return (AvenTestResult){ 0 };
+    }
+
     static void test_bfs(AvenArena arena) {
         AvenTestCase tcase_data[] = {
             {
@@ -254,6 +673,155 @@
                 },
                 .fn = test_bfs_grid,
             },
+            {
+                .desc = aven_str("direction-optimizing K_7 start 3"),
+                .args = &(TestBfsGenArgs){
+                    .size = 7,
+                    .start = 3,
+                    .type = TEST_GEN_GRAPH_TYPE_COMPLETE,
+                },
+                .fn = test_bfs_dir,
+            },
+            {
+                .desc = aven_str("direction-optimizing 37x37 grid start 100"),
+                .args = &(TestBfsGenArgs){
+                    .size = 37,
+                    .start = 100,
+                    .type = TEST_GEN_GRAPH_TYPE_GRID,
+                },
+                .fn = test_bfs_dir,
+            },
+            {
+                .desc = aven_str("direction-optimizing pyramid A_19 start 0"),
+                .args = &(TestBfsGenArgs){
+                    .size = 19,
+                    .start = 0,
+                    .type = TEST_GEN_GRAPH_TYPE_PYRAMID,
+                },
+                .fn = test_bfs_dir,
+            },
+            {
+                .desc = aven_str(
+                    "direction-optimizing order 5119 triangulation start 17"
+                ),
+                .args = &(TestBfsGenArgs){
+                    .size = 5119,
+                    .start = 17,
+                    .type = TEST_GEN_GRAPH_TYPE_TRIANGULATION,
+                },
+                .fn = test_bfs_dir,
+            },
+            {
+                .desc = aven_str("direction-optimizing three wheel hubs"),
+                .args = &(TestBfsDirHubsArgs){
+                    .nhubs = 3,
+                    .hub_size = 4096,
+                    .path_len = 30,
+                },
+                .fn = test_bfs_dir_hubs,
+            },
+            {
+                .desc = aven_str("multi-source K_1 one root"),
+                .args = &(TestBfsMultiArgs){
+                    .size = 1,
+                    .nroots = 1,
+                    .type = TEST_GEN_GRAPH_TYPE_COMPLETE,
+                },
+                .fn = test_bfs_multi,
+            },
+            {
+                .desc = aven_str("multi-source 23x23 grid 64 roots"),
+                .args = &(TestBfsMultiArgs){
+                    .size = 23,
+                    .nroots = 64,
+                    .type = TEST_GEN_GRAPH_TYPE_GRID,
+                },
+                .fn = test_bfs_multi,
+            },
+            {
+                .desc = aven_str(
+                    "multi-source order 1119 triangulation 150 roots"
+                ),
+                .args = &(TestBfsMultiArgs){
+                    .size = 1119,
+                    .nroots = 150,
+                    .type = TEST_GEN_GRAPH_TYPE_TRIANGULATION,
+                },
+                .fn = test_bfs_multi,
+            },
+            {
+                .desc = aven_str("reused context 23x23 grid 40 roots"),
+                .args = &(TestBfsMultiArgs){
+                    .size = 23,
+                    .nroots = 40,
+                    .type = TEST_GEN_GRAPH_TYPE_GRID,
+                },
+                .fn = test_bfs_epoch,
+            },
+            {
+                .desc = aven_str(
+                    "reused context order 1119 triangulation 40 roots"
+                ),
+                .args = &(TestBfsMultiArgs){
+                    .size = 1119,
+                    .nroots = 40,
+                    .type = TEST_GEN_GRAPH_TYPE_TRIANGULATION,
+                },
+                .fn = test_bfs_epoch,
+            },
+            {
+                .desc = aven_str("budgeted run order 1119 triangulation"),
+                .args = &(TestBfsGenArgs){
+                    .size = 1119,
+                    .start = 5,
+                    .type = TEST_GEN_GRAPH_TYPE_TRIANGULATION,
+                },
+                .fn = test_bfs_run,
+            },
+            {
+                .desc = aven_str("threaded (1 thread) 37x37 grid start 100"),
+                .args = &(TestBfsThreadArgs){
+                    .size = 37,
+                    .start = 100,
+                    .type = TEST_GEN_GRAPH_TYPE_GRID,
+                    .nthreads = 1,
+                },
+                .fn = test_bfs_thread,
+            },
+            {
+                .desc = aven_str("threaded (4 threads) 37x37 grid start 100"),
+                .args = &(TestBfsThreadArgs){
+                    .size = 37,
+                    .start = 100,
+                    .type = TEST_GEN_GRAPH_TYPE_GRID,
+                    .nthreads = 4,
+                },
+                .fn = test_bfs_thread,
+            },
+            {
+                .desc = aven_str(
+                    "threaded (1 thread) order 5119 triangulation start 17"
+                ),
+                .args = &(TestBfsThreadArgs){
+                    .size = 5119,
+                    .start = 17,
+                    .type = TEST_GEN_GRAPH_TYPE_TRIANGULATION,
+                    .nthreads = 1,
+                },
+                .fn = test_bfs_thread,
+            },
+            {
+                .desc = aven_str(
+                    "threaded (3 threads) order 5119 triangulation start 17"
+                ),
+                .args = &(TestBfsThreadArgs){
+                    .size = 5119,
+                    .start = 17,
+                    .type = TEST_GEN_GRAPH_TYPE_TRIANGULATION,
+                    .nthreads = 3,
+                },
+                .fn = test_bfs_thread,
+            },
         };
         AvenTestCaseSlice tcases = slice_array(tcase_data);
 
@@ -0,0 +1,134 @@
+#ifndef TEST_COMPRESSED_H
+    #define TEST_COMPRESSED_H
+
+    #include <aven.h>
+    #include <aven/arena.h>
+    #include <aven/test.h>
+
+    #include <graph.h>
+    #include <graph/bfs.h>
+    #include <graph/compressed.h>
+
+    #include "gen.h"
+
+    typedef struct {
+        uint32_t size;
+        TestGenGraphType type;
+    } TestCompressedArgs;
+
+    static AvenTestResult test_compressed_graph(
+        AvenArena *emsg_arena,
+        AvenArena arena,
+        void *opaque_args
+    ) {
+        (void)emsg_arena;
+        TestCompressedArgs *args = opaque_args;
+
+        Graph graph = test_gen_graph(args->size, args->type, &arena);
+        GraphCompressed cgraph = graph_compressed(graph, &arena);
+        Graph dgraph = graph_compressed_decode(cgraph, &arena);
+
+        if (
+            graph_compressed_vertices(cgraph) != graph.adj.len or
+            dgraph.adj.len != graph.adj.len or
+            dgraph.nb.len != graph.nb.len
+        ) {
+            return (AvenTestResult){
+                .error = 1,
+                .message = aven_str("compressed graph size mismatch"),
+            };
+        }
+
+        for (uint32_t v = 0; v < graph.adj.len; v += 1) {
+            GraphAdj v_adj = get(graph.adj, v);
+            GraphAdj v_dadj = get(dgraph.adj, v);
+
+            if (
+                v_dadj.len != v_adj.len or
+                graph_compressed_deg(cgraph, v) != v_adj.len
+            ) {
+                return (AvenTestResult){
+                    .error = 1,
+                    .message = aven_str("compressed degree mismatch"),
+                };
+            }
+
+            for (uint32_t i = 0; i < v_adj.len; i += 1) {
+                if (
+                    graph_nb(graph.nb, v_adj, i) !=
+                    graph_nb(dgraph.nb, v_dadj, i)
+                ) {
+                    return (AvenTestResult){
+                        .error = 1,
+                        .message = aven_str("compressed rotation mismatch"),
+                    };
+                }
+            }
+        }
+
+        GraphBfsTree tree = graph_bfs(graph, 0, &arena);
+        GraphBfsTree ctree = graph_bfs_compressed(cgraph, 0, &arena);
+        for (uint32_t v = 0; v < tree.len; v += 1) {
+            if (
+                get(tree, v).parent != get(ctree, v).parent or
+                get(tree, v).dist != get(ctree, v).dist
+            ) {
+                return (AvenTestResult){
+                    .error = 1,
+                    .message = aven_str("compressed BFS tree mismatch"),
+                };
+            }
+        }
+
+        return (AvenTestResult){ 0 };
+    }
+
+    static void test_compressed(AvenArena arena) {
+        AvenTestCase tcase_data[] = {
+            {
+                .desc = aven_str("compressed K_1"),
+                .args = &(TestCompressedArgs){
+                    .size = 1,
+                    .type = TEST_GEN_GRAPH_TYPE_COMPLETE,
+                },
+                .fn = test_compressed_graph,
+            },
+            {
+                .desc = aven_str("compressed K_7"),
+                .args = &(TestCompressedArgs){
+                    .size = 7,
+                    .type = TEST_GEN_GRAPH_TYPE_COMPLETE,
+                },
+                .fn = test_compressed_graph,
+            },
+            {
+                .desc = aven_str("compressed 13x13 grid"),
+                .args = &(TestCompressedArgs){
+                    .size = 13,
+                    .type = TEST_GEN_GRAPH_TYPE_GRID,
+                },
+                .fn = test_compressed_graph,
+            },
+            {
+                .desc = aven_str("compressed pyramid A_19"),
+                .args = &(TestCompressedArgs){
+                    .size = 19,
+                    .type = TEST_GEN_GRAPH_TYPE_PYRAMID,
+                },
+                .fn = test_compressed_graph,
+            },
+            {
+                .desc = aven_str("compressed order 1119 triangulation"),
+                .args = &(TestCompressedArgs){
+                    .size = 1119,
+                    .type = TEST_GEN_GRAPH_TYPE_TRIANGULATION,
+                },
+                .fn = test_compressed_graph,
+            },
+        };
+        AvenTestCaseSlice tcases = slice_array(tcase_data);
+
+        aven_test(tcases, arena);
+    }
+
+#endif // TEST_COMPRESSED_H
@@ -12,6 +12,8 @@
 
     #include <stdio.h>
 
+    #include "gen.h"
+
     typedef struct {
         uint32_t size;
         uint32_t start;
@@ -59,7 +61,7 @@
             };
         }
 
-        uint32_t root_number = get(data.tree, args->start).number;
+        GraphIndex root_number = get(data.tree, args->start).number;
         if (root_number != 0) {
             return (AvenTestResult){
                 .error = 1,
@@ -73,9 +75,9 @@
 
         size_t parents_valid = 0;
         for (uint32_t n = 0; n < data.numbering.len; n += 1) {
-            uint32_t v = get(data.numbering, n);
-            uint32_t p = graph_dfs_tree_parent(data.tree, v);
-            uint32_t pn = get(data.tree, p).number;
+            GraphIndex v = get(data.numbering, n);
+            GraphIndex p = graph_dfs_tree_parent(data.tree, v);
+            GraphIndex pn = get(data.tree, p).number;
             if (n == 0 and p == v and pn == n) {
                 parents_valid += 1;
             } else if (p != v and pn == n - 1) {
@@ -100,7 +102,7 @@
         if (g.adj.len > 2) {
             size_t valid_lowpoints = 0;
             for (uint32_t n = 0; n < data.numbering.len; n += 1) {
-                uint32_t v = get(data.numbering, n);
+                GraphIndex v = get(data.numbering, n);
                 if (get(data.tree, v).lowpoint == 0) {
                     valid_lowpoints += 1;
                 }
@@ -176,7 +178,7 @@
             };
         }
 
-        uint32_t root_number = get(data.tree, args->start).number;
+        GraphIndex root_number = get(data.tree, args->start).number;
         if (root_number != 0) {
             return (AvenTestResult){
                 .error = 1,
@@ -190,9 +192,9 @@
 
         size_t parents_valid = 0;
         for (uint32_t n = 0; n < data.numbering.len; n += 1) {
-            uint32_t v = get(data.numbering, n);
-            uint32_t p = graph_dfs_tree_parent(data.tree, v);
-            uint32_t pn = get(data.tree, p).number;
+            GraphIndex v = get(data.numbering, n);
+            GraphIndex p = graph_dfs_tree_parent(data.tree, v);
+            GraphIndex pn = get(data.tree, p).number;
             if (n == 0 and p == v and pn == n) {
                 parents_valid += 1;
             } else if (p != v and pn < n) {
@@ -216,7 +218,7 @@
 
         size_t valid_lowpoints = 0;
         for (uint32_t n = 0; n < data.numbering.len; n += 1) {
-            uint32_t v = get(data.numbering, n);
+            GraphIndex v = get(data.numbering, n);
             if (get(data.tree, v).lowpoint == n) {
                 valid_lowpoints += 1;
             }
@@ -239,6 +241,96 @@
         return (AvenTestResult){ 0 };
     }
 
+    typedef struct {
+        uint32_t size;
+        uint32_t nroots;
+        TestGenGraphType type;
+    } TestDfsEpochArgs;
+
+    static AvenTestResult test_dfs_epoch(
+        AvenArena *emsg_arena,
+        AvenArena arena,
+        void *opaque_args
+    ) {
+        TestDfsEpochArgs *args = opaque_args;
+
+        Graph graph = test_gen_graph(args->size, args->type, &arena);
+        GraphDfsEpochCtx ctx = graph_dfs_epoch_init(graph, &arena);
+
+        for (GraphIndex v = 0; v < graph.adj.len; v += 1) {
+            if (graph_dfs_epoch_contains(&ctx, v)) {
+                return (AvenTestResult){
+                    .error = 1,
+                    .message = aven_fmt(
+                        emsg_arena,
+                        "vertex {} contained before any search started",
+                        aven_fmt_uint(v)
+                    ),
+                };
+            }
+        }
+
+        for (uint32_t i = 0; i < args->nroots; i += 1) {
+            GraphIndex root = (GraphIndex)((i * 7919) % graph.adj.len);
+
+            // abandon a partial search to check that start discards it
+            graph_dfs_epoch_start(
+                &ctx,
+                (GraphIndex)((root + 1) % graph.adj.len)
+            );
+            for (uint32_t j = 0; j < i; j += 1) {
+                if (graph_dfs_epoch_step(&ctx)) {
+                    break;
+                }
+            }
+
+            graph_dfs_epoch_start(&ctx, root);
+            while (!graph_dfs_epoch_step(&ctx)) {}
+
+            AvenArena temp_arena = arena;
+            GraphDfsData data = graph_dfs(graph, root, &temp_arena);
+
+            GraphDfsNumbering numbering = graph_dfs_epoch_numbering(&ctx);
+            if (numbering.len != data.numbering.len) {
+                return (AvenTestResult){
+                    .error = 1,
+                    .message = aven_fmt(
+                        emsg_arena,
+                        "expected {} vertices in reused DFS from {}, found {}",
+                        aven_fmt_uint(data.numbering.len),
+                        aven_fmt_uint(root),
+                        aven_fmt_uint(numbering.len)
+                    ),
+                };
+            }
+
+            for (uint32_t n = 0; n < numbering.len; n += 1) {
+                GraphIndex v = get(data.numbering, n);
+                GraphDfsTreeNode expected = get(data.tree, v);
+                GraphDfsTreeNode node = graph_dfs_epoch_node(&ctx, v);
+                if (
+                    get(numbering, n) != v or
+                    node.parent != expected.parent or
+                    node.number != expected.number or
+                    node.least_ancestor != expected.least_ancestor or
+                    node.lowpoint != expected.lowpoint
+                ) {
+                    return (AvenTestResult){
+                        .error = 1,
+                        .message = aven_fmt(
+                            emsg_arena,
+                            "reused DFS context mismatch from root {} at {}",
+                            aven_fmt_uint(root),
+                            aven_fmt_uint(v)
+                        ),
+                    };
+                }
+            }
+        }
+
+        return (AvenTestResult){ 0 };
+    }
+
     static void test_dfs(AvenArena arena) {
         AvenTestCase tcase_data[] = {
             {
@@ -286,6 +378,26 @@
                 .args = &(TestDfsPathArgs){ .size = 7, .start = 4 },
                 .fn = test_dfs_path,
             },
+            {
+                .desc = aven_str("reused context 23x23 grid 40 roots"),
+                .args = &(TestDfsEpochArgs){
+                    .size = 23,
+                    .nroots = 40,
+                    .type = TEST_GEN_GRAPH_TYPE_GRID,
+                },
+                .fn = test_dfs_epoch,
+            },
+            {
+                .desc = aven_str(
+                    "reused context order 1119 triangulation 40 roots"
+                ),
+                .args = &(TestDfsEpochArgs){
+                    .size = 1119,
+                    .nroots = 40,
+                    .type = TEST_GEN_GRAPH_TYPE_TRIANGULATION,
+                },
+                .fn = test_dfs_epoch,
+            },
         };
         AvenTestCaseSlice tcases = slice_array(tcase_data);
 
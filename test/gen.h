@@ -9,10 +9,14 @@
     #include <aven/rng/pcg.h>
     #include <aven/str.h>
     #include <aven/test.h>
+    #include <aven/thread/pool.h>
 
     #include <graph.h>
     #include <graph/gen.h>
+    #include <graph/gen/thread.h>
+    #include <graph/io/thread.h>
     #include <graph/plane/gen.h>
+    #include <graph/thread.h>
 
     typedef enum {
         TEST_GEN_GRAPH_TYPE_COMPLETE,
@@ -56,4 +60,387 @@
         return graph;
     }
 
+    typedef struct {
+        uint32_t size;
+        bool plane;
+        bool square;
+        // compare graph_aug_thread on a type graph when nonzero
+        size_t nthreads;
+        TestGenGraphType type;
+    } TestGenAugArgs;
+
+    static AvenTestResult test_gen_aug(
+        AvenArena *emsg_arena,
+        AvenArena arena,
+        void *opaque_args
+    ) {
+        (void)emsg_arena;
+        TestGenAugArgs *args = opaque_args;
+
+        AvenRngPcg pcg = aven_rng_pcg_seed(0xdead, 0xbeef);
+        AvenRngPcg aug_pcg = pcg;
+
+        GraphAug expected_graph;
+        GraphAug aug_graph;
+        if (args->nthreads > 0) {
+            Graph graph = test_gen_graph(args->size, args->type, &arena);
+            expected_graph = graph_aug(graph, &arena);
+
+            AvenThreadPool thread_pool = aven_thread_pool_init(
+                args->nthreads - 1,
+                args->nthreads - 1,
+                &arena
+            );
+            aven_thread_pool_run(&thread_pool);
+
+            aug_graph = graph_aug_thread(
+                graph,
+                &thread_pool,
+                args->nthreads,
+                &arena
+            );
+
+            aven_thread_pool_halt_and_destroy(&thread_pool);
+        } else if (args->plane) {
+            Aff2 ident;
+            aff2_identity(ident);
+
+            GraphPlaneGenData data = graph_plane_gen_triangulation(
+                args->size,
+                ident,
+                0.001f,
+                0.01f,
+                args->square,
+                aven_rng_pcg(&pcg),
+                &arena
+            );
+            expected_graph = graph_aug(data.graph, &arena);
+
+            GraphPlaneGenAugData aug_data = graph_plane_gen_triangulation_aug(
+                args->size,
+                ident,
+                0.001f,
+                0.01f,
+                args->square,
+                aven_rng_pcg(&aug_pcg),
+                &arena
+            );
+            aug_graph = aug_data.graph;
+        } else {
+            Graph graph = graph_gen_triangulation(
+                args->size,
+                aven_rng_pcg(&pcg),
+                (Vec2){ 0.33f, 0.33f },
+                &arena
+            );
+            expected_graph = graph_aug(graph, &arena);
+
+            aug_graph = graph_gen_triangulation_aug(
+                args->size,
+                aven_rng_pcg(&aug_pcg),
+                (Vec2){ 0.33f, 0.33f },
+                &arena
+            );
+        }
+
+        if (aug_graph.adj.len != expected_graph.adj.len) {
+            return (AvenTestResult){
+                .error = 1,
+                .message = aven_str("generated augmented graph size mismatch"),
+            };
+        }
+
+        for (uint32_t v = 0; v < aug_graph.adj.len; v += 1) {
+            GraphAdj v_adj = get(aug_graph.adj, v);
+            GraphAdj v_expected_adj = get(expected_graph.adj, v);
+            if (
+                v_adj.index != v_expected_adj.index or
+                v_adj.len != v_expected_adj.len
+            ) {
+                return (AvenTestResult){
+                    .error = 1,
+                    .message = aven_str("generated augmented adj mismatch"),
+                };
+            }
+
+            for (uint32_t i = 0; i < v_adj.len; i += 1) {
+                GraphAugNb nb = graph_aug_nb(aug_graph.nb, v_adj, i);
+                GraphAugNb expected_nb = graph_aug_nb(
+                    expected_graph.nb,
+                    v_adj,
+                    i
+                );
+                if (
+                    nb.vertex != expected_nb.vertex or
+                    nb.back_index != expected_nb.back_index
+                ) {
+                    return (AvenTestResult){
+                        .error = 1,
+                        .message = aven_str(
+                            "generated augmented rotation mismatch"
+                        ),
+                    };
+                }
+            }
+        }
+
+        return (AvenTestResult){ 0 };
+    }
+
+    typedef struct {
+        uint32_t size;
+        size_t max_threads;
+    } TestGenTriangulationThreadArgs;
+
+    // A simple rotation system with 3 n - 6 edges whose faces are all
+    // triangles is a plane triangulation by Euler's formula
+    static bool test_gen_is_triangulation(Graph graph, AvenArena arena) {
+        size_t nvertices = graph.adj.len;
+        if (graph.nb.len != 6 * nvertices - 12) {
+            return false;
+        }
+
+        GraphAug aug_graph = graph_aug(graph, &arena);
+        for (GraphIndex v = 0; v < aug_graph.adj.len; v += 1) {
+            GraphAdj v_adj = get(aug_graph.adj, v);
+            for (GraphIndex i = 0; i < v_adj.len; i += 1) {
+                GraphIndex u = v;
+                GraphIndex j = i;
+                for (size_t k = 0; k < 3; k += 1) {
+                    GraphAugNb nb = graph_aug_nb(
+                        aug_graph.nb,
+                        get(aug_graph.adj, u),
+                        j
+                    );
+                    u = nb.vertex;
+                    j = graph_adj_next(get(aug_graph.adj, u), nb.back_index);
+                }
+                if (u != v or j != i) {
+                    return false;
+                }
+            }
+        }
+
+        return true;
+    }
+
+    static bool test_gen_graph_equal(Graph graph, Graph other_graph) {
+        if (
+            graph.adj.len != other_graph.adj.len or
+            graph.nb.len != other_graph.nb.len
+        ) {
+            return false;
+        }
+        for (GraphIndex v = 0; v < graph.adj.len; v += 1) {
+            GraphAdj v_adj = get(graph.adj, v);
+            GraphAdj other_v_adj = get(other_graph.adj, v);
+            if (
+                v_adj.index != other_v_adj.index or
+                v_adj.len != other_v_adj.len
+            ) {
+                return false;
+            }
+        }
+        for (GraphIndex i = 0; i < graph.nb.len; i += 1) {
+            if (get(graph.nb, i) != get(other_graph.nb, i)) {
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+    // The threaded generator must give a triangulation, and the same one
+    // for every number of threads
+    static AvenTestResult test_gen_triangulation_thread(
+        AvenArena *emsg_arena,
+        AvenArena arena,
+        void *opaque_args
+    ) {
+        TestGenTriangulationThreadArgs *args = opaque_args;
+        uint64_t seed = 0x5eedf00dUL;
+        Vec2 flip_prob = { 0.33f, 0.33f };
+
+        AvenThreadPool thread_pool = aven_thread_pool_init(
+            args->max_threads - 1,
+            args->max_threads - 1,
+            &arena
+        );
+        aven_thread_pool_run(&thread_pool);
+
+        Graph graph = graph_gen_triangulation_thread(
+            args->size,
+            seed,
+            flip_prob,
+            &thread_pool,
+            1,
+            &arena
+        );
+        GraphIndex first_invalid = graph_io_validate_thread(
+            graph,
+            &thread_pool,
+            args->max_threads,
+            arena
+        );
+
+        size_t differing_threads = 0;
+        for (
+            size_t nthreads = 2;
+            nthreads <= args->max_threads;
+            nthreads += 1
+        ) {
+            AvenArena temp_arena = arena;
+            Graph thread_graph = graph_gen_triangulation_thread(
+                args->size,
+                seed,
+                flip_prob,
+                &thread_pool,
+                nthreads,
+                &temp_arena
+            );
+            if (!test_gen_graph_equal(graph, thread_graph)) {
+                differing_threads = nthreads;
+                break;
+            }
+        }
+
+        aven_thread_pool_halt_and_destroy(&thread_pool);
+
+        if (first_invalid != GRAPH_INDEX_MAX) {
+            return (AvenTestResult){
+                .error = 1,
+                .message = aven_fmt(
+                    emsg_arena,
+                    "rotation of vertex {} is not simple and symmetric",
+                    aven_fmt_uint(first_invalid)
+                ),
+            };
+        }
+        for (GraphIndex v = 0; v < graph.adj.len; v += 1) {
+            GraphAdj v_adj = get(graph.adj, v);
+            for (GraphIndex i = 0; i < v_adj.len; i += 1) {
+                if (graph_nb(graph.nb, v_adj, i) == v) {
+                    return (AvenTestResult){
+                        .error = 1,
+                        .message = aven_str("generated graph has a loop"),
+                    };
+                }
+            }
+        }
+        if (!test_gen_is_triangulation(graph, arena)) {
+            return (AvenTestResult){
+                .error = 1,
+                .message = aven_str("generated graph is not a triangulation"),
+            };
+        }
+        if (differing_threads != 0) {
+            return (AvenTestResult){
+                .error = 1,
+                .message = aven_fmt(
+                    emsg_arena,
+                    "graph from {} threads differed from 1 thread",
+                    aven_fmt_uint(differing_threads)
+                ),
+            };
+        }
+
+        return (AvenTestResult){ 0 };
+    }
+
+    static void test_gen(AvenArena arena) {
+        AvenTestCase tcase_data[] = {
+            {
+                .desc = aven_str("augmented order 3 triangulation"),
+                .args = &(TestGenAugArgs){ .size = 3 },
+                .fn = test_gen_aug,
+            },
+            {
+                .desc = aven_str("augmented order 4 triangulation"),
+                .args = &(TestGenAugArgs){ .size = 4 },
+                .fn = test_gen_aug,
+            },
+            {
+                .desc = aven_str("augmented order 1119 triangulation"),
+                .args = &(TestGenAugArgs){ .size = 1119 },
+                .fn = test_gen_aug,
+            },
+            {
+                .desc = aven_str("augmented K_50 w/4 threads"),
+                .args = &(TestGenAugArgs){
+                    .size = 50,
+                    .type = TEST_GEN_GRAPH_TYPE_COMPLETE,
+                    .nthreads = 4,
+                },
+                .fn = test_gen_aug,
+            },
+            {
+                .desc = aven_str("augmented pyramid A_40 w/3 threads"),
+                .args = &(TestGenAugArgs){
+                    .size = 40,
+                    .type = TEST_GEN_GRAPH_TYPE_PYRAMID,
+                    .nthreads = 3,
+                },
+                .fn = test_gen_aug,
+            },
+            {
+                .desc = aven_str(
+                    "augmented order 11119 triangulation w/4 threads"
+                ),
+                .args = &(TestGenAugArgs){
+                    .size = 11119,
+                    .type = TEST_GEN_GRAPH_TYPE_TRIANGULATION,
+                    .nthreads = 4,
+                },
+                .fn = test_gen_aug,
+            },
+            {
+                .desc = aven_str("threaded order 3 triangulation"),
+                .args = &(TestGenTriangulationThreadArgs){
+                    .size = 3,
+                    .max_threads = 2,
+                },
+                .fn = test_gen_triangulation_thread,
+            },
+            {
+                .desc = aven_str("threaded order 119 triangulation"),
+                .args = &(TestGenTriangulationThreadArgs){
+                    .size = 119,
+                    .max_threads = 4,
+                },
+                .fn = test_gen_triangulation_thread,
+            },
+            {
+                .desc = aven_str("threaded order 11119 triangulation"),
+                .args = &(TestGenTriangulationThreadArgs){
+                    .size = 11119,
+                    .max_threads = 5,
+                },
+                .fn = test_gen_triangulation_thread,
+            },
+            {
+                .desc = aven_str("augmented order 3 plane triangulation"),
+                .args = &(TestGenAugArgs){ .size = 3, .plane = true },
+                .fn = test_gen_aug,
+            },
+            {
+                .desc = aven_str("augmented order 517 plane triangulation"),
+                .args = &(TestGenAugArgs){ .size = 517, .plane = true },
+                .fn = test_gen_aug,
+            },
+            {
+                .desc = aven_str("augmented order 517 plane square"),
+                .args = &(TestGenAugArgs){
+                    .size = 517,
+                    .plane = true,
+                    .square = true,
+                },
+                .fn = test_gen_aug,
+            },
+        };
+        AvenTestCaseSlice tcases = slice_array(tcase_data);
+
+        aven_test(tcases, arena);
+    }
+
 #endif // TEST_GEN_H
+
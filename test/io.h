@@ -8,9 +8,17 @@
     #include <aven/path.h>
     #include <aven/str.h>
     #include <aven/test.h>
+    #include <aven/thread/pool.h>
 
     #include <graph.h>
     #include <graph/io.h>
+    #include <graph/io/cache.h>
+    #include <graph/io/container.h>
+    #include <graph/io/import.h>
+    #include <graph/io/import/thread.h>
+    #include <graph/io/map.h>
+    #include <graph/io/stream.h>
+    #include <graph/io/thread.h>
 
     #include <stdio.h>
 
@@ -19,6 +27,7 @@
     typedef struct {
         uint32_t size;
         TestGenGraphType type;
+        size_t nthreads;
     } TestIoGraphArgs;
 
     static AvenTestResult test_io_graph(
@@ -93,9 +102,9 @@
                 inv_adj += 1;
                 continue;
             }
-            for (uint32_t i = 0; i < v_adj.len; i += 1) {
-                uint32_t u = graph_nb(graph.nb, v_adj, i);
-                uint32_t ru = graph_nb(read_graph.nb, rv_adj, i);
+            for (GraphIndex i = 0; i < v_adj.len; i += 1) {
+                GraphIndex u = graph_nb(graph.nb, v_adj, i);
+                GraphIndex ru = graph_nb(read_graph.nb, rv_adj, i);
                 if (u != ru) {
                     inv_adj += 1;
                     i = v_adj.len;
@@ -191,7 +200,7 @@
                 inv_adj += 1;
                 continue;
             }
-            for (uint32_t i = 0; i < v_adj.len; i += 1) {
+            for (GraphIndex i = 0; i < v_adj.len; i += 1) {
                 GraphAugNb vu = graph_aug_nb(aug_graph.nb, v_adj, i);
                 GraphAugNb rvu = graph_aug_nb(read_graph.nb, rv_adj, i);
                 if (vu.vertex != rvu.vertex) {
@@ -216,6 +225,1407 @@
         return (AvenTestResult){ 0 };
     }
 
+    // Number of vertices whose neighbor lists differ, any difference in the
+    // vertex or half-edge counts counts every vertex
+    static size_t test_io_graph_diff(Graph graph, Graph read_graph) {
+        if (
+            read_graph.adj.len != graph.adj.len or
+            read_graph.nb.len != graph.nb.len
+        ) {
+            return max(graph.adj.len, 1);
+        }
+
+        size_t inv_adj = 0;
+        for (GraphIndex v = 0; v < graph.adj.len; v += 1) {
+            GraphAdj v_adj = get(graph.adj, v);
+            GraphAdj rv_adj = get(read_graph.adj, v);
+            if (v_adj.len != rv_adj.len) {
+                inv_adj += 1;
+                continue;
+            }
+            for (GraphIndex i = 0; i < v_adj.len; i += 1) {
+                GraphIndex u = graph_nb(graph.nb, v_adj, i);
+                GraphIndex ru = graph_nb(read_graph.nb, rv_adj, i);
+                if (u != ru) {
+                    inv_adj += 1;
+                    break;
+                }
+            }
+        }
+
+        return inv_adj;
+    }
+
+    static size_t test_io_graph_aug_diff(GraphAug graph, GraphAug read_graph) {
+        if (
+            read_graph.adj.len != graph.adj.len or
+            read_graph.nb.len != graph.nb.len
+        ) {
+            return max(graph.adj.len, 1);
+        }
+
+        size_t inv_adj = 0;
+        for (GraphIndex v = 0; v < graph.adj.len; v += 1) {
+            GraphAdj v_adj = get(graph.adj, v);
+            GraphAdj rv_adj = get(read_graph.adj, v);
+            if (v_adj.len != rv_adj.len) {
+                inv_adj += 1;
+                continue;
+            }
+            for (GraphIndex i = 0; i < v_adj.len; i += 1) {
+                GraphAugNb vu = graph_aug_nb(graph.nb, v_adj, i);
+                GraphAugNb rvu = graph_aug_nb(read_graph.nb, rv_adj, i);
+                if (
+                    vu.vertex != rvu.vertex or
+                    vu.back_index != rvu.back_index
+                ) {
+                    inv_adj += 1;
+                    break;
+                }
+            }
+        }
+
+        return inv_adj;
+    }
+
+    static bool test_io_points_into(ByteSlice bytes, void *ptr) {
+        unsigned char *p = ptr;
+        return p >= bytes.ptr and p <= bytes.ptr + bytes.len;
+    }
+
+    static AvenTestResult test_io_graph_aligned(
+        AvenArena *emsg_arena,
+        AvenArena arena,
+        void *opaque_args
+    ) {
+        TestIoGraphArgs *args = opaque_args;
+        Graph graph = test_gen_graph(args->size, args->type, &arena);
+        GraphAug aug_graph = graph_aug(graph, &arena);
+
+        size_t size = max(
+            graph_io_aligned_size(graph),
+            graph_io_aligned_size(aug_graph)
+        );
+        ByteSlice space = { .len = size };
+        space.ptr = (unsigned char *)aven_arena_create_array(
+            uint64_t,
+            &arena,
+            (size + sizeof(uint64_t) - 1) / sizeof(uint64_t)
+        );
+
+        ByteSlice bytes = { .ptr = space.ptr };
+        bytes.len = graph_io_aligned_size(graph);
+        graph_io_aligned_write(bytes, graph);
+
+        GraphIoResult view_res = graph_io_aligned_view(bytes);
+        if (view_res.error != 0) {
+            return (AvenTestResult){
+                .message = aven_str("failed to view aligned graph"),
+                .error = view_res.error,
+            };
+        }
+        Graph view = view_res.payload;
+
+        if (
+            !test_io_points_into(bytes, view.adj.ptr) or
+            !test_io_points_into(bytes, view.nb.ptr)
+        ) {
+            return (AvenTestResult){
+                .message = aven_str("aligned view copied the graph"),
+                .error = 1,
+            };
+        }
+        if (!graph_io_validate(view)) {
+            return (AvenTestResult){
+                .message = aven_str("viewed graph invalid"),
+                .error = 1,
+            };
+        }
+
+        size_t inv_adj = test_io_graph_diff(graph, view);
+        if (inv_adj != 0) {
+            return (AvenTestResult){
+                .error = 1,
+                .message = aven_fmt(
+                    emsg_arena,
+                    "viewed graph differed from original in {} places",
+                    aven_fmt_uint(inv_adj)
+                ),
+            };
+        }
+
+        if (graph_io_aug_aligned_view(bytes).error == 0) {
+            return (AvenTestResult){
+                .message = aven_str("viewed graph as augmented graph"),
+                .error = 1,
+            };
+        }
+
+        if (graph.nb.len > 0) {
+            ByteSlice short_bytes = bytes;
+            short_bytes.len -= 1;
+            if (graph_io_aligned_view(short_bytes).error == 0) {
+                return (AvenTestResult){
+                    .message = aven_str("viewed truncated graph"),
+                    .error = 1,
+                };
+            }
+        }
+
+        bytes.len = graph_io_aligned_size(aug_graph);
+        graph_io_aug_aligned_write(bytes, aug_graph);
+
+        GraphIoAugResult aug_view_res = graph_io_aug_aligned_view(bytes);
+        if (aug_view_res.error != 0) {
+            return (AvenTestResult){
+                .message = aven_str("failed to view aligned augmented graph"),
+                .error = aug_view_res.error,
+            };
+        }
+        GraphAug aug_view = aug_view_res.payload;
+
+        if (!graph_io_aug_validate(aug_view)) {
+            return (AvenTestResult){
+                .message = aven_str("viewed augmented graph invalid"),
+                .error = 1,
+            };
+        }
+
+        inv_adj = test_io_graph_aug_diff(aug_graph, aug_view);
+        if (inv_adj != 0) {
+            return (AvenTestResult){
+                .error = 1,
+                .message = aven_fmt(
+                    emsg_arena,
+                    "viewed augmented graph differed in {} places",
+                    aven_fmt_uint(inv_adj)
+                ),
+            };
+        }
+
+        return (AvenTestResult){ 0 };
+    }
+
+    static AvenTestResult test_io_graph_map(
+        AvenArena *emsg_arena,
+        AvenArena arena,
+        void *opaque_args
+    ) {
+        TestIoGraphArgs *args = opaque_args;
+        Graph graph = test_gen_graph(args->size, args->type, &arena);
+        AvenStr path = aven_str("test_io_graph_map.bin");
+
+        GraphIoMapResult create_res = graph_io_map_create(
+            path,
+            graph_io_aligned_size(graph),
+            arena
+        );
+        if (create_res.error != 0) {
+            return (AvenTestResult){
+                .message = aven_str("failed to create mapped file"),
+                .error = create_res.error,
+            };
+        }
+        GraphIoMap map = create_res.payload;
+        graph_io_aligned_write(map.bytes, graph);
+        graph_io_map_close(&map);
+
+        GraphIoMapResult open_res = graph_io_map_open(path, arena);
+        if (open_res.error != 0) {
+            return (AvenTestResult){
+                .message = aven_str("failed to open mapped file"),
+                .error = open_res.error,
+            };
+        }
+        map = open_res.payload;
+
+        AvenTestResult result = { 0 };
+        GraphIoResult view_res = graph_io_map_graph(map);
+        if (view_res.error != 0) {
+            result = (AvenTestResult){
+                .message = aven_str("failed to view mapped graph"),
+                .error = view_res.error,
+            };
+        } else if (!graph_io_validate(view_res.payload)) {
+            result = (AvenTestResult){
+                .message = aven_str("mapped graph invalid"),
+                .error = 1,
+            };
+        } else {
+            size_t inv_adj = test_io_graph_diff(graph, view_res.payload);
+            if (inv_adj != 0) {
+                result = (AvenTestResult){
+                    .error = 1,
+                    .message = aven_fmt(
+                        emsg_arena,
+                        "mapped graph differed from original in {} places",
+                        aven_fmt_uint(inv_adj)
+                    ),
+                };
+            }
+        }
+
+        graph_io_map_close(&map);
+        remove("test_io_graph_map.bin");
+
+        return result;
+    }
+
+    static AvenTestResult test_io_graph_container(
+        AvenArena *emsg_arena,
+        AvenArena arena,
+        void *opaque_args
+    ) {
+        TestIoGraphArgs *args = opaque_args;
+        Graph graph = test_gen_graph(args->size, args->type, &arena);
+        GraphAug aug_graph = graph_aug(graph, &arena);
+
+        GraphPlaneEmbedding embedding = { .len = graph.adj.len };
+        embedding.ptr = aven_arena_create_array(Vec2, &arena, embedding.len);
+        GraphPropUint8 coloring = aven_arena_create_slice(
+            uint8_t,
+            &arena,
+            graph.adj.len
+        );
+        for (GraphIndex v = 0; v < graph.adj.len; v += 1) {
+            get(embedding, v)[0] = (float)v;
+            get(embedding, v)[1] = -(float)v;
+            get(coloring, v) = (uint8_t)(1 + v % 3);
+        }
+
+        GraphIoContainerWriter writer = graph_io_container_writer_init(
+            8,
+            true,
+            &arena
+        );
+        graph_io_container_writer_add_graph(&writer, graph);
+        graph_io_container_writer_add_aug(&writer, aug_graph);
+        graph_io_container_writer_add(
+            &writer,
+            GRAPH_IO_SECTION_EMBEDDING,
+            embedding
+        );
+        graph_io_container_writer_add(
+            &writer,
+            GRAPH_IO_SECTION_COLORING,
+            coloring
+        );
+
+        size_t size = graph_io_container_size(&writer);
+        ByteSlice bytes = { .len = size };
+        bytes.ptr = (unsigned char *)aven_arena_create_array(
+            uint64_t,
+            &arena,
+            (size + sizeof(uint64_t) - 1) / sizeof(uint64_t)
+        );
+        graph_io_container_write(&writer, bytes);
+
+        GraphIoContainerResult open_res = graph_io_container_open(bytes);
+        if (open_res.error != 0) {
+            return (AvenTestResult){
+                .message = aven_str("failed to open container"),
+                .error = open_res.error,
+            };
+        }
+        GraphIoContainer container = open_res.payload;
+
+        GraphIoResult graph_res = graph_io_container_graph(container);
+        GraphIoAugResult aug_res = graph_io_container_aug(container);
+        if (graph_res.error != 0 or aug_res.error != 0) {
+            return (AvenTestResult){
+                .message = aven_str("failed to view container graphs"),
+                .error = 1,
+            };
+        }
+        if (
+            !graph_io_validate(graph_res.payload) or
+            !graph_io_aug_validate(aug_res.payload) or
+            test_io_graph_diff(graph, graph_res.payload) != 0 or
+            test_io_graph_aug_diff(aug_graph, aug_res.payload) != 0
+        ) {
+            return (AvenTestResult){
+                .message = aven_str("container graphs differed from original"),
+                .error = 1,
+            };
+        }
+
+        GraphIoSectionResult emb_res = graph_io_container_section(
+            Vec2,
+            container,
+            GRAPH_IO_SECTION_EMBEDDING
+        );
+        if (emb_res.error != 0) {
+            return (AvenTestResult){
+                .message = aven_str("failed to view container embedding"),
+                .error = emb_res.error,
+            };
+        }
+        GraphPlaneEmbedding read_embedding = aven_io_slice(
+            Vec2,
+            emb_res.payload
+        );
+        if (read_embedding.len != embedding.len) {
+            return (AvenTestResult){
+                .message = aven_str("container embedding has wrong length"),
+                .error = 1,
+            };
+        }
+        for (GraphIndex v = 0; v < embedding.len; v += 1) {
+            if (
+                get(read_embedding, v)[0] != get(embedding, v)[0] or
+                get(read_embedding, v)[1] != get(embedding, v)[1]
+            ) {
+                return (AvenTestResult){
+                    .error = 1,
+                    .message = aven_fmt(
+                        emsg_arena,
+                        "container embedding differed at vertex {}",
+                        aven_fmt_uint(v)
+                    ),
+                };
+            }
+        }
+
+        if (
+            graph_io_container_section(
+                GraphIndex,
+                container,
+                GRAPH_IO_SECTION_PATH_P
+            ).error == 0 or
+            graph_io_container_section(
+                uint8_t,
+                container,
+                GRAPH_IO_SECTION_EMBEDDING
+            ).error == 0
+        ) {
+            return (AvenTestResult){
+                .message = aven_str("viewed missing or mistyped section"),
+                .error = 1,
+            };
+        }
+
+        uint32_t kinds[] = {
+            GRAPH_IO_SECTION_ADJ,
+            GRAPH_IO_SECTION_NB,
+            GRAPH_IO_SECTION_AUG_NB,
+            GRAPH_IO_SECTION_EMBEDDING,
+            GRAPH_IO_SECTION_COLORING,
+        };
+        for (size_t i = 0; i < countof(kinds); i += 1) {
+            if (!graph_io_container_verify(container, kinds[i])) {
+                return (AvenTestResult){
+                    .error = 1,
+                    .message = aven_fmt(
+                        emsg_arena,
+                        "section {} failed its checksum",
+                        aven_fmt_uint(kinds[i])
+                    ),
+                };
+            }
+        }
+
+        GraphIoSection *color_section = graph_io_container_find(
+            container,
+            GRAPH_IO_SECTION_COLORING
+        );
+        get(bytes, color_section->offset) ^= 0x4;
+        if (
+            graph_io_container_verify(container, GRAPH_IO_SECTION_COLORING) or
+            !graph_io_container_verify(container, GRAPH_IO_SECTION_ADJ)
+        ) {
+            return (AvenTestResult){
+                .message = aven_str("checksum missed corrupted coloring"),
+                .error = 1,
+            };
+        }
+
+        ((GraphIoContainerHeader *)bytes.ptr)->version += 1;
+        if (graph_io_container_open(bytes).error == 0) {
+            return (AvenTestResult){
+                .message = aven_str("opened container from a newer version"),
+                .error = 1,
+            };
+        }
+
+        return (AvenTestResult){ 0 };
+    }
+
+    static AvenTestResult test_io_graph_cache(
+        AvenArena *emsg_arena,
+        AvenArena arena,
+        void *opaque_args
+    ) {
+        TestIoGraphArgs *args = opaque_args;
+        Graph graph = test_gen_graph(args->size, args->type, &arena);
+        GraphAug aug_graph = graph_aug(graph, &arena);
+
+        AvenStr dir = aven_str(".");
+        uint64_t key = graph_io_cache_key(aven_str("test_io_graph_cache"));
+        key = graph_io_cache_key_push(key, args->size);
+        key = graph_io_cache_key_push(key, args->type);
+        uint64_t hash = graph_io_cache_hash(graph);
+
+        GraphIoContainerWriter writer = graph_io_container_writer_init(
+            4,
+            true,
+            &arena
+        );
+        graph_io_container_writer_add_graph(&writer, graph);
+        graph_io_container_writer_add_aug(&writer, aug_graph);
+
+        int store_error = graph_io_cache_store(dir, key, hash, &writer, arena);
+        if (store_error != 0) {
+            return (AvenTestResult){
+                .message = aven_str("failed to store cache entry"),
+                .error = store_error,
+            };
+        }
+        char *cpath = graph_io_map_cstr(
+            graph_io_cache_path(dir, key, &arena),
+            &arena
+        );
+
+        GraphIoCacheResult miss_res = graph_io_cache_load(
+            dir,
+            graph_io_cache_key_push(key, 1),
+            arena
+        );
+        if (miss_res.error == 0) {
+            graph_io_cache_close(&miss_res.payload);
+            remove(cpath);
+            return (AvenTestResult){
+                .message = aven_str("loaded cache entry for another key"),
+                .error = 1,
+            };
+        }
+
+        GraphIoCacheResult load_res = graph_io_cache_load(dir, key, arena);
+        if (load_res.error != 0) {
+            remove(cpath);
+            return (AvenTestResult){
+                .message = aven_str("failed to load cache entry"),
+                .error = load_res.error,
+            };
+        }
+        GraphIoCacheEntry entry = load_res.payload;
+
+        AvenTestResult result = { 0 };
+        GraphIoResult graph_res = graph_io_container_graph(entry.container);
+        GraphIoAugResult aug_res = graph_io_container_aug(entry.container);
+        if (graph_res.error != 0 or aug_res.error != 0) {
+            result = (AvenTestResult){
+                .message = aven_str("cache entry missing graph sections"),
+                .error = 1,
+            };
+        } else if (!graph_io_cache_check(&entry, graph_res.payload)) {
+            result = (AvenTestResult){
+                .message = aven_str("cached graph failed its hash check"),
+                .error = 1,
+            };
+        } else {
+            size_t inv_adj = test_io_graph_diff(graph, graph_res.payload) +
+                test_io_graph_aug_diff(aug_graph, aug_res.payload);
+            if (inv_adj != 0) {
+                result = (AvenTestResult){
+                    .error = 1,
+                    .message = aven_fmt(
+                        emsg_arena,
+                        "cached graphs differed from originals in {} places",
+                        aven_fmt_uint(inv_adj)
+                    ),
+                };
+            }
+        }
+
+        graph_io_cache_close(&entry);
+        remove(cpath);
+        if (result.error != 0) {
+            return result;
+        }
+
+        // reversing a rotation keeps the edges but changes the embedding
+        GraphNbSlice nb = aven_arena_create_slice(
+            GraphIndex,
+            &arena,
+            graph.nb.len
+        );
+        for (GraphIndex i = 0; i < nb.len; i += 1) {
+            get(nb, i) = get(graph.nb, i);
+        }
+        Graph flipped_graph = { .adj = graph.adj, .nb = nb };
+        for (GraphIndex v = 0; v < graph.adj.len; v += 1) {
+            GraphAdj v_adj = get(graph.adj, v);
+            if (v_adj.len < 3) {
+                continue;
+            }
+            for (GraphIndex i = 0; i < v_adj.len; i += 1) {
+                get(nb, v_adj.index + i) =
+                    graph_nb(graph.nb, v_adj, v_adj.len - 1 - i);
+            }
+            if (graph_io_cache_hash(flipped_graph) == hash) {
+                return (AvenTestResult){
+                    .message = aven_str("hash ignores rotation order"),
+                    .error = 1,
+                };
+            }
+            break;
+        }
+
+        return (AvenTestResult){ 0 };
+    }
+
+    typedef struct {
+        uint32_t size;
+        TestGenGraphType type;
+        uint32_t chunk_len;
+        uint32_t chunk_nb_len;
+    } TestIoStreamArgs;
+
+    static AvenTestResult test_io_graph_stream(
+        AvenArena *emsg_arena,
+        AvenArena arena,
+        void *opaque_args
+    ) {
+        TestIoStreamArgs *args = opaque_args;
+        Graph graph = test_gen_graph(args->size, args->type, &arena);
+
+        // every chunk may hold a single vertex, plus the end marker
+        size_t chunk_overhead = sizeof(GraphIoStreamChunkHeader) +
+            aven_io_slice_size((GraphAdjSlice){ 0 }) +
+            aven_io_slice_size((GraphNbSlice){ 0 });
+        ByteSlice space = aven_arena_create_slice(
+            unsigned char,
+            &arena,
+            graph_io_size(graph) + (graph.adj.len + 1) * chunk_overhead
+        );
+
+        AvenIoWriter io_writer = aven_io_writer_init_bytes(space);
+        GraphIoStreamWriter writer = graph_io_stream_writer_init(
+            &io_writer,
+            args->chunk_len,
+            args->chunk_nb_len,
+            &arena
+        );
+        for (GraphIndex v = 0; v < graph.adj.len; v += 1) {
+            GraphAdj v_adj = get(graph.adj, v);
+            GraphNbSlice rotation = {
+                .ptr = &get(graph.nb, v_adj.index),
+                .len = v_adj.len,
+            };
+            int wr_error = graph_io_stream_writer_push(&writer, rotation);
+            if (wr_error != 0) {
+                return (AvenTestResult){
+                    .message = aven_str("failed to stream vertex"),
+                    .error = wr_error,
+                };
+            }
+        }
+        int fin_error = graph_io_stream_writer_finish(&writer);
+        if (fin_error != 0) {
+            return (AvenTestResult){
+                .message = aven_str("failed to finish stream"),
+                .error = fin_error,
+            };
+        }
+
+        Graph read_graph = {
+            .adj = { .len = graph.adj.len },
+            .nb = { .len = graph.nb.len },
+        };
+        read_graph.adj.ptr = aven_arena_create_array(
+            GraphAdj,
+            &arena,
+            read_graph.adj.len
+        );
+        read_graph.nb.ptr = aven_arena_create_array(
+            GraphIndex,
+            &arena,
+            read_graph.nb.len
+        );
+
+        AvenIoReader io_reader = aven_io_reader_init_bytes(space);
+        GraphIoStreamReaderResult rd_res = graph_io_stream_reader_init(
+            &io_reader
+        );
+        if (rd_res.error != 0) {
+            return (AvenTestResult){
+                .message = aven_str("failed to open stream"),
+                .error = rd_res.error,
+            };
+        }
+        GraphIoStreamReader reader = rd_res.payload;
+
+        size_t nchunks = 0;
+        while (!reader.done) {
+            AvenArena chunk_arena = arena;
+            GraphIoStreamChunkResult chunk_res = graph_io_stream_reader_pop(
+                &reader,
+                &chunk_arena
+            );
+            if (chunk_res.error != 0) {
+                return (AvenTestResult){
+                    .error = chunk_res.error,
+                    .message = aven_fmt(
+                        emsg_arena,
+                        "failed to pop chunk {}",
+                        aven_fmt_uint(nchunks)
+                    ),
+                };
+            }
+
+            GraphIoStreamChunk chunk = chunk_res.payload;
+            if (
+                chunk.first_vertex + chunk.adj.len > read_graph.adj.len or
+                chunk.first_nb + chunk.nb.len > read_graph.nb.len
+            ) {
+                return (AvenTestResult){
+                    .message = aven_str("stream holds too many vertices"),
+                    .error = 1,
+                };
+            }
+            for (GraphIndex i = 0; i < chunk.adj.len; i += 1) {
+                GraphAdj v_adj = get(chunk.adj, i);
+                get(read_graph.adj, chunk.first_vertex + i) = v_adj;
+                for (GraphIndex j = 0; j < v_adj.len; j += 1) {
+                    get(read_graph.nb, v_adj.index + j) =
+                        graph_io_stream_chunk_nb(chunk, v_adj, j);
+                }
+            }
+            nchunks += 1;
+        }
+
+        if (
+            reader.next_vertex != graph.adj.len or
+            reader.next_nb != graph.nb.len
+        ) {
+            return (AvenTestResult){
+                .message = aven_str("stream ended early"),
+                .error = 1,
+            };
+        }
+
+        size_t min_chunks = 1 +
+            (graph.adj.len + args->chunk_len - 1) / args->chunk_len;
+        if (nchunks < min_chunks) {
+            return (AvenTestResult){
+                .error = 1,
+                .message = aven_fmt(
+                    emsg_arena,
+                    "expected at least {} chunks, found {}",
+                    aven_fmt_uint(min_chunks),
+                    aven_fmt_uint(nchunks)
+                ),
+            };
+        }
+
+        if (!graph_io_validate(read_graph)) {
+            return (AvenTestResult){
+                .message = aven_str("streamed graph invalid"),
+                .error = 1,
+            };
+        }
+
+        size_t inv_adj = test_io_graph_diff(graph, read_graph);
+        if (inv_adj != 0) {
+            return (AvenTestResult){
+                .error = 1,
+                .message = aven_fmt(
+                    emsg_arena,
+                    "streamed graph differed from original in {} places",
+                    aven_fmt_uint(inv_adj)
+                ),
+            };
+        }
+
+        return (AvenTestResult){ 0 };
+    }
+
+    typedef struct {
+        uint64_t len;
+        uint64_t nb_len;
+    } TestIoStreamOversizeArgs;
+
+    // A chunk declaring more than the header allows must be rejected before
+    // the reader allocates anything for it
+    static AvenTestResult test_io_graph_stream_oversize(
+        AvenArena *emsg_arena,
+        AvenArena arena,
+        void *opaque_args
+    ) {
+        (void)emsg_arena;
+        TestIoStreamOversizeArgs *args = opaque_args;
+
+        GraphIoStreamHeader header = {
+            .type = GRAPH_IO_TYPE_STREAM,
+            .chunk_len = 4,
+            .chunk_nb_len = 8,
+        };
+        GraphIoStreamChunkHeader chunk_header = {
+            .len = args->len,
+            .nb_len = args->nb_len,
+        };
+        ByteSlice space = aven_arena_create_slice(
+            unsigned char,
+            &arena,
+            sizeof(header) + sizeof(chunk_header)
+        );
+
+        AvenIoWriter io_writer = aven_io_writer_init_bytes(space);
+        int hd_error = aven_io_writer_push_struct(&io_writer, &header);
+        int ch_error = aven_io_writer_push_struct(&io_writer, &chunk_header);
+        if (hd_error != 0 or ch_error != 0) {
+            return (AvenTestResult){
+                .message = aven_str("failed to write stream headers"),
+                .error = 1,
+            };
+        }
+
+        AvenIoReader io_reader = aven_io_reader_init_bytes(space);
+        GraphIoStreamReaderResult rd_res = graph_io_stream_reader_init(
+            &io_reader
+        );
+        if (rd_res.error != 0) {
+            return (AvenTestResult){
+                .message = aven_str("failed to open stream"),
+                .error = rd_res.error,
+            };
+        }
+        GraphIoStreamReader reader = rd_res.payload;
+
+        GraphIoStreamChunkResult chunk_res = graph_io_stream_reader_pop(
+            &reader,
+            &arena
+        );
+        if (chunk_res.error != AVEN_IO_ERROR_MISMATCH) {
+            return (AvenTestResult){
+                .message = aven_str("oversized chunk was not rejected"),
+                .error = 1,
+            };
+        }
+
+        return (AvenTestResult){ 0 };
+    }
+
+    typedef enum {
+        TEST_IO_VALIDATE_MUTATION_NONE = 0,
+        TEST_IO_VALIDATE_MUTATION_OUT_OF_RANGE,
+        TEST_IO_VALIDATE_MUTATION_REPEATED,
+        TEST_IO_VALIDATE_MUTATION_ASYMMETRIC,
+    } TestIoValidateMutation;
+
+    typedef struct {
+        uint32_t size;
+        TestGenGraphType type;
+        TestIoValidateMutation mutation;
+        size_t nthreads;
+    } TestIoValidateArgs;
+
+    static bool test_io_lists(Graph graph, GraphIndex v, GraphIndex u) {
+        GraphAdj v_adj = get(graph.adj, v);
+        for (GraphIndex i = 0; i < v_adj.len; i += 1) {
+            if (graph_nb(graph.nb, v_adj, i) == u) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    // Corrupt the rotation of the middle vertex v and check that both
+    // validators report the smaller of v and the neighbor u it loses
+    static AvenTestResult test_io_graph_validate_thread(
+        AvenArena *emsg_arena,
+        AvenArena arena,
+        void *opaque_args
+    ) {
+        TestIoValidateArgs *args = opaque_args;
+        Graph graph = test_gen_graph(args->size, args->type, &arena);
+        GraphAug aug_graph = graph_aug(graph, &arena);
+
+        GraphIndex v = (GraphIndex)(graph.adj.len / 2);
+        GraphAdj v_adj = get(graph.adj, v);
+        GraphIndex expected = GRAPH_INDEX_MAX;
+        if (args->mutation != TEST_IO_VALIDATE_MUTATION_NONE) {
+            assert(v_adj.len > 1);
+            GraphIndex u = graph_nb(graph.nb, v_adj, 1);
+            expected = min(v, u);
+
+            GraphNbSlice nb = aven_arena_create_slice(
+                GraphIndex,
+                &arena,
+                graph.nb.len
+            );
+            for (size_t i = 0; i < nb.len; i += 1) {
+                get(nb, i) = get(graph.nb, i);
+            }
+            graph.nb = nb;
+
+            GraphAugNbSlice aug_nb = aven_arena_create_slice(
+                GraphAugNb,
+                &arena,
+                aug_graph.nb.len
+            );
+            for (size_t i = 0; i < aug_nb.len; i += 1) {
+                get(aug_nb, i) = get(aug_graph.nb, i);
+            }
+            aug_graph.nb = aug_nb;
+
+            GraphAugNb *aug_vu = &get(aug_graph.nb, v_adj.index + 1);
+            GraphIndex u_len = get(aug_graph.adj, u).len;
+            switch (args->mutation) {
+                case TEST_IO_VALIDATE_MUTATION_OUT_OF_RANGE:
+                    get(graph.nb, v_adj.index + 1) = (GraphIndex)graph.adj.len;
+                    aug_vu->vertex = (GraphIndex)graph.adj.len;
+                    break;
+                case TEST_IO_VALIDATE_MUTATION_REPEATED:
+                    get(graph.nb, v_adj.index + 1) = graph_nb(
+                        graph.nb,
+                        v_adj,
+                        0
+                    );
+                    aug_vu->back_index = (aug_vu->back_index + 1) % u_len;
+                    break;
+                case TEST_IO_VALIDATE_MUTATION_ASYMMETRIC: {
+                    GraphIndex w = 0;
+                    while (w == v or test_io_lists(graph, v, w)) {
+                        w += 1;
+                    }
+                    assert(w < graph.adj.len);
+                    get(graph.nb, v_adj.index + 1) = w;
+                    aug_vu->back_index = (aug_vu->back_index + 1) % u_len;
+                    break;
+                }
+                default:
+                    assert(false);
+                    break;
+            }
+        }
+
+        AvenThreadPool thread_pool = aven_thread_pool_init(
+            args->nthreads - 1,
+            args->nthreads - 1,
+            &arena
+        );
+        aven_thread_pool_run(&thread_pool);
+
+        GraphIndex first = graph_io_validate_thread(
+            graph,
+            &thread_pool,
+            args->nthreads,
+            arena
+        );
+        GraphIndex aug_first = graph_io_aug_validate_thread(
+            aug_graph,
+            &thread_pool,
+            args->nthreads,
+            arena
+        );
+
+        aven_thread_pool_halt_and_destroy(&thread_pool);
+
+        if (first != expected or aug_first != expected) {
+            return (AvenTestResult){
+                .error = 1,
+                .message = aven_fmt(
+                    emsg_arena,
+                    "expected first offending vertex {}, found {} and {}",
+                    aven_fmt_uint(expected),
+                    aven_fmt_uint(first),
+                    aven_fmt_uint(aug_first)
+                ),
+            };
+        }
+
+        return (AvenTestResult){ 0 };
+    }
+
+    static void test_io_text_push(ByteSlice text, size_t *pos, AvenStr str) {
+        for (size_t i = 0; i < str.len; i += 1) {
+            get(text, *pos) = (unsigned char)get(str, i);
+            *pos += 1;
+        }
+    }
+
+    static void test_io_text_push_uint(
+        ByteSlice text,
+        size_t *pos,
+        size_t x
+    ) {
+        unsigned char digits[24];
+        size_t ndigits = 0;
+        do {
+            digits[ndigits] = (unsigned char)('0' + x % 10);
+            ndigits += 1;
+            x /= 10;
+        } while (x > 0);
+
+        while (ndigits > 0) {
+            ndigits -= 1;
+            get(text, *pos) = digits[ndigits];
+            *pos += 1;
+        }
+    }
+
+    typedef struct {
+        uint32_t size;
+        TestGenGraphType type;
+        GraphIoImportFormat format;
+        size_t nthreads;
+    } TestIoImportArgs;
+
+    // Write every edge once, as the smaller vertex followed by the larger,
+    // the imported rotations then hold the same neighbors in another order
+    static AvenTestResult test_io_graph_import_text(
+        AvenArena *emsg_arena,
+        AvenArena arena,
+        void *opaque_args
+    ) {
+        TestIoImportArgs *args = opaque_args;
+        Graph graph = test_gen_graph(args->size, args->type, &arena);
+
+        size_t line_size = 2 * 24 + 4;
+        ByteSlice space = aven_arena_create_slice(
+            unsigned char,
+            &arena,
+            (graph.nb.len / 2 + 3) * line_size
+        );
+
+        size_t pos = 0;
+        bool dimacs = args->format == GRAPH_IO_IMPORT_FORMAT_DIMACS;
+        GraphIndex offset = dimacs ? 1 : 0;
+        if (dimacs) {
+            test_io_text_push(space, &pos, aven_str("c generated\np edge "));
+            test_io_text_push_uint(space, &pos, graph.adj.len);
+            test_io_text_push(space, &pos, aven_str(" "));
+            test_io_text_push_uint(space, &pos, graph.nb.len / 2);
+            test_io_text_push(space, &pos, aven_str("\n"));
+        } else {
+            test_io_text_push(space, &pos, aven_str("# generated\n"));
+        }
+        for (GraphIndex v = 0; v < graph.adj.len; v += 1) {
+            GraphAdj v_adj = get(graph.adj, v);
+            for (GraphIndex i = 0; i < v_adj.len; i += 1) {
+                GraphIndex u = graph_nb(graph.nb, v_adj, i);
+                if (u < v) {
+                    continue;
+                }
+                if (dimacs) {
+                    test_io_text_push(space, &pos, aven_str("e "));
+                }
+                test_io_text_push_uint(space, &pos, v + offset);
+                test_io_text_push(space, &pos, aven_str("\t"));
+                test_io_text_push_uint(space, &pos, u + offset);
+                test_io_text_push(space, &pos, aven_str("\r\n"));
+            }
+        }
+        ByteSlice text = { .ptr = space.ptr, .len = pos };
+
+        GraphIoResult import_res;
+        if (dimacs) {
+            import_res = graph_io_import_dimacs(text, &arena);
+        } else {
+            import_res = graph_io_import_edge_list(text, &arena);
+        }
+        if (import_res.error != 0) {
+            return (AvenTestResult){
+                .message = aven_str("failed to import graph"),
+                .error = import_res.error,
+            };
+        }
+        Graph read_graph = import_res.payload;
+
+        // an edge list has no isolated vertices past its largest vertex
+        if (
+            read_graph.adj.len != graph.adj.len or
+            read_graph.nb.len != graph.nb.len or
+            !graph_io_validate(read_graph)
+        ) {
+            return (AvenTestResult){
+                .message = aven_str("imported graph has the wrong size"),
+                .error = 1,
+            };
+        }
+
+        GraphPropIndex marks = { .len = graph.adj.len };
+        marks.ptr = aven_arena_create_array(GraphIndex, &arena, marks.len);
+        for (GraphIndex v = 0; v < marks.len; v += 1) {
+            get(marks, v) = GRAPH_INDEX_MAX;
+        }
+
+        size_t inv_adj = 0;
+        for (GraphIndex v = 0; v < graph.adj.len; v += 1) {
+            GraphAdj v_adj = get(graph.adj, v);
+            GraphAdj rv_adj = get(read_graph.adj, v);
+            for (GraphIndex i = 0; i < v_adj.len; i += 1) {
+                get(marks, graph_nb(graph.nb, v_adj, i)) = v;
+            }
+
+            bool valid = v_adj.len == rv_adj.len;
+            for (GraphIndex i = 0; valid and i < rv_adj.len; i += 1) {
+                GraphIndex u = graph_nb(read_graph.nb, rv_adj, i);
+                GraphIndex *mark = &get(marks, u);
+                valid = *mark == v;
+                *mark = GRAPH_INDEX_MAX;
+            }
+            if (!valid) {
+                inv_adj += 1;
+            }
+        }
+
+        if (inv_adj != 0) {
+            return (AvenTestResult){
+                .error = 1,
+                .message = aven_fmt(
+                    emsg_arena,
+                    "imported graph differed from original in {} places",
+                    aven_fmt_uint(inv_adj)
+                ),
+            };
+        }
+
+        if (args->nthreads == 0) {
+            return (AvenTestResult){ 0 };
+        }
+
+        AvenThreadPool thread_pool = aven_thread_pool_init(
+            args->nthreads - 1,
+            args->nthreads - 1,
+            &arena
+        );
+        aven_thread_pool_run(&thread_pool);
+
+        GraphIoResult thread_res;
+        if (dimacs) {
+            thread_res = graph_io_import_dimacs_thread(
+                text,
+                &thread_pool,
+                args->nthreads,
+                &arena
+            );
+        } else {
+            thread_res = graph_io_import_edge_list_thread(
+                text,
+                &thread_pool,
+                args->nthreads,
+                &arena
+            );
+        }
+
+        aven_thread_pool_halt_and_destroy(&thread_pool);
+
+        if (thread_res.error != 0) {
+            return (AvenTestResult){
+                .message = aven_str("failed to import graph with threads"),
+                .error = thread_res.error,
+            };
+        }
+
+        size_t inv_thread_adj = test_io_graph_diff(
+            read_graph,
+            thread_res.payload
+        );
+        if (inv_thread_adj != 0) {
+            return (AvenTestResult){
+                .error = 1,
+                .message = aven_fmt(
+                    emsg_arena,
+                    "threaded import differed from sequential in {} places",
+                    aven_fmt_uint(inv_thread_adj)
+                ),
+            };
+        }
+
+        return (AvenTestResult){ 0 };
+    }
+
+    static AvenTestResult test_io_graph_import_errors(
+        AvenArena *emsg_arena,
+        AvenArena arena,
+        void *opaque_args
+    ) {
+        (void)emsg_arena;
+        (void)opaque_args;
+
+        size_t nthreads = 3;
+        AvenThreadPool thread_pool = aven_thread_pool_init(
+            nthreads - 1,
+            nthreads - 1,
+            &arena
+        );
+        aven_thread_pool_run(&thread_pool);
+
+        AvenStr edge_lists[] = {
+            aven_str("0 1\n1\n"),
+            aven_str("0 1\n1 2x\n"),
+            aven_str("0 -1\n"),
+            aven_str("0 1\n1 2\n2 3\n3 4\n# fine so far\n4 x\n"),
+        };
+        size_t edge_lists_imported = 0;
+        for (size_t i = 0; i < countof(edge_lists); i += 1) {
+            ByteSlice text = {
+                .ptr = (unsigned char *)edge_lists[i].ptr,
+                .len = edge_lists[i].len,
+            };
+            AvenArena temp_arena = arena;
+            GraphIoResult res = graph_io_import_edge_list(text, &temp_arena);
+            GraphIoResult thread_res = graph_io_import_edge_list_thread(
+                text,
+                &thread_pool,
+                nthreads,
+                &temp_arena
+            );
+            if (res.error == 0 or thread_res.error == 0) {
+                edge_lists_imported += 1;
+            }
+        }
+
+        AvenStr dimacs[] = {
+            aven_str("e 1 2\n"),
+            aven_str("p edge 2 1\ne 1 3\n"),
+            aven_str("p edge 2 1\ne 0 1\n"),
+            aven_str("p edge 3 3\ne 1 2\ne 2 3\ne 3 4\n"),
+        };
+        size_t dimacs_imported = 0;
+        for (size_t i = 0; i < countof(dimacs); i += 1) {
+            ByteSlice text = {
+                .ptr = (unsigned char *)dimacs[i].ptr,
+                .len = dimacs[i].len,
+            };
+            AvenArena temp_arena = arena;
+            GraphIoResult res = graph_io_import_dimacs(text, &temp_arena);
+            GraphIoResult thread_res = graph_io_import_dimacs_thread(
+                text,
+                &thread_pool,
+                nthreads,
+                &temp_arena
+            );
+            if (res.error == 0 or thread_res.error == 0) {
+                dimacs_imported += 1;
+            }
+        }
+
+        // a neighbor past the vertex count, then a graph cut short
+        unsigned char planar_code_data[][6] = {
+            { 3, 2, 0, 5, 0, 0 },
+            { 3, 2, 3, 0, 1, 0 },
+        };
+        size_t planar_code_imported = 0;
+        for (size_t i = 0; i < countof(planar_code_data); i += 1) {
+            ByteSlice bytes = {
+                .ptr = planar_code_data[i],
+                .len = countof(planar_code_data[i]),
+            };
+            AvenArena temp_arena = arena;
+            GraphIoPlanarCodeReader reader = graph_io_planar_code_init(bytes);
+            GraphIoResult res = graph_io_planar_code_pop(
+                &reader,
+                &temp_arena
+            );
+            GraphIoPlanarCodeReader thread_reader = graph_io_planar_code_init(
+                bytes
+            );
+            GraphIoResult thread_res = graph_io_planar_code_pop_thread(
+                &thread_reader,
+                &thread_pool,
+                nthreads,
+                &temp_arena
+            );
+            if (res.error == 0 or thread_res.error == 0) {
+                planar_code_imported += 1;
+            }
+        }
+
+        // isolated vertices after the last edge are kept from the header
+        AvenStr isolated = aven_str("p edge 5 2\ne 1 2\nc\ne 2 2\n");
+        ByteSlice text = {
+            .ptr = (unsigned char *)isolated.ptr,
+            .len = isolated.len,
+        };
+        GraphIoResult res = graph_io_import_dimacs(text, &arena);
+        GraphIoResult thread_res = graph_io_import_dimacs_thread(
+            text,
+            &thread_pool,
+            nthreads,
+            &arena
+        );
+
+        aven_thread_pool_halt_and_destroy(&thread_pool);
+
+        if (edge_lists_imported != 0) {
+            return (AvenTestResult){
+                .message = aven_str("imported a malformed edge list"),
+                .error = 1,
+            };
+        }
+        if (dimacs_imported != 0) {
+            return (AvenTestResult){
+                .message = aven_str("imported a malformed DIMACS file"),
+                .error = 1,
+            };
+        }
+        if (planar_code_imported != 0) {
+            return (AvenTestResult){
+                .message = aven_str("imported malformed planar code"),
+                .error = 1,
+            };
+        }
+
+        if (res.error != 0 or thread_res.error != 0) {
+            return (AvenTestResult){
+                .message = aven_str("failed to import DIMACS file"),
+                .error = res.error != 0 ? res.error : thread_res.error,
+            };
+        }
+        Graph graph = res.payload;
+        GraphAdj v_adj = get(graph.adj, 1);
+        if (
+            graph.adj.len != 5 or
+            graph.nb.len != 4 or
+            v_adj.len != 3 or
+            graph_nb(graph.nb, v_adj, 0) != 0 or
+            graph_nb(graph.nb, v_adj, 1) != 1 or
+            graph_nb(graph.nb, v_adj, 2) != 1
+        ) {
+            return (AvenTestResult){
+                .message = aven_str("imported DIMACS graph is wrong"),
+                .error = 1,
+            };
+        }
+        if (test_io_graph_diff(graph, thread_res.payload) != 0) {
+            return (AvenTestResult){
+                .message = aven_str("threaded DIMACS import differed"),
+                .error = 1,
+            };
+        }
+
+        return (AvenTestResult){ 0 };
+    }
+
+    static void test_io_planar_code_push(
+        ByteSlice bytes,
+        size_t *pos,
+        size_t entry_size,
+        size_t x
+    ) {
+        get(bytes, *pos) = (unsigned char)(x & 0xff);
+        *pos += 1;
+        if (entry_size == 2) {
+            get(bytes, *pos) = (unsigned char)(x >> 8);
+            *pos += 1;
+        }
+    }
+
+    // Two copies of the graph in one file, the second must be read from
+    // where the first ends with every rotation in its original order
+    static AvenTestResult test_io_graph_planar_code(
+        AvenArena *emsg_arena,
+        AvenArena arena,
+        void *opaque_args
+    ) {
+        TestIoGraphArgs *args = opaque_args;
+        Graph graph = test_gen_graph(args->size, args->type, &arena);
+
+        // 16-bit graphs start with a 0 byte and a 16-bit count
+        size_t entry_size = graph.adj.len > 0xff ? 2 : 1;
+        size_t record_size = (entry_size == 2 ? 1 : 0) +
+            (1 + graph.adj.len + graph.nb.len) * entry_size;
+        AvenStr header = aven_str(">>planar_code<<");
+        ByteSlice space = aven_arena_create_slice(
+            unsigned char,
+            &arena,
+            header.len + 2 * record_size
+        );
+
+        size_t pos = 0;
+        test_io_text_push(space, &pos, header);
+        for (size_t copy = 0; copy < 2; copy += 1) {
+            if (entry_size == 2) {
+                test_io_planar_code_push(space, &pos, 1, 0);
+            }
+            test_io_planar_code_push(space, &pos, entry_size, graph.adj.len);
+            for (GraphIndex v = 0; v < graph.adj.len; v += 1) {
+                GraphAdj v_adj = get(graph.adj, v);
+                for (GraphIndex i = 0; i < v_adj.len; i += 1) {
+                    test_io_planar_code_push(
+                        space,
+                        &pos,
+                        entry_size,
+                        graph_nb(graph.nb, v_adj, i) + 1
+                    );
+                }
+                test_io_planar_code_push(space, &pos, entry_size, 0);
+            }
+        }
+        assert(pos == space.len);
+
+        // the pool is halted before any result is checked
+        AvenThreadPool thread_pool = { 0 };
+        if (args->nthreads > 0) {
+            thread_pool = aven_thread_pool_init(
+                args->nthreads - 1,
+                args->nthreads - 1,
+                &arena
+            );
+            aven_thread_pool_run(&thread_pool);
+        }
+
+        GraphIoPlanarCodeReader reader = graph_io_planar_code_init(space);
+        GraphIoResult results[2] = { 0 };
+        for (size_t copy = 0; copy < countof(results); copy += 1) {
+            if (args->nthreads > 0) {
+                results[copy] = graph_io_planar_code_pop_thread(
+                    &reader,
+                    &thread_pool,
+                    args->nthreads,
+                    &arena
+                );
+            } else {
+                results[copy] = graph_io_planar_code_pop(&reader, &arena);
+            }
+            if (results[copy].error != 0) {
+                break;
+            }
+        }
+
+        if (args->nthreads > 0) {
+            aven_thread_pool_halt_and_destroy(&thread_pool);
+        }
+
+        for (size_t copy = 0; copy < countof(results); copy += 1) {
+            GraphIoResult res = results[copy];
+            if (res.error != 0) {
+                return (AvenTestResult){
+                    .error = res.error,
+                    .message = aven_fmt(
+                        emsg_arena,
+                        "failed to read graph {}",
+                        aven_fmt_uint(copy)
+                    ),
+                };
+            }
+
+            size_t inv_adj = test_io_graph_diff(graph, res.payload);
+            if (inv_adj != 0) {
+                return (AvenTestResult){
+                    .error = 1,
+                    .message = aven_fmt(
+                        emsg_arena,
+                        "read graph differed from original in {} places",
+                        aven_fmt_uint(inv_adj)
+                    ),
+                };
+            }
+        }
+
+        if (!graph_io_planar_code_done(&reader)) {
+            return (AvenTestResult){
+                .message = aven_str("planar code reader did not finish"),
+                .error = 1,
+            };
+        }
+
+        return (AvenTestResult){ 0 };
+    }
+
     static void test_io(AvenArena arena) {
         AvenTestCase tcase_data[] = {
             {
@@ -330,6 +1740,328 @@
                 },
                 .fn = test_io_graph_aug,
             },
+            {
+                .desc = aven_str("aligned view K_1"),
+                .args = &(TestIoGraphArgs){
+                    .size = 1,
+                    .type = TEST_GEN_GRAPH_TYPE_COMPLETE,
+                },
+                .fn = test_io_graph_aligned,
+            },
+            {
+                .desc = aven_str("aligned view K_19"),
+                .args = &(TestIoGraphArgs){
+                    .size = 19,
+                    .type = TEST_GEN_GRAPH_TYPE_COMPLETE,
+                },
+                .fn = test_io_graph_aligned,
+            },
+            {
+                .desc = aven_str("aligned view 31x31 grid"),
+                .args = &(TestIoGraphArgs){
+                    .size = 31,
+                    .type = TEST_GEN_GRAPH_TYPE_GRID,
+                },
+                .fn = test_io_graph_aligned,
+            },
+            {
+                .desc = aven_str("aligned view pyramid A_9"),
+                .args = &(TestIoGraphArgs){
+                    .size = 9,
+                    .type = TEST_GEN_GRAPH_TYPE_PYRAMID,
+                },
+                .fn = test_io_graph_aligned,
+            },
+            {
+                .desc = aven_str("mapped file 31x31 grid"),
+                .args = &(TestIoGraphArgs){
+                    .size = 31,
+                    .type = TEST_GEN_GRAPH_TYPE_GRID,
+                },
+                .fn = test_io_graph_map,
+            },
+            {
+                .desc = aven_str("container K_1"),
+                .args = &(TestIoGraphArgs){
+                    .size = 1,
+                    .type = TEST_GEN_GRAPH_TYPE_COMPLETE,
+                },
+                .fn = test_io_graph_container,
+            },
+            {
+                .desc = aven_str("container 9x9 grid"),
+                .args = &(TestIoGraphArgs){
+                    .size = 9,
+                    .type = TEST_GEN_GRAPH_TYPE_GRID,
+                },
+                .fn = test_io_graph_container,
+            },
+            {
+                .desc = aven_str("container pyramid A_9"),
+                .args = &(TestIoGraphArgs){
+                    .size = 9,
+                    .type = TEST_GEN_GRAPH_TYPE_PYRAMID,
+                },
+                .fn = test_io_graph_container,
+            },
+            {
+                .desc = aven_str("cache entry K_1"),
+                .args = &(TestIoGraphArgs){
+                    .size = 1,
+                    .type = TEST_GEN_GRAPH_TYPE_COMPLETE,
+                },
+                .fn = test_io_graph_cache,
+            },
+            {
+                .desc = aven_str("cache entry order 21 triangulation"),
+                .args = &(TestIoGraphArgs){
+                    .size = 21,
+                    .type = TEST_GEN_GRAPH_TYPE_TRIANGULATION,
+                },
+                .fn = test_io_graph_cache,
+            },
+            {
+                .desc = aven_str("stream K_1"),
+                .args = &(TestIoStreamArgs){
+                    .size = 1,
+                    .type = TEST_GEN_GRAPH_TYPE_COMPLETE,
+                    .chunk_len = 4,
+                    .chunk_nb_len = 8,
+                },
+                .fn = test_io_graph_stream,
+            },
+            {
+                .desc = aven_str("stream K_19 one vertex per chunk"),
+                .args = &(TestIoStreamArgs){
+                    .size = 19,
+                    .type = TEST_GEN_GRAPH_TYPE_COMPLETE,
+                    .chunk_len = 5,
+                    .chunk_nb_len = 18,
+                },
+                .fn = test_io_graph_stream,
+            },
+            {
+                .desc = aven_str("stream 31x31 grid"),
+                .args = &(TestIoStreamArgs){
+                    .size = 31,
+                    .type = TEST_GEN_GRAPH_TYPE_GRID,
+                    .chunk_len = 64,
+                    .chunk_nb_len = 100,
+                },
+                .fn = test_io_graph_stream,
+            },
+            {
+                .desc = aven_str("stream pyramid A_9"),
+                .args = &(TestIoStreamArgs){
+                    .size = 9,
+                    .type = TEST_GEN_GRAPH_TYPE_PYRAMID,
+                    .chunk_len = 16,
+                    .chunk_nb_len = 4096,
+                },
+                .fn = test_io_graph_stream,
+            },
+            {
+                .desc = aven_str("stream chunk with too many vertices"),
+                .args = &(TestIoStreamOversizeArgs){
+                    .len = (uint64_t)1 << 40,
+                    .nb_len = 1,
+                },
+                .fn = test_io_graph_stream_oversize,
+            },
+            {
+                .desc = aven_str("stream chunk with too many half-edges"),
+                .args = &(TestIoStreamOversizeArgs){
+                    .len = 1,
+                    .nb_len = (uint64_t)1 << 40,
+                },
+                .fn = test_io_graph_stream_oversize,
+            },
+            {
+                .desc = aven_str("validate K_19 w/3 threads"),
+                .args = &(TestIoValidateArgs){
+                    .size = 19,
+                    .type = TEST_GEN_GRAPH_TYPE_COMPLETE,
+                    .mutation = TEST_IO_VALIDATE_MUTATION_NONE,
+                    .nthreads = 3,
+                },
+                .fn = test_io_graph_validate_thread,
+            },
+            {
+                .desc = aven_str(
+                    "validate order 1119 triangulation w/4 threads"
+                ),
+                .args = &(TestIoValidateArgs){
+                    .size = 1119,
+                    .type = TEST_GEN_GRAPH_TYPE_TRIANGULATION,
+                    .mutation = TEST_IO_VALIDATE_MUTATION_NONE,
+                    .nthreads = 4,
+                },
+                .fn = test_io_graph_validate_thread,
+            },
+            {
+                .desc = aven_str(
+                    "validate 31x31 grid out of range neighbor w/4 threads"
+                ),
+                .args = &(TestIoValidateArgs){
+                    .size = 31,
+                    .type = TEST_GEN_GRAPH_TYPE_GRID,
+                    .mutation = TEST_IO_VALIDATE_MUTATION_OUT_OF_RANGE,
+                    .nthreads = 4,
+                },
+                .fn = test_io_graph_validate_thread,
+            },
+            {
+                .desc = aven_str(
+                    "validate pyramid A_9 repeated neighbor w/3 threads"
+                ),
+                .args = &(TestIoValidateArgs){
+                    .size = 9,
+                    .type = TEST_GEN_GRAPH_TYPE_PYRAMID,
+                    .mutation = TEST_IO_VALIDATE_MUTATION_REPEATED,
+                    .nthreads = 3,
+                },
+                .fn = test_io_graph_validate_thread,
+            },
+            {
+                .desc = aven_str(
+                    "validate order 1119 triangulation asymmetric w/4 threads"
+                ),
+                .args = &(TestIoValidateArgs){
+                    .size = 1119,
+                    .type = TEST_GEN_GRAPH_TYPE_TRIANGULATION,
+                    .mutation = TEST_IO_VALIDATE_MUTATION_ASYMMETRIC,
+                    .nthreads = 4,
+                },
+                .fn = test_io_graph_validate_thread,
+            },
+            {
+                .desc = aven_str("validate 31x31 grid asymmetric w/1 thread"),
+                .args = &(TestIoValidateArgs){
+                    .size = 31,
+                    .type = TEST_GEN_GRAPH_TYPE_GRID,
+                    .mutation = TEST_IO_VALIDATE_MUTATION_ASYMMETRIC,
+                    .nthreads = 1,
+                },
+                .fn = test_io_graph_validate_thread,
+            },
+            {
+                .desc = aven_str("import edge list 31x31 grid"),
+                .args = &(TestIoImportArgs){
+                    .size = 31,
+                    .type = TEST_GEN_GRAPH_TYPE_GRID,
+                    .format = GRAPH_IO_IMPORT_FORMAT_EDGE_LIST,
+                },
+                .fn = test_io_graph_import_text,
+            },
+            {
+                .desc = aven_str("import edge list pyramid A_9"),
+                .args = &(TestIoImportArgs){
+                    .size = 9,
+                    .type = TEST_GEN_GRAPH_TYPE_PYRAMID,
+                    .format = GRAPH_IO_IMPORT_FORMAT_EDGE_LIST,
+                },
+                .fn = test_io_graph_import_text,
+            },
+            {
+                .desc = aven_str("import DIMACS K_19"),
+                .args = &(TestIoImportArgs){
+                    .size = 19,
+                    .type = TEST_GEN_GRAPH_TYPE_COMPLETE,
+                    .format = GRAPH_IO_IMPORT_FORMAT_DIMACS,
+                },
+                .fn = test_io_graph_import_text,
+            },
+            {
+                .desc = aven_str("import DIMACS K_1"),
+                .args = &(TestIoImportArgs){
+                    .size = 1,
+                    .type = TEST_GEN_GRAPH_TYPE_COMPLETE,
+                    .format = GRAPH_IO_IMPORT_FORMAT_DIMACS,
+                },
+                .fn = test_io_graph_import_text,
+            },
+            {
+                .desc = aven_str("import edge list 31x31 grid w/4 threads"),
+                .args = &(TestIoImportArgs){
+                    .size = 31,
+                    .type = TEST_GEN_GRAPH_TYPE_GRID,
+                    .format = GRAPH_IO_IMPORT_FORMAT_EDGE_LIST,
+                    .nthreads = 4,
+                },
+                .fn = test_io_graph_import_text,
+            },
+            {
+                .desc = aven_str(
+                    "import edge list order 1119 triangulation w/3 threads"
+                ),
+                .args = &(TestIoImportArgs){
+                    .size = 1119,
+                    .type = TEST_GEN_GRAPH_TYPE_TRIANGULATION,
+                    .format = GRAPH_IO_IMPORT_FORMAT_EDGE_LIST,
+                    .nthreads = 3,
+                },
+                .fn = test_io_graph_import_text,
+            },
+            {
+                .desc = aven_str("import DIMACS K_19 w/4 threads"),
+                .args = &(TestIoImportArgs){
+                    .size = 19,
+                    .type = TEST_GEN_GRAPH_TYPE_COMPLETE,
+                    .format = GRAPH_IO_IMPORT_FORMAT_DIMACS,
+                    .nthreads = 4,
+                },
+                .fn = test_io_graph_import_text,
+            },
+            {
+                .desc = aven_str("import DIMACS K_1 w/2 threads"),
+                .args = &(TestIoImportArgs){
+                    .size = 1,
+                    .type = TEST_GEN_GRAPH_TYPE_COMPLETE,
+                    .format = GRAPH_IO_IMPORT_FORMAT_DIMACS,
+                    .nthreads = 2,
+                },
+                .fn = test_io_graph_import_text,
+            },
+            {
+                .desc = aven_str("import malformed text"),
+                .fn = test_io_graph_import_errors,
+            },
+            {
+                .desc = aven_str("planar code pyramid A_9"),
+                .args = &(TestIoGraphArgs){
+                    .size = 9,
+                    .type = TEST_GEN_GRAPH_TYPE_PYRAMID,
+                },
+                .fn = test_io_graph_planar_code,
+            },
+            {
+                .desc = aven_str("planar code 31x31 grid"),
+                .args = &(TestIoGraphArgs){
+                    .size = 31,
+                    .type = TEST_GEN_GRAPH_TYPE_GRID,
+                },
+                .fn = test_io_graph_planar_code,
+            },
+            {
+                .desc = aven_str("planar code 31x31 grid w/4 threads"),
+                .args = &(TestIoGraphArgs){
+                    .size = 31,
+                    .type = TEST_GEN_GRAPH_TYPE_GRID,
+                    .nthreads = 4,
+                },
+                .fn = test_io_graph_planar_code,
+            },
+            {
+                .desc = aven_str(
+                    "planar code order 11119 triangulation w/3 threads"
+                ),
+                .args = &(TestIoGraphArgs){
+                    .size = 11119,
+                    .type = TEST_GEN_GRAPH_TYPE_TRIANGULATION,
+                    .nthreads = 3,
+                },
+                .fn = test_io_graph_planar_code,
+            },
         };
         AvenTestCaseSlice tcases = slice_array(tcase_data);
 
@@ -0,0 +1,211 @@
+#ifndef TEST_LCA_H
+    #define TEST_LCA_H
+
+    #include <aven.h>
+    #include <aven/arena.h>
+    #include <aven/fmt.h>
+    #include <aven/test.h>
+
+    #include <graph.h>
+    #include <graph/bfs.h>
+    #include <graph/dfs.h>
+    #include <graph/lca.h>
+
+    #include "gen.h"
+
+    // Check every query against walks up the parent pointers, parent is
+    // indexed like the tree and roots are their own parent
+    static AvenTestResult test_lca_check(
+        AvenArena *emsg_arena,
+        GraphLca lca,
+        GraphPropIndex parent,
+        uint32_t npairs,
+        AvenArena arena
+    ) {
+        GraphIndex n = (GraphIndex)parent.len;
+        GraphPropUint8 marks = aven_arena_create_slice(uint8_t, &arena, n);
+
+        for (uint32_t i = 0; i < npairs; i += 1) {
+            GraphIndex u = (GraphIndex)(((uint64_t)i * 7919) % n);
+            GraphIndex v = (GraphIndex)(((uint64_t)i * 104729 + 13) % n);
+
+            for (GraphIndex w = 0; w < n; w += 1) {
+                get(marks, w) = 0;
+            }
+
+            GraphIndex x = u;
+            GraphIndex depth = 0;
+            while (get(parent, x) != x) {
+                get(marks, x) = 1;
+                x = get(parent, x);
+                depth += 1;
+            }
+            get(marks, x) = 1;
+
+            if (get(lca.depth, u) != depth) {
+                return (AvenTestResult){
+                    .error = 1,
+                    .message = aven_fmt(
+                        emsg_arena,
+                        "expected depth {} for {}, found {}",
+                        aven_fmt_uint(depth),
+                        aven_fmt_uint(u),
+                        aven_fmt_uint(get(lca.depth, u))
+                    ),
+                };
+            }
+
+            GraphIndex expected = v;
+            while (get(marks, expected) == 0) {
+                expected = get(parent, expected);
+            }
+
+            GraphIndex w = graph_lca(lca, u, v);
+            if (w != expected) {
+                return (AvenTestResult){
+                    .error = 1,
+                    .message = aven_fmt(
+                        emsg_arena,
+                        "expected LCA {} of {} and {}, found {}",
+                        aven_fmt_uint(expected),
+                        aven_fmt_uint(u),
+                        aven_fmt_uint(v),
+                        aven_fmt_uint(w)
+                    ),
+                };
+            }
+
+            GraphIndex k = (GraphIndex)(i % (depth + 1));
+            GraphIndex ancestor = u;
+            for (GraphIndex j = 0; j < k; j += 1) {
+                ancestor = get(parent, ancestor);
+            }
+            if (graph_lca_ancestor(lca, u, k) != ancestor) {
+                return (AvenTestResult){
+                    .error = 1,
+                    .message = aven_fmt(
+                        emsg_arena,
+                        "wrong ancestor {} levels above {}",
+                        aven_fmt_uint(k),
+                        aven_fmt_uint(u)
+                    ),
+                };
+            }
+
+            AvenArena temp_arena = arena;
+            GraphSubset path = graph_lca_path(lca, u, v, &temp_arena);
+            bool path_valid = path.len ==
+                graph_lca_dist(lca, u, v) + 1 and
+                get(path, 0) == u and
+                get(path, path.len - 1) == v;
+            for (size_t j = 1; path_valid and j < path.len; j += 1) {
+                GraphIndex a = get(path, j - 1);
+                GraphIndex b = get(path, j);
+                path_valid = get(parent, a) == b or get(parent, b) == a;
+            }
+            if (!path_valid) {
+                return (AvenTestResult){
+                    .error = 1,
+                    .message = aven_fmt(
+                        emsg_arena,
+                        "invalid tree path from {} to {}",
+                        aven_fmt_uint(u),
+                        aven_fmt_uint(v)
+                    ),
+                };
+            }
+        }
+
+        return (AvenTestResult){ 0 };
+    }
+
+    typedef struct {
+        uint32_t size;
+        uint32_t start;
+        uint32_t npairs;
+        TestGenGraphType type;
+        bool dfs;
+    } TestLcaArgs;
+
+    static AvenTestResult test_lca_tree(
+        AvenArena *emsg_arena,
+        AvenArena arena,
+        void *opaque_args
+    ) {
+        TestLcaArgs *args = opaque_args;
+
+        Graph graph = test_gen_graph(args->size, args->type, &arena);
+        GraphPropIndex parent = aven_arena_create_slice(
+            GraphIndex,
+            &arena,
+            graph.adj.len
+        );
+
+        GraphLca lca;
+        if (args->dfs) {
+            GraphDfsData data = graph_dfs(graph, args->start, &arena);
+            for (GraphIndex v = 0; v < parent.len; v += 1) {
+                get(parent, v) = graph_dfs_tree_parent(data.tree, v);
+            }
+            lca = graph_lca_init_dfs(data, &arena);
+        } else {
+            GraphBfsTree tree = graph_bfs(graph, args->start, &arena);
+            for (GraphIndex v = 0; v < parent.len; v += 1) {
+                get(parent, v) = graph_bfs_tree_parent(tree, v);
+            }
+            lca = graph_lca_init_bfs(tree, &arena);
+        }
+
+        return test_lca_check(emsg_arena, lca, parent, args->npairs, arena);
+    }
+
+    static void test_lca(AvenArena arena) {
+        AvenTestCase tcase_data[] = {
+            {
+                .desc = aven_str("BFS K_1"),
+                .args = &(TestLcaArgs){
+                    .size = 1,
+                    .npairs = 1,
+                    .type = TEST_GEN_GRAPH_TYPE_COMPLETE,
+                },
+                .fn = test_lca_tree,
+            },
+            {
+                .desc = aven_str("BFS 31x31 grid start 480"),
+                .args = &(TestLcaArgs){
+                    .size = 31,
+                    .start = 480,
+                    .npairs = 500,
+                    .type = TEST_GEN_GRAPH_TYPE_GRID,
+                },
+                .fn = test_lca_tree,
+            },
+            {
+                .desc = aven_str("DFS 31x31 grid start 0"),
+                .args = &(TestLcaArgs){
+                    .size = 31,
+                    .start = 0,
+                    .npairs = 500,
+                    .type = TEST_GEN_GRAPH_TYPE_GRID,
+                    .dfs = true,
+                },
+                .fn = test_lca_tree,
+            },
+            {
+                .desc = aven_str("DFS order 1119 triangulation start 7"),
+                .args = &(TestLcaArgs){
+                    .size = 1119,
+                    .start = 7,
+                    .npairs = 500,
+                    .type = TEST_GEN_GRAPH_TYPE_TRIANGULATION,
+                    .dfs = true,
+                },
+                .fn = test_lca_tree,
+            },
+        };
+        AvenTestCaseSlice tcases = slice_array(tcase_data);
+
+        aven_test(tcases, arena);
+    }
+
+#endif // TEST_LCA_H
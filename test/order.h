@@ -0,0 +1,272 @@
+#ifndef TEST_ORDER_H
+    #define TEST_ORDER_H
+
+    #include <aven.h>
+    #include <aven/arena.h>
+    #include <aven/math.h>
+    #include <aven/test.h>
+
+    #include <graph.h>
+    #include <graph/order.h>
+    #include <graph/path_color.h>
+    #include <graph/plane/gen.h>
+    #include <graph/plane/order.h>
+    #include <graph/plane/p3color.h>
+
+    #include "gen.h"
+
+    typedef enum {
+        TEST_ORDER_BFS,
+        TEST_ORDER_CUTHILL_MCKEE,
+        TEST_ORDER_DEGREE,
+        TEST_ORDER_HILBERT,
+        TEST_ORDER_MORTON,
+    } TestOrder;
+
+    typedef struct {
+        uint32_t size;
+        TestGenGraphType type;
+        TestOrder order;
+    } TestOrderArgs;
+
+    static AvenTestResult test_order_graph(
+        AvenArena *emsg_arena,
+        AvenArena arena,
+        void *opaque_args
+    ) {
+        (void)emsg_arena;
+        TestOrderArgs *args = opaque_args;
+
+        Graph graph;
+        GraphPlaneEmbedding embedding = { 0 };
+        if (
+            args->order == TEST_ORDER_HILBERT or
+            args->order == TEST_ORDER_MORTON
+        ) {
+            assert(args->type == TEST_GEN_GRAPH_TYPE_PYRAMID);
+            Aff2 ident;
+            aff2_identity(ident);
+            GraphPlaneGenData data = graph_plane_gen_pyramid(
+                args->size,
+                ident,
+                0.0f,
+                &arena
+            );
+            graph = data.graph;
+            embedding = data.embedding;
+        } else {
+            graph = test_gen_graph(args->size, args->type, &arena);
+        }
+
+        GraphPerm perm;
+        switch (args->order) {
+            case TEST_ORDER_BFS:
+                perm = graph_order_bfs(graph, 0, &arena);
+                break;
+            case TEST_ORDER_CUTHILL_MCKEE:
+                perm = graph_order_cuthill_mckee(graph, 0, &arena);
+                break;
+            case TEST_ORDER_DEGREE:
+                perm = graph_order_degree(graph, &arena);
+                break;
+            case TEST_ORDER_HILBERT:
+                perm = graph_plane_order_hilbert(embedding, &arena);
+                break;
+            case TEST_ORDER_MORTON:
+                perm = graph_plane_order_morton(embedding, &arena);
+                break;
+            default:
+                assert(false);
+                perm = (GraphPerm){ 0 };
+                break;
+        }
+
+        if (
+            perm.forward.len != graph.adj.len or
+            perm.inverse.len != graph.adj.len
+        ) {
+            return (AvenTestResult){
+                .error = 1,
+                .message = aven_str("permutation has the wrong length"),
+            };
+        }
+
+        for (uint32_t i = 0; i < perm.inverse.len; i += 1) {
+            GraphIndex v = get(perm.inverse, i);
+            if (v >= perm.forward.len or get(perm.forward, v) != i) {
+                return (AvenTestResult){
+                    .error = 1,
+                    .message = aven_str("forward and inverse do not match"),
+                };
+            }
+        }
+
+        Graph new_graph = graph_relabel(graph, perm, &arena);
+        GraphAug new_aug_graph = graph_aug_relabel(
+            graph_aug(graph, &arena),
+            perm,
+            &arena
+        );
+
+        for (uint32_t v = 0; v < graph.adj.len; v += 1) {
+            GraphIndex new_v = get(perm.forward, v);
+            GraphAdj v_adj = get(graph.adj, v);
+            GraphAdj new_v_adj = get(new_graph.adj, new_v);
+            GraphAdj new_v_aug_adj = get(new_aug_graph.adj, new_v);
+
+            if (new_v_adj.len != v_adj.len or new_v_aug_adj.len != v_adj.len) {
+                return (AvenTestResult){
+                    .error = 1,
+                    .message = aven_str("relabeled degree mismatch"),
+                };
+            }
+
+            for (uint32_t i = 0; i < v_adj.len; i += 1) {
+                GraphIndex new_u = get(
+                    perm.forward,
+                    graph_nb(graph.nb, v_adj, i)
+                );
+                if (graph_nb(new_graph.nb, new_v_adj, i) != new_u) {
+                    return (AvenTestResult){
+                        .error = 1,
+                        .message = aven_str("relabeled rotation mismatch"),
+                    };
+                }
+
+                GraphAugNb vu = graph_aug_nb(
+                    new_aug_graph.nb,
+                    new_v_aug_adj,
+                    i
+                );
+                GraphAugNb uv = graph_aug_nb(
+                    new_aug_graph.nb,
+                    get(new_aug_graph.adj, vu.vertex),
+                    vu.back_index
+                );
+                if (vu.vertex != new_u or uv.vertex != new_v) {
+                    return (AvenTestResult){
+                        .error = 1,
+                        .message = aven_str("relabeled back index mismatch"),
+                    };
+                }
+            }
+        }
+
+        if (
+            args->type == TEST_GEN_GRAPH_TYPE_PYRAMID or
+            args->type == TEST_GEN_GRAPH_TYPE_TRIANGULATION
+        ) {
+            GraphSubset p1 = graph_perm_subset(
+                (GraphSubset)slice_array((GraphIndex[]){ 0 }),
+                perm,
+                &arena
+            );
+            GraphSubset p2 = graph_perm_subset(
+                (GraphSubset)slice_array((GraphIndex[]){ 2, 1 }),
+                perm,
+                &arena
+            );
+            GraphPropUint8 new_coloring = graph_plane_p3color(
+                new_graph,
+                p1,
+                p2,
+                &arena
+            );
+            GraphPropUint8 coloring = graph_perm_prop_uint8(
+                new_coloring,
+                graph_perm_invert(perm),
+                &arena
+            );
+
+            if (!graph_path_color_verify(graph, coloring, arena)) {
+                return (AvenTestResult){
+                    .error = 1,
+                    .message = aven_str("invalid path coloring"),
+                };
+            }
+        }
+
+        return (AvenTestResult){ 0 };
+    }
+
+    static void test_order(AvenArena arena) {
+        AvenTestCase tcase_data[] = {
+            {
+                .desc = aven_str("bfs order 4x4 grid"),
+                .args = &(TestOrderArgs){
+                    .size = 4,
+                    .type = TEST_GEN_GRAPH_TYPE_GRID,
+                    .order = TEST_ORDER_BFS,
+                },
+                .fn = test_order_graph,
+            },
+            {
+                .desc = aven_str("bfs order order 119 triangulation"),
+                .args = &(TestOrderArgs){
+                    .size = 119,
+                    .type = TEST_GEN_GRAPH_TYPE_TRIANGULATION,
+                    .order = TEST_ORDER_BFS,
+                },
+                .fn = test_order_graph,
+            },
+            {
+                .desc = aven_str("cuthill-mckee order pyramid A_5"),
+                .args = &(TestOrderArgs){
+                    .size = 5,
+                    .type = TEST_GEN_GRAPH_TYPE_PYRAMID,
+                    .order = TEST_ORDER_CUTHILL_MCKEE,
+                },
+                .fn = test_order_graph,
+            },
+            {
+                .desc = aven_str("cuthill-mckee order order 119 triangulation"),
+                .args = &(TestOrderArgs){
+                    .size = 119,
+                    .type = TEST_GEN_GRAPH_TYPE_TRIANGULATION,
+                    .order = TEST_ORDER_CUTHILL_MCKEE,
+                },
+                .fn = test_order_graph,
+            },
+            {
+                .desc = aven_str("degree order pyramid A_19"),
+                .args = &(TestOrderArgs){
+                    .size = 19,
+                    .type = TEST_GEN_GRAPH_TYPE_PYRAMID,
+                    .order = TEST_ORDER_DEGREE,
+                },
+                .fn = test_order_graph,
+            },
+            {
+                .desc = aven_str("degree order order 1119 triangulation"),
+                .args = &(TestOrderArgs){
+                    .size = 1119,
+                    .type = TEST_GEN_GRAPH_TYPE_TRIANGULATION,
+                    .order = TEST_ORDER_DEGREE,
+                },
+                .fn = test_order_graph,
+            },
+            {
+                .desc = aven_str("hilbert order pyramid A_19"),
+                .args = &(TestOrderArgs){
+                    .size = 19,
+                    .type = TEST_GEN_GRAPH_TYPE_PYRAMID,
+                    .order = TEST_ORDER_HILBERT,
+                },
+                .fn = test_order_graph,
+            },
+            {
+                .desc = aven_str("morton order pyramid A_19"),
+                .args = &(TestOrderArgs){
+                    .size = 19,
+                    .type = TEST_GEN_GRAPH_TYPE_PYRAMID,
+                    .order = TEST_ORDER_MORTON,
+                },
+                .fn = test_order_graph,
+            },
+        };
+        AvenTestCaseSlice tcases = slice_array(tcase_data);
+
+        aven_test(tcases, arena);
+    }
+
+#endif // TEST_ORDER_H
@@ -3,11 +3,15 @@
 
     #include <aven.h>
     #include <aven/arena.h>
+    #include <aven/rng.h>
+    #include <aven/rng/pcg.h>
     #include <aven/test.h>
+    #include <aven/thread/pool.h>
 
     #include <graph.h>
     #include <graph/path_color.h>
     #include <graph/plane/p3choose.h>
+    #include <graph/plane/p3choose/thread.h>
 
     #include "gen.h"
 
@@ -57,6 +61,144 @@
             };
         }
 
+        // The same engine driven in small slices must give the same coloring
+        GraphPlaneP3ChooseCtx ctx = graph_plane_p3choose_init(
+            aug_graph,
+            args->list_assignment,
+            args->outer_face,
+            &arena
+        );
+        GraphPlaneP3ChooseFrameOptional frame = { 0 };
+        while (!graph_plane_p3choose_run(&ctx, &frame, 3)) {}
+
+        for (GraphIndex v = 0; v < coloring.len; v += 1) {
+            GraphPlaneP3ChooseList v_colors = get(ctx.colors, v);
+            if (v_colors.len != 1 or get(v_colors, 0) != get(coloring, v)) {
+                return (AvenTestResult){
+                    .error = 1,
+                    .message = aven_str("budgeted run changed the coloring"),
+                };
+            }
+        }
+
+        GraphPathColorVerifyCtx verify_ctx = graph_path_color_verify_init(
+            graph,
+            coloring,
+            &arena
+        );
+        while (!graph_path_color_verify_run(&verify_ctx, 3)) {}
+        if (!graph_path_color_verify_result(&verify_ctx)) {
+            return (AvenTestResult){
+                .error = 1,
+                .message = aven_str("budgeted verification failed"),
+            };
+        }
+
+        return (AvenTestResult){ 0 };
+    }
+
+    typedef struct {
+        uint32_t size;
+        size_t nthreads;
+        // pool workers, defaults to nthreads - 1 when zero
+        size_t nworkers;
+    } TestP3ChooseThreadArgs;
+
+    static AvenTestResult test_p3choose_thread(
+        AvenArena *emsg_arena,
+        AvenArena arena,
+        void *opaque_args
+    ) {
+        (void)emsg_arena;
+        TestP3ChooseThreadArgs *args = opaque_args;
+
+        Graph graph = test_gen_graph(
+            args->size,
+            TEST_GEN_GRAPH_TYPE_TRIANGULATION,
+            &arena
+        );
+        GraphAug aug_graph = graph_aug(graph, &arena);
+        GraphSubset outer_face = slice_array((GraphIndex[]){ 0, 1, 2 });
+
+        AvenRngPcg pcg = aven_rng_pcg_seed(0xcafe, 0xf00d);
+        AvenRng rng = aven_rng_pcg(&pcg);
+
+        GraphPlaneP3ChooseListProp color_lists = { .len = graph.adj.len };
+        color_lists.ptr = aven_arena_create_array(
+            GraphPlaneP3ChooseList,
+            &arena,
+            color_lists.len
+        );
+        for (GraphIndex v = 0; v < color_lists.len; v += 1) {
+            GraphPlaneP3ChooseList list = { .len = 3 };
+            for (size_t i = 0; i < list.len; i += 1) {
+                bool repeat = true;
+                while (repeat) {
+                    get(list, i) = (uint8_t)(
+                        1 + aven_rng_rand_bounded(rng, 6)
+                    );
+                    repeat = false;
+                    for (size_t j = 0; j < i; j += 1) {
+                        repeat = repeat or get(list, j) == get(list, i);
+                    }
+                }
+            }
+            get(color_lists, v) = list;
+        }
+
+        size_t nworkers = args->nworkers;
+        if (nworkers == 0) {
+            nworkers = args->nthreads - 1;
+        }
+        AvenThreadPool thread_pool = aven_thread_pool_init(
+            nworkers,
+            args->nthreads - 1,
+            &arena
+        );
+        aven_thread_pool_run(&thread_pool);
+
+        GraphPropUint8 coloring = graph_plane_p3choose_thread(
+            aug_graph,
+            color_lists,
+            outer_face,
+            &thread_pool,
+            args->nthreads,
+            &arena
+        );
+
+        aven_thread_pool_halt_and_destroy(&thread_pool);
+
+        if (!graph_plane_p3choose_verify_list_coloring(color_lists, coloring)) {
+            return (AvenTestResult){
+                .error = 1,
+                .message = aven_str("invalid list coloring"),
+            };
+        }
+
+        if (!graph_path_color_verify(graph, coloring, arena)) {
+            return (AvenTestResult){
+                .error = 1,
+                .message = aven_str("invalid path coloring"),
+            };
+        }
+
+        GraphPropUint8 seq_coloring = graph_plane_p3choose(
+            aug_graph,
+            color_lists,
+            outer_face,
+            &arena
+        );
+        for (GraphIndex v = 0; v < coloring.len; v += 1) {
+            if (get(coloring, v) != get(seq_coloring, v)) {
+                return (AvenTestResult){
+                    .error = 1,
+                    .message = aven_str(
+                        "threaded coloring differs from sequential"
+                    ),
+                };
+            }
+        }
+
         return (AvenTestResult){ 0 };
     }
 
@@ -67,7 +209,7 @@
                 .args = &(TestP3ChooseArgs){
                     .size = 3,
                     .type = TEST_GEN_GRAPH_TYPE_COMPLETE,
-                    .outer_face = slice_array((uint32_t[]){ 0, 1, 2 }),
+                    .outer_face = slice_array((GraphIndex[]){ 0, 1, 2 }),
                     .list_assignment = slice_array(
                         (GraphPlaneP3ChooseList[]){
                             { .len = 2, .ptr = { 1, 2 } },
@@ -83,7 +225,7 @@
                 .args = &(TestP3ChooseArgs){
                     .size = 4,
                     .type = TEST_GEN_GRAPH_TYPE_COMPLETE,
-                    .outer_face = slice_array((uint32_t[]){ 0, 1, 3 }),
+                    .outer_face = slice_array((GraphIndex[]){ 0, 1, 3 }),
                     .list_assignment = slice_array(
                         (GraphPlaneP3ChooseList[]){
                             { .len = 2, .ptr = { 1, 2 } },
@@ -100,7 +242,7 @@
                 .args = &(TestP3ChooseArgs){
                     .size = 5,
                     .type = TEST_GEN_GRAPH_TYPE_PYRAMID,
-                    .outer_face = slice_array((uint32_t[]){ 0, 1, 2 }),
+                    .outer_face = slice_array((GraphIndex[]){ 0, 1, 2 }),
                     .list_assignment = slice_array(
                         (GraphPlaneP3ChooseList[]){
                             { .len = 2, .ptr = { 1, 2 } },
@@ -131,7 +273,7 @@
                 .args = &(TestP3ChooseArgs){
                     .size = 18,
                     .type = TEST_GEN_GRAPH_TYPE_TRIANGULATION,
-                    .outer_face = slice_array((uint32_t[]){ 0, 1, 2 }),
+                    .outer_face = slice_array((GraphIndex[]){ 0, 1, 2 }),
                     .list_assignment = slice_array(
                         (GraphPlaneP3ChooseList[]){
                             { .len = 2, .ptr = { 1, 2 } },
@@ -157,6 +299,37 @@
                 },
                 .fn = test_p3choose_graph,
             },
+            {
+                .desc = aven_str(
+                    "path choose order 18 triangulation w/2 threads"
+                ),
+                .args = &(TestP3ChooseThreadArgs){
+                    .size = 18,
+                    .nthreads = 2,
+                },
+                .fn = test_p3choose_thread,
+            },
+            {
+                .desc = aven_str(
+                    "path choose order 1119 triangulation w/4 threads 1 worker"
+                ),
+                .args = &(TestP3ChooseThreadArgs){
+                    .size = 1119,
+                    .nthreads = 4,
+                    .nworkers = 1,
+                },
+                .fn = test_p3choose_thread,
+            },
+            {
+                .desc = aven_str(
+                    "path choose order 5119 triangulation w/8 threads"
+                ),
+                .args = &(TestP3ChooseThreadArgs){
+                    .size = 5119,
+                    .nthreads = 8,
+                },
+                .fn = test_p3choose_thread,
+            },
         };
         AvenTestCaseSlice tcases = slice_array(tcase_data);
 
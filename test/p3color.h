@@ -4,25 +4,39 @@
     #include <aven.h>
     #include <aven/arena.h>
     #include <aven/test.h>
+    #include <aven/thread/pool.h>
 
     #include <graph.h>
     #include <graph/path_color.h>
     #include <graph/plane/p3color.h>
     #include <graph/plane/p3color_bfs.h>
+    #include <graph/plane/p3color/thread.h>
 
     #include "gen.h"
 
     typedef enum {
         TEST_P3COLOR_ALG_BFS,
         TEST_P3COLOR_ALG_TRACE,
+        TEST_P3COLOR_ALG_AUG,
+        TEST_P3COLOR_ALG_SMALL_AUG,
+        TEST_P3COLOR_ALG_BFS_RUN,
+        TEST_P3COLOR_ALG_TRACE_RUN,
+        TEST_P3COLOR_ALG_THREAD,
+        TEST_P3COLOR_ALG_THREAD_AUG,
     } TestP3ColorAlg;
 
+    // Drive the engines in small slices through the budgeted run functions
+    #define TEST_P3COLOR_RUN_BUDGET 5
+
     typedef struct {
         uint32_t size;
         GraphSubset p1;
         GraphSubset p2;
         TestGenGraphType type;
         TestP3ColorAlg alg;
+        size_t nthreads;
+        // pool workers, defaults to nthreads - 1 when zero
+        size_t nworkers;
     } TestP3ColorArgs;
 
     static AvenTestResult test_p3color_graph(
@@ -53,6 +67,133 @@
                     &arena
                 );
                 break;
+            case TEST_P3COLOR_ALG_AUG:
+                coloring = graph_plane_p3color_aug(
+                    graph_aug(graph, &arena),
+                    args->p1,
+                    args->p2,
+                    &arena
+                );
+                break;
+            case TEST_P3COLOR_ALG_SMALL_AUG:
+                coloring = graph_plane_p3color_small_aug(
+                    graph_small_aug(graph_aug(graph, &arena), &arena),
+                    args->p1,
+                    args->p2,
+                    &arena
+                );
+                break;
+            case TEST_P3COLOR_ALG_BFS_RUN: {
+                GraphPlaneP3ColorCtx ctx = graph_plane_p3color_init(
+                    graph,
+                    args->p1,
+                    args->p2,
+                    &arena
+                );
+                GraphPlaneP3ColorFrameOptional frame = { 0 };
+                while (
+                    !graph_plane_p3color_run(
+                        &ctx,
+                        &frame,
+                        TEST_P3COLOR_RUN_BUDGET
+                    )
+                ) {}
+                coloring = (GraphPropUint8){ .len = graph.adj.len };
+                coloring.ptr = aven_arena_create_array(
+                    uint8_t,
+                    &arena,
+                    coloring.len
+                );
+                for (GraphIndex v = 0; v < coloring.len; v += 1) {
+                    get(coloring, v) = (uint8_t)get(ctx.marks, v);
+                }
+                break;
+            }
+            case TEST_P3COLOR_ALG_TRACE_RUN: {
+                GraphPlaneP3ColorBfsCtx ctx = graph_plane_p3color_bfs_init(
+                    graph,
+                    args->p1,
+                    args->p2,
+                    &arena
+                );
+                GraphPlaneP3ColorBfsQueue bfs_queue = aven_arena_create_queue(
+                    GraphIndex,
+                    &arena,
+                    graph.adj.len
+                );
+                GraphPlaneP3ColorBfsFrameOptional frame = { 0 };
+                while (
+                    !graph_plane_p3color_bfs_run(
+                        &ctx,
+                        &frame,
+                        &bfs_queue,
+                        TEST_P3COLOR_RUN_BUDGET
+                    )
+                ) {}
+                coloring = (GraphPropUint8){ .len = graph.adj.len };
+                coloring.ptr = aven_arena_create_array(
+                    uint8_t,
+                    &arena,
+                    coloring.len
+                );
+                for (GraphIndex v = 0; v < coloring.len; v += 1) {
+                    get(coloring, v) = (uint8_t)get(ctx.marks, v);
+                }
+                break;
+            }
+            case TEST_P3COLOR_ALG_THREAD:
+            case TEST_P3COLOR_ALG_THREAD_AUG: {
+                size_t nworkers = args->nworkers;
+                if (nworkers == 0) {
+                    nworkers = args->nthreads - 1;
+                }
+                AvenThreadPool thread_pool = aven_thread_pool_init(
+                    nworkers,
+                    args->nthreads - 1,
+                    &arena
+                );
+                aven_thread_pool_run(&thread_pool);
+
+                if (args->alg == TEST_P3COLOR_ALG_THREAD_AUG) {
+                    coloring = graph_plane_p3color_thread_aug(
+                        graph_aug(graph, &arena),
+                        args->p1,
+                        args->p2,
+                        &thread_pool,
+                        args->nthreads,
+                        &arena
+                    );
+                } else {
+                    coloring = graph_plane_p3color_thread(
+                        graph,
+                        args->p1,
+                        args->p2,
+                        &thread_pool,
+                        args->nthreads,
+                        &arena
+                    );
+                }
+
+                aven_thread_pool_halt_and_destroy(&thread_pool);
+
+                GraphPropUint8 seq_coloring = graph_plane_p3color(
+                    graph,
+                    args->p1,
+                    args->p2,
+                    &arena
+                );
+                for (GraphIndex v = 0; v < coloring.len; v += 1) {
+                    if (get(coloring, v) != get(seq_coloring, v)) {
+                        return (AvenTestResult){
+                            .error = 1,
+                            .message = aven_str(
+                                "threaded coloring differs from sequential"
+                            ),
+                        };
+                    }
+                }
+                break;
+            }
         }
 
         if (!graph_path_color_verify(graph, coloring, arena)) {
@@ -73,8 +214,8 @@
                     .size = 3,
                     .type = TEST_GEN_GRAPH_TYPE_COMPLETE,
                     .alg = TEST_P3COLOR_ALG_BFS,
-                    .p1 = slice_array((uint32_t[]){ 0 }),
-                    .p2 = slice_array((uint32_t[]){ 2, 1 }),
+                    .p1 = slice_array((GraphIndex[]){ 0 }),
+                    .p2 = slice_array((GraphIndex[]){ 2, 1 }),
                 },
                 .fn = test_p3color_graph,
             },
@@ -84,8 +225,8 @@
                     .size = 4,
                     .type = TEST_GEN_GRAPH_TYPE_COMPLETE,
                     .alg = TEST_P3COLOR_ALG_BFS,
-                    .p1 = slice_array((uint32_t[]){ 0 }),
-                    .p2 = slice_array((uint32_t[]){ 3, 1 }),
+                    .p1 = slice_array((GraphIndex[]){ 0 }),
+                    .p2 = slice_array((GraphIndex[]){ 3, 1 }),
                 },
                 .fn = test_p3color_graph,
             },
@@ -95,8 +236,8 @@
                     .size = 5,
                     .type = TEST_GEN_GRAPH_TYPE_PYRAMID,
                     .alg = TEST_P3COLOR_ALG_BFS,
-                    .p1 = slice_array((uint32_t[]){ 0 }),
-                    .p2 = slice_array((uint32_t[]){ 2, 1 }),
+                    .p1 = slice_array((GraphIndex[]){ 0 }),
+                    .p2 = slice_array((GraphIndex[]){ 2, 1 }),
                 },
                 .fn = test_p3color_graph,
             },
@@ -106,8 +247,8 @@
                     .size = 19,
                     .type = TEST_GEN_GRAPH_TYPE_PYRAMID,
                     .alg = TEST_P3COLOR_ALG_BFS,
-                    .p1 = slice_array((uint32_t[]){ 0 }),
-                    .p2 = slice_array((uint32_t[]){ 2, 1 }),
+                    .p1 = slice_array((GraphIndex[]){ 0 }),
+                    .p2 = slice_array((GraphIndex[]){ 2, 1 }),
                 },
                 .fn = test_p3color_graph,
             },
@@ -117,8 +258,8 @@
                     .size = 9,
                     .type = TEST_GEN_GRAPH_TYPE_TRIANGULATION,
                     .alg = TEST_P3COLOR_ALG_BFS,
-                    .p1 = slice_array((uint32_t[]){ 0 }),
-                    .p2 = slice_array((uint32_t[]){ 2, 1 }),
+                    .p1 = slice_array((GraphIndex[]){ 0 }),
+                    .p2 = slice_array((GraphIndex[]){ 2, 1 }),
                 },
                 .fn = test_p3color_graph,
             },
@@ -128,8 +269,8 @@
                     .size = 19,
                     .type = TEST_GEN_GRAPH_TYPE_TRIANGULATION,
                     .alg = TEST_P3COLOR_ALG_BFS,
-                    .p1 = slice_array((uint32_t[]){ 0 }),
-                    .p2 = slice_array((uint32_t[]){ 2, 1 }),
+                    .p1 = slice_array((GraphIndex[]){ 0 }),
+                    .p2 = slice_array((GraphIndex[]){ 2, 1 }),
                 },
                 .fn = test_p3color_graph,
             },
@@ -139,8 +280,8 @@
                     .size = 119,
                     .type = TEST_GEN_GRAPH_TYPE_TRIANGULATION,
                     .alg = TEST_P3COLOR_ALG_BFS,
-                    .p1 = slice_array((uint32_t[]){ 0 }),
-                    .p2 = slice_array((uint32_t[]){ 2, 1 }),
+                    .p1 = slice_array((GraphIndex[]){ 0 }),
+                    .p2 = slice_array((GraphIndex[]){ 2, 1 }),
                 },
                 .fn = test_p3color_graph,
             },
@@ -150,8 +291,8 @@
                     .size = 1119,
                     .type = TEST_GEN_GRAPH_TYPE_TRIANGULATION,
                     .alg = TEST_P3COLOR_ALG_BFS,
-                    .p1 = slice_array((uint32_t[]){ 0 }),
-                    .p2 = slice_array((uint32_t[]){ 2, 1 }),
+                    .p1 = slice_array((GraphIndex[]){ 0 }),
+                    .p2 = slice_array((GraphIndex[]){ 2, 1 }),
                 },
                 .fn = test_p3color_graph,
             },
@@ -161,8 +302,8 @@
                     .size = 3,
                     .type = TEST_GEN_GRAPH_TYPE_COMPLETE,
                     .alg = TEST_P3COLOR_ALG_TRACE,
-                    .p1 = slice_array((uint32_t[]){ 0 }),
-                    .p2 = slice_array((uint32_t[]){ 2, 1 }),
+                    .p1 = slice_array((GraphIndex[]){ 0 }),
+                    .p2 = slice_array((GraphIndex[]){ 2, 1 }),
                 },
                 .fn = test_p3color_graph,
             },
@@ -172,8 +313,8 @@
                     .size = 4,
                     .type = TEST_GEN_GRAPH_TYPE_COMPLETE,
                     .alg = TEST_P3COLOR_ALG_TRACE,
-                    .p1 = slice_array((uint32_t[]){ 0 }),
-                    .p2 = slice_array((uint32_t[]){ 3, 1 }),
+                    .p1 = slice_array((GraphIndex[]){ 0 }),
+                    .p2 = slice_array((GraphIndex[]){ 3, 1 }),
                 },
                 .fn = test_p3color_graph,
             },
@@ -183,8 +324,8 @@
                     .size = 5,
                     .type = TEST_GEN_GRAPH_TYPE_PYRAMID,
                     .alg = TEST_P3COLOR_ALG_TRACE,
-                    .p1 = slice_array((uint32_t[]){ 0 }),
-                    .p2 = slice_array((uint32_t[]){ 2, 1 }),
+                    .p1 = slice_array((GraphIndex[]){ 0 }),
+                    .p2 = slice_array((GraphIndex[]){ 2, 1 }),
                 },
                 .fn = test_p3color_graph,
             },
@@ -194,8 +335,8 @@
                     .size = 19,
                     .type = TEST_GEN_GRAPH_TYPE_PYRAMID,
                     .alg = TEST_P3COLOR_ALG_TRACE,
-                    .p1 = slice_array((uint32_t[]){ 0 }),
-                    .p2 = slice_array((uint32_t[]){ 2, 1 }),
+                    .p1 = slice_array((GraphIndex[]){ 0 }),
+                    .p2 = slice_array((GraphIndex[]){ 2, 1 }),
                 },
                 .fn = test_p3color_graph,
             },
@@ -205,8 +346,8 @@
                     .size = 9,
                     .type = TEST_GEN_GRAPH_TYPE_TRIANGULATION,
                     .alg = TEST_P3COLOR_ALG_TRACE,
-                    .p1 = slice_array((uint32_t[]){ 0 }),
-                    .p2 = slice_array((uint32_t[]){ 2, 1 }),
+                    .p1 = slice_array((GraphIndex[]){ 0 }),
+                    .p2 = slice_array((GraphIndex[]){ 2, 1 }),
                 },
                 .fn = test_p3color_graph,
             },
@@ -216,8 +357,8 @@
                     .size = 19,
                     .type = TEST_GEN_GRAPH_TYPE_TRIANGULATION,
                     .alg = TEST_P3COLOR_ALG_TRACE,
-                    .p1 = slice_array((uint32_t[]){ 0 }),
-                    .p2 = slice_array((uint32_t[]){ 2, 1 }),
+                    .p1 = slice_array((GraphIndex[]){ 0 }),
+                    .p2 = slice_array((GraphIndex[]){ 2, 1 }),
                 },
                 .fn = test_p3color_graph,
             },
@@ -227,8 +368,8 @@
                     .size = 119,
                     .type = TEST_GEN_GRAPH_TYPE_TRIANGULATION,
                     .alg = TEST_P3COLOR_ALG_TRACE,
-                    .p1 = slice_array((uint32_t[]){ 0 }),
-                    .p2 = slice_array((uint32_t[]){ 2, 1 }),
+                    .p1 = slice_array((GraphIndex[]){ 0 }),
+                    .p2 = slice_array((GraphIndex[]){ 2, 1 }),
                 },
                 .fn = test_p3color_graph,
             },
@@ -238,8 +379,207 @@
                     .size = 1119,
                     .type = TEST_GEN_GRAPH_TYPE_TRIANGULATION,
                     .alg = TEST_P3COLOR_ALG_TRACE,
-                    .p1 = slice_array((uint32_t[]){ 0 }),
-                    .p2 = slice_array((uint32_t[]){ 2, 1 }),
+                    .p1 = slice_array((GraphIndex[]){ 0 }),
+                    .p2 = slice_array((GraphIndex[]){ 2, 1 }),
+                },
+                .fn = test_p3color_graph,
+            },
+            {
+                .desc = aven_str("path color K_3 w/aug"),
+                .args = &(TestP3ColorArgs){
+                    .size = 3,
+                    .type = TEST_GEN_GRAPH_TYPE_COMPLETE,
+                    .alg = TEST_P3COLOR_ALG_AUG,
+                    .p1 = slice_array((GraphIndex[]){ 0 }),
+                    .p2 = slice_array((GraphIndex[]){ 2, 1 }),
+                },
+                .fn = test_p3color_graph,
+            },
+            {
+                .desc = aven_str("path color K_4 w/aug"),
+                .args = &(TestP3ColorArgs){
+                    .size = 4,
+                    .type = TEST_GEN_GRAPH_TYPE_COMPLETE,
+                    .alg = TEST_P3COLOR_ALG_AUG,
+                    .p1 = slice_array((GraphIndex[]){ 0 }),
+                    .p2 = slice_array((GraphIndex[]){ 3, 1 }),
+                },
+                .fn = test_p3color_graph,
+            },
+            {
+                .desc = aven_str("path color pyramid A_19 w/aug"),
+                .args = &(TestP3ColorArgs){
+                    .size = 19,
+                    .type = TEST_GEN_GRAPH_TYPE_PYRAMID,
+                    .alg = TEST_P3COLOR_ALG_AUG,
+                    .p1 = slice_array((GraphIndex[]){ 0 }),
+                    .p2 = slice_array((GraphIndex[]){ 2, 1 }),
+                },
+                .fn = test_p3color_graph,
+            },
+            {
+                .desc = aven_str("path color order 119 triangulation w/aug"),
+                .args = &(TestP3ColorArgs){
+                    .size = 119,
+                    .type = TEST_GEN_GRAPH_TYPE_TRIANGULATION,
+                    .alg = TEST_P3COLOR_ALG_AUG,
+                    .p1 = slice_array((GraphIndex[]){ 0 }),
+                    .p2 = slice_array((GraphIndex[]){ 2, 1 }),
+                },
+                .fn = test_p3color_graph,
+            },
+            {
+                .desc = aven_str("path color order 1119 triangulation w/aug"),
+                .args = &(TestP3ColorArgs){
+                    .size = 1119,
+                    .type = TEST_GEN_GRAPH_TYPE_TRIANGULATION,
+                    .alg = TEST_P3COLOR_ALG_AUG,
+                    .p1 = slice_array((GraphIndex[]){ 0 }),
+                    .p2 = slice_array((GraphIndex[]){ 2, 1 }),
+                },
+                .fn = test_p3color_graph,
+            },
+            {
+                .desc = aven_str("path color order 11119 triangulation"),
+                .args = &(TestP3ColorArgs){
+                    .size = 11119,
+                    .type = TEST_GEN_GRAPH_TYPE_TRIANGULATION,
+                    .alg = TEST_P3COLOR_ALG_BFS,
+                    .p1 = slice_array((GraphIndex[]){ 0 }),
+                    .p2 = slice_array((GraphIndex[]){ 2, 1 }),
+                },
+                .fn = test_p3color_graph,
+            },
+            {
+                .desc = aven_str("path color K_4 w/small aug"),
+                .args = &(TestP3ColorArgs){
+                    .size = 4,
+                    .type = TEST_GEN_GRAPH_TYPE_COMPLETE,
+                    .alg = TEST_P3COLOR_ALG_SMALL_AUG,
+                    .p1 = slice_array((GraphIndex[]){ 0 }),
+                    .p2 = slice_array((GraphIndex[]){ 3, 1 }),
+                },
+                .fn = test_p3color_graph,
+            },
+            {
+                .desc = aven_str(
+                    "path color order 1119 triangulation w/small aug"
+                ),
+                .args = &(TestP3ColorArgs){
+                    .size = 1119,
+                    .type = TEST_GEN_GRAPH_TYPE_TRIANGULATION,
+                    .alg = TEST_P3COLOR_ALG_SMALL_AUG,
+                    .p1 = slice_array((GraphIndex[]){ 0 }),
+                    .p2 = slice_array((GraphIndex[]){ 2, 1 }),
+                },
+                .fn = test_p3color_graph,
+            },
+            {
+                .desc = aven_str(
+                    "path color order 1119 triangulation w/BFS in slices"
+                ),
+                .args = &(TestP3ColorArgs){
+                    .size = 1119,
+                    .type = TEST_GEN_GRAPH_TYPE_TRIANGULATION,
+                    .alg = TEST_P3COLOR_ALG_BFS_RUN,
+                    .p1 = slice_array((GraphIndex[]){ 0 }),
+                    .p2 = slice_array((GraphIndex[]){ 2, 1 }),
+                },
+                .fn = test_p3color_graph,
+            },
+            {
+                .desc = aven_str(
+                    "path color order 1119 triangulation w/trace in slices"
+                ),
+                .args = &(TestP3ColorArgs){
+                    .size = 1119,
+                    .type = TEST_GEN_GRAPH_TYPE_TRIANGULATION,
+                    .alg = TEST_P3COLOR_ALG_TRACE_RUN,
+                    .p1 = slice_array((GraphIndex[]){ 0 }),
+                    .p2 = slice_array((GraphIndex[]){ 2, 1 }),
+                },
+                .fn = test_p3color_graph,
+            },
+            {
+                .desc = aven_str("path color K_4 w/2 threads"),
+                .args = &(TestP3ColorArgs){
+                    .size = 4,
+                    .type = TEST_GEN_GRAPH_TYPE_COMPLETE,
+                    .alg = TEST_P3COLOR_ALG_THREAD,
+                    .nthreads = 2,
+                    .p1 = slice_array((GraphIndex[]){ 0 }),
+                    .p2 = slice_array((GraphIndex[]){ 3, 1 }),
+                },
+                .fn = test_p3color_graph,
+            },
+            {
+                .desc = aven_str(
+                    "path color order 1119 triangulation w/4 threads"
+                ),
+                .args = &(TestP3ColorArgs){
+                    .size = 1119,
+                    .type = TEST_GEN_GRAPH_TYPE_TRIANGULATION,
+                    .alg = TEST_P3COLOR_ALG_THREAD,
+                    .nthreads = 4,
+                    .p1 = slice_array((GraphIndex[]){ 0 }),
+                    .p2 = slice_array((GraphIndex[]){ 2, 1 }),
+                },
+                .fn = test_p3color_graph,
+            },
+            {
+                .desc = aven_str(
+                    "path color order 1119 triangulation w/4 threads 1 worker"
+                ),
+                .args = &(TestP3ColorArgs){
+                    .size = 1119,
+                    .type = TEST_GEN_GRAPH_TYPE_TRIANGULATION,
+                    .alg = TEST_P3COLOR_ALG_THREAD,
+                    .nthreads = 4,
+                    .nworkers = 1,
+                    .p1 = slice_array((GraphIndex[]){ 0 }),
+                    .p2 = slice_array((GraphIndex[]){ 2, 1 }),
+                },
+                .fn = test_p3color_graph,
+            },
+            {
+                .desc = aven_str(
+                    "path color order 11119 triangulation w/8 threads"
+                ),
+                .args = &(TestP3ColorArgs){
+                    .size = 11119,
+                    .type = TEST_GEN_GRAPH_TYPE_TRIANGULATION,
+                    .alg = TEST_P3COLOR_ALG_THREAD,
+                    .nthreads = 8,
+                    .p1 = slice_array((GraphIndex[]){ 0 }),
+                    .p2 = slice_array((GraphIndex[]){ 2, 1 }),
+                },
+                .fn = test_p3color_graph,
+            },
+            {
+                .desc = aven_str(
+                    "path color order 1119 triangulation w/aug 4 threads"
+                ),
+                .args = &(TestP3ColorArgs){
+                    .size = 1119,
+                    .type = TEST_GEN_GRAPH_TYPE_TRIANGULATION,
+                    .alg = TEST_P3COLOR_ALG_THREAD_AUG,
+                    .nthreads = 4,
+                    .p1 = slice_array((GraphIndex[]){ 0 }),
+                    .p2 = slice_array((GraphIndex[]){ 2, 1 }),
+                },
+                .fn = test_p3color_graph,
+            },
+            {
+                .desc = aven_str(
+                    "path color order 11119 triangulation w/aug 8 threads"
+                ),
+                .args = &(TestP3ColorArgs){
+                    .size = 11119,
+                    .type = TEST_GEN_GRAPH_TYPE_TRIANGULATION,
+                    .alg = TEST_P3COLOR_ALG_THREAD_AUG,
+                    .nthreads = 8,
+                    .p1 = slice_array((GraphIndex[]){ 0 }),
+                    .p2 = slice_array((GraphIndex[]){ 2, 1 }),
                 },
                 .fn = test_p3color_graph,
             },
@@ -3,11 +3,17 @@
 
     #include <aven.h>
     #include <aven/arena.h>
+    #include <aven/math.h>
+    #include <aven/rng.h>
+    #include <aven/rng/pcg.h>
     #include <aven/str.h>
     #include <aven/test.h>
 
     #include <graph.h>
     #include <graph/plane.h>
+    #include <graph/plane/gen.h>
+    #include <graph/plane/rotation.h>
+    #include <graph/plane/rotation/thread.h>
 
     #include "gen.h"
 
@@ -37,6 +43,310 @@
         return (AvenTestResult){ 0 };
     }
 
+    typedef struct {
+        uint32_t size;
+        TestGenGraphType type;
+    } TestGraphPlaneRotationArgs;
+
+    // Whether the rotation of v in read_graph is a cyclic shift of the one
+    // in graph
+    static bool test_graph_plane_rotation_match(
+        Graph graph,
+        Graph read_graph,
+        GraphIndex v
+    ) {
+        GraphAdj v_adj = get(graph.adj, v);
+        GraphAdj rv_adj = get(read_graph.adj, v);
+        if (v_adj.len != rv_adj.len) {
+            return false;
+        }
+        if (v_adj.len == 0) {
+            return true;
+        }
+
+        GraphIndex shift = 0;
+        GraphIndex first = graph_nb(graph.nb, v_adj, 0);
+        while (
+            shift < rv_adj.len and
+            graph_nb(read_graph.nb, rv_adj, shift) != first
+        ) {
+            shift += 1;
+        }
+
+        for (GraphIndex i = 0; i < v_adj.len; i += 1) {
+            GraphIndex j = (shift + i) % rv_adj.len;
+            if (
+                graph_nb(graph.nb, v_adj, i) !=
+                graph_nb(read_graph.nb, rv_adj, j)
+            ) {
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+    // Edges of a generated plane graph listed in reverse, each once
+    static GraphIoEdgeSlice test_graph_plane_rotation_edges(
+        Graph graph,
+        AvenArena *arena
+    ) {
+        // the generated triangulation may stop short of its capacity
+        size_t nb_len = 0;
+        for (GraphIndex v = 0; v < graph.adj.len; v += 1) {
+            nb_len += get(graph.adj, v).len;
+        }
+
+        GraphIoEdgeSlice edges = aven_arena_create_slice(
+            GraphIoEdge,
+            arena,
+            nb_len / 2
+        );
+        size_t nedges = 0;
+        for (GraphIndex v = (GraphIndex)graph.adj.len; v > 0; v -= 1) {
+            GraphAdj v_adj = get(graph.adj, v - 1);
+            for (GraphIndex i = v_adj.len; i > 0; i -= 1) {
+                GraphIndex u = graph_nb(graph.nb, v_adj, i - 1);
+                if (u > v - 1) {
+                    get(edges, nedges) = (GraphIoEdge){ .u = u, .v = v - 1 };
+                    nedges += 1;
+                }
+            }
+        }
+        assert(nedges == edges.len);
+
+        return edges;
+    }
+
+    // Rebuild the rotations of a generated plane graph from its drawing and
+    // edges listed in reverse
+    AvenTestResult test_graph_plane_rotation(
+        AvenArena *emsg_arena,
+        AvenArena arena,
+        void *opaque_args
+    ) {
+        TestGraphPlaneRotationArgs *args = opaque_args;
+
+        Aff2 ident;
+        aff2_identity(ident);
+
+        GraphPlaneGenData data;
+        switch (args->type) {
+            case TEST_GEN_GRAPH_TYPE_GRID:
+                data = graph_plane_gen_grid(
+                    args->size,
+                    args->size,
+                    ident,
+                    &arena
+                );
+                break;
+            case TEST_GEN_GRAPH_TYPE_PYRAMID:
+                data = graph_plane_gen_pyramid(
+                    args->size,
+                    ident,
+                    0.0f,
+                    &arena
+                );
+                break;
+            case TEST_GEN_GRAPH_TYPE_TRIANGULATION: {
+                AvenRngPcg pcg = aven_rng_pcg_seed(0xdead, 0xbeef);
+                data = graph_plane_gen_triangulation(
+                    args->size,
+                    ident,
+                    0.001f,
+                    0.01f,
+                    false,
+                    aven_rng_pcg(&pcg),
+                    &arena
+                );
+                break;
+            }
+            default:
+                assert(false);
+                return (AvenTestResult){ .error = 1 };
+        }
+        Graph graph = data.graph;
+        GraphIoEdgeSlice edges = test_graph_plane_rotation_edges(graph, &arena);
+
+        Graph read_graph = graph_plane_rotation_graph(
+            data.embedding,
+            edges,
+            &arena
+        );
+        if (!graph_plane_validate(read_graph, arena)) {
+            return (AvenTestResult){
+                .message = aven_str("rebuilt graph not a plane embedding"),
+                .error = 1,
+            };
+        }
+
+        size_t inv_adj = 0;
+        for (GraphIndex v = 0; v < graph.adj.len; v += 1) {
+            if (!test_graph_plane_rotation_match(graph, read_graph, v)) {
+                inv_adj += 1;
+            }
+        }
+        if (inv_adj != 0) {
+            return (AvenTestResult){
+                .error = 1,
+                .message = aven_fmt(
+                    emsg_arena,
+                    "rebuilt rotations differed from original in {} places",
+                    aven_fmt_uint(inv_adj)
+                ),
+            };
+        }
+
+        GraphAug aug_graph = graph_plane_rotation_aug_graph(
+            data.embedding,
+            edges,
+            &arena
+        );
+        if (!graph_plane_aug_validate(aug_graph, arena)) {
+            return (AvenTestResult){
+                .message = aven_str("rebuilt augmented graph not a plane"),
+                .error = 1,
+            };
+        }
+
+        return (AvenTestResult){ 0 };
+    }
+
+    typedef struct {
+        uint32_t size;
+        uint32_t seed;
+        size_t nthreads;
+    } TestGraphPlaneRotationThreadArgs;
+
+    // The threaded rotation sort must match the sequential one exactly on
+    // a random straight-line drawing
+    AvenTestResult test_graph_plane_rotation_thread(
+        AvenArena *emsg_arena,
+        AvenArena arena,
+        void *opaque_args
+    ) {
+        TestGraphPlaneRotationThreadArgs *args = opaque_args;
+
+        Aff2 ident;
+        aff2_identity(ident);
+
+        AvenRngPcg pcg = aven_rng_pcg_seed(args->seed, 0xbeef);
+        GraphPlaneGenData data = graph_plane_gen_triangulation(
+            args->size,
+            ident,
+            0.001f,
+            0.01f,
+            false,
+            aven_rng_pcg(&pcg),
+            &arena
+        );
+        GraphIoEdgeSlice edges = test_graph_plane_rotation_edges(
+            data.graph,
+            &arena
+        );
+
+        Graph graph = graph_plane_rotation_graph(
+            data.embedding,
+            edges,
+            &arena
+        );
+        GraphAug aug_graph = graph_plane_rotation_aug_graph(
+            data.embedding,
+            edges,
+            &arena
+        );
+
+        AvenThreadPool thread_pool = aven_thread_pool_init(
+            args->nthreads - 1,
+            args->nthreads - 1,
+            &arena
+        );
+        aven_thread_pool_run(&thread_pool);
+
+        Graph thread_graph = graph_plane_rotation_graph_thread(
+            data.embedding,
+            edges,
+            &thread_pool,
+            args->nthreads,
+            &arena
+        );
+        GraphAug thread_aug_graph = graph_plane_rotation_aug_graph_thread(
+            data.embedding,
+            edges,
+            &thread_pool,
+            args->nthreads,
+            &arena
+        );
+
+        aven_thread_pool_halt_and_destroy(&thread_pool);
+
+        if (
+            thread_graph.adj.len != graph.adj.len or
+            thread_graph.nb.len != graph.nb.len or
+            thread_aug_graph.adj.len != aug_graph.adj.len or
+            thread_aug_graph.nb.len != aug_graph.nb.len
+        ) {
+            return (AvenTestResult){
+                .message = aven_str("threaded graph has the wrong size"),
+                .error = 1,
+            };
+        }
+
+        size_t inv_adj = 0;
+        for (GraphIndex v = 0; v < graph.adj.len; v += 1) {
+            GraphAdj v_adj = get(graph.adj, v);
+            GraphAdj v_thread_adj = get(thread_graph.adj, v);
+            GraphAdj v_aug_adj = get(aug_graph.adj, v);
+            GraphAdj v_thread_aug_adj = get(thread_aug_graph.adj, v);
+            if (
+                v_adj.index != v_thread_adj.index or
+                v_adj.len != v_thread_adj.len or
+                v_aug_adj.index != v_thread_aug_adj.index or
+                v_aug_adj.len != v_thread_aug_adj.len
+            ) {
+                inv_adj += 1;
+            }
+        }
+        size_t inv_nb = 0;
+        for (GraphIndex i = 0; i < graph.nb.len; i += 1) {
+            GraphAugNb aug_nb = get(aug_graph.nb, i);
+            GraphAugNb thread_aug_nb = get(thread_aug_graph.nb, i);
+            if (
+                get(graph.nb, i) != get(thread_graph.nb, i) or
+                aug_nb.vertex != thread_aug_nb.vertex or
+                aug_nb.back_index != thread_aug_nb.back_index
+            ) {
+                inv_nb += 1;
+            }
+        }
+        if (inv_adj != 0 or inv_nb != 0) {
+            return (AvenTestResult){
+                .error = 1,
+                .message = aven_fmt(
+                    emsg_arena,
+                    "threaded rotations differed in {} vertices, {} entries",
+                    aven_fmt_uint(inv_adj),
+                    aven_fmt_uint(inv_nb)
+                ),
+            };
+        }
+
+        if (!graph_plane_validate(thread_graph, arena)) {
+            return (AvenTestResult){
+                .message = aven_str("threaded graph not a plane embedding"),
+                .error = 1,
+            };
+        }
+        if (!graph_plane_aug_validate(thread_aug_graph, arena)) {
+            return (AvenTestResult){
+                .message = aven_str("threaded augmented graph not a plane"),
+                .error = 1,
+            };
+        }
+
+        return (AvenTestResult){ 0 };
+    }
+
     static void test_plane(AvenArena arena) {
         AvenTestCase tcase_data[] = {
             {
@@ -147,6 +457,66 @@
                 },
                 .fn = test_graph_plane,
             },
+            {
+                .desc = aven_str("rotations from drawing 9x9 grid"),
+                .args = &(TestGraphPlaneRotationArgs){
+                    .size = 9,
+                    .type = TEST_GEN_GRAPH_TYPE_GRID,
+                },
+                .fn = test_graph_plane_rotation,
+            },
+            {
+                .desc = aven_str("rotations from drawing pyramid A_21"),
+                .args = &(TestGraphPlaneRotationArgs){
+                    .size = 21,
+                    .type = TEST_GEN_GRAPH_TYPE_PYRAMID,
+                },
+                .fn = test_graph_plane_rotation,
+            },
+            {
+                .desc = aven_str("rotations from drawn triangulation"),
+                .args = &(TestGraphPlaneRotationArgs){
+                    .size = 99,
+                    .type = TEST_GEN_GRAPH_TYPE_TRIANGULATION,
+                },
+                .fn = test_graph_plane_rotation,
+            },
+            {
+                .desc = aven_str("threaded rotations, 1 thread, order 99"),
+                .args = &(TestGraphPlaneRotationThreadArgs){
+                    .size = 99,
+                    .seed = 0x1234,
+                    .nthreads = 1,
+                },
+                .fn = test_graph_plane_rotation_thread,
+            },
+            {
+                .desc = aven_str("threaded rotations, 3 threads, order 99"),
+                .args = &(TestGraphPlaneRotationThreadArgs){
+                    .size = 99,
+                    .seed = 0x5678,
+                    .nthreads = 3,
+                },
+                .fn = test_graph_plane_rotation_thread,
+            },
+            {
+                .desc = aven_str("threaded rotations, 1 thread, order 999"),
+                .args = &(TestGraphPlaneRotationThreadArgs){
+                    .size = 999,
+                    .seed = 0x9abc,
+                    .nthreads = 1,
+                },
+                .fn = test_graph_plane_rotation_thread,
+            },
+            {
+                .desc = aven_str("threaded rotations, 4 threads, order 999"),
+                .args = &(TestGraphPlaneRotationThreadArgs){
+                    .size = 999,
+                    .seed = 0xdef0,
+                    .nthreads = 4,
+                },
+                .fn = test_graph_plane_rotation_thread,
+            },
         };
         AvenTestCaseSlice tcases = slice_array(tcase_data);
 
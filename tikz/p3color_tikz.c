@@ -132,9 +132,9 @@ int main(void) {
                     frame.value.y != last_frame.y or
                     frame.value.z != last_frame.z or
                     frame.value.edge_index == get(
-                        test_case.ctx.vertex_info,
+                        test_case.ctx.adj,
                         frame.value.u
-                    ).adj.len
+                    ).len
                 ) {
                     steps += 1;
                 }
@@ -158,7 +158,7 @@ int main(void) {
         same_as_bfs = true;
         for (uint32_t v = 0; v < test_case.bfs_coloring.len; v += 1) {
             int32_t bfs_color = (int32_t)get(test_case.bfs_coloring, v);
-            same_as_bfs = get(test_case.ctx.vertex_info, v).mark == bfs_color;
+            same_as_bfs = get(test_case.ctx.marks, v) == bfs_color;
             if (!same_as_bfs) {
                 break;
             }
@@ -188,9 +188,9 @@ int main(void) {
                 frame.value.y != last_frame.y or
                 frame.value.z != last_frame.z or
                 frame.value.edge_index == get(
-                    test_case.ctx.vertex_info,
+                    test_case.ctx.adj,
                     frame.value.u
-                ).adj.len
+                ).len
             ) {
                 graph_plane_p3color_tikz(
                     test_case.embedding,
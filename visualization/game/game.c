@@ -222,7 +222,7 @@ static void game_info_alg_step(GameInfoAlg *info_alg) {
                             ctx->frames,
                             j - 1
                         );
-                        if (get(ctx->vertex_info, nframe->z).colors.len == 1) {
+                        if (get(ctx->colors, nframe->z).len == 1) {
                             frame->valid = true;
                             frame->value = *nframe;
                             *nframe = get(ctx->frames, ctx->frames.len - 1);